@@ -0,0 +1,148 @@
+// Copyright 2010-2021:
+//   GobySoft, LLC (2013-)
+//   Massachusetts Institute of Technology (2007-2014)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+
+#include "ip_header_compression.h"
+
+std::uint32_t goby::acomms::ip_header_compression_check(const protobuf::NetworkHeader& header)
+{
+    // FNV-1a, folded to the width of the check
+    std::uint32_t hash = 2166136261u;
+    for (unsigned char c : header.SerializeAsString())
+    {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return (hash ^ (hash >> 6) ^ (hash >> 12) ^ (hash >> 18) ^ (hash >> 24) ^ (hash >> 30)) %
+           IP_HEADER_COMPRESSION_CHECK_MODULUS;
+}
+
+goby::acomms::protobuf::CompressedNetworkHeader
+goby::acomms::IPHeaderCompressor::compress(int dest, const protobuf::NetworkHeader& header)
+{
+    std::string flow = header.SerializeAsString();
+    ++packet_count_;
+
+    auto& contexts = contexts_[dest];
+    Context* context = nullptr;
+    for (auto& c : contexts)
+    {
+        if (c.flow == flow)
+        {
+            context = &c;
+            break;
+        }
+    }
+
+    bool send_full = false;
+    if (!context)
+    {
+        // unused contexts have last_used == 0, so are taken first
+        context = &contexts[0];
+        for (auto& c : contexts)
+        {
+            if (c.last_used < context->last_used)
+                context = &c;
+        }
+        context->flow = flow;
+        context->generation =
+            (context->generation + 1) % IP_HEADER_COMPRESSION_GENERATION_MODULUS;
+        context->check = ip_header_compression_check(header);
+        context->sequence = 0;
+        send_full = true;
+    }
+    else if (++context->since_refresh >= refresh_interval_)
+    {
+        send_full = true;
+    }
+    context->last_used = packet_count_;
+
+    protobuf::CompressedNetworkHeader compressed;
+    compressed.set_context(context - &contexts[0]);
+    compressed.set_sequence(context->sequence);
+    compressed.set_generation(context->generation);
+    compressed.set_check(context->check);
+    if (send_full)
+    {
+        *compressed.mutable_full() = header;
+        context->since_refresh = 0;
+    }
+
+    context->sequence = (context->sequence + 1) % IP_HEADER_COMPRESSION_SEQUENCE_MODULUS;
+    return compressed;
+}
+
+void goby::acomms::IPHeaderCompressor::reset(int dest)
+{
+    auto it = contexts_.find(dest);
+    if (it == contexts_.end())
+        return;
+
+    // keep the generations, so that the flows are reassigned to a new generation of their contexts
+    for (auto& c : it->second)
+    {
+        c.flow.clear();
+        c.last_used = 0;
+    }
+}
+
+bool goby::acomms::IPHeaderDecompressor::decompress(
+    int src, int dest, const protobuf::CompressedNetworkHeader& compressed,
+    protobuf::NetworkHeader* header)
+{
+    auto& context = contexts_[std::make_pair(src, dest)][compressed.context()];
+
+    if (compressed.has_full())
+    {
+        if (ip_header_compression_check(compressed.full()) != compressed.check())
+        {
+            ++packets_dropped_;
+            return false;
+        }
+
+        // a new flow if the generation changed
+        if (context.valid && context.generation != compressed.generation())
+            context.valid = false;
+        context.header = compressed.full();
+        context.generation = compressed.generation();
+        context.check = compressed.check();
+    }
+    else if (!context.valid || context.generation != compressed.generation() ||
+             context.check != compressed.check())
+    {
+        // the context was reassigned and we missed its full header(s)
+        context.valid = false;
+        ++packets_dropped_;
+        return false;
+    }
+
+    if (context.valid)
+        packets_lost_ += (int(compressed.sequence()) - context.next_sequence +
+                          IP_HEADER_COMPRESSION_SEQUENCE_MODULUS) %
+                         IP_HEADER_COMPRESSION_SEQUENCE_MODULUS;
+
+    context.valid = true;
+    context.next_sequence =
+        (compressed.sequence() + 1) % IP_HEADER_COMPRESSION_SEQUENCE_MODULUS;
+    *header = context.header;
+    return true;
+}
@@ -0,0 +1,116 @@
+// Copyright 2016-2021:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_ACOMMS_IP_HEADER_COMPRESSION_H
+#define GOBY_ACOMMS_IP_HEADER_COMPRESSION_H
+
+#include <array>   // for array
+#include <cstdint> // for uint32_t, uint64_t
+#include <map>     // for map
+#include <string>  // for string
+#include <utility> // for pair
+
+#include "goby/acomms/protobuf/network_header.pb.h" // for NetworkHeader, CompressedNetw...
+
+namespace goby
+{
+namespace acomms
+{
+/// \brief Bounds of CompressedNetworkHeader's context, sequence, generation and check fields
+enum
+{
+    IP_HEADER_COMPRESSION_CONTEXTS = 8,
+    IP_HEADER_COMPRESSION_SEQUENCE_MODULUS = 8,
+    IP_HEADER_COMPRESSION_GENERATION_MODULUS = 8,
+    IP_HEADER_COMPRESSION_CHECK_MODULUS = 64
+};
+
+/// \brief Value of CompressedNetworkHeader::check for header
+std::uint32_t ip_header_compression_check(const protobuf::NetworkHeader& header);
+
+/// \brief Sender side of the stateful NetworkHeader compression used by goby_ip_gateway
+///
+/// Each destination has its own IP_HEADER_COMPRESSION_CONTEXTS contexts, so that a receiver only has to follow the flows sent to it. Each flow (distinct NetworkHeader) is assigned one of these contexts (the least recently used is reassigned when all are in use). The full NetworkHeader is only sent with the first packet of the flow and then every refresh_interval packets, which resynchronizes receivers that lost the previous full header.
+class IPHeaderCompressor
+{
+  public:
+    IPHeaderCompressor(int refresh_interval) : refresh_interval_(refresh_interval) {}
+
+    /// \brief Compresses header for a packet sent to dest
+    protobuf::CompressedNetworkHeader compress(int dest, const protobuf::NetworkHeader& header);
+
+    /// \brief Sends the full header with the next packet of every flow to dest, e.g. when queued packets to dest were discarded before being sent
+    void reset(int dest);
+
+  private:
+    struct Context
+    {
+        std::string flow; // serialized NetworkHeader, empty if unused
+        std::uint32_t generation{0};
+        std::uint32_t check{0};
+        int sequence{0};
+        int since_refresh{0};
+        std::uint64_t last_used{0};
+    };
+
+    const int refresh_interval_;
+    // dest -> contexts
+    std::map<int, std::array<Context, IP_HEADER_COMPRESSION_CONTEXTS>> contexts_;
+    std::uint64_t packet_count_{0};
+};
+
+/// \brief Receiver side of the stateful NetworkHeader compression used by goby_ip_gateway, with separate contexts for each sender and destination
+class IPHeaderDecompressor
+{
+  public:
+    /// \brief Restores the NetworkHeader sent by src to dest
+    ///
+    /// \return false if header could not be restored as the full NetworkHeader for its context hasn't been received, or the restored header doesn't match the check of compressed (the packet must be dropped)
+    bool decompress(int src, int dest, const protobuf::CompressedNetworkHeader& compressed,
+                    protobuf::NetworkHeader* header);
+
+    /// \brief Number of packets that were not received, as detected by gaps in the sequence numbers
+    std::uint64_t packets_lost() const { return packets_lost_; }
+    /// \brief Number of packets that could not be decompressed (see decompress())
+    std::uint64_t packets_dropped() const { return packets_dropped_; }
+
+  private:
+    struct Context
+    {
+        bool valid{false};
+        std::uint32_t generation{0};
+        std::uint32_t check{0};
+        int next_sequence{0};
+        protobuf::NetworkHeader header;
+    };
+
+    // (src, dest) -> contexts
+    std::map<std::pair<int, int>, std::array<Context, IP_HEADER_COMPRESSION_CONTEXTS>> contexts_;
+    std::uint64_t packets_lost_{0};
+    std::uint64_t packets_dropped_{0};
+};
+
+} // namespace acomms
+} // namespace goby
+
+#endif
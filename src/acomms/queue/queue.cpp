@@ -77,11 +77,17 @@ goby::acomms::Queue::Queue(const google::protobuf::Descriptor* desc, QueueManage
 bool goby::acomms::Queue::push_message(const std::shared_ptr<google::protobuf::Message>& dccl_msg)
 {
     protobuf::QueuedMessageMeta meta = meta_from_msg(*dccl_msg);
-    return push_message(dccl_msg, meta);
+    return push_message(dccl_msg, meta, meta.non_repeated_size());
 }
 
 bool goby::acomms::Queue::push_message(const std::shared_ptr<google::protobuf::Message>& dccl_msg,
                                        protobuf::QueuedMessageMeta meta)
+{
+    return push_message(dccl_msg, std::move(meta), 0);
+}
+
+bool goby::acomms::Queue::push_message(const std::shared_ptr<google::protobuf::Message>& dccl_msg,
+                                       protobuf::QueuedMessageMeta meta, unsigned encoded_size)
 {
     // loopback if set
     if (parent_->manip_manager_.has(id(), protobuf::LOOPBACK) && !meta.has_encoded_message())
@@ -146,6 +152,8 @@ bool goby::acomms::Queue::push_message(const std::shared_ptr<google::protobuf::M
     messages_.emplace_back();
     messages_.back().meta = meta;
     messages_.back().dccl_msg = dccl_msg;
+    // size once here, rather than each time a frame is packed
+    messages_.back().encoded_size = encoded_size ? encoded_size : parent_->codec_->size(*dccl_msg);
 
     glog.is(DEBUG1) && glog << group(parent_->glog_push_group())
                             << "pushed to send stack (queue size " << size() << "/"
@@ -166,15 +174,11 @@ bool goby::acomms::Queue::push_message(const std::shared_ptr<google::protobuf::M
         if (it_to_erase == messages_.end())
             --it_to_erase;
 
-        // if we were waiting for an ack for this, erase that too
-        auto it = find_ack_value(it_to_erase);
-        if (it != waiting_for_ack_.end())
-            waiting_for_ack_.erase(it);
-
         glog.is(DEBUG1) && glog << group(parent_->glog_pop_group()) << "queue exceeded for "
                                 << name() << ". removing: " << it_to_erase->meta << std::endl;
 
-        messages_.erase(it_to_erase);
+        // if we were waiting for an ack for this, erase that too
+        erase(it_to_erase);
     }
 
     return true;
@@ -182,9 +186,16 @@ bool goby::acomms::Queue::push_message(const std::shared_ptr<google::protobuf::M
 
 goby::acomms::protobuf::QueuedMessageMeta
 goby::acomms::Queue::meta_from_msg(const google::protobuf::Message& dccl_msg)
+{
+    return meta_from_msg(dccl_msg, parent_->codec_->size(dccl_msg));
+}
+
+goby::acomms::protobuf::QueuedMessageMeta
+goby::acomms::Queue::meta_from_msg(const google::protobuf::Message& dccl_msg,
+                                   unsigned encoded_size)
 {
     protobuf::QueuedMessageMeta meta = static_meta_;
-    meta.set_non_repeated_size(parent_->codec_->size(dccl_msg));
+    meta.set_non_repeated_size(encoded_size);
 
     if (!roles_[protobuf::QueuedMessageEntry::DESTINATION_ID].empty())
     {
@@ -318,14 +329,14 @@ boost::any goby::acomms::Queue::find_queue_field(const std::string& field_name,
     return boost::any();
 }
 
-goby::acomms::messages_it goby::acomms::Queue::next_message_it()
+goby::acomms::Queue::messages_it goby::acomms::Queue::next_message_it()
 {
     auto it_to_give = queue_message_options().newest_first() ? messages_.end() : messages_.begin();
     if (it_to_give == messages_.end())
         --it_to_give; // want "back" iterator not "end"
 
     // find a value that isn't already waiting to be acknowledged
-    while (find_ack_value(it_to_give) != waiting_for_ack_.end())
+    while (it_to_give->waiting_for_ack)
         queue_message_options().newest_first() ? --it_to_give : ++it_to_give;
 
     return it_to_give;
@@ -348,7 +359,11 @@ goby::acomms::QueuedMessage goby::acomms::Queue::give_data(unsigned frame)
     it_to_give->meta.set_ack_requested(ack);
 
     if (ack)
-        waiting_for_ack_.insert(std::pair<unsigned, messages_it>(frame, it_to_give));
+    {
+        it_to_give->waiting_for_ack = true;
+        it_to_give->ack_frame = frame;
+        ++num_waiting_for_ack_;
+    }
 
     last_send_time_ = time::SystemClock::now<boost::posix_time::ptime>();
     it_to_give->meta.set_last_sent_time_with_units(time::convert<time::MicroTime>(last_send_time_));
@@ -376,17 +391,32 @@ bool goby::acomms::Queue::get_priority_values(double* priority,
                                               const protobuf::ModemTransmission& request_msg,
                                               const std::string& data)
 {
-    *priority = time_duration2double(
-                    (time::SystemClock::now<boost::posix_time::ptime>() - last_send_time_)) /
-                queue_message_options().ttl() * queue_message_options().value_base();
-
+    *priority = this->priority(time::SystemClock::now<boost::posix_time::ptime>());
     *last_send_time = last_send_time_;
 
+    if (!can_send(request_msg, data))
+        return false;
+
+    glog.is(DEBUG1) && glog << group(parent_->glog_priority_group()) << "\t" << name()
+                            << " has priority value: " << *priority << std::endl;
+    return true;
+}
+
+double goby::acomms::Queue::priority(const boost::posix_time::ptime& now)
+{
+    return time_duration2double(now - last_send_time_) / queue_message_options().ttl() *
+           queue_message_options().value_base();
+}
+
+bool goby::acomms::Queue::can_send(const protobuf::ModemTransmission& request_msg,
+                                   const std::string& data)
+{
     // no messages left to send
-    if (messages_.size() <= waiting_for_ack_.size())
+    if (!has_data())
         return false;
 
-    protobuf::QueuedMessageMeta& next_msg = next_message_it()->meta;
+    const QueuedMessage& next = *next_message_it();
+    const protobuf::QueuedMessageMeta& next_msg = next.meta;
 
     // for followup user-frames, destination must be either zero (broadcast)
     // or the same as the first user-frame
@@ -400,11 +430,11 @@ bool goby::acomms::Queue::get_priority_values(double* priority,
     }
     // wrong size
     else if (request_msg.has_max_frame_bytes() &&
-             (next_msg.non_repeated_size() > (request_msg.max_frame_bytes() - data.size())))
+             (next.encoded_size > (request_msg.max_frame_bytes() - data.size())))
     {
         glog.is(DEBUG1) && glog << group(parent_->glog_priority_group()) << "\t" << name()
-                                << " next message is too large {" << next_msg.non_repeated_size()
-                                << "}" << std::endl;
+                                << " next message is too large {" << next.encoded_size << "}"
+                                << std::endl;
         return false;
     }
     // wrong destination
@@ -431,8 +461,7 @@ bool goby::acomms::Queue::get_priority_values(double* priority,
     else // ok!
     {
         glog.is(DEBUG1) && glog << group(parent_->glog_priority_group()) << "\t" << name() << " ("
-                                << next_msg.non_repeated_size() << "B) has priority value"
-                                << ": " << *priority << std::endl;
+                                << next.encoded_size << "B) can send" << std::endl;
         return true;
     }
 }
@@ -451,7 +480,7 @@ bool goby::acomms::Queue::pop_message(unsigned /*frame*/)
         if (!it->meta.ack_requested())
         {
             stream_for_pop(*it);
-            messages_.erase(it);
+            erase(it);
             return true;
         }
 
@@ -467,18 +496,16 @@ bool goby::acomms::Queue::pop_message_ack(unsigned frame,
                                           std::shared_ptr<google::protobuf::Message>& removed_msg)
 {
     // pop message from the ack stack
-    if (waiting_for_ack_.count(frame))
+    auto it = find_ack_frame(frame);
+    if (it != messages_.end())
     {
         // remove a messages in this frame that needs ack
-        auto it = waiting_for_ack_.find(frame);
-        removed_msg = (it->second)->dccl_msg;
+        removed_msg = it->dccl_msg;
 
-        stream_for_pop(*it->second);
+        stream_for_pop(*it);
 
-        // remove the message
-        messages_.erase(it->second);
-        // clear the acknowledgement map entry for this message
-        waiting_for_ack_.erase(it);
+        // remove the message, and with it the acknowledgement state
+        erase(it);
     }
     else
     {
@@ -518,11 +545,7 @@ std::vector<std::shared_ptr<google::protobuf::Message>> goby::acomms::Queue::exp
                                     << "/" << queue_message_options().max_queue()
                                     << "): " << *messages_.front().dccl_msg << std::endl;
             // if we were waiting for an ack for this, erase that too
-            auto it = find_ack_value(messages_.begin());
-            if (it != waiting_for_ack_.end())
-                waiting_for_ack_.erase(it);
-
-            messages_.pop_front();
+            erase(messages_.begin());
         }
         else
         {
@@ -533,15 +556,37 @@ std::vector<std::shared_ptr<google::protobuf::Message>> goby::acomms::Queue::exp
     return expired_msgs;
 }
 
-goby::acomms::waiting_for_ack_it goby::acomms::Queue::find_ack_value(messages_it it_to_find)
+goby::acomms::Queue::messages_it goby::acomms::Queue::find_ack_frame(unsigned frame)
 {
-    auto n = waiting_for_ack_.end();
-    for (auto it = waiting_for_ack_.begin(); it != n; ++it)
+    if (!num_waiting_for_ack_)
+        return messages_.end();
+
+    // messages are given from the back (newest_first) or front, so search from there
+    if (queue_message_options().newest_first())
     {
-        if (it->second == it_to_find)
-            return it;
+        for (auto it = messages_.end(); it != messages_.begin();)
+        {
+            --it;
+            if (it->waiting_for_ack && it->ack_frame == frame)
+                return it;
+        }
     }
-    return n;
+    else
+    {
+        for (auto it = messages_.begin(), end = messages_.end(); it != end; ++it)
+        {
+            if (it->waiting_for_ack && it->ack_frame == frame)
+                return it;
+        }
+    }
+    return messages_.end();
+}
+
+void goby::acomms::Queue::erase(messages_it it)
+{
+    if (it->waiting_for_ack)
+        --num_waiting_for_ack_;
+    messages_.erase(it);
 }
 
 void goby::acomms::Queue::info(std::ostream* os) const
@@ -559,40 +604,45 @@ void goby::acomms::Queue::flush()
     glog.is(DEBUG1) && glog << group(parent_->glog_pop_group()) << "flushing stack " << name()
                             << " (qsize 0)" << std::endl;
     messages_.clear();
-    waiting_for_ack_.clear();
+    num_waiting_for_ack_ = 0;
 }
 
 bool goby::acomms::Queue::clear_ack_queue(unsigned start_frame)
 {
-    for (auto it = waiting_for_ack_.begin(), end = waiting_for_ack_.end(); it != end;)
+    if (!num_waiting_for_ack_)
+        return true;
+
+    auto now = time::SystemClock::now<time::MicroTime>();
+    for (auto& msg : messages_)
     {
+        if (!msg.waiting_for_ack)
+            continue;
+
         // clear out acks for frames whose ack wait time has expired (or whose frame
         // number has come around again. This should avoid losing unack'd data.
-        if (it->first >= start_frame)
+        if (msg.ack_frame >= start_frame)
         {
             glog.is(DEBUG1) &&
                 glog << group(parent_->glog_pop_group()) << name()
                      << ": Clearing ack for queue because last_frame >= current_frame" << std::endl;
-            waiting_for_ack_.erase(it++);
+            msg.waiting_for_ack = false;
+            --num_waiting_for_ack_;
         }
-        else if (it->second->meta.last_sent_time_with_units() +
+        else if (msg.meta.last_sent_time_with_units() +
                      time::MicroTime(parent_->cfg_.minimum_ack_wait_seconds() *
                                      boost::units::si::seconds) <
-                 time::SystemClock::now<time::MicroTime>())
+                 now)
         {
             glog.is(DEBUG1) && glog << group(parent_->glog_pop_group()) << name()
                                     << ": Clearing ack for queue because "
                                     << parent_->cfg_.minimum_ack_wait_seconds()
                                     << " seconds has elapsed since last send. Last send:"
-                                    << it->second->meta.last_sent_time() << std::endl;
-            waiting_for_ack_.erase(it++);
-        }
-        else
-        {
-            ++it;
+                                    << msg.meta.last_sent_time() << std::endl;
+            msg.waiting_for_ack = false;
+            --num_waiting_for_ack_;
         }
     }
-    return waiting_for_ack_.empty();
+    return num_waiting_for_ack_ == 0;
 }
 
 std::ostream& goby::acomms::operator<<(std::ostream& os, const goby::acomms::Queue& oq)
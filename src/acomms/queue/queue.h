@@ -25,10 +25,11 @@
 #ifndef GOBY_ACOMMS_QUEUE_QUEUE_H
 #define GOBY_ACOMMS_QUEUE_QUEUE_H
 
-#include <cstddef> // for size_t
+#include <cstddef>  // for size_t
+#include <deque>    // for deque
 #include <iostream> // for ostream
 #include <list>     // for list
-#include <map>      // for multimap
+#include <map>      // for map, multimap
 #include <memory>   // for shared_ptr
 #include <string>   // for string
 #include <vector>   // for vector
@@ -65,10 +66,14 @@ struct QueuedMessage
 {
     std::shared_ptr<google::protobuf::Message> dccl_msg;
     protobuf::QueuedMessageMeta meta;
+    // DCCL encoded size of dccl_msg (bytes), computed once when pushed
+    unsigned encoded_size{0};
 };
 
-typedef std::list<QueuedMessage>::iterator messages_it;
-using waiting_for_ack_it = std::multimap<unsigned int, messages_it>::iterator;
+// Queue no longer stores its messages in a std::list with a multimap of the frames waiting for acknowledgment
+[[deprecated("no longer used by Queue")]] typedef std::list<QueuedMessage>::iterator messages_it;
+[[deprecated("no longer used by Queue")]] typedef std::multimap<
+    unsigned int, std::list<QueuedMessage>::iterator>::iterator waiting_for_ack_it;
 
 class Queue
 {
@@ -81,6 +86,9 @@ class Queue
                       protobuf::QueuedMessageMeta meta);
 
     protobuf::QueuedMessageMeta meta_from_msg(const google::protobuf::Message& dccl_msg);
+    /// \brief As meta_from_msg(dccl_msg), for a message whose encoded size is already known
+    protobuf::QueuedMessageMeta meta_from_msg(const google::protobuf::Message& dccl_msg,
+                                              unsigned encoded_size);
 
     boost::any find_queue_field(const std::string& field_name,
                                 const google::protobuf::Message& msg);
@@ -96,6 +104,15 @@ class Queue
                              const protobuf::ModemTransmission& request_msg,
                              const std::string& data);
 
+    /// \brief Priority value at the given time (grows linearly with the time since the last send)
+    double priority(const boost::posix_time::ptime& now);
+
+    /// \brief Returns false if in blackout interval, if no data, or if the next message is of the wrong size, destination or ack value for this request
+    bool can_send(const protobuf::ModemTransmission& request_msg, const std::string& data);
+
+    /// \brief Returns true if there are messages not already waiting for an acknowledgment
+    bool has_data() const { return messages_.size() > num_waiting_for_ack_; }
+
     // returns true if empty
     bool clear_ack_queue(unsigned start_frame);
 
@@ -130,8 +147,25 @@ class Queue
     int id() { return goby::acomms::DCCLCodec::get()->id(desc_); }
 
   private:
-    waiting_for_ack_it find_ack_value(messages_it it_to_find);
+    // encoded_size of 0 if not yet known
+    bool push_message(const std::shared_ptr<google::protobuf::Message>& dccl_msg,
+                      protobuf::QueuedMessageMeta meta, unsigned encoded_size);
+
+    // message on the send stack, and whether it is waiting to be acknowledged
+    struct StackMessage : public QueuedMessage
+    {
+        bool waiting_for_ack{false};
+        // frame this message was sent in, if waiting_for_ack
+        unsigned ack_frame{0};
+    };
+    using messages_it = std::deque<StackMessage>::iterator;
+
+    // returns the back (newest_first) or front message that isn't waiting for an ack (requires has_data())
     messages_it next_message_it();
+    // returns messages_.end() if not found
+    messages_it find_ack_frame(unsigned frame);
+    // erases it, keeping num_waiting_for_ack_ up to date
+    void erase(messages_it it);
 
     void set_latest_metadata(const google::protobuf::FieldDescriptor* field,
                              const boost::any& field_value, const boost::any& wire_value);
@@ -151,11 +185,11 @@ class Queue
 
     boost::posix_time::ptime last_send_time_;
 
-    std::list<QueuedMessage> messages_;
+    // contiguous for the scans over the send stack, and usually only pushed and popped at the ends
+    std::deque<StackMessage> messages_;
 
-    // map frame number onto messages list iterator
-    // can have multiples in the same frame now
-    std::multimap<unsigned, messages_it> waiting_for_ack_;
+    // number of messages_ with waiting_for_ack (can have multiples in the same frame)
+    std::size_t num_waiting_for_ack_{0};
 
     protobuf::QueuedMessageMeta static_meta_;
 };
@@ -23,9 +23,10 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with Goby.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <cassert> // for assert
-#include <cstdint> // for int32_t
-#include <memory>   // for shared...
+#include <algorithm> // for make_heap, pop_heap, push_heap
+#include <cassert>   // for assert
+#include <cstdint>   // for int32_t
+#include <memory>    // for shared...
 #include <ostream>  // for operat...
 #include <vector>   // for vector
 
@@ -257,6 +258,8 @@ void goby::acomms::QueueManager::handle_modem_data_request(protobuf::ModemTransm
         else
         {
             std::list<QueuedMessage> dccl_msgs;
+            // encoded size of dccl_msgs, kept as each is added
+            unsigned repeated_size_bytes = 0;
 
             // set true if we are passing on encrypted data untouched
             bool using_encrypted_body = false;
@@ -346,8 +349,10 @@ void goby::acomms::QueueManager::handle_modem_data_request(protobuf::ModemTransm
                 // new_data.insert(DCCL_NUM_HEADER_BYTES, frame_size);
 
                 // fix the destination
-                next_user_frame.meta = meta_from_msg(*next_user_frame.dccl_msg);
-                dccl_msgs.push_back(next_user_frame);
+                next_user_frame.meta = winning_queue->meta_from_msg(*next_user_frame.dccl_msg,
+                                                                    next_user_frame.encoded_size);
+                repeated_size_bytes += next_user_frame.encoded_size;
+                dccl_msgs.push_back(std::move(next_user_frame));
 
                 //
                 if (using_encrypted_body)
@@ -357,8 +362,6 @@ void goby::acomms::QueueManager::handle_modem_data_request(protobuf::ModemTransm
                 }
                 else
                 {
-                    unsigned repeated_size_bytes = size_repeated(dccl_msgs);
-
                     glog.is(DEBUG2) && glog << group(glog_out_group_) << "Size repeated "
                                             << repeated_size_bytes << std::endl;
                     data->resize(repeated_size_bytes + original_data_size);
@@ -503,18 +506,20 @@ goby::acomms::QueueManager::decode_repeated(const std::string& orig_bytes)
     return out;
 }
 
-unsigned goby::acomms::QueueManager::size_repeated(const std::list<QueuedMessage>& msgs)
-{
-    unsigned out = 0;
-    for (const QueuedMessage& msg : msgs) out += codec_->size(*(msg.dccl_msg));
-    return out;
-}
-
 void goby::acomms::QueueManager::clear_packet(const protobuf::ModemTransmission& message)
 {
+    // clear each queue once, however many frames it is waiting on (value is true if now empty)
+    std::map<Queue*, bool> cleared;
     for (auto it = waiting_for_ack_.begin(), end = waiting_for_ack_.end(); it != end;)
     {
-        if (it->second->clear_ack_queue(message.frame_start()))
+        auto cleared_it = cleared.find(it->second);
+        if (cleared_it == cleared.end())
+            cleared_it = cleared
+                             .insert(std::make_pair(
+                                 it->second, it->second->clear_ack_queue(message.frame_start())))
+                             .first;
+
+        if (cleared_it->second)
             waiting_for_ack_.erase(it++);
         else
             ++it;
@@ -526,67 +531,87 @@ void goby::acomms::QueueManager::clear_packet(const protobuf::ModemTransmission&
 
 goby::acomms::Queue*
 goby::acomms::QueueManager::find_next_sender(const protobuf::ModemTransmission& request_msg,
-                                             const std::string& data, bool /*first_user_frame*/)
+                                             const std::string& data, bool first_user_frame)
 {
-    // competition between variable about who gets to send
-    double winning_priority = 0;
-    boost::posix_time::ptime winning_last_send_time;
-
-    Queue* winning_queue = nullptr;
-
     glog.is(DEBUG1) && glog << group(glog_priority_group_) << "Starting priority contest\n"
                             << "\tRequesting " << request_msg.max_num_frames() << " frame(s), have "
                             << data.size() << "/" << request_msg.max_frame_bytes() << "B"
                             << std::endl;
 
-    for (auto& queue : queues_)
+    // The priorities are computed for all the queues at the first user-frame and kept in a heap for the rest of the frame: within a frame only the last winner's priority changes (it was just sent), and the other queues can only become unable to send (as the frame fills), so these are dropped from the heap when found
+    if (first_user_frame)
     {
-        Queue& q = *(queue.second);
-
-        // encode on demand
-        if (manip_manager_.has(codec_->id(q.descriptor()), protobuf::ON_DEMAND) &&
-            (!q.size() || q.newest_msg_time() + boost::posix_time::microseconds(static_cast<long>(
-                                                    cfg_.on_demand_skew_seconds() * 1e6)) <
-                              time::SystemClock::now<boost::posix_time::ptime>()))
+        contenders_.clear();
+        contest_time_ = time::SystemClock::now<boost::posix_time::ptime>();
+        for (auto& queue : queues_)
         {
-            auto new_msg = dccl::DynamicProtobufManager::new_protobuf_message<
-                std::shared_ptr<google::protobuf::Message> >(q.descriptor());
-            signal_data_on_demand(request_msg, new_msg.get());
-
-            if (new_msg->IsInitialized())
-                push_message(*new_msg);
+            Queue& q = *(queue.second);
+            encode_on_demand(request_msg, q);
+            if (q.has_data())
+                contenders_.push_back(
+                    {q.priority(contest_time_), q.last_send_time(), queue.first, &q});
         }
-
-        double priority;
-        boost::posix_time::ptime last_send_time;
-        if (q.get_priority_values(&priority, &last_send_time, request_msg, data))
+        std::make_heap(contenders_.begin(), contenders_.end());
+    }
+    else if (last_winner_)
+    {
+        Queue& q = *last_winner_;
+        encode_on_demand(request_msg, q);
+        if (q.has_data())
         {
-            // no winner, better winner, or equal & older winner
-            if ((!winning_queue || priority > winning_priority ||
-                 (priority == winning_priority && last_send_time < winning_last_send_time)))
-            {
-                winning_priority = priority;
-                winning_last_send_time = last_send_time;
-                winning_queue = &q;
-            }
+            contenders_.push_back(
+                {q.priority(contest_time_), q.last_send_time(), codec_->id(q.descriptor()), &q});
+            std::push_heap(contenders_.begin(), contenders_.end());
         }
     }
 
-    glog.is(DEBUG1) && glog << group(glog_priority_group_) << "\t"
-                            << "all other queues have no messages" << std::endl;
+    last_winner_ = nullptr;
+    while (!contenders_.empty())
+    {
+        std::pop_heap(contenders_.begin(), contenders_.end());
+        Contender next = contenders_.back();
+        contenders_.pop_back();
+
+        if (next.queue->can_send(request_msg, data))
+        {
+            glog.is(DEBUG1) && glog << group(glog_priority_group_) << "\t" << next.queue->name()
+                                    << " has priority value: " << next.priority << std::endl;
+            last_winner_ = next.queue;
+            break;
+        }
+    }
 
-    if (winning_queue)
+    if (last_winner_)
     {
-        glog.is(DEBUG1) && glog << group(glog_priority_group_) << winning_queue->name()
+        glog.is(DEBUG1) && glog << group(glog_priority_group_) << last_winner_->name()
                                 << " has highest priority." << std::endl;
     }
     else
     {
+        glog.is(DEBUG1) && glog << group(glog_priority_group_) << "\t"
+                                << "all other queues have no messages" << std::endl;
         glog.is(DEBUG1) && glog << group(glog_priority_group_) << "ending priority contest"
                                 << std::endl;
     }
 
-    return winning_queue;
+    return last_winner_;
+}
+
+void goby::acomms::QueueManager::encode_on_demand(const protobuf::ModemTransmission& request_msg,
+                                                  Queue& q)
+{
+    if (manip_manager_.has(codec_->id(q.descriptor()), protobuf::ON_DEMAND) &&
+        (!q.size() || q.newest_msg_time() + boost::posix_time::microseconds(static_cast<long>(
+                                                cfg_.on_demand_skew_seconds() * 1e6)) <
+                          time::SystemClock::now<boost::posix_time::ptime>()))
+    {
+        auto new_msg = dccl::DynamicProtobufManager::new_protobuf_message<
+            std::shared_ptr<google::protobuf::Message> >(q.descriptor());
+        signal_data_on_demand(request_msg, new_msg.get());
+
+        if (new_msg->IsInitialized())
+            push_message(*new_msg);
+    }
 }
 
 void goby::acomms::QueueManager::process_modem_ack(const protobuf::ModemTransmission& ack_msg)
@@ -32,10 +32,12 @@
 #include <set>     // for set
 #include <string>  // for string, operator+
 #include <utility> // for pair, make_pair
+#include <vector>  // for vector
 
-#include <boost/signals2/signal.hpp>    // for signal
-#include <google/protobuf/descriptor.h> // for Descriptor
-#include <google/protobuf/message.h>    // for Message
+#include <boost/date_time/posix_time/ptime.hpp> // for ptime
+#include <boost/signals2/signal.hpp>            // for signal
+#include <google/protobuf/descriptor.h>         // for Descriptor
+#include <google/protobuf/message.h>            // for Message
 
 #include "goby/acomms/dccl/dccl.h"               // for DCCLCodec
 #include "goby/acomms/protobuf/manipulator.pb.h" // for Manipulator
@@ -243,6 +245,8 @@ class QueueManager
     // finds the %queue with the highest priority
     Queue* find_next_sender(const protobuf::ModemTransmission& message, const std::string& data,
                             bool first_user_frame);
+    // pushes a message from signal_data_on_demand if q has the ON_DEMAND manipulator and needs one
+    void encode_on_demand(const protobuf::ModemTransmission& request_msg, Queue& q);
 
     // clears the destination and ack values for the packet to reset for next $CADRQ
     void clear_packet(const protobuf::ModemTransmission& message);
@@ -255,13 +259,35 @@ class QueueManager
     // "overload" those from DCCLCodec to allow changing of crypto passphrase
     std::string encode_repeated(const std::list<QueuedMessage>& msgs);
     std::list<QueuedMessage> decode_repeated(const std::string& orig_bytes);
-    unsigned size_repeated(const std::list<QueuedMessage>& msgs);
 
   private:
     friend class Queue;
     int modem_id_;
     std::map<unsigned, std::shared_ptr<Queue> > queues_;
 
+    // %queue in the priority contest for the current frame
+    struct Contender
+    {
+        double priority;
+        boost::posix_time::ptime last_send_time;
+        unsigned dccl_id;
+        Queue* queue;
+
+        // highest priority, then oldest last_send_time, then lowest DCCL id is the greatest
+        bool operator<(const Contender& other) const
+        {
+            if (priority != other.priority)
+                return priority < other.priority;
+            if (last_send_time != other.last_send_time)
+                return last_send_time > other.last_send_time;
+            return dccl_id > other.dccl_id;
+        }
+    };
+    // max-heap of the queues that may still send in the current frame (see find_next_sender)
+    std::vector<Contender> contenders_;
+    boost::posix_time::ptime contest_time_;
+    Queue* last_winner_{nullptr};
+
     // map frame number onto %queue pointer that contains
     // the data for this ack
     std::multimap<unsigned, Queue*> waiting_for_ack_;
@@ -33,6 +33,7 @@ protobuf_generate_cpp(ACOMMS_PROTO_SRCS ACOMMS_PROTO_HDRS
 
 set(ACOMMS_SRC
   acomms/ip_codecs.cpp
+  acomms/ip_header_compression.cpp
   acomms/dccl/dccl.cpp
   acomms/queue/queue.cpp
   acomms/queue/queue_manager.cpp
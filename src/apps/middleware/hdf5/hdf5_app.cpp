@@ -48,7 +48,9 @@ namespace hdf5
 class WriterApp : public goby::middleware::Application<goby::middleware::protobuf::HDF5Config>
 {
   public:
-    WriterApp() : writer_(app_cfg().output_file())
+    WriterApp()
+        : writer_(app_cfg().output_file(), true, false, 0, false, 0,
+                  app_cfg().extraction_threads())
     {
         load();
         collect();
@@ -37,6 +37,7 @@
 #include "goby/middleware/application/configuration_reader.h" // for Config...
 #include "goby/middleware/application/interface.h"            // for run
 #include "goby/middleware/group.h"                            // for operat...
+#include "goby/middleware/log/compressed_log.h"              // for LogIFS...
 #include "goby/middleware/log/dccl_log_plugin.h"              // for DCCLPl...
 #include "goby/middleware/log/json_log_plugin.h"
 #include "goby/middleware/log/log_entry.h"               // for LogEntry
@@ -123,7 +124,7 @@ class LogTool : public goby::middleware::Application<protobuf::LogToolConfig>
     // scheme to plugin
     std::map<int, std::unique_ptr<goby::middleware::log::LogPlugin>> plugins_;
 
-    std::ifstream f_in_;
+    goby::middleware::log::LogIFStream f_in_;
     std::string output_file_path_;
 
     std::ofstream f_out_;
@@ -148,7 +149,7 @@ int main(int argc, char* argv[])
 }
 
 goby::apps::middleware::LogTool::LogTool()
-    : f_in_(app_cfg().input_file().c_str()),
+    : f_in_(app_cfg().input_file()),
       output_file_path_(create_output_filename()),
       type_regex_(app_cfg().type_regex()),
       group_regex_(app_cfg().group_regex()),
@@ -173,7 +174,8 @@ goby::apps::middleware::LogTool::LogTool()
             h5_writer_ = std::make_unique<goby::middleware::hdf5::Writer>(
                 output_file_path_, app_cfg().write_hdf5_zero_length_dim(),
                 app_cfg().has_hdf5_chunk_length(), app_cfg().hdf5_chunk_length(),
-                app_cfg().has_hdf5_compression_level(), app_cfg().hdf5_compression_level());
+                app_cfg().has_hdf5_compression_level(), app_cfg().hdf5_compression_level(),
+                app_cfg().hdf5_extraction_threads());
             break;
 #endif
         default:
@@ -244,15 +246,7 @@ goby::apps::middleware::LogTool::LogTool()
                     }
                     case protobuf::LogToolConfig::JSON:
                     {
-                        std::shared_ptr<nlohmann::json> j = plugin->second->json_message(log_entry);
-                        (*j)["_scheme_"] = log_entry.scheme();
-                        (*j)["_utime_"] =
-                            goby::time::convert<goby::time::MicroTime>(log_entry.timestamp())
-                                .value();
-                        (*j)["_strtime_"] = goby::time::str(log_entry.timestamp());
-                        (*j)["_group_"] = log_entry.group();
-                        (*j)["_type_"] = log_entry.type();
-                        f_out_ << j->dump() << std::endl;
+                        plugin->second->write_json(log_entry, f_out_);
                         break;
                     }
                 }
@@ -280,15 +274,10 @@ goby::apps::middleware::LogTool::LogTool()
                         break;
 
                     case protobuf::LogToolConfig::JSON:
-                        auto j = std::make_shared<nlohmann::json>();
-                        (*j)["_scheme_"] = log_entry.scheme();
-                        (*j)["_utime_"] =
-                            goby::time::convert<goby::time::MicroTime>(log_entry.timestamp())
-                                .value();
-                        (*j)["_strtime_"] = goby::time::str(log_entry.timestamp());
-                        (*j)["_group_"] = log_entry.group();
-                        (*j)["_type_"] = log_entry.type();
-                        (*j)["_error_"] = "Could not parse message";
+                        nlohmann::json j;
+                        goby::middleware::log::LogPlugin::add_json_metadata(log_entry, j);
+                        j["_error_"] = "Could not parse message";
+                        f_out_ << j.dump() << '\n';
                         break;
                 }
             }
@@ -40,6 +40,7 @@
 #include "goby/acomms/amac.h"
 #include "goby/acomms/connect.h"
 #include "goby/acomms/ip_codecs.h"
+#include "goby/acomms/ip_header_compression.h"
 #include "goby/acomms/protobuf/modem_message.pb.h"
 #include "goby/middleware/acomms/groups.h"
 #include "goby/util/binary.h"
@@ -85,8 +86,9 @@ class IPGateway : public goby::zeromq::SingleThreadApplication<protobuf::IPGatew
 
     void loop();
     void receive_packets();
+    bool handle_tun_packet(const char* buffer, int len);
 
-    void handle_udp_packet(const goby::acomms::protobuf::IPv4Header& ip_hdr,
+    bool handle_udp_packet(const goby::acomms::protobuf::IPv4Header& ip_hdr,
                            const goby::acomms::protobuf::UDPHeader& udp_hdr,
                            const std::string& payload);
     void write_udp_packet(goby::acomms::protobuf::IPv4Header& ip_hdr,
@@ -113,7 +115,7 @@ class IPGateway : public goby::zeromq::SingleThreadApplication<protobuf::IPGatew
     int ac_freq(int srcdest);
 
   private:
-    dccl::Codec dccl_goby_nh_, dccl_ip_, dccl_udp_, dccl_icmp_;
+    dccl::Codec dccl_goby_nh_, dccl_ip_, dccl_udp_, dccl_icmp_, dccl_goby_nh_compressed_;
     int tun_fd_;
     int total_addresses_;
     std::uint32_t local_address_; // in host byte order
@@ -127,6 +129,11 @@ class IPGateway : public goby::zeromq::SingleThreadApplication<protobuf::IPGatew
     int dynamic_port_index_;
     std::vector<int> dynamic_udp_fd_;
 
+    goby::acomms::IPHeaderCompressor header_compressor_;
+    goby::acomms::IPHeaderDecompressor header_decompressor_;
+
+    std::vector<char> tun_buffer_;
+
     int ip_mtu_; // the MTU on the tun interface, which is slightly different than the Goby MTU specified in the config file since the IP and Goby NetworkHeader are different sizes.
 
     // maps destination goby address to message buffer
@@ -150,11 +157,14 @@ goby::apps::zeromq::acomms::IPGateway::IPGateway()
       dccl_ip_("ip_gateway_id_codec_1", goby::acomms::IPGatewayEmptyIdentifierCodec<0xF001>()),
       dccl_udp_("ip_gateway_id_codec_2", goby::acomms::IPGatewayEmptyIdentifierCodec<0xF002>()),
       dccl_icmp_("ip_gateway_id_codec_3", goby::acomms::IPGatewayEmptyIdentifierCodec<0xF003>()),
+      dccl_goby_nh_compressed_("ip_gateway_id_codec_4",
+                               goby::acomms::IPGatewayEmptyIdentifierCodec<0xF004>()),
 #else
       dccl_goby_nh_("ip_gateway_id_codec_0"),
       dccl_ip_("ip_gateway_id_codec_1"),
       dccl_udp_("ip_gateway_id_codec_2"),
       dccl_icmp_("ip_gateway_id_codec_3"),
+      dccl_goby_nh_compressed_("ip_gateway_id_codec_4"),
 #endif
       tun_fd_(-1),
       total_addresses_((1 << (IPV4_ADDRESS_BITS - cfg().cidr_netmask_prefix())) -
@@ -162,7 +172,8 @@ goby::apps::zeromq::acomms::IPGateway::IPGateway()
       local_address_(0),
       local_modem_id_(0),
       netmask_(0),
-      dynamic_port_index_(cfg().static_udp_port_size())
+      dynamic_port_index_(cfg().static_udp_port_size()),
+      header_compressor_(cfg().header_compression_refresh_interval())
 {
     for (int d = 0; d < total_addresses_; ++d)
     {
@@ -234,6 +245,7 @@ void goby::apps::zeromq::acomms::IPGateway::init_dccl()
     dccl::dlog.connect(dccl::logger::INFO, &std::cout);
 
     dccl_arithmetic_load(&dccl_goby_nh_);
+    dccl_arithmetic_load(&dccl_goby_nh_compressed_);
 
     dccl::arith::protobuf::ArithmeticModel addr_model;
     addr_model.set_name("goby.acomms.NetworkHeader.AddrModel");
@@ -265,6 +277,7 @@ void goby::apps::zeromq::acomms::IPGateway::init_dccl()
     glog.is(DEBUG1) && glog << addr_model.DebugString() << std::endl;
 
     dccl::arith::ModelManager::set_model(dccl_goby_nh_, addr_model);
+    dccl::arith::ModelManager::set_model(dccl_goby_nh_compressed_, addr_model);
 
     if (cfg().total_ports() < cfg().static_udp_port_size())
         glog.is(DIE) &&
@@ -297,8 +310,10 @@ void goby::apps::zeromq::acomms::IPGateway::init_dccl()
     port_model.set_eof_frequency(0);
     port_model.set_out_of_range_frequency(0);
     dccl::arith::ModelManager::set_model(dccl_goby_nh_, port_model);
+    dccl::arith::ModelManager::set_model(dccl_goby_nh_compressed_, port_model);
 
     dccl_goby_nh_.load<goby::acomms::protobuf::NetworkHeader>();
+    dccl_goby_nh_compressed_.load<goby::acomms::protobuf::CompressedNetworkHeader>();
     dccl_ip_.load<goby::acomms::protobuf::IPv4Header>();
     dccl_udp_.load<goby::acomms::protobuf::UDPHeader>();
     dccl_icmp_.load<goby::acomms::protobuf::ICMPHeader>();
@@ -321,8 +336,16 @@ void goby::apps::zeromq::acomms::IPGateway::init_tun()
     if (tun_fd_ < 0)
         glog.is(DIE) && glog << "Could not allocate tun interface. Check permissions?" << std::endl;
 
-    ip_mtu_ = cfg().mtu() - dccl_goby_nh_.max_size<goby::acomms::protobuf::NetworkHeader>() +
-              MIN_IPV4_HEADER_LENGTH * 4;
+    // receive_packets() reads until no packets are left
+    if (fcntl(tun_fd_, F_SETFL, fcntl(tun_fd_, F_GETFL) | O_NONBLOCK) < 0)
+        glog.is(DIE) && glog << "Could not set tun interface to non-blocking" << std::endl;
+
+    int max_header_size =
+        cfg().header_compression()
+            ? dccl_goby_nh_compressed_.max_size<goby::acomms::protobuf::CompressedNetworkHeader>()
+            : dccl_goby_nh_.max_size<goby::acomms::protobuf::NetworkHeader>();
+    ip_mtu_ = cfg().mtu() - max_header_size + MIN_IPV4_HEADER_LENGTH * 4;
+    tun_buffer_.resize(ip_mtu_ + 1);
 
     int ret = tun_config(tun_name, cfg().local_ipv4_address().c_str(), cfg().cidr_netmask_prefix(),
                          ip_mtu_);
@@ -338,7 +361,11 @@ void goby::apps::zeromq::acomms::IPGateway::init_tun()
     local_modem_id_ = ipv4_to_goby_address(cfg().local_ipv4_address());
 }
 
-goby::apps::zeromq::acomms::IPGateway::~IPGateway() { dccl_arithmetic_unload(&dccl_goby_nh_); }
+goby::apps::zeromq::acomms::IPGateway::~IPGateway()
+{
+    dccl_arithmetic_unload(&dccl_goby_nh_);
+    dccl_arithmetic_unload(&dccl_goby_nh_compressed_);
+}
 
 void goby::apps::zeromq::acomms::IPGateway::loop()
 {
@@ -346,7 +373,7 @@ void goby::apps::zeromq::acomms::IPGateway::loop()
     receive_packets();
 }
 
-void goby::apps::zeromq::acomms::IPGateway::handle_udp_packet(
+bool goby::apps::zeromq::acomms::IPGateway::handle_udp_packet(
     const goby::acomms::protobuf::IPv4Header& ip_hdr,
     const goby::acomms::protobuf::UDPHeader& udp_hdr, const std::string& payload)
 {
@@ -375,7 +402,7 @@ void goby::apps::zeromq::acomms::IPGateway::handle_udp_packet(
     {
         glog.is(WARN) && glog << "No mapping for destination UDP port: " << udp_hdr.dest_port()
                               << ". Unable to send packet." << std::endl;
-        return;
+        return false;
     }
 
     boost::bimap<int, int>::right_map::const_iterator src_it =
@@ -393,7 +420,7 @@ void goby::apps::zeromq::acomms::IPGateway::handle_udp_packet(
                                   << " and we have no dynamic ports allocated (static_udp_port "
                                      "size == total_ports)"
                                   << std::endl;
-            return;
+            return false;
         }
         else
         {
@@ -412,9 +439,6 @@ void goby::apps::zeromq::acomms::IPGateway::handle_udp_packet(
 
     glog.is(VERBOSE) && glog << "NetHeader: " << net_header.DebugString() << std::endl;
 
-    std::string nh;
-    dccl_goby_nh_.encode(&nh, net_header);
-
     std::map<int, boost::circular_buffer<std::string>>::iterator it = outgoing_.find(dest);
     if (it == outgoing_.end())
     {
@@ -424,8 +448,21 @@ void goby::apps::zeromq::acomms::IPGateway::handle_udp_packet(
         it = itboolpair.first;
     }
 
+    std::string nh;
+    if (cfg().header_compression())
+    {
+        // push_back() will overwrite the oldest packet, which may carry the only full header of its flow
+        if (it->second.full())
+            header_compressor_.reset(dest);
+        dccl_goby_nh_compressed_.encode(&nh, header_compressor_.compress(dest, net_header));
+    }
+    else
+    {
+        dccl_goby_nh_.encode(&nh, net_header);
+    }
+
     it->second.push_back(nh + payload);
-    icmp_report_queue();
+    return true;
 }
 
 void goby::apps::zeromq::acomms::IPGateway::handle_initiate_transmission(
@@ -436,80 +473,73 @@ void goby::apps::zeromq::acomms::IPGateway::handle_initiate_transmission(
 
 void goby::apps::zeromq::acomms::IPGateway::receive_packets()
 {
+    // read all the packets queued on the (non-blocking) tun fd since the last loop(), without a select() for each
+    bool queued = false;
     while (true)
     {
-        fd_set rd_set;
-        FD_ZERO(&rd_set);
-        FD_SET(tun_fd_, &rd_set);
+        int len = read(tun_fd_, tun_buffer_.data(), ip_mtu_);
 
-        timeval tout = {0};
-        int ret = select(tun_fd_ + 1, &rd_set, 0, 0, &tout);
-
-        if (ret < 0 && errno != EINTR)
+        if (len < 0)
         {
-            glog.is(WARN) && glog << "Could not select on tun fd." << std::endl;
-            return;
+            if (errno == EINTR)
+                continue;
+            else if (errno != EAGAIN && errno != EWOULDBLOCK)
+                glog.is(WARN) && glog << "tun read error." << std::endl;
+            break;
         }
-        else if (ret > 0)
+        else if (len == 0)
         {
-            char buffer[ip_mtu_ + 1];
-            int len = read(tun_fd_, buffer, ip_mtu_);
+            glog.is(DIE) && glog << "tun reached EOF." << std::endl;
+        }
+        else if (handle_tun_packet(tun_buffer_.data(), len))
+        {
+            queued = true;
+        }
+    }
 
-            if (len < 0)
-            {
-                glog.is(WARN) && glog << "tun read error." << std::endl;
-            }
-            else if (len == 0)
-            {
-                glog.is(DIE) && glog << "tun reached EOF." << std::endl;
-            }
-            else
-            {
-                goby::acomms::protobuf::IPv4Header ip_hdr;
-                unsigned short ip_header_size = (buffer[0] & 0xF) * 4;
-                unsigned short version = ((buffer[0] >> 4) & 0xF);
-                if (version == 4)
-                {
-                    std::string header_data(buffer, ip_header_size);
-                    dccl_ip_.decode(header_data, &ip_hdr);
-                    glog.is(DEBUG2) && glog << "Received " << len << " bytes. " << std::endl;
-                    switch (ip_hdr.protocol())
-                    {
-                        default:
-                            glog.is(DEBUG1) && glog << "IPv4 Protocol " << ip_hdr.protocol()
-                                                    << " is not supported." << std::endl;
-                            break;
-                        case IPPROTO_UDP:
-                        {
-                            goby::acomms::protobuf::UDPHeader udp_hdr;
-                            std::string udp_header_data(&buffer[ip_header_size], UDP_HEADER_SIZE);
-                            dccl_udp_.decode(udp_header_data, &udp_hdr);
-                            handle_udp_packet(ip_hdr, udp_hdr,
-                                              std::string(&buffer[ip_header_size + UDP_HEADER_SIZE],
-                                                          ip_hdr.total_length() - ip_header_size -
-                                                              UDP_HEADER_SIZE));
-                            break;
-                        }
-                        case IPPROTO_ICMP:
-                        {
-                            goby::acomms::protobuf::ICMPHeader icmp_hdr;
-                            std::string icmp_header_data(&buffer[ip_header_size], ICMP_HEADER_SIZE);
-                            dccl_icmp_.decode(icmp_header_data, &icmp_hdr);
-                            glog.is(DEBUG1) && glog << "Received ICMP Packet with header: "
-                                                    << icmp_hdr.ShortDebugString() << std::endl;
-                            glog.is(DEBUG1) && glog << "ICMP sending is not supported."
-                                                    << std::endl;
-
-                            break;
-                        }
-                    }
-                }
-            }
+    // report the queue (and bypass the MAC if configured) once for all the packets read
+    if (queued)
+        icmp_report_queue();
+}
+
+bool goby::apps::zeromq::acomms::IPGateway::handle_tun_packet(const char* buffer, int len)
+{
+    goby::acomms::protobuf::IPv4Header ip_hdr;
+    unsigned short ip_header_size = (buffer[0] & 0xF) * 4;
+    unsigned short version = ((buffer[0] >> 4) & 0xF);
+    if (version != 4)
+        return false;
+
+    std::string header_data(buffer, ip_header_size);
+    dccl_ip_.decode(header_data, &ip_hdr);
+    glog.is(DEBUG2) && glog << "Received " << len << " bytes. " << std::endl;
+    switch (ip_hdr.protocol())
+    {
+        default:
+            glog.is(DEBUG1) && glog << "IPv4 Protocol " << ip_hdr.protocol() << " is not supported."
+                                    << std::endl;
+            return false;
+
+        case IPPROTO_UDP:
+        {
+            goby::acomms::protobuf::UDPHeader udp_hdr;
+            std::string udp_header_data(&buffer[ip_header_size], UDP_HEADER_SIZE);
+            dccl_udp_.decode(udp_header_data, &udp_hdr);
+            return handle_udp_packet(
+                ip_hdr, udp_hdr,
+                std::string(&buffer[ip_header_size + UDP_HEADER_SIZE],
+                            ip_hdr.total_length() - ip_header_size - UDP_HEADER_SIZE));
         }
-        else
+
+        case IPPROTO_ICMP:
         {
-            // no select items
-            return;
+            goby::acomms::protobuf::ICMPHeader icmp_hdr;
+            std::string icmp_header_data(&buffer[ip_header_size], ICMP_HEADER_SIZE);
+            dccl_icmp_.decode(icmp_header_data, &icmp_hdr);
+            glog.is(DEBUG1) && glog << "Received ICMP Packet with header: "
+                                    << icmp_hdr.ShortDebugString() << std::endl;
+            glog.is(DEBUG1) && glog << "ICMP sending is not supported." << std::endl;
+            return false;
         }
     }
 }
@@ -592,7 +622,24 @@ void goby::apps::zeromq::acomms::IPGateway::handle_modem_receive(
 
         try
         {
-            dccl_goby_nh_.decode(&frame, &net_header); // strips used bytes off frame
+            // strips used bytes off frame
+            if (cfg().header_compression())
+            {
+                goby::acomms::protobuf::CompressedNetworkHeader compressed;
+                dccl_goby_nh_compressed_.decode(&frame, &compressed);
+                if (!header_decompressor_.decompress(modem_msg.src(), modem_msg.dest(),
+                                                     compressed, &net_header))
+                {
+                    glog.is(DEBUG1) && glog << "No valid context for compressed header: "
+                                            << compressed.ShortDebugString()
+                                            << ", dropping packet." << std::endl;
+                    continue;
+                }
+            }
+            else
+            {
+                dccl_goby_nh_.decode(&frame, &net_header);
+            }
         }
         catch (goby::Exception& e)
         {
@@ -927,6 +974,8 @@ int main(int argc, char* argv[])
         "ip_gateway_id_codec_2");
     dccl::FieldCodecManager::add<goby::acomms::IPGatewayEmptyIdentifierCodec<0xF003>>(
         "ip_gateway_id_codec_3");
+    dccl::FieldCodecManager::add<goby::acomms::IPGatewayEmptyIdentifierCodec<0xF004>>(
+        "ip_gateway_id_codec_4");
     dccl::FieldCodecManager::add<goby::acomms::NetShortCodec>("net.short");
     dccl::FieldCodecManager::add<goby::acomms::IPv4AddressCodec>("ip.v4.address");
     dccl::FieldCodecManager::add<goby::acomms::IPv4FlagsFragOffsetCodec>("ip.v4.flagsfragoffset");
@@ -45,9 +45,11 @@
 #include "goby/middleware/application/configuration_reader.h" // for Config...
 #include "goby/middleware/application/interface.h"            // for run
 #include "goby/middleware/group.h"                            // for operat...
+#include "goby/middleware/log/compressed_log.h"              // for LogOFS...
 #include "goby/middleware/log/dccl_log_plugin.h"              // for DCCLPl...
 #include "goby/middleware/log/groups.h"
 #include "goby/middleware/log/log_entry.h"           // for LogEntry
+#include "goby/middleware/log/log_tail.h"            // for LogTailWriter
 #include "goby/middleware/log/protobuf_log_plugin.h" // for Protob...
 #include "goby/middleware/marshalling/interface.h"   // for Marsha...
 #include "goby/middleware/protobuf/logger.pb.h"
@@ -80,6 +82,15 @@ class Logger : public goby::zeromq::SingleThreadApplication<protobuf::LoggerConf
 
         logging_ = cfg().log_at_startup();
 
+        if (cfg().log_tail().enable())
+        {
+            std::string tail_name = cfg().log_tail().has_name()
+                                        ? cfg().log_tail().name()
+                                        : "goby_logger_" + cfg().interprocess().platform();
+            log_tail_.reset(
+                new goby::middleware::log::LogTailWriter(tail_name, cfg().log_tail().size()));
+        }
+
         namespace sp = std::placeholders;
         interprocess().subscribe_regex(
             std::bind(&Logger::log, this, sp::_1, sp::_2, sp::_3, sp::_4),
@@ -156,7 +167,18 @@ class Logger : public goby::zeromq::SingleThreadApplication<protobuf::LoggerConf
         std::string timestamp =
             cfg().omit().file_timestamp() ? "" : std::string("_") + goby::time::file_str();
         log_file_path_ = log_file_base_ + timestamp + ".goby";
-        log_.reset(new std::ofstream(log_file_path_.c_str(), std::ofstream::binary));
+        const auto& compression_cfg = cfg().compression();
+        try
+        {
+            log_.reset(new goby::middleware::log::LogOFStream(
+                log_file_path_,
+                static_cast<goby::middleware::log::CompressionType>(compression_cfg.type()),
+                compression_cfg.level(), compression_cfg.block_size()));
+        }
+        catch (goby::middleware::log::LogException& e)
+        {
+            glog.is_die() && glog << "Failed to open log: " << e.what() << std::endl;
+        }
 
         if (!log_->is_open())
             glog.is_die() && glog << "Failed to open log in directory: " << cfg().log_dir()
@@ -183,6 +205,12 @@ class Logger : public goby::zeromq::SingleThreadApplication<protobuf::LoggerConf
     {
         glog.is_verbose() && glog << "Closing log at: " << log_file_path_ << std::endl;
         log_->close();
+        if (log_->compression() != goby::middleware::log::CompressionType::NONE &&
+            log_->compressed_bytes() > 0)
+            glog.is_verbose() && glog << "Compression ratio: "
+                                      << static_cast<double>(log_->uncompressed_bytes()) /
+                                             log_->compressed_bytes()
+                                      << std::endl;
         log_.reset();
         goby::middleware::log::LogEntry::reset();
 
@@ -205,7 +233,8 @@ class Logger : public goby::zeromq::SingleThreadApplication<protobuf::LoggerConf
   private:
     std::string log_file_base_;
     std::string log_file_path_;
-    std::unique_ptr<std::ofstream> log_;
+    std::unique_ptr<goby::middleware::log::LogOFStream> log_;
+    std::unique_ptr<goby::middleware::log::LogTailWriter> log_tail_;
 
     std::vector<void*> dl_handles_;
 
@@ -256,7 +285,7 @@ void signal_handler(int /*sig*/) { goby::apps::zeromq::Logger::do_quit = true; }
 void goby::apps::zeromq::Logger::log(const std::vector<unsigned char>& data, int scheme,
                                      const std::string& type, const goby::middleware::Group& group)
 {
-    if (!logging_ || !log_is_open())
+    if (!log_tail_ && (!logging_ || !log_is_open()))
         return;
 
     glog.is_debug1() && glog << "Received " << data.size()
@@ -264,5 +293,19 @@ void goby::apps::zeromq::Logger::log(const std::vector<unsigned char>& data, int
                              << type << ", " << group << "]" << std::endl;
 
     goby::middleware::log::LogEntry entry(data, scheme, type, group);
-    entry.serialize(&*log_);
+
+    if (log_tail_)
+    {
+        try
+        {
+            log_tail_->write(entry);
+        }
+        catch (goby::middleware::log::LogException& e)
+        {
+            glog.is_warn() && glog << "Failed to write to log tail: " << e.what() << std::endl;
+        }
+    }
+
+    if (logging_ && log_is_open())
+        entry.serialize(&*log_);
 }
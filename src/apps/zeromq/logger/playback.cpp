@@ -1,4 +1,4 @@
-// Copyright 2021-2023:
+// Copyright 2021-2026:
 //   GobySoft, LLC (2013-)
 //   Community contributors (see AUTHORS file)
 // File authors:
@@ -23,8 +23,12 @@
 
 #include "goby/middleware/marshalling/protobuf.h"
 
-#include "goby/middleware/log/dccl_log_plugin.h" // for DCCLPl...
-#include "goby/middleware/log/log_entry.h"       // for LogEntry
+#include "goby/middleware/log/dccl_log_plugin.h"    // for DCCLPl...
+#include "goby/middleware/log/groups.h"             // for playback_request
+#include "goby/middleware/log/indexed_log_reader.h" // for IndexedLogReader
+#include "goby/middleware/log/log_entry.h"          // for LogEntry
+#include "goby/middleware/log/playback_scheduler.h" // for PlaybackScheduler
+#include "goby/middleware/protobuf/logger.pb.h"     // for PlaybackRequest
 #include "goby/zeromq/application/single_thread.h"
 #include "goby/zeromq/protobuf/interprocess_config.pb.h"
 #include "goby/zeromq/protobuf/logger_config.pb.h"
@@ -44,10 +48,7 @@ class Playback : public goby::zeromq::SingleThreadApplication<protobuf::Playback
     Playback()
         : goby::zeromq::SingleThreadApplication<protobuf::PlaybackConfig>(100 *
                                                                           boost::units::si::hertz),
-          f_in_(cfg().input_file().c_str()),
-          playback_start_(goby::time::SystemClock::now() +
-                          goby::time::convert_duration<goby::time::SystemClock::duration>(
-                              cfg().playback_start_delay_with_units())),
+          reader_(cfg().input_file(), cfg().prefetch_depth()),
           group_regex_(cfg().group_regex()),
           internal_group_regex_("goby::zeromq::_internal_.*")
     {
@@ -67,15 +68,32 @@ class Playback : public goby::zeromq::SingleThreadApplication<protobuf::Playback
         plugins_[goby::middleware::MarshallingScheme::DCCL] =
             std::make_unique<goby::middleware::log::DCCLPlugin>();
 
-        for (auto& p : plugins_) p.second->register_read_hooks(f_in_);
+        for (auto& p : plugins_) p.second->register_read_hooks(reader_.stream());
 
-        read_next_entry();
-        log_start_ = next_log_entry_.timestamp() +
-                     goby::time::convert_duration<goby::time::SystemClock::duration>(
-                         cfg().start_from_offset_with_units());
+        reader_.build_index();
+        if (reader_.empty())
+            glog.is_die() && glog << "No entries found in " << cfg().input_file() << std::endl;
 
-        // skip to desired start
-        while (next_log_entry_.timestamp() < log_start_) read_next_entry();
+        auto log_start = reader_.begin_time() +
+                         goby::time::convert_duration<goby::time::SystemClock::duration>(
+                             cfg().start_from_offset_with_units());
+
+        auto log_end = goby::time::SystemClock::time_point::max();
+        if (cfg().has_playback_duration())
+            log_end = log_start + goby::time::convert_duration<goby::time::SystemClock::duration>(
+                                      cfg().playback_duration_with_units());
+
+        auto playback_start = goby::time::SystemClock::now() +
+                              goby::time::convert_duration<goby::time::SystemClock::duration>(
+                                  cfg().playback_start_delay_with_units());
+
+        // skips to the desired start
+        scheduler_ = std::make_unique<goby::middleware::log::PlaybackScheduler>(
+            reader_, log_start, playback_start, cfg().rate(), log_end);
+
+        interprocess().subscribe<goby::middleware::groups::playback_request>(
+            [this](const goby::middleware::protobuf::PlaybackRequest& request)
+            { handle_request(request); });
     }
 
     ~Playback() override
@@ -86,69 +104,68 @@ class Playback : public goby::zeromq::SingleThreadApplication<protobuf::Playback
   private:
     void loop() override
     {
-        while (is_time_to_publish())
+        auto now = goby::time::SystemClock::now();
+        scheduler_->play_due(
+            [this](const goby::middleware::log::LogEntry& entry)
+            {
+                // playback the entry
+                if (is_filtered(entry))
+                    return;
+
+                glog.is_verbose() &&
+                    glog << "Playing back: " << entry.scheme() << " | " << entry.group() << " | "
+                         << entry.type() << " | "
+                         << goby::time::convert<boost::posix_time::ptime>(entry.timestamp())
+                         << std::endl;
+
+                std::vector<char> data(entry.data().begin(), entry.data().end());
+
+                interprocess().publish_serialized(entry.type(), entry.scheme(), data,
+                                                  entry.group());
+            },
+            now);
+
+        if (scheduler_->end_of_window(now))
         {
-            // playback the entry
-            if (!is_filtered())
+            if (cfg().loop())
             {
-                glog.is_verbose() && glog << "Playing back: " << next_log_entry_.scheme() << " | "
-                                          << next_log_entry_.group() << " | "
-                                          << next_log_entry_.type() << " | "
-                                          << goby::time::convert<boost::posix_time::ptime>(
-                                                 next_log_entry_.timestamp())
-                                          << std::endl;
-
-                std::vector<char> data(next_log_entry_.data().begin(),
-                                       next_log_entry_.data().end());
-
-                interprocess().publish_serialized(next_log_entry_.type(), next_log_entry_.scheme(),
-                                                  data, next_log_entry_.group());
+                glog.is_verbose() && glog << "Reached end of playback, looping" << std::endl;
+                scheduler_->restart();
+            }
+            else
+            {
+                glog.is_verbose() && glog << "Reached end of playback" << std::endl;
+                quit();
             }
-
-            // read the next entry
-            read_next_entry();
         }
-
-        if (do_quit_)
-            quit();
     }
 
-    void read_next_entry()
+    void handle_request(const goby::middleware::protobuf::PlaybackRequest& request)
     {
-        try
-        {
-            next_log_entry_.parse(&f_in_);
-        }
-        catch (goby::middleware::log::LogException& e)
-        {
-            glog.is_warn() && glog << "Exception processing input log (will attempt to continue): "
-                                   << e.what() << std::endl;
-        }
-        catch (std::exception& e)
+        glog.is_verbose() && glog << "Received playback request: " << request.ShortDebugString()
+                                  << std::endl;
+
+        if (request.has_rate())
         {
-            if (!f_in_.eof())
-                glog.is_warn() && glog << "Error processing input log: " << e.what() << std::endl;
+            if (request.rate() > 0)
+                scheduler_->clock().set_rate(request.rate());
             else
-                glog.is_verbose() && glog << "Reached EOF" << std::endl;
-            do_quit_ = true;
+                glog.is_warn() && glog << "Ignoring invalid rate: " << request.rate()
+                                       << std::endl;
         }
-    }
 
-    bool is_time_to_publish()
-    {
-        if (do_quit_)
-            return false;
+        if (request.has_pause())
+            scheduler_->clock().set_paused(request.pause());
 
-        auto now = goby::time::SystemClock::now();
-        auto dt_log = next_log_entry_.timestamp() - log_start_;
-        auto dt_wall = now - playback_start_;
-        // as much wall time has elapsed (modified by rate) as log time
-        return (dt_wall * cfg().rate()) >= dt_log;
+        if (request.has_seek_to_offset())
+            scheduler_->seek(reader_.begin_time() +
+                             std::chrono::duration_cast<goby::time::SystemClock::duration>(
+                                 std::chrono::duration<double>(request.seek_to_offset())));
     }
 
-    bool is_filtered()
+    bool is_filtered(const goby::middleware::log::LogEntry& entry)
     {
-        std::string group = next_log_entry_.group();
+        std::string group = entry.group();
         bool internal_group_is_filtered = std::regex_match(group, internal_group_regex_);
 
         // check regex and type_filters
@@ -159,10 +176,10 @@ class Playback : public goby::zeromq::SingleThreadApplication<protobuf::Playback
         bool type_is_filtered = true;
         if (!type_regex_.empty())
         {
-            auto it_p = type_regex_.equal_range(next_log_entry_.scheme());
+            auto it_p = type_regex_.equal_range(entry.scheme());
             for (auto it = it_p.first; it != it_p.second; ++it)
             {
-                if (std::regex_match(next_log_entry_.type(), it->second))
+                if (std::regex_match(entry.type(), it->second))
                     type_is_filtered = false;
             }
         }
@@ -182,18 +199,12 @@ class Playback : public goby::zeromq::SingleThreadApplication<protobuf::Playback
     // scheme to plugin
     std::map<int, std::unique_ptr<goby::middleware::log::LogPlugin>> plugins_;
 
-    std::ifstream f_in_;
-
-    goby::middleware::log::LogEntry next_log_entry_;
-
-    goby::time::SystemClock::time_point log_start_;
-    goby::time::SystemClock::time_point playback_start_;
+    goby::middleware::log::IndexedLogReader reader_;
+    std::unique_ptr<goby::middleware::log::PlaybackScheduler> scheduler_;
 
     std::regex group_regex_;
     std::regex internal_group_regex_;
     std::multimap<int, std::regex> type_regex_;
-
-    bool do_quit_{false};
 };
 } // namespace zeromq
 } // namespace apps
@@ -204,6 +204,9 @@ template <typename Config> void goby::middleware::Application<Config>::configure
 
     if (app3_base_configuration_->glog_config().show_dccl_log())
         goby::middleware::detail::DCCLSerializerParserHelperBase::setup_dlog();
+
+    if (app3_base_configuration_->glog_config().has_async())
+        glog.enable_async(app3_base_configuration_->glog_config().async());
 }
 
 template <typename Config> void goby::middleware::Application<Config>::check_rotate_glog_file()
@@ -367,6 +370,9 @@ int goby::run(const goby::middleware::ConfiguratorInterface<typename App::Config
 
     goby::glog.is_debug2() && goby::glog << "goby::run: exiting cleanly with code: " << return_value
                                          << std::endl;
+
+    // write any queued lines while the streams (e.g. the glog file) still exist
+    goby::glog.disable_async();
     return return_value;
 }
 
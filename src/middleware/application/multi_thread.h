@@ -25,6 +25,8 @@
 #ifndef GOBY_MIDDLEWARE_APPLICATION_MULTI_THREAD_H
 #define GOBY_MIDDLEWARE_APPLICATION_MULTI_THREAD_H
 
+#include <set>
+
 #include <boost/core/demangle.hpp>
 #include <boost/units/systems/si.hpp>
 
@@ -40,6 +42,7 @@
 #include "goby/middleware/application/interface.h"
 #include "goby/middleware/application/simple_thread.h"
 #include "goby/middleware/application/thread.h"
+#include "goby/middleware/application/timer_service.h"
 
 #include "goby/middleware/transport/interprocess.h"
 #include "goby/middleware/transport/interthread.h"
@@ -51,7 +54,7 @@ namespace middleware
 {
 /// \brief Thread that simply publishes an empty message on its loop interval to TimerThread::group
 ///
-/// This can be launched to provide a simple timer by subscribing to TimerThread::group.
+/// This can be launched to provide a simple timer by subscribing to TimerThread::group. MultiThreadApplicationBase::launch_timer() no longer uses this class (it publishes to the same group from the shared TimerService, rather than from a thread per timer), but it is retained for code that launches it directly.
 ///
 /// For example, to create timer that expires every two seconds:
 /// ```
@@ -125,6 +128,12 @@ class MultiThreadApplicationBase : public goby::middleware::Application<Config>,
     int running_thread_count_{0};
     InterThreadTransporter interthread_;
 
+    std::shared_ptr<TimerService> timer_service_;
+    // launch_timer index to TimerService id
+    std::map<int, TimerService::TimerId> timers_;
+    std::map<int, std::function<void()>> timer_callbacks_;
+    std::set<int> timer_subscriptions_;
+
   public:
     template <typename ThreadType> void launch_thread()
     {
@@ -163,16 +172,52 @@ class MultiThreadApplicationBase : public goby::middleware::Application<Config>,
         interthread_.publish<MainThreadBase::shutdown_group_>(ti);
     }
 
+    /// \brief Calls on_expire (from the main thread) at the given frequency until join_timer<i>() is called
+    ///
+    /// The timer is run by the application's TimerService, which publishes to TimerThread<i>::expire_group at each expiry.
     template <int i>
     void launch_timer(boost::units::quantity<boost::units::si::frequency> freq,
                       std::function<void()> on_expire)
     {
-        launch_thread<goby::middleware::TimerThread<i>>(freq);
-        this->interthread()
-            .template subscribe_empty<goby::middleware::TimerThread<i>::expire_group>(on_expire);
+        if (timers_.count(i))
+            throw(Exception("Timer " + std::to_string(i) + " is already launched and running."));
+
+        if (!timer_subscriptions_.count(i))
+        {
+            this->interthread()
+                .template subscribe_empty<goby::middleware::TimerThread<i>::expire_group>(
+                    [this]()
+                    {
+                        auto it = timer_callbacks_.find(i);
+                        if (it != timer_callbacks_.end())
+                            it->second();
+                    });
+            timer_subscriptions_.insert(i);
+        }
+        timer_callbacks_[i] = on_expire;
+        timers_[i] = timer_service()
+                         .template add_periodic_publication<
+                             goby::middleware::TimerThread<i>::expire_group>(freq);
     }
 
-    template <int i> void join_timer() { join_thread<goby::middleware::TimerThread<i>>(); }
+    template <int i> void join_timer()
+    {
+        auto it = timers_.find(i);
+        if (it != timers_.end())
+        {
+            timer_service_->cancel(it->second);
+            timers_.erase(it);
+            timer_callbacks_.erase(i);
+        }
+    }
+
+    /// \brief The TimerService shared by all the threads of this process (started on first use)
+    TimerService& timer_service()
+    {
+        if (!timer_service_)
+            timer_service_ = TimerService::acquire();
+        return *timer_service_;
+    }
 
     int running_thread_count() { return running_thread_count_; }
 
@@ -194,7 +239,13 @@ class MultiThreadApplicationBase : public goby::middleware::Application<Config>,
     virtual ~MultiThreadApplicationBase() {}
 
     InterThreadTransporter& interthread() { return interthread_; }
-    virtual void post_finalize() override { join_all_threads(); }
+    virtual void post_finalize() override
+    {
+        join_all_threads();
+        for (const auto& timer_p : timers_) timer_service_->cancel(timer_p.second);
+        timers_.clear();
+        timer_callbacks_.clear();
+    }
 
     std::map<std::type_index, std::map<int, ThreadManagement>>& threads() { return threads_; }
 
@@ -29,6 +29,7 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <typeindex>
 
 #include <boost/units/systems/si.hpp>
@@ -39,6 +40,7 @@
 
 #include "goby/middleware/common.h"
 #include "goby/middleware/group.h"
+#include "goby/middleware/transport/detail/subscription_store.h"
 #include "goby/time/simulation.h"
 
 namespace goby
@@ -216,6 +218,8 @@ template <typename Config, typename TransporterType> class Thread
 #endif
         if (uid_ >= 0)
             health.set_uid(uid_);
+        // called from this thread (in response to a HealthRequest)
+        detail::SubscriptionStoreBase::queue_health(std::this_thread::get_id(), health);
         this->health(health);
     }
 
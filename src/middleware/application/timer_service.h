@@ -0,0 +1,290 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_APPLICATION_TIMER_SERVICE_H
+#define GOBY_MIDDLEWARE_APPLICATION_TIMER_SERVICE_H
+
+#include <atomic>             // for atomic
+#include <chrono>             // for steady_clock, nanoseconds
+#include <condition_variable> // for condition_variable
+#include <cstdint>            // for uint64_t
+#include <functional>         // for function, greater
+#include <limits>             // for numeric_limits
+#include <map>                // for map
+#include <memory>             // for shared_ptr, weak_ptr
+#include <mutex>              // for mutex, unique_lock
+#include <queue>              // for priority_queue
+#include <string>             // for to_string
+#include <thread>             // for thread
+#include <utility>            // for pair, move
+#include <vector>             // for vector
+
+#include <boost/units/quantity.hpp>   // for quantity
+#include <boost/units/systems/si.hpp> // for frequency, time, hertz
+
+#include "goby/exception.h"                        // for Exception
+#include "goby/middleware/group.h"                 // for Group
+#include "goby/middleware/transport/interthread.h" // for InterThreadTransporter
+#include "goby/time/simulation.h"                  // for SimulatorSettings
+#include "goby/util/debug_logger.h"                // for glog
+
+namespace goby
+{
+namespace middleware
+{
+/// \brief Single thread that services all the periodic and one-shot timers of an application.
+///
+/// Timers are kept in a heap ordered by expiry, so the service thread sleeps until the earliest expiry and then runs all the timers that are due, regardless of how many timers are registered. Any thread may register or cancel timers. The expiry callbacks run on the service thread so they should be short: to run the work in another thread, register a group publication (add_periodic_publication() / add_one_shot_publication()) and subscribe to the group from that thread.
+///
+/// \code
+/// constexpr goby::middleware::Group status_timer{"status_timer"};
+/// auto timers = goby::middleware::TimerService::acquire();
+/// auto id = timers->add_periodic_publication<status_timer>(2 * boost::units::si::hertz);
+/// interthread().subscribe_empty<status_timer>([]() { std::cout << "Timer expired." << std::endl; });
+/// // ...
+/// timers->cancel(id);
+/// \endcode
+///
+/// Like Thread::loop(), intervals are scaled by time::SimulatorSettings::warp_factor (read when the timer is added) and periodic timers expire on multiples of their interval, so all the timers with the same frequency expire together.
+class TimerService
+{
+  public:
+    using clock = std::chrono::steady_clock;
+    /// \brief Identifies a timer for cancel(). Zero is never a valid id.
+    using TimerId = std::uint64_t;
+
+    /// \brief Returns the running service for this process, starting it if necessary. The service thread is joined when the last shared_ptr is released.
+    static std::shared_ptr<TimerService> acquire()
+    {
+        std::lock_guard<std::mutex> lock(instance_mutex());
+        auto service = instance().lock();
+        if (!service)
+        {
+            service.reset(new TimerService);
+            instance() = service;
+        }
+        return service;
+    }
+
+    ~TimerService()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shutdown_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    /// \brief Adds a timer that calls on_expire (from the service thread) at the given frequency until cancelled
+    TimerId add_periodic(boost::units::quantity<boost::units::si::frequency> freq,
+                         std::function<void()> on_expire)
+    {
+        auto interval = interval_from_frequency(freq);
+        // align to multiples of the interval (as Thread does for loop())
+        auto now = clock::now();
+        auto expire = clock::time_point((now.time_since_epoch() / interval + 1) * interval);
+        return add(expire, interval, std::move(on_expire));
+    }
+
+    /// \brief Adds a timer that calls on_expire (from the service thread) once after the given delay
+    TimerId add_one_shot(boost::units::quantity<boost::units::si::time> delay,
+                         std::function<void()> on_expire)
+    {
+        double warped_seconds =
+            (delay / boost::units::si::seconds) / time::SimulatorSettings::warp_factor;
+        if (!(warped_seconds >= 0))
+            throw(goby::Exception("TimerService: invalid delay for one-shot timer: " +
+                                  std::to_string(delay / boost::units::si::seconds) + " s"));
+        auto expire = clock::now() + std::chrono::duration_cast<clock::duration>(
+                                         std::chrono::duration<double>(warped_seconds));
+        return add(expire, clock::duration::zero(), std::move(on_expire));
+    }
+
+    /// \brief Adds a timer that publishes an empty message to group (on the InterThreadTransporter) at the given frequency until cancelled
+    template <const Group& group>
+    TimerId add_periodic_publication(boost::units::quantity<boost::units::si::frequency> freq)
+    {
+        return add_periodic(freq, [this]() { interthread_->template publish_empty<group>(); });
+    }
+
+    /// \brief Adds a timer that publishes an empty message to group (on the InterThreadTransporter) once after the given delay
+    template <const Group& group>
+    TimerId add_one_shot_publication(boost::units::quantity<boost::units::si::time> delay)
+    {
+        return add_one_shot(delay, [this]() { interthread_->template publish_empty<group>(); });
+    }
+
+    /// \brief Cancels a timer. Returns false if the timer doesn't exist (e.g. an expired one-shot timer). The timer's callback may still be running (in the service thread) when this returns, but will not be called again.
+    bool cancel(TimerId id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_.erase(id) > 0;
+    }
+
+    /// \brief Number of active timers
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_.size();
+    }
+
+    /// \brief Number of periodic expirations that were skipped because the service thread fell behind by more than one interval (e.g. due to a slow callback)
+    std::uint64_t overrun_count() const { return overruns_; }
+
+  private:
+    struct Timer
+    {
+        // zero for one-shot timers
+        clock::duration interval;
+        clock::time_point expire;
+        std::shared_ptr<const std::function<void()>> on_expire;
+    };
+
+    using QueueEntry = std::pair<clock::time_point, TimerId>;
+
+    TimerService() : thread_([this]() { run(); }) {}
+
+    static clock::duration
+    interval_from_frequency(boost::units::quantity<boost::units::si::frequency> freq)
+    {
+        double hertz = freq / boost::units::si::hertz;
+        if (!(hertz > 0) || hertz == std::numeric_limits<double>::infinity())
+            throw(goby::Exception("TimerService: invalid frequency for periodic timer: " +
+                                  std::to_string(hertz) + " Hz"));
+
+        auto interval = std::chrono::nanoseconds((unsigned long long)(
+            1000000000ull / (hertz * time::SimulatorSettings::warp_factor)));
+        return interval > clock::duration::zero() ? interval : clock::duration(1);
+    }
+
+    TimerId add(clock::time_point expire, clock::duration interval,
+                std::function<void()> on_expire)
+    {
+        TimerId id;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            id = ++last_id_;
+            timers_[id] =
+                Timer{interval, expire,
+                      std::make_shared<const std::function<void()>>(std::move(on_expire))};
+            queue_.emplace(expire, id);
+        }
+        cv_.notify_all();
+        return id;
+    }
+
+    void run()
+    {
+        // publications are made only from this thread
+        InterThreadTransporter interthread;
+        interthread_ = &interthread;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!shutdown_)
+        {
+            if (queue_.empty())
+            {
+                cv_.wait(lock);
+                continue;
+            }
+
+            QueueEntry next = queue_.top();
+            auto now = clock::now();
+            if (next.first > now)
+            {
+                cv_.wait_until(lock, next.first);
+                continue;
+            }
+            queue_.pop();
+
+            auto it = timers_.find(next.second);
+            // cancelled (ids are never reused, so any remaining entry is current)
+            if (it == timers_.end())
+                continue;
+
+            Timer& timer = it->second;
+            auto on_expire = timer.on_expire;
+            if (timer.interval > clock::duration::zero())
+            {
+                timer.expire += timer.interval;
+                if (timer.expire <= now)
+                {
+                    // skip the missed expirations rather than calling on_expire in a burst to catch up
+                    auto missed = (now - timer.expire) / timer.interval + 1;
+                    overruns_ += missed;
+                    timer.expire += missed * timer.interval;
+                }
+                queue_.emplace(timer.expire, next.second);
+            }
+            else
+            {
+                timers_.erase(it);
+            }
+
+            lock.unlock();
+            try
+            {
+                (*on_expire)();
+            }
+            catch (const std::exception& e)
+            {
+                goby::glog.is_warn() &&
+                    goby::glog << "TimerService: uncaught exception in timer callback: "
+                               << e.what() << std::endl;
+            }
+            lock.lock();
+        }
+
+        interthread_ = nullptr;
+    }
+
+    static std::mutex& instance_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::weak_ptr<TimerService>& instance()
+    {
+        static std::weak_ptr<TimerService> instance;
+        return instance;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool shutdown_{false};
+    TimerId last_id_{0};
+    std::map<TimerId, Timer> timers_;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue_;
+    std::atomic<std::uint64_t> overruns_{0};
+    InterThreadTransporter* interthread_{nullptr};
+    // last, so that the thread starts after the other members are initialized
+    std::thread thread_;
+};
+
+} // namespace middleware
+} // namespace goby
+
+#endif
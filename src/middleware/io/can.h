@@ -25,29 +25,30 @@
 #ifndef GOBY_MIDDLEWARE_IO_CAN_H
 #define GOBY_MIDDLEWARE_IO_CAN_H
 
+#include <algorithm>       // for max
+#include <chrono>          // for milliseconds
 #include <errno.h>         // for errno
 #include <linux/can.h>     // for can_frame, socka...
 #include <linux/can/raw.h> // for CAN_RAW_FILTER
 #include <memory>          // for make_shared, sha...
 #include <net/if.h>        // for ifreq, ifr_ifindex
 #include <stdint.h>        // for uint32_t, uint8_t
-#include <string.h>        // for strcpy, strerror
+#include <string.h>        // for strncpy, strerror
 #include <string>          // for string, operator+
 #include <sys/ioctl.h>     // for ioctl, SIOCGIFINDEX
 #include <sys/socket.h>    // for bind, setsockopt
 #include <tuple>           // for make_tuple, tuple
 #include <vector>          // for vector
 
-#include <boost/asio/buffer.hpp>                  // for buffer
 #include <boost/asio/posix/stream_descriptor.hpp> // for stream_descriptor
-#include <boost/asio/read.hpp>                    // for async_read
-#include <boost/bind/bind.hpp>                    // for bind
-#include <boost/core/ref.hpp>                     // for ref
+#include <boost/asio/steady_timer.hpp>            // for steady_timer
+#include <boost/system/error_code.hpp>            // for error_code
 
 #include "goby/exception.h"                         // for Exception
+#include "goby/middleware/io/detail/can_batch.h"    // for CanReceiveBatch
 #include "goby/middleware/io/detail/io_interface.h" // for PubSubLayer, IOT...
 #include "goby/middleware/protobuf/can_config.pb.h" // for CanConfig, CanCo...
-#include "goby/middleware/protobuf/io.pb.h"         // for IOData
+#include "goby/middleware/protobuf/io.pb.h"         // for IOData, CanStati...
 namespace goby
 {
 namespace middleware
@@ -105,13 +106,42 @@ class CanThread
     /// \param config A reference to the Protocol Buffers config read by the main application at launch
     /// \param index Thread index for multiple instances in a given application (-1 indicates a single instance)
     CanThread(const goby::middleware::protobuf::CanConfig& config, int index = -1)
-        : Base(config, index, std::string("can: ") + config.interface())
+        : Base(config, index, std::string("can: ") + config.interface()),
+          receive_batch_(std::max(1u, config.batch_size())),
+          filters_(make_filters(config))
     {
+        publish_timer_.reset(new boost::asio::steady_timer(this->mutable_io()));
+        statistics_timer_.reset(new boost::asio::steady_timer(this->mutable_io()));
+
+        if (this->cfg().statistics_interval_ms() > 0)
+            start_statistics_timer();
+
+        // subscribe here rather than in open_socket() so that we don't duplicate the subscription each time the socket is reopened
+        this->interthread().template subscribe<line_out_group, can_frame>(
+            [this](const can_frame& frame)
+            {
+                auto io_msg = std::make_shared<goby::middleware::protobuf::IOData>();
+                std::string& bytes = *io_msg->mutable_data();
+
+                const int frame_size = sizeof(can_frame);
+
+                for (int i = 0; i < frame_size; ++i)
+                {
+                    bytes += *(reinterpret_cast<const char*>(&frame) + i);
+                }
+                this->write(io_msg);
+            });
+
         auto ready = ThreadState::SUBSCRIPTIONS_COMPLETE;
         this->interthread().template publish<line_in_group>(ready);
     }
 
-    ~CanThread() override {}
+    void finalize() override
+    {
+        // frames still waiting for the publish window to close (the socket isn't closed before destruction)
+        publish_pending();
+        Base::finalize();
+    }
 
   private:
     void async_read() override;
@@ -122,10 +152,33 @@ class CanThread
 
     void open_socket() override;
 
-    void data_rec(struct can_frame& receive_frame_, boost::asio::posix::stream_descriptor& stream);
+    void data_rec(const struct can_frame& receive_frame_);
+
+    /// \brief Publishes (or, with a publish window, queues) each of the n frames received in receive_batch_
+    void receive_batch(int n);
+
+    void publish_pending();
+    void start_statistics_timer();
+    void publish_statistics();
+
+    static std::vector<can_filter> make_filters(const goby::middleware::protobuf::CanConfig& cfg);
 
   private:
-    struct can_frame receive_frame_;
+    // maximum number of recvmmsg() calls per wakeup, so that a busy bus can't starve the outgoing frames
+    static constexpr int max_receives_per_read{16};
+
+    detail::CanReceiveBatch receive_batch_;
+    const std::vector<can_filter> filters_;
+    // filters_ couldn't be (or weren't) installed in the kernel
+    bool user_space_filter_{false};
+
+    std::vector<can_frame> pending_;
+    std::unique_ptr<boost::asio::steady_timer> publish_timer_;
+    std::unique_ptr<boost::asio::steady_timer> statistics_timer_;
+
+    // SO_RXQ_OVFL count for the current socket
+    std::uint32_t socket_dropped_{0};
+    goby::middleware::protobuf::CanStatistics statistics_;
 };
 } // namespace io
 } // namespace middleware
@@ -136,21 +189,14 @@ template <const goby::middleware::Group& line_in_group,
           goby::middleware::io::PubSubLayer publish_layer,
           goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
           bool use_indexed_groups>
-void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
-                                     ThreadType, use_indexed_groups>::open_socket()
+std::vector<can_filter>
+goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
+                                ThreadType, use_indexed_groups>::
+    make_filters(const goby::middleware::protobuf::CanConfig& cfg)
 {
-    int can_socket;
-
-    struct sockaddr_can addr_
-    {
-    };
-    struct can_frame receive_frame_;
-    struct ifreq ifr_;
-    can_socket = socket(PF_CAN, SOCK_RAW, CAN_RAW);
-
     std::vector<struct can_filter> filters;
 
-    for (auto x : this->cfg().filter())
+    for (auto x : cfg.filter())
     {
         auto id = x.can_id();
         auto mask = x.has_can_mask_custom() ? x.can_mask_custom() : x.can_mask();
@@ -158,44 +204,115 @@ void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_laye
         filters.push_back({id, mask});
     }
 
-    for (std::uint32_t x : this->cfg().pgn_filter())
+    for (std::uint32_t x : cfg.pgn_filter())
     {
         constexpr std::uint32_t one_byte = 8; // bits
         auto id = x << one_byte;
         constexpr auto mask = protobuf::CanConfig::CanFilter::PGNOnly; // PGN mask
         filters.push_back({id, mask});
     }
+    return filters;
+}
+
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
+          bool use_indexed_groups>
+void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
+                                     ThreadType, use_indexed_groups>::open_socket()
+{
+    int can_socket;
 
-    if (filters.size())
+    struct sockaddr_can addr_
     {
-        setsockopt(can_socket, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(),
-                   sizeof(can_filter) * filters.size());
+    };
+    struct ifreq ifr_;
+    can_socket = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (can_socket < 0)
+        throw(goby::Exception(std::string("Error creating CAN socket: ") + std::strerror(errno)));
+
+    // give ownership to the descriptor right away so that it is closed if we throw below
+    this->mutable_socket().assign(can_socket);
+
+    user_space_filter_ = !filters_.empty() && !this->cfg().kernel_filter();
+    if (!filters_.empty() && this->cfg().kernel_filter())
+    {
+        if (setsockopt(can_socket, SOL_CAN_RAW, CAN_RAW_FILTER, filters_.data(),
+                       sizeof(can_filter) * filters_.size()) < 0)
+        {
+            goby::glog.is_warn() && goby::glog << group(this->glog_group())
+                                               << "Failed to set CAN_RAW_FILTER ("
+                                               << std::strerror(errno)
+                                               << "), filtering in user space instead"
+                                               << std::endl;
+            user_space_filter_ = true;
+        }
     }
-    std::strcpy(ifr_.ifr_name, this->cfg().interface().c_str());
 
-    ioctl(can_socket, SIOCGIFINDEX, &ifr_);
+    // report frames dropped by the kernel as ancillary data
+    int enable = 1;
+    socket_dropped_ = 0;
+    if (setsockopt(can_socket, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) < 0)
+        goby::glog.is_warn() && goby::glog << group(this->glog_group())
+                                           << "Failed to set SO_RXQ_OVFL (" << std::strerror(errno)
+                                           << "), frames_dropped will not be counted"
+                                           << std::endl;
+
+    std::strncpy(ifr_.ifr_name, this->cfg().interface().c_str(), IFNAMSIZ - 1);
+    ifr_.ifr_name[IFNAMSIZ - 1] = '\0';
+
+    if (ioctl(can_socket, SIOCGIFINDEX, &ifr_) < 0)
+        throw(goby::Exception(std::string("Error finding interface ") + this->cfg().interface() +
+                              ": " + std::strerror(errno)));
 
     addr_.can_family = AF_CAN;
     addr_.can_ifindex = ifr_.ifr_ifindex;
     if (bind(can_socket, (struct sockaddr*)&addr_, sizeof(addr_)) < 0)
         throw(goby::Exception(std::string("Error in socket bind to interface ") +
                               this->cfg().interface() + ": " + std::strerror(errno)));
+}
 
-    this->mutable_socket().assign(can_socket);
-
-    this->interthread().template subscribe<line_out_group, can_frame>(
-        [this](const can_frame& frame)
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
+          bool use_indexed_groups>
+void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
+                                     ThreadType, use_indexed_groups>::async_read()
+{
+    // wait for the socket to become readable, then read all the frames available (up to batch_size per system call)
+    this->mutable_socket().async_wait(
+        boost::asio::posix::stream_descriptor::wait_read,
+        [this](const boost::system::error_code& ec)
         {
-            auto io_msg = std::make_shared<goby::middleware::protobuf::IOData>();
-            std::string& bytes = *io_msg->mutable_data();
-
-            const int frame_size = sizeof(can_frame);
+            if (ec)
+            {
+                this->handle_read_error(ec);
+                return;
+            }
 
-            for (int i = 0; i < frame_size; ++i)
+            int fd = this->mutable_socket().native_handle();
+            for (int i = 0; i < max_receives_per_read; ++i)
             {
-                bytes += *(reinterpret_cast<const char*>(&frame) + i);
+                int n = receive_batch_.receive(fd);
+                if (n < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                        break;
+
+                    this->handle_read_error(
+                        boost::system::error_code(errno, boost::system::system_category()));
+                    return;
+                }
+
+                receive_batch(n);
+
+                // nothing more to read
+                if (n < static_cast<int>(receive_batch_.batch_size()))
+                    break;
             }
-            this->write(io_msg);
+            async_read();
         });
 }
 
@@ -205,12 +322,51 @@ template <const goby::middleware::Group& line_in_group,
           goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
           bool use_indexed_groups>
 void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
-                                     ThreadType, use_indexed_groups>::async_read()
+                                     ThreadType, use_indexed_groups>::receive_batch(int n)
 {
-    boost::asio::async_read(this->mutable_socket(),
-                            boost::asio::buffer(&receive_frame_, sizeof(receive_frame_)),
-                            boost::bind(&CanThread::data_rec, this, boost::ref(receive_frame_),
-                                        boost::ref(this->mutable_socket())));
+    for (int i = 0; i < n; ++i)
+    {
+        std::uint32_t dropped;
+        if (receive_batch_.dropped(i, &dropped) && dropped != socket_dropped_)
+        {
+            // counter is unsigned 32-bit and wraps
+            statistics_.set_frames_dropped(statistics_.frames_dropped() +
+                                           static_cast<std::uint32_t>(dropped - socket_dropped_));
+            socket_dropped_ = dropped;
+        }
+
+        if (!receive_batch_.complete(i))
+            continue;
+
+        const can_frame& frame = receive_batch_.frame(i);
+        statistics_.set_frames_received(statistics_.frames_received() + 1);
+
+        if (user_space_filter_ && !detail::can_filter_match(filters_, frame.can_id))
+        {
+            statistics_.set_frames_filtered(statistics_.frames_filtered() + 1);
+            continue;
+        }
+
+        if (this->cfg().publish_window_ms() == 0)
+        {
+            data_rec(frame);
+        }
+        else
+        {
+            if (pending_.empty())
+            {
+                publish_timer_->expires_after(
+                    std::chrono::milliseconds(this->cfg().publish_window_ms()));
+                publish_timer_->async_wait(
+                    [this](const boost::system::error_code& ec)
+                    {
+                        if (!ec)
+                            publish_pending();
+                    });
+            }
+            pending_.push_back(frame);
+        }
+    }
 }
 
 template <const goby::middleware::Group& line_in_group,
@@ -220,25 +376,85 @@ template <const goby::middleware::Group& line_in_group,
           bool use_indexed_groups>
 void goby::middleware::io::CanThread<
     line_in_group, line_out_group, publish_layer, subscribe_layer, ThreadType,
-    use_indexed_groups>::data_rec(struct can_frame& receive_frame_,
-                                  boost::asio::posix::stream_descriptor& stream)
+    use_indexed_groups>::data_rec(const struct can_frame& receive_frame_)
 {
     //  Within a process raw can frames are probably what we are looking for.
     this->interthread().template publish<line_in_group>(receive_frame_);
 
-    std::string bytes;
-    const int frame_size = sizeof(can_frame);
+    std::string bytes(reinterpret_cast<const char*>(&receive_frame_), sizeof(can_frame));
+    this->handle_read_success(bytes.size(), bytes);
 
-    for (int i = 0; i < frame_size; ++i)
+    statistics_.set_frames_published(statistics_.frames_published() + 1);
+}
+
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
+          bool use_indexed_groups>
+void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
+                                     ThreadType, use_indexed_groups>::publish_pending()
+{
+    if (pending_.empty())
+        return;
+
+    auto frames = std::make_shared<std::vector<can_frame>>();
+    frames->swap(pending_);
+
+    auto batch = std::make_shared<goby::middleware::protobuf::IODataBatch>();
+    if (this->index() != -1)
+        batch->set_index(this->index());
+    for (const auto& frame : *frames)
     {
-        bytes += *(reinterpret_cast<char*>(&receive_frame_) + i);
+        auto& io_msg = *batch->add_data();
+        if (this->index() != -1)
+            io_msg.set_index(this->index());
+        io_msg.set_data(reinterpret_cast<const char*>(&frame), sizeof(can_frame));
     }
 
-    this->handle_read_success(bytes.size(), bytes);
+    goby::glog.is_debug2() && goby::glog << group(this->glog_group()) << "(" << frames->size()
+                                         << " frames) >" << std::endl;
+
+    statistics_.set_frames_published(statistics_.frames_published() + frames->size());
+    statistics_.set_batches_published(statistics_.batches_published() + 1);
+
+    this->interthread().template publish<line_in_group>(
+        std::shared_ptr<const std::vector<can_frame>>(frames));
+    this->publish_in(batch);
+}
+
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
+          bool use_indexed_groups>
+void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
+                                     ThreadType, use_indexed_groups>::start_statistics_timer()
+{
+    statistics_timer_->expires_after(
+        std::chrono::milliseconds(this->cfg().statistics_interval_ms()));
+    statistics_timer_->async_wait(
+        [this](const boost::system::error_code& ec)
+        {
+            if (ec)
+                return;
+            publish_statistics();
+            start_statistics_timer();
+        });
+}
 
-    boost::asio::async_read(
-        stream, boost::asio::buffer(&receive_frame_, sizeof(receive_frame_)),
-        boost::bind(&CanThread::data_rec, this, boost::ref(receive_frame_), boost::ref(stream)));
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, template <class> class ThreadType,
+          bool use_indexed_groups>
+void goby::middleware::io::CanThread<line_in_group, line_out_group, publish_layer, subscribe_layer,
+                                     ThreadType, use_indexed_groups>::publish_statistics()
+{
+    auto statistics = std::make_shared<goby::middleware::protobuf::CanStatistics>(statistics_);
+    if (this->index() != -1)
+        statistics->set_index(this->index());
+    this->publish_in(statistics);
 }
 
 #endif
@@ -106,9 +106,9 @@ void cobs_async_read(Thread* this_thread,
                                                      << " " << goby::util::hex_encode(bytes)
                                                      << std::endl;
 
-                auto io_msg = std::make_shared<goby::middleware::protobuf::IOData>();
+                auto io_msg = this_thread->acquire_io_data();
                 auto& cobs_decoded = *io_msg->mutable_data();
-                cobs_decoded = std::string(bytes_transferred, '\0');
+                cobs_decoded.resize(bytes_transferred);
 
                 int decoded_size =
                     cobs_decode(reinterpret_cast<const uint8_t*>(bytes.data()), bytes_transferred,
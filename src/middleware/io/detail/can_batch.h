@@ -0,0 +1,133 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_IO_DETAIL_CAN_BATCH_H
+#define GOBY_MIDDLEWARE_IO_DETAIL_CAN_BATCH_H
+
+#include <cstdint>      // for uint32_t
+#include <cstring>      // for memcpy
+#include <linux/can.h>  // for can_frame, can_filter
+#include <sys/socket.h> // for recvmmsg, mmsghdr, CMSG_*
+#include <vector>       // for vector
+
+namespace goby
+{
+namespace middleware
+{
+namespace io
+{
+namespace detail
+{
+/// \brief Buffers for receiving up to batch_size CAN frames with a single recvmmsg() call, along with the socket's dropped frame count (if SO_RXQ_OVFL is enabled on the socket)
+class CanReceiveBatch
+{
+  public:
+    CanReceiveBatch(std::size_t batch_size)
+        : frames_(batch_size), msgs_(batch_size), iovecs_(batch_size),
+          control_(batch_size * control_size)
+    {
+        for (std::size_t i = 0; i < batch_size; ++i)
+        {
+            iovecs_[i].iov_base = &frames_[i];
+            iovecs_[i].iov_len = sizeof(can_frame);
+        }
+    }
+
+    /// \brief Receives the available frames (up to the batch size) without blocking
+    /// \return Number of frames received, or -1 on error (see errno)
+    int receive(int fd)
+    {
+        for (std::size_t i = 0, n = msgs_.size(); i < n; ++i)
+        {
+            auto& hdr = msgs_[i].msg_hdr;
+            hdr = msghdr();
+            hdr.msg_iov = &iovecs_[i];
+            hdr.msg_iovlen = 1;
+            hdr.msg_control = &control_[i * control_size];
+            hdr.msg_controllen = control_size;
+            msgs_[i].msg_len = 0;
+        }
+        return recvmmsg(fd, msgs_.data(), msgs_.size(), MSG_DONTWAIT, nullptr);
+    }
+
+    std::size_t batch_size() const { return msgs_.size(); }
+
+    const can_frame& frame(int i) const { return frames_[i]; }
+
+    /// \brief Was a whole can_frame received? (CAN FD frames are larger and are truncated)
+    bool complete(int i) const
+    {
+        return msgs_[i].msg_len == sizeof(can_frame) &&
+               !(msgs_[i].msg_hdr.msg_flags & MSG_TRUNC);
+    }
+
+    /// \brief Gets the total number of frames dropped by the socket when frame i was received
+    /// \return false if the count wasn't provided (SO_RXQ_OVFL not enabled, or no drops yet)
+    bool dropped(int i, std::uint32_t* count) const
+    {
+        auto* hdr = const_cast<msghdr*>(&msgs_[i].msg_hdr);
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(hdr, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+            {
+                std::memcpy(count, CMSG_DATA(cmsg), sizeof(*count));
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    static constexpr std::size_t control_size{CMSG_SPACE(sizeof(std::uint32_t))};
+
+    std::vector<can_frame> frames_;
+    std::vector<mmsghdr> msgs_;
+    std::vector<iovec> iovecs_;
+    std::vector<char> control_;
+};
+
+/// \brief Does the CAN id pass any of the filters, using the same rules as the kernel's CAN_RAW_FILTER? (An empty filter list passes everything)
+inline bool can_filter_match(const std::vector<can_filter>& filters, canid_t can_id)
+{
+    if (filters.empty())
+        return true;
+
+    for (const auto& filter : filters)
+    {
+        bool inverted = filter.can_id & CAN_INV_FILTER;
+        canid_t filter_id = filter.can_id & ~CAN_INV_FILTER;
+        bool match = (can_id & filter.can_mask) == (filter_id & filter.can_mask);
+        if (inverted)
+            match = !match;
+        if (match)
+            return true;
+    }
+    return false;
+}
+
+} // namespace detail
+} // namespace io
+} // namespace middleware
+} // namespace goby
+
+#endif
@@ -31,16 +31,18 @@
 #include <ostream>   // for endl, size_t
 #include <string>    // for string, oper...
 #include <thread>    // for thread
-#include <unistd.h>  // for usleep
+#include <unistd.h>  // for usleep, dup
 
-#include <boost/asio/write.hpp>        // for async_write
-#include <boost/system/error_code.hpp> // for error_code
+#include <boost/asio/posix/stream_descriptor.hpp> // for stream_descriptor
+#include <boost/asio/write.hpp>                   // for async_write
+#include <boost/system/error_code.hpp>            // for error_code
 
 #include "goby/exception.h"                           // for Exception
 #include "goby/middleware/application/multi_thread.h" // for SimpleThread
 #include "goby/middleware/common.h"                   // for thread_id
 #include "goby/middleware/io/groups.h"                // for status
 #include "goby/middleware/protobuf/io.pb.h"           // for IOError, IOS...
+#include "goby/middleware/transport/message_pool.h"   // for MessagePool
 #include "goby/time/steady_clock.h"                   // for SteadyClock
 #include "goby/util/asio_compat.h"
 #include "goby/util/debug_logger.h" // for glog
@@ -123,38 +125,27 @@ class IOThread : public ThreadType<IOConfig>,
 
     void initialize() override
     {
-        // thread to handle synchonization between boost::asio and goby condition_variable signaling
-        incoming_mail_notify_thread_.reset(new std::thread([this]() {
-            while (this->alive())
-            {
-                std::unique_lock<std::mutex> lock(incoming_mail_notify_mutex_);
-                this->interthread().cv()->wait(lock);
-                // post empty handler to cause loop() to return and allow incoming mail to be handled
-                io_.post([]() {});
-            }
-        }));
-
         this->set_name(thread_name_);
+
+        // wait on the poller's wakeup descriptor in the io_context, so that incoming mail causes loop() to return and be handled
+        wakeup_ = this->interthread().wakeup();
+        wakeup_->arm_fd();
+        incoming_mail_descriptor_.reset(
+            new boost::asio::posix::stream_descriptor(io_, ::dup(wakeup_->fd())));
+        async_wait_incoming_mail();
     }
 
     void finalize() override
     {
-        // join incoming mail thread
-        {
-            std::lock_guard<std::mutex> l(incoming_mail_notify_mutex_);
-            this->interthread().cv()->notify_all();
-        }
-        incoming_mail_notify_thread_->join();
-        incoming_mail_notify_thread_.reset();
+        close_incoming_mail();
     }
 
     virtual ~IOThread()
     {
         socket_.reset();
 
-        // for non clean shutdown, avoid abort
-        if (incoming_mail_notify_thread_)
-            incoming_mail_notify_thread_->detach();
+        // for non clean shutdown
+        close_incoming_mail();
 
         auto status = std::make_shared<protobuf::IOStatus>();
         status->set_state(protobuf::IO__LINK_CLOSED);
@@ -184,8 +175,8 @@ class IOThread : public ThreadType<IOConfig>,
 
     void handle_read_success(std::size_t bytes_transferred, const std::string& bytes)
     {
-        auto io_msg = std::make_shared<goby::middleware::protobuf::IOData>();
-        *io_msg->mutable_data() = bytes;
+        auto io_msg = acquire_io_data();
+        io_msg->set_data(bytes);
 
         handle_read_success(bytes_transferred, io_msg);
     }
@@ -205,6 +196,12 @@ class IOThread : public ThreadType<IOConfig>,
     }
 
     void handle_write_success(std::size_t bytes_transferred) {}
+
+    /// \brief Returns a (cleared) IOData message for publishing incoming data, recycled once all the subscribers have released it
+    std::shared_ptr<goby::middleware::protobuf::IOData> acquire_io_data()
+    {
+        return io_data_pool_.acquire();
+    }
     void handle_read_error(const boost::system::error_code& ec);
     void handle_write_error(const boost::system::error_code& ec);
 
@@ -240,17 +237,47 @@ class IOThread : public ThreadType<IOConfig>,
     /// \brief If the socket is not open, try to open it. Otherwise, block until either 1) data is read or 2) we have incoming mail
     void loop() override;
 
+    void async_wait_incoming_mail()
+    {
+        auto handler = [this](const boost::system::error_code& ec, std::size_t = 0)
+        {
+            // operation_aborted on shutdown
+            if (ec)
+                return;
+            // the interthread poll in run_once() (after loop() returns) handles the mail
+            wakeup_->clear_fd();
+            async_wait_incoming_mail();
+        };
+#if BOOST_VERSION >= 106600
+        incoming_mail_descriptor_->async_wait(boost::asio::posix::stream_descriptor::wait_read,
+                                              handler);
+#else
+        incoming_mail_descriptor_->async_read_some(boost::asio::null_buffers(), handler);
+#endif
+    }
+
+    void close_incoming_mail()
+    {
+        if (incoming_mail_descriptor_)
+        {
+            incoming_mail_descriptor_.reset();
+            wakeup_->disarm_fd();
+        }
+    }
+
   private:
     boost::asio::io_context io_;
     std::unique_ptr<SocketType> socket_;
+    MessagePool<goby::middleware::protobuf::IOData> io_data_pool_;
 
     const goby::time::SteadyClock::duration min_backoff_interval_{std::chrono::seconds(1)};
     const goby::time::SteadyClock::duration max_backoff_interval_{std::chrono::seconds(128)};
     goby::time::SteadyClock::duration backoff_interval_{min_backoff_interval_};
     goby::time::SteadyClock::time_point next_open_attempt_{goby::time::SteadyClock::now()};
 
-    std::mutex incoming_mail_notify_mutex_;
-    std::unique_ptr<std::thread> incoming_mail_notify_thread_;
+    // duplicate of the interthread poller's wakeup descriptor
+    std::shared_ptr<PollerWakeup> wakeup_;
+    std::unique_ptr<boost::asio::posix::stream_descriptor> incoming_mail_descriptor_;
 
     std::string glog_group_;
     std::string thread_name_;
@@ -360,7 +387,7 @@ void goby::middleware::io::detail::IOThread<line_in_group, line_out_group, publi
     {
         // run the io service (blocks until either we read something
         // from the socket or a subscription is available
-        // as signaled from an empty handler in the incoming_mail_notify_thread)
+        // as signaled by the poller's wakeup descriptor)
         io_.run_one();
     }
     else
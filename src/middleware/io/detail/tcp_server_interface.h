@@ -159,6 +159,11 @@ class TCPSession : public std::enable_shared_from_this<TCPSession<TCPServerThrea
         server_.handle_read_success(bytes_transferred, io_msg);
     }
 
+    std::shared_ptr<goby::middleware::protobuf::IOData> acquire_io_data()
+    {
+        return server_.acquire_io_data();
+    }
+
     void handle_read_error(const boost::system::error_code& ec)
     {
         if (ec != boost::asio::error::eof)
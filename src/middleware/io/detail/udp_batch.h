@@ -0,0 +1,175 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_IO_DETAIL_UDP_BATCH_H
+#define GOBY_MIDDLEWARE_IO_DETAIL_UDP_BATCH_H
+
+// recvmmsg/sendmmsg are Linux specific
+#ifdef __linux__
+#define GOBY_IO_UDP_BATCH_AVAILABLE
+
+#include <algorithm>    // for min
+#include <cstring>      // for memcpy
+#include <deque>        // for deque
+#include <memory>       // for shared_ptr
+#include <sys/socket.h> // for recvmmsg, sendmmsg, mmsghdr
+#include <vector>       // for vector
+
+#include <boost/asio/ip/udp.hpp> // for udp::endpoint
+
+#include "goby/middleware/protobuf/io.pb.h" // for IOData
+
+namespace goby
+{
+namespace middleware
+{
+namespace io
+{
+namespace detail
+{
+/// \brief Buffers for receiving up to batch_size datagrams with a single recvmmsg() call
+class UDPReceiveBatch
+{
+  public:
+    UDPReceiveBatch(std::size_t batch_size, std::size_t max_datagram_size)
+        : max_datagram_size_(max_datagram_size),
+          data_(batch_size * max_datagram_size),
+          msgs_(batch_size),
+          iovecs_(batch_size),
+          addrs_(batch_size)
+    {
+        for (std::size_t i = 0; i < batch_size; ++i)
+        {
+            iovecs_[i].iov_base = &data_[i * max_datagram_size_];
+            iovecs_[i].iov_len = max_datagram_size_;
+        }
+    }
+
+    /// \brief Receives the available datagrams (up to the batch size) without blocking
+    /// \return Number of datagrams received, or -1 on error (see errno)
+    int receive(int fd)
+    {
+        for (std::size_t i = 0, n = msgs_.size(); i < n; ++i)
+        {
+            auto& hdr = msgs_[i].msg_hdr;
+            hdr = msghdr();
+            hdr.msg_name = &addrs_[i];
+            hdr.msg_namelen = sizeof(addrs_[i]);
+            hdr.msg_iov = &iovecs_[i];
+            hdr.msg_iovlen = 1;
+            msgs_[i].msg_len = 0;
+        }
+        return recvmmsg(fd, msgs_.data(), msgs_.size(), MSG_DONTWAIT, nullptr);
+    }
+
+    std::size_t batch_size() const { return msgs_.size(); }
+
+    const char* data(int i) const { return &data_[i * max_datagram_size_]; }
+    std::size_t size(int i) const { return msgs_[i].msg_len; }
+    bool truncated(int i) const { return msgs_[i].msg_hdr.msg_flags & MSG_TRUNC; }
+
+    boost::asio::ip::udp::endpoint sender(int i) const
+    {
+        boost::asio::ip::udp::endpoint endpoint;
+        std::memcpy(endpoint.data(), &addrs_[i], msgs_[i].msg_hdr.msg_namelen);
+        endpoint.resize(msgs_[i].msg_hdr.msg_namelen);
+        return endpoint;
+    }
+
+  private:
+    const std::size_t max_datagram_size_;
+    std::vector<char> data_;
+    std::vector<mmsghdr> msgs_;
+    std::vector<iovec> iovecs_;
+    std::vector<sockaddr_storage> addrs_;
+};
+
+/// \brief Queue of outgoing datagrams, sent up to batch_size at a time with sendmmsg()
+class UDPSendBatch
+{
+  public:
+    UDPSendBatch(std::size_t batch_size) : batch_size_(batch_size) {}
+
+    void push(const boost::asio::ip::udp::endpoint& destination,
+              std::shared_ptr<const goby::middleware::protobuf::IOData> io_msg)
+    {
+        queue_.push_back({destination, io_msg});
+    }
+
+    /// \brief Sends the datagrams at the front of the queue (up to the batch size) without blocking, and removes the ones sent from the queue
+    /// \param bytes_sent Incremented by the number of bytes sent
+    /// \return Number of datagrams sent, or -1 on error (see errno)
+    int send(int fd, std::size_t* bytes_sent)
+    {
+        std::size_t n = std::min(batch_size_, queue_.size());
+        msgs_.resize(n);
+        iovecs_.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto& datagram = queue_[i];
+            iovecs_[i].iov_base = const_cast<char*>(datagram.io_msg->data().data());
+            iovecs_[i].iov_len = datagram.io_msg->data().size();
+
+            auto& hdr = msgs_[i].msg_hdr;
+            hdr = msghdr();
+            hdr.msg_name = const_cast<void*>(static_cast<const void*>(datagram.destination.data()));
+            hdr.msg_namelen = datagram.destination.size();
+            hdr.msg_iov = &iovecs_[i];
+            hdr.msg_iovlen = 1;
+            msgs_[i].msg_len = 0;
+        }
+
+        int sent = sendmmsg(fd, msgs_.data(), n, MSG_DONTWAIT);
+        if (sent > 0)
+        {
+            for (int i = 0; i < sent; ++i) *bytes_sent += msgs_[i].msg_len;
+            queue_.erase(queue_.begin(), queue_.begin() + sent);
+        }
+        return sent;
+    }
+
+    bool empty() const { return queue_.empty(); }
+    std::size_t size() const { return queue_.size(); }
+    void clear() { queue_.clear(); }
+
+  private:
+    struct Datagram
+    {
+        boost::asio::ip::udp::endpoint destination;
+        // keeps the data alive until sent
+        std::shared_ptr<const goby::middleware::protobuf::IOData> io_msg;
+    };
+
+    const std::size_t batch_size_;
+    std::deque<Datagram> queue_;
+    std::vector<mmsghdr> msgs_;
+    std::vector<iovec> iovecs_;
+};
+
+} // namespace detail
+} // namespace io
+} // namespace middleware
+} // namespace goby
+
+#endif
+#endif
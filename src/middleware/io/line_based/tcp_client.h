@@ -116,9 +116,9 @@ void goby::middleware::io::TCPClientThreadLineBased<line_in_group, line_out_grou
         [this](const boost::system::error_code& ec, std::size_t bytes_transferred) {
             if (!ec && bytes_transferred > 0)
             {
-                auto io_msg = std::make_shared<goby::middleware::protobuf::IOData>();
+                auto io_msg = this->acquire_io_data();
                 auto& bytes = *io_msg->mutable_data();
-                bytes = std::string(bytes_transferred, 0);
+                bytes.resize(bytes_transferred);
                 std::istream is(&buffer_);
                 is.read(&bytes[0], bytes_transferred);
                 this->insert_endpoints(io_msg);
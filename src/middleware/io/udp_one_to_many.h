@@ -30,12 +30,14 @@
 #include <boost/asio/ip/udp.hpp>       // for udp, udp::endpoint
 #include <boost/asio/socket_base.hpp>  // for socket_base
 #include <boost/system/error_code.hpp> // for error_code
+#include <cerrno>                      // for errno
 #include <cstddef>                     // for size_t
 #include <memory>                      // for shared_ptr, __s...
 #include <string>                      // for string, to_string
 
 #include "goby/exception.h"                         // for Exception
 #include "goby/middleware/io/detail/io_interface.h" // for PubSubLayer
+#include "goby/middleware/io/detail/udp_batch.h"    // for UDPReceiveBatch
 #include "goby/middleware/protobuf/io.pb.h"         // for IOData, UDPEndP...
 #include "goby/middleware/protobuf/udp_config.pb.h" // for UDPOneToManyConfig
 
@@ -76,6 +78,21 @@ class UDPOneToManyThread
     UDPOneToManyThread(const Config& config, int index = -1, bool is_final = true)
         : Base(config, index, std::string("udp: ") + std::to_string(config.bind_port()))
     {
+        if (this->cfg().batch_size() > 1)
+        {
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+            rx_batch_.reset(new detail::UDPReceiveBatch(this->cfg().batch_size(),
+                                                        this->cfg().max_datagram_size()));
+            tx_batch_.reset(new detail::UDPSendBatch(this->cfg().batch_size()));
+#else
+            goby::glog.is_warn() && goby::glog << group(this->glog_group())
+                                               << "batch_size > 1 is not supported on this "
+                                                  "platform, sending/receiving one datagram at a "
+                                                  "time"
+                                               << std::endl;
+#endif
+        }
+
         if (is_final)
         {
             auto ready = ThreadState::SUBSCRIPTIONS_COMPLETE;
@@ -93,15 +110,40 @@ class UDPOneToManyThread
     virtual void
     async_write(std::shared_ptr<const goby::middleware::protobuf::IOData> io_msg) override;
 
+    /// \brief Sends the data to the given endpoint (queued and sent with sendmmsg when batching)
+    void send_to(std::shared_ptr<const goby::middleware::protobuf::IOData> io_msg,
+                 const boost::asio::ip::udp::endpoint& remote_endpoint);
+
   private:
     /// \brief Tries to open the udp socket, and if fails publishes an error
     void open_socket() override;
 
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+    /// \brief Waits for the socket to be readable, then drains the available datagrams with recvmmsg
+    void async_read_batch();
+    void publish_batch(int n);
+
+    /// \brief Waits for the socket to be writable, then sends the queued datagrams with sendmmsg
+    void async_write_batch();
+#endif
+
   private:
     static constexpr int max_udp_size{65507};
     std::array<char, max_udp_size> rx_message_;
     boost::asio::ip::udp::endpoint sender_endpoint_;
     boost::asio::ip::udp::endpoint local_endpoint_;
+
+    // avoids resolving the destination of every datagram in async_write()
+    protobuf::UDPEndPoint last_dest_;
+    boost::asio::ip::udp::endpoint last_remote_endpoint_;
+
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+    // maximum number of recvmmsg calls per readiness event, so that a flood of incoming data doesn't starve writes
+    static constexpr int max_receives_per_read{16};
+    std::unique_ptr<detail::UDPReceiveBatch> rx_batch_;
+    std::unique_ptr<detail::UDPSendBatch> tx_batch_;
+    bool tx_waiting_{false};
+#endif
 };
 } // namespace io
 } // namespace middleware
@@ -145,15 +187,23 @@ void goby::middleware::io::UDPOneToManyThread<line_in_group, line_out_group, pub
                                               subscribe_layer, Config, ThreadType,
                                               use_indexed_groups>::async_read()
 {
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+    if (rx_batch_)
+    {
+        async_read_batch();
+        return;
+    }
+#endif
+
     this->mutable_socket().async_receive_from(
         boost::asio::buffer(rx_message_), sender_endpoint_,
         [this](const boost::system::error_code& ec, size_t bytes_transferred)
         {
             if (!ec && bytes_transferred > 0)
             {
-                auto io_msg = std::make_shared<goby::middleware::protobuf::IOData>();
-                *io_msg->mutable_data() =
-                    std::string(rx_message_.begin(), rx_message_.begin() + bytes_transferred);
+                auto io_msg = this->acquire_io_data();
+                io_msg->mutable_data()->assign(rx_message_.begin(),
+                                               rx_message_.begin() + bytes_transferred);
 
                 *io_msg->mutable_udp_src() =
                     detail::endpoint_convert<protobuf::UDPEndPoint>(sender_endpoint_);
@@ -183,10 +233,39 @@ void goby::middleware::io::UDPOneToManyThread<
     if (!io_msg->has_udp_dest())
         throw(goby::Exception("UDPOneToManyThread requires 'udp_dest' field to be set in IOData"));
 
-    boost::asio::ip::udp::resolver resolver(this->mutable_io());
-    boost::asio::ip::udp::endpoint remote_endpoint =
-        *resolver.resolve({io_msg->udp_dest().addr(), std::to_string(io_msg->udp_dest().port()),
-                           boost::asio::ip::resolver_query_base::numeric_service});
+    if (!last_dest_.has_addr() || io_msg->udp_dest().addr() != last_dest_.addr() ||
+        io_msg->udp_dest().port() != last_dest_.port())
+    {
+        boost::asio::ip::udp::resolver resolver(this->mutable_io());
+        last_remote_endpoint_ = *resolver.resolve(
+            {io_msg->udp_dest().addr(), std::to_string(io_msg->udp_dest().port()),
+             boost::asio::ip::resolver_query_base::numeric_service});
+        last_dest_ = io_msg->udp_dest();
+    }
+
+    send_to(io_msg, last_remote_endpoint_);
+}
+
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, typename Config,
+          template <class> class ThreadType, bool use_indexed_groups>
+void goby::middleware::io::UDPOneToManyThread<line_in_group, line_out_group, publish_layer,
+                                              subscribe_layer, Config, ThreadType,
+                                              use_indexed_groups>::
+    send_to(std::shared_ptr<const goby::middleware::protobuf::IOData> io_msg,
+            const boost::asio::ip::udp::endpoint& remote_endpoint)
+{
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+    if (tx_batch_)
+    {
+        tx_batch_->push(remote_endpoint, io_msg);
+        if (!tx_waiting_)
+            async_write_batch();
+        return;
+    }
+#endif
 
     this->mutable_socket().async_send_to(
         boost::asio::buffer(io_msg->data()), remote_endpoint,
@@ -203,4 +282,162 @@ void goby::middleware::io::UDPOneToManyThread<
         });
 }
 
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, typename Config,
+          template <class> class ThreadType, bool use_indexed_groups>
+void goby::middleware::io::UDPOneToManyThread<line_in_group, line_out_group, publish_layer,
+                                              subscribe_layer, Config, ThreadType,
+                                              use_indexed_groups>::async_read_batch()
+{
+    this->mutable_socket().async_wait(
+        boost::asio::ip::udp::socket::wait_read,
+        [this](const boost::system::error_code& ec)
+        {
+            if (ec)
+            {
+                this->handle_read_error(ec);
+                return;
+            }
+
+            int fd = this->mutable_socket().native_handle();
+            for (int i = 0; i < max_receives_per_read; ++i)
+            {
+                int n = rx_batch_->receive(fd);
+                if (n < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                        break;
+
+                    this->handle_read_error(
+                        boost::system::error_code(errno, boost::system::system_category()));
+                    return;
+                }
+
+                publish_batch(n);
+
+                // nothing more to read
+                if (n < static_cast<int>(rx_batch_->batch_size()))
+                    break;
+            }
+            this->async_read();
+        });
+}
+
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, typename Config,
+          template <class> class ThreadType, bool use_indexed_groups>
+void goby::middleware::io::UDPOneToManyThread<line_in_group, line_out_group, publish_layer,
+                                              subscribe_layer, Config, ThreadType,
+                                              use_indexed_groups>::publish_batch(int n)
+{
+    auto dest = detail::endpoint_convert<protobuf::UDPEndPoint>(local_endpoint_);
+
+    std::shared_ptr<goby::middleware::protobuf::IODataBatch> batch;
+    if (this->cfg().publish_batch())
+    {
+        batch = std::make_shared<goby::middleware::protobuf::IODataBatch>();
+        if (this->index() != -1)
+            batch->set_index(this->index());
+    }
+
+    std::size_t bytes_transferred = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if (rx_batch_->truncated(i))
+            goby::glog.is_warn() && goby::glog << group(this->glog_group())
+                                               << "Datagram truncated to max_datagram_size ("
+                                               << this->cfg().max_datagram_size() << " bytes)"
+                                               << std::endl;
+
+        std::size_t size = rx_batch_->size(i);
+        bytes_transferred += size;
+
+        auto set_io_data = [&](goby::middleware::protobuf::IOData& io_msg)
+        {
+            io_msg.mutable_data()->assign(rx_batch_->data(i), size);
+            *io_msg.mutable_udp_src() =
+                detail::endpoint_convert<protobuf::UDPEndPoint>(rx_batch_->sender(i));
+            *io_msg.mutable_udp_dest() = dest;
+        };
+
+        if (batch)
+        {
+            auto& io_msg = *batch->add_data();
+            if (this->index() != -1)
+                io_msg.set_index(this->index());
+            set_io_data(io_msg);
+        }
+        else
+        {
+            auto io_msg = this->acquire_io_data();
+            set_io_data(*io_msg);
+            this->handle_read_success(size, io_msg);
+        }
+    }
+
+    if (batch && batch->data_size() > 0)
+    {
+        goby::glog.is_debug2() && goby::glog << group(this->glog_group()) << "("
+                                             << bytes_transferred << "B in " << n
+                                             << " datagrams) > " << std::endl;
+        this->publish_in(batch);
+    }
+}
+
+template <const goby::middleware::Group& line_in_group,
+          const goby::middleware::Group& line_out_group,
+          goby::middleware::io::PubSubLayer publish_layer,
+          goby::middleware::io::PubSubLayer subscribe_layer, typename Config,
+          template <class> class ThreadType, bool use_indexed_groups>
+void goby::middleware::io::UDPOneToManyThread<line_in_group, line_out_group, publish_layer,
+                                              subscribe_layer, Config, ThreadType,
+                                              use_indexed_groups>::async_write_batch()
+{
+    tx_waiting_ = true;
+    this->mutable_socket().async_wait(
+        boost::asio::ip::udp::socket::wait_write,
+        [this](const boost::system::error_code& ec)
+        {
+            tx_waiting_ = false;
+            if (ec)
+            {
+                tx_batch_->clear();
+                // cancelled as the socket was closed after an error (already reported)
+                if (ec != boost::asio::error::operation_aborted)
+                    this->handle_write_error(ec);
+                return;
+            }
+
+            // everything written while we were waiting for the socket to become writable is sent together
+            int fd = this->mutable_socket().native_handle();
+            std::size_t bytes_transferred = 0;
+            while (!tx_batch_->empty())
+            {
+                int n = tx_batch_->send(fd, &bytes_transferred);
+                if (n < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                        break;
+
+                    tx_batch_->clear();
+                    this->handle_write_error(
+                        boost::system::error_code(errno, boost::system::system_category()));
+                    return;
+                }
+            }
+
+            if (bytes_transferred > 0)
+                this->handle_write_success(bytes_transferred);
+
+            if (!tx_batch_->empty())
+                async_write_batch();
+        });
+}
+#endif
+
 #endif
@@ -0,0 +1,537 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "compressed_log.h"
+
+#include <algorithm> // for upper_bound, fill, equal
+
+#include <boost/crc.hpp> // for crc_32_type
+
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#include "goby/middleware/log/log_entry.h"       // for LogException
+#include "goby/util/debug_logger/flex_ostream.h" // for glog
+
+using goby::glog;
+using goby::middleware::log::CompressionType;
+using goby::middleware::log::LogIFStream;
+using goby::middleware::log::LogOFStream;
+using goby::middleware::log::detail::CompressedLogFormat;
+using goby::middleware::log::detail::CompressedLogIStreamBuf;
+using goby::middleware::log::detail::CompressedLogOStreamBuf;
+
+const std::string CompressedLogFormat::file_magic{"GBYZ"};
+const std::string CompressedLogFormat::block_magic{"GBZB"};
+
+namespace
+{
+// blocks waiting for the compression thread before the writer blocks
+constexpr std::size_t max_queued_blocks{4};
+
+// guard against allocating huge buffers due to a corrupted block header
+constexpr std::uint32_t max_block_size{1 << 28};
+
+void append_be32(std::vector<char>* out, std::uint32_t u)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out->push_back(static_cast<char>((u >> shift) & 0xFF));
+}
+
+std::uint32_t read_be32(const char* in)
+{
+    std::uint32_t u = 0;
+    for (int i = 0; i < 4; ++i) u = (u << 8) | static_cast<unsigned char>(in[i]);
+    return u;
+}
+
+// CRC over the block sizes and the compressed data, so a damaged header is also detected
+std::uint32_t block_crc(const char* sizes, const char* data, std::size_t data_size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(sizes, 8);
+    crc.process_bytes(data, data_size);
+    return crc.checksum();
+}
+
+void compress(CompressionType type, int level, const std::vector<char>& in, std::vector<char>* out)
+{
+    switch (type)
+    {
+        case CompressionType::NONE: out->assign(in.begin(), in.end()); return;
+
+        case CompressionType::ZLIB:
+        {
+#ifdef HAS_ZLIB
+            uLongf out_size = compressBound(in.size());
+            out->resize(out_size);
+            int result = compress2(reinterpret_cast<Bytef*>(out->data()), &out_size,
+                                   reinterpret_cast<const Bytef*>(in.data()), in.size(), level);
+            if (result != Z_OK)
+                throw(goby::middleware::log::LogException("zlib compression failed: " +
+                                                          std::to_string(result)));
+            out->resize(out_size);
+            return;
+#else
+            break;
+#endif
+        }
+
+        case CompressionType::ZSTD:
+        {
+#ifdef HAS_ZSTD
+            if (level == LogOFStream::default_compression_level)
+                level = 3; // ZSTD_CLEVEL_DEFAULT (not public API in older libzstd)
+            out->resize(ZSTD_compressBound(in.size()));
+            std::size_t out_size =
+                ZSTD_compress(out->data(), out->size(), in.data(), in.size(), level);
+            if (ZSTD_isError(out_size))
+                throw(goby::middleware::log::LogException(
+                    std::string("zstd compression failed: ") + ZSTD_getErrorName(out_size)));
+            out->resize(out_size);
+            return;
+#else
+            break;
+#endif
+        }
+    }
+    throw(goby::middleware::log::LogException(
+        "Compression type " + std::to_string(static_cast<int>(type)) + " is not available"));
+}
+
+bool decompress(CompressionType type, const std::vector<char>& in, std::vector<char>* out)
+{
+    switch (type)
+    {
+        case CompressionType::NONE:
+            if (in.size() != out->size())
+                return false;
+            std::copy(in.begin(), in.end(), out->begin());
+            return true;
+
+        case CompressionType::ZLIB:
+        {
+#ifdef HAS_ZLIB
+            uLongf out_size = out->size();
+            int result = uncompress(reinterpret_cast<Bytef*>(out->data()), &out_size,
+                                    reinterpret_cast<const Bytef*>(in.data()), in.size());
+            return result == Z_OK && out_size == out->size();
+#else
+            return false;
+#endif
+        }
+
+        case CompressionType::ZSTD:
+        {
+#ifdef HAS_ZSTD
+            std::size_t out_size = ZSTD_decompress(out->data(), out->size(), in.data(), in.size());
+            return !ZSTD_isError(out_size) && out_size == out->size();
+#else
+            return false;
+#endif
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool goby::middleware::log::compression_available(CompressionType type)
+{
+    switch (type)
+    {
+        case CompressionType::NONE: return true;
+#ifdef HAS_ZLIB
+        case CompressionType::ZLIB: return true;
+#endif
+#ifdef HAS_ZSTD
+        case CompressionType::ZSTD: return true;
+#endif
+        default: return false;
+    }
+}
+
+CompressedLogOStreamBuf::CompressedLogOStreamBuf(std::streambuf* sink, CompressionType type,
+                                                 int level, std::size_t block_size)
+    : sink_(sink),
+      type_(type),
+      level_(level),
+      block_size_(std::max<std::size_t>(std::min<std::size_t>(block_size, max_block_size), 1)),
+      block_(block_size_)
+{
+    if (!compression_available(type_))
+        throw(LogException("Compression type " + std::to_string(static_cast<int>(type_)) +
+                           " is not available in this build of Goby"));
+
+    std::string header = CompressedLogFormat::file_magic;
+    header.push_back(static_cast<char>(CompressedLogFormat::container_version));
+    header.push_back(static_cast<char>(type_));
+    header.append(2, '\0');
+    sink_->sputn(header.data(), header.size());
+    compressed_bytes_ = header.size();
+
+    setp(block_.data(), block_.data() + block_.size());
+    compress_thread_.reset(new std::thread([this]() { compress_loop(); }));
+}
+
+CompressedLogOStreamBuf::~CompressedLogOStreamBuf() { finish(); }
+
+void CompressedLogOStreamBuf::finish()
+{
+    if (!compress_thread_)
+        return;
+
+    submit_block();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finish_ = true;
+    }
+    compress_cv_.notify_all();
+    compress_thread_->join();
+    compress_thread_.reset();
+    setp(nullptr, nullptr);
+    sink_->pubsync();
+}
+
+std::uint64_t CompressedLogOStreamBuf::uncompressed_bytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return uncompressed_bytes_;
+}
+
+std::uint64_t CompressedLogOStreamBuf::compressed_bytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compressed_bytes_;
+}
+
+CompressedLogOStreamBuf::int_type CompressedLogOStreamBuf::overflow(int_type c)
+{
+    if (!compress_thread_)
+        return traits_type::eof();
+
+    submit_block();
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int CompressedLogOStreamBuf::sync()
+{
+    if (compress_thread_)
+        submit_block();
+    return 0;
+}
+
+void CompressedLogOStreamBuf::submit_block()
+{
+    std::size_t size = pptr() - pbase();
+    if (size == 0)
+        return;
+
+    block_.resize(size);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // apply backpressure rather than queuing without bound if compression can't keep up
+        submit_cv_.wait(lock, [this]() { return queue_.size() < max_queued_blocks; });
+        queue_.push_back(std::move(block_));
+        uncompressed_bytes_ += size;
+    }
+    compress_cv_.notify_all();
+
+    block_ = std::vector<char>(block_size_);
+    setp(block_.data(), block_.data() + block_.size());
+}
+
+void CompressedLogOStreamBuf::compress_loop()
+{
+    std::vector<char> compressed;
+    std::vector<char> header;
+    for (;;)
+    {
+        std::vector<char> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            compress_cv_.wait(lock, [this]() { return finish_ || !queue_.empty(); });
+            if (queue_.empty())
+                return;
+            block = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        submit_cv_.notify_all();
+
+        try
+        {
+            compress(type_, level_, block, &compressed);
+        }
+        catch (std::exception& e)
+        {
+            glog.is_warn() && glog << "Failed to compress log block, dropping "
+                                   << block.size() << " bytes: " << e.what() << std::endl;
+            continue;
+        }
+
+        header.clear();
+        header.insert(header.end(), CompressedLogFormat::block_magic.begin(),
+                      CompressedLogFormat::block_magic.end());
+        append_be32(&header, block.size());
+        append_be32(&header, compressed.size());
+        append_be32(&header, block_crc(&header[4], compressed.data(), compressed.size()));
+
+        if (sink_->sputn(header.data(), header.size()) != std::streamsize(header.size()) ||
+            sink_->sputn(compressed.data(), compressed.size()) !=
+                std::streamsize(compressed.size()))
+            glog.is_warn() && glog << "Failed to write compressed log block" << std::endl;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        compressed_bytes_ += header.size() + compressed.size();
+    }
+}
+
+CompressedLogIStreamBuf::CompressedLogIStreamBuf(std::streambuf* source) : source_(source)
+{
+    char header[CompressedLogFormat::file_header_bytes - 4];
+    if (source_->sgetn(header, sizeof(header)) != sizeof(header))
+        throw(LogException("Compressed log is missing file header"));
+
+    if (static_cast<std::uint8_t>(header[0]) > CompressedLogFormat::container_version)
+        throw(LogException("Compressed log container version " +
+                           std::to_string(static_cast<int>(header[0])) +
+                           " is newer than this version of Goby supports"));
+
+    type_ = static_cast<CompressionType>(header[1]);
+    if (!compression_available(type_))
+        throw(LogException("Compressed log uses compression type " +
+                           std::to_string(static_cast<int>(type_)) +
+                           " which is not available in this build of Goby"));
+
+    scan_offset_ = CompressedLogFormat::file_header_bytes;
+    scan_blocks();
+    setg(nullptr, nullptr, nullptr);
+}
+
+void CompressedLogIStreamBuf::scan_blocks()
+{
+    std::streamoff file_end = source_->pubseekoff(0, std::ios_base::end, std::ios_base::in);
+    char header[CompressedLogFormat::block_header_bytes];
+    const auto& magic = CompressedLogFormat::block_magic;
+
+    for (;;)
+    {
+        if (scan_offset_ + CompressedLogFormat::block_header_bytes > file_end)
+            break;
+
+        source_->pubseekpos(scan_offset_, std::ios_base::in);
+        if (source_->sgetn(header, sizeof(header)) != sizeof(header))
+            break;
+
+        if (!std::equal(magic.begin(), magic.end(), header))
+        {
+            glog.is_warn() && glog << "Invalid compressed log block header at offset "
+                                   << scan_offset_ << ", seeking next block" << std::endl;
+            ++scan_offset_;
+            continue;
+        }
+
+        Block block;
+        block.uncompressed_size = read_be32(header + 4);
+        block.compressed_size = read_be32(header + 8);
+        block.crc = read_be32(header + 12);
+        block.file_offset = scan_offset_ + CompressedLogFormat::block_header_bytes;
+        block.uncompressed_offset = uncompressed_size_;
+
+        if (block.uncompressed_size > max_block_size || block.compressed_size > max_block_size)
+        {
+            glog.is_warn() && glog << "Invalid compressed log block sizes at offset "
+                                   << scan_offset_ << ", seeking next block" << std::endl;
+            ++scan_offset_;
+            continue;
+        }
+
+        // incomplete block (file is still being written)
+        if (block.file_offset + block.compressed_size > file_end)
+            break;
+
+        blocks_.push_back(block);
+        uncompressed_size_ += block.uncompressed_size;
+        scan_offset_ = block.file_offset + block.compressed_size;
+    }
+}
+
+void CompressedLogIStreamBuf::load_block(std::size_t i)
+{
+    const Block& block = blocks_[i];
+    compressed_.resize(block.compressed_size);
+    uncompressed_.resize(block.uncompressed_size);
+
+    std::vector<char> sizes;
+    append_be32(&sizes, block.uncompressed_size);
+    append_be32(&sizes, block.compressed_size);
+
+    source_->pubseekpos(block.file_offset, std::ios_base::in);
+    bool ok =
+        source_->sgetn(compressed_.data(), compressed_.size()) ==
+            std::streamsize(compressed_.size()) &&
+        block_crc(sizes.data(), compressed_.data(), compressed_.size()) == block.crc &&
+        (compressed_.empty() ? uncompressed_.empty() : decompress(type_, compressed_, &uncompressed_));
+
+    if (!ok)
+    {
+        // present the damaged block as zeros so LogEntry::parse skips to the next magic word
+        glog.is_warn() && glog << "Compressed log block " << i << " is corrupt, skipping "
+                               << block.uncompressed_size << " bytes" << std::endl;
+        std::fill(uncompressed_.begin(), uncompressed_.end(), 0);
+    }
+
+    loaded_block_ = i;
+}
+
+CompressedLogIStreamBuf::int_type CompressedLogIStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    std::uint64_t pos = current_position();
+    if (pos >= uncompressed_size_)
+        scan_blocks();
+    if (pos >= uncompressed_size_)
+        return traits_type::eof();
+
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), pos,
+                               [](std::uint64_t p, const Block& block)
+                               { return p < block.uncompressed_offset; });
+    std::size_t i = (it - blocks_.begin()) - 1;
+    if (i != loaded_block_)
+        load_block(i);
+
+    buffer_offset_ = blocks_[i].uncompressed_offset;
+    char* base = uncompressed_.data();
+    setg(base, base + (pos - buffer_offset_), base + uncompressed_.size());
+
+    if (gptr() == egptr())
+        return traits_type::eof();
+    return traits_type::to_int_type(*gptr());
+}
+
+CompressedLogIStreamBuf::pos_type CompressedLogIStreamBuf::seekoff(off_type off,
+                                                                   std::ios_base::seekdir dir,
+                                                                   std::ios_base::openmode which)
+{
+    switch (dir)
+    {
+        case std::ios_base::beg: return seekpos(off, which);
+        case std::ios_base::cur: return seekpos(off_type(current_position()) + off, which);
+        case std::ios_base::end:
+            scan_blocks();
+            return seekpos(off_type(uncompressed_size_) + off, which);
+        default: return pos_type(off_type(-1));
+    }
+}
+
+CompressedLogIStreamBuf::pos_type CompressedLogIStreamBuf::seekpos(pos_type pos,
+                                                                   std::ios_base::openmode which)
+{
+    off_type target = pos;
+    if (!(which & std::ios_base::in) || target < 0)
+        return pos_type(off_type(-1));
+
+    if (std::uint64_t(target) > uncompressed_size_)
+        scan_blocks();
+    if (std::uint64_t(target) > uncompressed_size_)
+        return pos_type(off_type(-1));
+
+    // within the current buffer (common case for LogEntry::parse rewinding a few bytes)
+    if (eback() && std::uint64_t(target) >= buffer_offset_ &&
+        std::uint64_t(target) <= buffer_offset_ + (egptr() - eback()))
+    {
+        setg(eback(), eback() + (target - buffer_offset_), egptr());
+    }
+    else
+    {
+        // defer decompression to underflow()
+        buffer_offset_ = target;
+        setg(nullptr, nullptr, nullptr);
+    }
+    return pos;
+}
+
+LogOFStream::LogOFStream(const std::string& file_name, CompressionType compression,
+                         int compression_level, std::size_t block_size)
+    : std::ofstream(file_name.c_str(), std::ofstream::binary), compression_(compression)
+{
+    if (compression_ != CompressionType::NONE && is_open())
+    {
+        compressed_buf_.reset(new detail::CompressedLogOStreamBuf(
+            std::ofstream::rdbuf(), compression_, compression_level, block_size));
+        std::basic_ios<char>::rdbuf(compressed_buf_.get());
+    }
+}
+
+LogOFStream::~LogOFStream()
+{
+    if (compressed_buf_)
+        compressed_buf_->finish();
+}
+
+void LogOFStream::close()
+{
+    if (compressed_buf_)
+        compressed_buf_->finish();
+    std::ofstream::close();
+}
+
+void LogIFStream::open(const std::string& file_name)
+{
+    if (compressed_buf_)
+    {
+        std::basic_ios<char>::rdbuf(std::ifstream::rdbuf());
+        compressed_buf_.reset();
+    }
+
+    if (is_open())
+        std::ifstream::close();
+    std::ifstream::open(file_name.c_str(), std::ifstream::binary);
+    if (!is_open())
+        return;
+
+    std::filebuf* file_buf = std::ifstream::rdbuf();
+    std::string magic(CompressedLogFormat::file_magic.size(), '\0');
+    if (file_buf->sgetn(&magic[0], magic.size()) == std::streamsize(magic.size()) &&
+        magic == CompressedLogFormat::file_magic)
+    {
+        compressed_buf_.reset(new detail::CompressedLogIStreamBuf(file_buf));
+        std::basic_ios<char>::rdbuf(compressed_buf_.get());
+    }
+    else
+    {
+        file_buf->pubseekpos(0, std::ios_base::in);
+    }
+}
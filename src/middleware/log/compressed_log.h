@@ -0,0 +1,214 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_COMPRESSED_LOG_H
+#define GOBY_MIDDLEWARE_LOG_COMPRESSED_LOG_H
+
+#include <condition_variable> // for condition_variable
+#include <cstdint>            // for uint8_t, uint32_t, uint64_t
+#include <deque>              // for deque
+#include <fstream>            // for ifstream, ofstream
+#include <memory>             // for unique_ptr
+#include <mutex>              // for mutex
+#include <streambuf>          // for streambuf
+#include <string>             // for string
+#include <thread>             // for thread
+#include <vector>             // for vector
+
+namespace goby
+{
+namespace middleware
+{
+namespace log
+{
+/// \brief Compression algorithm for a compressed .goby container
+enum class CompressionType : std::uint8_t
+{
+    NONE = 0,
+    ZLIB = 1,
+    ZSTD = 2
+};
+
+/// \brief Returns true if Goby was compiled with support for the given compression type
+bool compression_available(CompressionType type);
+
+namespace detail
+{
+/// \brief Layout of the compressed .goby container
+///
+/// [file header: "GBYZ"][container version: 1][compression type: 1][reserved: 2]
+/// followed by any number of blocks:
+/// [block header: "GBZB"][uncompressed size: 4][compressed size: 4][crc32 of compressed data: 4][compressed data]
+///
+/// The concatenation of the uncompressed data of all the blocks is an ordinary (uncompressed) .goby file. All integers are big-endian (network byte order) as in LogEntry.
+struct CompressedLogFormat
+{
+    static const std::string file_magic;
+    static const std::string block_magic;
+    static constexpr int file_header_bytes{8};
+    static constexpr int block_header_bytes{16};
+    static constexpr std::uint8_t container_version{1};
+};
+
+/// \brief Buffers the uncompressed stream into blocks, which are compressed and written to \c sink by a background thread.
+class CompressedLogOStreamBuf : public std::streambuf
+{
+  public:
+    CompressedLogOStreamBuf(std::streambuf* sink, CompressionType type, int level,
+                            std::size_t block_size);
+    ~CompressedLogOStreamBuf() override;
+
+    /// \brief Compress and write any buffered data and stop the background thread. Called automatically by the destructor.
+    void finish();
+
+    /// \brief Total bytes given to this stream buffer
+    std::uint64_t uncompressed_bytes() const;
+    /// \brief Total bytes written to the sink (including headers) by the background thread
+    std::uint64_t compressed_bytes() const;
+
+  protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+  private:
+    void submit_block();
+    void compress_loop();
+
+  private:
+    std::streambuf* sink_;
+    CompressionType type_;
+    int level_;
+    std::size_t block_size_;
+    std::vector<char> block_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable compress_cv_;
+    std::condition_variable submit_cv_;
+    std::deque<std::vector<char>> queue_;
+    bool finish_{false};
+    std::uint64_t uncompressed_bytes_{0};
+    std::uint64_t compressed_bytes_{0};
+    std::unique_ptr<std::thread> compress_thread_;
+};
+
+/// \brief Presents the uncompressed contents of a compressed .goby container read from \c source, with support for seeking (only the block containing the new position is decompressed).
+class CompressedLogIStreamBuf : public std::streambuf
+{
+  public:
+    /// \param source Stream buffer positioned directly after the file magic word
+    CompressedLogIStreamBuf(std::streambuf* source);
+
+    struct Block
+    {
+        std::streamoff file_offset; // offset of compressed data in the container
+        std::uint32_t compressed_size;
+        std::uint32_t crc;
+        std::uint64_t uncompressed_offset; // offset in the uncompressed stream
+        std::uint32_t uncompressed_size;
+    };
+    const std::vector<Block>& blocks() const { return blocks_; }
+
+  protected:
+    int_type underflow() override;
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which = std::ios_base::in) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) override;
+
+  private:
+    // read any (new) complete block headers
+    void scan_blocks();
+    void load_block(std::size_t i);
+    std::uint64_t current_position() const { return buffer_offset_ + (gptr() - eback()); }
+
+  private:
+    std::streambuf* source_;
+    CompressionType type_{CompressionType::NONE};
+    std::vector<Block> blocks_;
+    // file offset of the next unscanned block header
+    std::streamoff scan_offset_{0};
+    std::uint64_t uncompressed_size_{0};
+
+    // uncompressed offset of eback()
+    std::uint64_t buffer_offset_{0};
+    // index of the block in uncompressed_
+    std::size_t loaded_block_{static_cast<std::size_t>(-1)};
+    std::vector<char> compressed_;
+    std::vector<char> uncompressed_;
+};
+} // namespace detail
+
+/// \brief Output file stream for .goby logs that optionally writes the compressed container (see detail::CompressedLogFormat), with compression performed on a background thread.
+///
+/// As this is a std::ofstream, it can be passed to LogPlugin::register_write_hooks and LogEntry::serialize directly.
+class LogOFStream : public std::ofstream
+{
+  public:
+    static constexpr int default_compression_level{-1};
+    static constexpr std::size_t default_block_size{1 << 20};
+
+    LogOFStream(const std::string& file_name, CompressionType compression = CompressionType::NONE,
+                int compression_level = default_compression_level,
+                std::size_t block_size = default_block_size);
+    ~LogOFStream() override;
+
+    /// \brief Flush any buffered blocks and close the file
+    void close();
+
+    CompressionType compression() const { return compression_; }
+    /// \brief Uncompressed bytes written so far (or 0 if not compressed)
+    std::uint64_t uncompressed_bytes() const
+    {
+        return compressed_buf_ ? compressed_buf_->uncompressed_bytes() : 0;
+    }
+    /// \brief Compressed bytes written so far (or 0 if not compressed)
+    std::uint64_t compressed_bytes() const
+    {
+        return compressed_buf_ ? compressed_buf_->compressed_bytes() : 0;
+    }
+
+  private:
+    CompressionType compression_;
+    std::unique_ptr<detail::CompressedLogOStreamBuf> compressed_buf_;
+};
+
+/// \brief Input file stream for .goby logs that transparently reads both uncompressed logs and the compressed container.
+///
+/// As this is a std::ifstream, it can be passed to LogPlugin::register_read_hooks and LogEntry::parse directly.
+class LogIFStream : public std::ifstream
+{
+  public:
+    LogIFStream() = default;
+    explicit LogIFStream(const std::string& file_name) { open(file_name); }
+
+    void open(const std::string& file_name);
+    bool is_compressed() const { return compressed_buf_ != nullptr; }
+
+  private:
+    std::unique_ptr<detail::CompressedLogIStreamBuf> compressed_buf_;
+};
+
+} // namespace log
+} // namespace middleware
+} // namespace goby
+
+#endif
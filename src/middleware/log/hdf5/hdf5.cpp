@@ -21,19 +21,18 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with Goby.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <cstddef> // for size_t
-#include <cstdint> // for uint64_t, int...
+#include <algorithm> // for copy, max
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t, int...
+#include <future>    // for async
 
 #include <boost/algorithm/string/classification.hpp>   // for is_any_ofF
 #include <boost/algorithm/string/predicate_facade.hpp> // for predicate_facade
 #include <boost/algorithm/string/split.hpp>            // for split
 #include <boost/algorithm/string/trim.hpp>             // for trim_copy_if
 
-#include <dccl/dynamic_protobuf_manager.h> // for DynamicProtob...
-
 #include "goby/exception.h"
 #include "goby/time/types.h" // for MicroTime
-#include "goby/util/dccl_compat.h"
 #include "goby/util/debug_logger.h"
 
 #include "hdf5.h"
@@ -88,7 +87,7 @@ goby::middleware::hdf5::GroupFactory::GroupWrapper::fetch_group(std::deque<std::
 
 goby::middleware::hdf5::Writer::Writer(const std::string& output_file, bool write_zero_length_dim,
                                        bool use_chunks, hsize_t chunk_length, bool use_compression,
-                                       int compression_level)
+                                       int compression_level, int extraction_threads)
     : h5file_(output_file, H5F_ACC_TRUNC),
       group_factory_(h5file_),
       write_zero_length_dim_(write_zero_length_dim),
@@ -96,10 +95,29 @@ goby::middleware::hdf5::Writer::Writer(const std::string& output_file, bool writ
       chunk_length_(chunk_length),
       use_compression_(use_compression),
       compression_level_(compression_level),
-      final_write_(false)
+      final_write_(false),
+      extraction_threads_(std::max(extraction_threads, 1))
 {
 }
 
+goby::middleware::hdf5::Writer::~Writer()
+{
+    // chunks that have been queued but not yet written
+    try
+    {
+        write_all_pending();
+    }
+    catch (const H5::Exception& e)
+    {
+        glog.is_warn() && glog << "Failed to write pending HDF5 data: " << e.getDetailMsg()
+                               << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        glog.is_warn() && glog << "Failed to write pending HDF5 data: " << e.what() << std::endl;
+    }
+}
+
 void goby::middleware::hdf5::Writer::add_entry(goby::middleware::HDF5ProtobufEntry entry)
 {
     if (final_write_)
@@ -127,16 +145,21 @@ void goby::middleware::hdf5::Writer::write(bool final_write)
     if (final_write_)
         throw(goby::Exception("write() called after final_write = true"));
 
-    final_write_ = final_write;
-    for (const auto& channel : channels_) write_channel(channel.second);
-}
-
-void goby::middleware::hdf5::Writer::write_channel(const goby::middleware::hdf5::Channel& channel)
-{
-    const auto& group = channel.group;
-    glog.is_verbose() && glog << "Writing HDF5 group: " << group << std::endl;
+    // finish any chunks still in progress before (possibly) changing to final_write
+    write_all_pending();
 
-    for (const auto& entry : channel.entries) write_message_collection(entry.second);
+    final_write_ = final_write;
+    for (auto& channel : channels_)
+    {
+        glog.is_verbose() && glog << "Writing HDF5 group: " << channel.second.group << std::endl;
+        for (auto& entry : channel.second.entries)
+        {
+            // no more entries can be added after the final write, so we can take the existing ones
+            if (!entry.second.entries.empty())
+                queue_message_collection(entry.second, final_write_);
+        }
+    }
+    write_all_pending();
 }
 
 void goby::middleware::hdf5::Writer::write_channel_chunk_and_clear(
@@ -146,230 +169,161 @@ void goby::middleware::hdf5::Writer::write_channel_chunk_and_clear(
     glog.is_verbose() && glog << "Writing HDF5 group: " << group << std::endl;
     for (auto& entry : channel.entries)
     {
-        if (entry.second.entries.size() >= chunk_length_)
-        {
-            write_message_collection(entry.second);
-            entry.second.entries.clear();
-        }
+        if (!entry.second.entries.empty() && entry.second.entries.size() >= chunk_length_)
+            queue_message_collection(entry.second, true);
     }
 }
 
-void goby::middleware::hdf5::Writer::write_message_collection(
-    const goby::middleware::hdf5::MessageCollection& message_collection)
+const goby::middleware::hdf5::ExtractionPlan&
+goby::middleware::hdf5::Writer::plan(const google::protobuf::Descriptor* desc)
 {
-    const auto& group = message_collection.group;
-    glog.is_verbose() && glog << "Writing HDF5 group: " << group << std::endl;
-    write_time(group, message_collection);
-    write_scheme(group, message_collection);
-
-    auto write_field = [&, this](const google::protobuf::FieldDescriptor* field_desc) {
-        std::vector<const google::protobuf::Message*> messages;
-        for (const auto& entry : message_collection.entries)
-        { messages.push_back(entry.second.msg.get()); }
-        std::vector<hsize_t> hs;
-        hs.push_back(messages.size());
-        write_field_selector(group, field_desc, messages, hs);
-    };
-
-    const google::protobuf::Descriptor* desc =
-        message_collection.entries.begin()->second.msg->GetDescriptor();
-    for (int i = 0, n = desc->field_count(); i < n; ++i)
+    auto it = plans_.find(desc);
+    if (it == plans_.end())
     {
-        const google::protobuf::FieldDescriptor* field_desc = desc->field(i);
-        write_field(field_desc);
+        glog.is_debug1() && glog << "Compiling HDF5 extraction plan for " << desc->full_name()
+                                 << std::endl;
+        it = plans_.insert(std::make_pair(desc, std::make_unique<ExtractionPlan>(desc))).first;
     }
-
-    std::vector<const google::protobuf::FieldDescriptor*> extensions;
-    google::protobuf::DescriptorPool::generated_pool()->FindAllExtensions(desc, &extensions);
-
-#ifdef DCCL_VERSION_4_1_OR_NEWER
-    dccl::DynamicProtobufManager::user_descriptor_pool_call(
-        &google::protobuf::DescriptorPool::FindAllExtensions, desc, &extensions);
-#else
-    dccl::DynamicProtobufManager::user_descriptor_pool().FindAllExtensions(desc, &extensions);
-#endif
-
-    for (auto field_desc : extensions) { write_field(field_desc); }
+    return *it->second;
 }
 
-void goby::middleware::hdf5::Writer::write_embedded_message(
-    const std::string& group, const google::protobuf::FieldDescriptor* field_desc,
-    const std::vector<const google::protobuf::Message*> messages, std::vector<hsize_t>& hs)
+void goby::middleware::hdf5::Writer::queue_message_collection(
+    goby::middleware::hdf5::MessageCollection& message_collection, bool take_entries)
 {
-    const google::protobuf::Descriptor* sub_desc = field_desc->message_type();
-    if (field_desc->is_repeated())
-    {
-        int max_field_size = 0;
-        for (auto message : messages)
-        {
-            if (message)
-            {
-                const google::protobuf::Reflection* refl = message->GetReflection();
-                int field_size = refl->FieldSize(*message, field_desc);
-                if (field_size > max_field_size)
-                    max_field_size = field_size;
-            }
-        }
-
-        hs.push_back(max_field_size);
+    pending_.emplace_back();
+    PendingWrite& pending = pending_.back();
+    pending.collection = &message_collection;
+    if (take_entries)
+        pending.entries.swap(message_collection.entries);
+    else
+        pending.entries = message_collection.entries;
 
-        auto write_field = [&, this](const google::protobuf::FieldDescriptor* sub_field_desc) {
-            std::vector<const google::protobuf::Message*> sub_messages(
-                messages.size() * max_field_size, (const google::protobuf::Message*)nullptr);
+    pending.plan = &plan(pending.entries.begin()->second.msg->GetDescriptor());
 
-            bool has_submessages = false;
-            for (unsigned i = 0, n = messages.size(); i < n; ++i)
-            {
-                if (messages[i])
-                {
-                    const google::protobuf::Reflection* refl = messages[i]->GetReflection();
-                    int field_size = refl->FieldSize(*messages[i], field_desc);
-
-                    for (int j = 0; j < field_size; ++j)
-                    {
-                        const google::protobuf::Message& sub_msg =
-                            refl->GetRepeatedMessage(*messages[i], field_desc, j);
-                        sub_messages[i * max_field_size + j] = &sub_msg;
-                    }
-                    has_submessages = true;
-                }
-            }
+    std::unique_ptr<ColumnBuffers> columns;
+    if (message_collection.spare_columns.empty())
+    {
+        columns = std::make_unique<ColumnBuffers>();
+    }
+    else
+    {
+        columns = std::move(message_collection.spare_columns.back());
+        message_collection.spare_columns.pop_back();
+    }
 
-            if (has_submessages) // don't recurse unless one or more message requires it
-                write_field_selector(
-                    group + "/" +
-                        (field_desc->is_extension() ? field_desc->full_name() : field_desc->name()),
-                    sub_field_desc, sub_messages, hs);
-        };
+    std::vector<const google::protobuf::Message*> messages;
+    messages.reserve(pending.entries.size());
+    for (const auto& entry : pending.entries) messages.push_back(entry.second.msg.get());
 
-        for (int i = 0, n = sub_desc->field_count(); i < n; ++i)
-        {
-            const google::protobuf::FieldDescriptor* sub_field_desc = sub_desc->field(i);
-            write_field(sub_field_desc);
-        }
+    // the messages are owned by pending.entries, which outlives the future
+    auto extract = [plan = pending.plan, messages = std::move(messages),
+                    columns = std::move(columns)]() mutable {
+        plan->extract(messages, columns.get());
+        return std::move(columns);
+    };
 
-        std::vector<const google::protobuf::FieldDescriptor*> extensions;
-        google::protobuf::DescriptorPool::generated_pool()->FindAllExtensions(sub_desc,
-                                                                              &extensions);
-#ifdef DCCL_VERSION_4_1_OR_NEWER
-        dccl::DynamicProtobufManager::user_descriptor_pool_call(
-            &google::protobuf::DescriptorPool::FindAllExtensions, sub_desc, &extensions);
-#else
-        dccl::DynamicProtobufManager::user_descriptor_pool().FindAllExtensions(sub_desc,
-                                                                               &extensions);
+    // with one thread, extract when written
+    pending.columns = std::async(extraction_threads_ > 1 ? std::launch::async
+                                                          : std::launch::deferred,
+                                 std::move(extract));
 
-#endif
-        for (auto sub_field_desc : extensions) { write_field(sub_field_desc); }
+    while (static_cast<int>(pending_.size()) >= extraction_threads_) write_next_pending();
+}
 
-        hs.pop_back();
+void goby::middleware::hdf5::Writer::write_next_pending()
+{
+    std::unique_ptr<ColumnBuffers> columns;
+    try
+    {
+        columns = pending_.front().columns.get();
     }
-    else
+    catch (...)
     {
-        auto write_field = [&, this](const google::protobuf::FieldDescriptor* sub_field_desc) {
-            std::vector<const google::protobuf::Message*> sub_messages;
+        pending_.pop_front();
+        throw;
+    }
 
-            bool has_submessages = false;
+    PendingWrite pending = std::move(pending_.front());
+    pending_.pop_front();
 
-            for (auto message : messages)
-            {
-                if (message)
-                {
-                    const google::protobuf::Reflection* refl = message->GetReflection();
-                    const google::protobuf::Message& sub_msg =
-                        refl->GetMessage(*message, field_desc);
-                    sub_messages.push_back(&sub_msg);
-                    has_submessages = true;
-                }
-                else
-                {
-                    sub_messages.push_back(nullptr);
-                }
-            }
-
-            if (has_submessages)
-                write_field_selector(
-                    group + "/" +
-                        (field_desc->is_extension() ? field_desc->full_name() : field_desc->name()),
-                    sub_field_desc, sub_messages, hs);
-        };
+    write_message_collection(*pending.collection, pending.entries, *pending.plan, *columns);
 
-        for (int i = 0, n = sub_desc->field_count(); i < n; ++i)
-        {
-            const google::protobuf::FieldDescriptor* sub_field_desc = sub_desc->field(i);
-            write_field(sub_field_desc);
-        }
+    // keep the buffers for the next chunk, unless this was the last one
+    if (!final_write_)
+        pending.collection->spare_columns.push_back(std::move(columns));
+}
 
-        std::vector<const google::protobuf::FieldDescriptor*> extensions;
-        google::protobuf::DescriptorPool::generated_pool()->FindAllExtensions(sub_desc,
-                                                                              &extensions);
-#ifdef DCCL_VERSION_4_1_OR_NEWER
-        dccl::DynamicProtobufManager::user_descriptor_pool_call(
-            &google::protobuf::DescriptorPool::FindAllExtensions, sub_desc, &extensions);
-#else
-        dccl::DynamicProtobufManager::user_descriptor_pool().FindAllExtensions(sub_desc,
-                                                                               &extensions);
-#endif
-        for (auto sub_field_desc : extensions) { write_field(sub_field_desc); }
-    }
+void goby::middleware::hdf5::Writer::write_all_pending()
+{
+    while (!pending_.empty()) write_next_pending();
 }
 
-void goby::middleware::hdf5::Writer::write_field_selector(
-    const std::string& group, const google::protobuf::FieldDescriptor* field_desc,
-    const std::vector<const google::protobuf::Message*>& messages, std::vector<hsize_t>& hs)
+void goby::middleware::hdf5::Writer::write_message_collection(
+    const goby::middleware::hdf5::MessageCollection& message_collection, const Entries& entries,
+    const ExtractionPlan& plan, ColumnBuffers& columns)
 {
-    glog.is_debug1() && glog << "Writing HDF5 group: " << group << std::endl;
-    glog.is_debug1() && glog << "Writing field \"" << field_desc->name()
-                             << "\" (size: " << dim_str(hs) << ")" << std::endl;
+    const auto& group = message_collection.group;
+    glog.is_verbose() && glog << "Writing HDF5 group: " << group << std::endl;
+    write_time(group, entries);
+    write_scheme(group, entries);
 
-    switch (field_desc->cpp_type())
+    const auto& nodes = plan.nodes();
+    for (int i = 0, n = nodes.size(); i < n; ++i)
     {
-        case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
-            if (field_desc->message_type()->full_name() == "google.protobuf.FileDescriptorProto")
-                glog.is_warn() && glog << "Omitting google.protobuf.FileDescriptorProto"
-                                       << std::endl;
-            else
-                write_embedded_message(group, field_desc, messages, hs);
-            break;
-
-        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
-        {
-            // google uses int for the enum value type, we'll assume that's an int32 here
-            write_field<std::int32_t>(group, field_desc, messages, hs);
-            write_enum_attributes(group, field_desc);
-            break;
-        }
-
-        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
-            write_field<std::int32_t>(group, field_desc, messages, hs);
-            break;
-
-        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
-            write_field<std::int64_t>(group, field_desc, messages, hs);
-            break;
+        if (!columns.present(i))
+            continue;
 
-        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
-            write_field<std::uint32_t>(group, field_desc, messages, hs);
-            break;
+        const ExtractionPlan::Node& node = nodes[i];
+        const std::string field_group = group + node.group;
+        const std::vector<hsize_t>& hs = columns.dims(i);
 
-        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
-            write_field<std::uint64_t>(group, field_desc, messages, hs);
-            break;
+        auto write_column = [&](const auto& values) {
+            using T = typename std::decay<decltype(values)>::type::value_type;
 
-        case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
-            write_field<unsigned char>(group, field_desc, messages, hs);
-            break;
+            glog.is_debug1() && glog << "Writing HDF5 group: " << field_group << std::endl;
+            glog.is_debug1() && glog << "Writing field \"" << node.field_desc->name()
+                                     << "\" (size: " << dim_str(hs) << ")" << std::endl;
 
-        case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
-            write_field<std::string>(group, field_desc, messages, hs);
-            break;
-
-        case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
-            write_field<float>(group, field_desc, messages, hs);
-            break;
+            T default_value;
+            retrieve_default_value(&default_value, node.field_desc);
+            write_vector(field_group, node.field_desc->name(), values, hs, default_value);
+        };
 
-        case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
-            write_field<double>(group, field_desc, messages, hs);
-            break;
+        switch (node.type)
+        {
+            case ExtractionPlan::NodeType::MESSAGE:
+            case ExtractionPlan::NodeType::OMITTED: break;
+
+            case ExtractionPlan::NodeType::ENUM:
+                write_column(columns.values<std::int32_t>(node.column));
+                write_enum_attributes(field_group, node.field_desc);
+                break;
+
+            case ExtractionPlan::NodeType::INT32:
+                write_column(columns.values<std::int32_t>(node.column));
+                break;
+            case ExtractionPlan::NodeType::INT64:
+                write_column(columns.values<std::int64_t>(node.column));
+                break;
+            case ExtractionPlan::NodeType::UINT32:
+                write_column(columns.values<std::uint32_t>(node.column));
+                break;
+            case ExtractionPlan::NodeType::UINT64:
+                write_column(columns.values<std::uint64_t>(node.column));
+                break;
+            case ExtractionPlan::NodeType::BOOL:
+                write_column(columns.values<unsigned char>(node.column));
+                break;
+            case ExtractionPlan::NodeType::STRING:
+                write_column(columns.values<std::string>(node.column));
+                break;
+            case ExtractionPlan::NodeType::FLOAT:
+                write_column(columns.values<float>(node.column));
+                break;
+            case ExtractionPlan::NodeType::DOUBLE:
+                write_column(columns.values<double>(node.column));
+                break;
+        }
     }
 }
 
@@ -417,16 +371,14 @@ void goby::middleware::hdf5::Writer::write_enum_attributes(
     }
 }
 
-void goby::middleware::hdf5::Writer::write_time(
-    const std::string& group, const goby::middleware::hdf5::MessageCollection& message_collection)
+void goby::middleware::hdf5::Writer::write_time(const std::string& group, const Entries& entries)
 {
-    glog.is_debug1() && glog << "Writing time (size: " << message_collection.entries.size() << ")"
-                             << std::endl;
+    glog.is_debug1() && glog << "Writing time (size: " << entries.size() << ")" << std::endl;
 
-    std::vector<std::uint64_t> utime(message_collection.entries.size(), 0);
-    std::vector<double> datenum(message_collection.entries.size(), 0);
+    std::vector<std::uint64_t> utime(entries.size(), 0);
+    std::vector<double> datenum(entries.size(), 0);
     int i = 0;
-    for (const auto& entry : message_collection.entries)
+    for (const auto& entry : entries)
     {
         utime[i] = entry.first;
         // datenum(1970, 1, 1, 0, 0, 0)
@@ -440,27 +392,25 @@ void goby::middleware::hdf5::Writer::write_time(
     }
 
     std::vector<hsize_t> hs;
-    hs.push_back(message_collection.entries.size());
+    hs.push_back(entries.size());
     write_vector(group, "_utime_", utime, hs, (std::uint64_t)0);
     write_vector(group, "_datenum_", datenum, hs, (double)0);
 }
 
-void goby::middleware::hdf5::Writer::write_scheme(
-    const std::string& group, const goby::middleware::hdf5::MessageCollection& message_collection)
+void goby::middleware::hdf5::Writer::write_scheme(const std::string& group, const Entries& entries)
 {
-    glog.is_debug1() && glog << "Writing scheme (size: " << message_collection.entries.size() << ")"
-                             << std::endl;
+    glog.is_debug1() && glog << "Writing scheme (size: " << entries.size() << ")" << std::endl;
 
-    std::vector<int> scheme(message_collection.entries.size(), 0);
+    std::vector<int> scheme(entries.size(), 0);
     int i = 0;
-    for (const auto& entry : message_collection.entries)
+    for (const auto& entry : entries)
     {
         scheme[i] = entry.second.scheme;
         ++i;
     }
 
     std::vector<hsize_t> hs;
-    hs.push_back(message_collection.entries.size());
+    hs.push_back(entries.size());
     write_vector(group, "_scheme_", scheme, hs, (int)0);
 }
 
@@ -470,10 +420,11 @@ void goby::middleware::hdf5::Writer::write_vector(const std::string& group,
                                                   const std::vector<hsize_t>& hs_outer,
                                                   const std::string& default_value)
 {
-    std::vector<char> data_char;
+    std::vector<char>& data_char = string_buffer_;
     std::vector<hsize_t> hs = hs_outer;
 
     std::vector<std::uint32_t> sizes;
+    sizes.reserve(data.size());
     size_t max_size = 0;
     for (const auto& i : data)
     {
@@ -483,11 +434,9 @@ void goby::middleware::hdf5::Writer::write_vector(const std::string& group,
     }
 
     char fill_value = '\0';
-    for (auto d : data)
-    {
-        d.resize(max_size, fill_value);
-        for (char c : d) data_char.push_back(c);
-    }
+    data_char.assign(data.size() * max_size, fill_value);
+    for (std::size_t i = 0, n = data.size(); i < n; ++i)
+        std::copy(data[i].begin(), data[i].end(), data_char.begin() + i * max_size);
     hs.push_back(max_size);
 
     glog.is_debug1() && glog << "Writing string field \"" << dataset_name
@@ -27,6 +27,7 @@
 #include <algorithm> // for max
 #include <cstdint>   // for uint64_t
 #include <deque>     // for deque
+#include <future>    // for future
 #include <map>       // for map, multimap
 #include <memory>    // for shared_ptr
 #include <string>    // for string
@@ -37,6 +38,9 @@
 #include <google/protobuf/descriptor.h> // for FieldDescriptor
 #include <google/protobuf/message.h>    // for Message, Reflection
 
+#include "goby/util/debug_logger.h"
+
+#include "hdf5_plan.h"            // for ExtractionPlan, ColumnBuffers
 #include "hdf5_predicate.h"       // for predicate
 #include "hdf5_protobuf_values.h" // for PBMeta, retrieve_default_value
 
@@ -59,6 +63,9 @@ struct MessageCollection
 
     // time -> ProtobufEntry
     std::multimap<std::uint64_t, HDF5ProtobufEntry> entries;
+
+    // column buffers from previously written batches, to be reused
+    std::vector<std::unique_ptr<ColumnBuffers>> spare_columns;
 };
 
 struct Channel
@@ -107,41 +114,48 @@ class GroupFactory
 class Writer
 {
   public:
+    /// \param extraction_threads Number of threads (including the calling thread) used to extract the message fields into columns. If greater than one, batches (chunks) of messages are extracted in the background while further entries are added, and written (in order) as they complete.
     Writer(const std::string& output_file, bool write_zero_length_dim = true,
            bool use_chunks = false, hsize_t chunk_length = 0, bool use_compression = false,
-           int compression_level = 0);
+           int compression_level = 0, int extraction_threads = 1);
+    ~Writer();
 
     void add_entry(goby::middleware::HDF5ProtobufEntry entry);
 
     void write(bool final_write = true);
 
   private:
-    void write_channel(const goby::middleware::hdf5::Channel& channel);
+    using Entries = std::multimap<std::uint64_t, HDF5ProtobufEntry>;
+
+    // a batch of messages from a single MessageCollection waiting to be written
+    struct PendingWrite
+    {
+        goby::middleware::hdf5::MessageCollection* collection{nullptr};
+        const ExtractionPlan* plan{nullptr};
+        Entries entries;
+        // destroyed first so that the extraction is complete before the entries are destroyed
+        std::future<std::unique_ptr<ColumnBuffers>> columns;
+    };
+
     void write_channel_chunk_and_clear(goby::middleware::hdf5::Channel& channel);
-    void
-    write_message_collection(const goby::middleware::hdf5::MessageCollection& message_collection);
-    void write_time(const std::string& group,
-                    const goby::middleware::hdf5::MessageCollection& message_collection);
-    void write_scheme(const std::string& group,
-                      const goby::middleware::hdf5::MessageCollection& message_collection);
 
-    void write_field_selector(const std::string& group,
-                              const google::protobuf::FieldDescriptor* field_desc,
-                              const std::vector<const google::protobuf::Message*>& messages,
-                              std::vector<hsize_t>& hs);
+    // starts extracting the collection's messages (moving them out of the collection if take_entries is true, otherwise copying them)
+    void queue_message_collection(goby::middleware::hdf5::MessageCollection& message_collection,
+                                  bool take_entries);
+    void write_next_pending();
+    void write_all_pending();
 
-    void write_enum_attributes(const std::string& group,
-                               const google::protobuf::FieldDescriptor* field_desc);
+    const ExtractionPlan& plan(const google::protobuf::Descriptor* desc);
 
-    template <typename T>
-    void write_field(const std::string& group, const google::protobuf::FieldDescriptor* field_desc,
-                     const std::vector<const google::protobuf::Message*>& messages,
-                     std::vector<hsize_t>& hs);
+    void
+    write_message_collection(const goby::middleware::hdf5::MessageCollection& message_collection,
+                             const Entries& entries, const ExtractionPlan& plan,
+                             ColumnBuffers& columns);
+    void write_time(const std::string& group, const Entries& entries);
+    void write_scheme(const std::string& group, const Entries& entries);
 
-    void write_embedded_message(const std::string& group,
-                                const google::protobuf::FieldDescriptor* field_desc,
-                                const std::vector<const google::protobuf::Message*> messages,
-                                std::vector<hsize_t>& hs);
+    void write_enum_attributes(const std::string& group,
+                               const google::protobuf::FieldDescriptor* field_desc);
 
     template <typename T>
     void write_vector(const std::string& group, const std::string dataset_name,
@@ -171,70 +185,14 @@ class Writer
     bool use_compression_;
     int compression_level_;
     bool final_write_;
-};
-
-template <typename T>
-void Writer::write_field(const std::string& group,
-                         const google::protobuf::FieldDescriptor* field_desc,
-                         const std::vector<const google::protobuf::Message*>& messages,
-                         std::vector<hsize_t>& hs)
-{
-    if (field_desc->is_repeated())
-    {
-        // pass one to figure out field size
-        int max_field_size = 0;
-        for (auto message : messages)
-        {
-            if (message)
-            {
-                const google::protobuf::Reflection* refl = message->GetReflection();
-                int field_size = refl->FieldSize(*message, field_desc);
-                if (field_size > max_field_size)
-                    max_field_size = field_size;
-            }
-        }
-
-        hs.push_back(max_field_size);
+    int extraction_threads_;
 
-        std::vector<T> values(messages.size() * max_field_size, retrieve_empty_value<T>());
+    std::map<const google::protobuf::Descriptor*, std::unique_ptr<ExtractionPlan>> plans_;
+    std::deque<PendingWrite> pending_;
 
-        for (unsigned i = 0, n = messages.size(); i < n; ++i)
-        {
-            if (messages[i])
-            {
-                const google::protobuf::Reflection* refl = messages[i]->GetReflection();
-                int field_size = refl->FieldSize(*messages[i], field_desc);
-                for (int j = 0; j < field_size; ++j)
-                    retrieve_repeated_value<T>(&values[i * max_field_size + j], j,
-                                               PBMeta(refl, field_desc, (*messages[i])));
-            }
-        }
-
-        T default_value;
-        retrieve_default_value(&default_value, field_desc);
-
-        write_vector(group, field_desc->name(), values, hs, default_value);
-
-        hs.pop_back();
-    }
-    else
-    {
-        std::vector<T> values(messages.size(), retrieve_empty_value<T>());
-        for (unsigned i = 0, n = messages.size(); i < n; ++i)
-        {
-            if (messages[i])
-            {
-                const google::protobuf::Reflection* refl = messages[i]->GetReflection();
-                retrieve_single_value<T>(&values[i], PBMeta(refl, field_desc, (*messages[i])));
-            }
-        }
-
-        T default_value;
-        retrieve_default_value(&default_value, field_desc);
-
-        write_vector(group, field_desc->name(), values, hs, default_value);
-    }
-}
+    // reused for converting string columns
+    std::vector<char> string_buffer_;
+};
 
 template <typename T>
 void Writer::write_vector(const std::string& group, const std::string dataset_name,
@@ -0,0 +1,411 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm> // for find, max
+
+#include <dccl/dynamic_protobuf_manager.h> // for DynamicProtob...
+
+#include "goby/util/dccl_compat.h"
+#include "goby/util/debug_logger.h"
+
+#include "hdf5_plan.h"
+#include "hdf5_protobuf_values.h" // for retrieve_empty_value
+
+using goby::glog;
+using goby::middleware::hdf5::ExtractionPlan;
+
+namespace
+{
+// index into ExtractionPlan::column_count_ (the value columns use the order of ColumnBuffers::values_)
+constexpr int message_column_index = 8;
+int column_index(ExtractionPlan::NodeType type)
+{
+    switch (type)
+    {
+        case ExtractionPlan::NodeType::INT32:
+        case ExtractionPlan::NodeType::ENUM: return 0;
+        case ExtractionPlan::NodeType::INT64: return 1;
+        case ExtractionPlan::NodeType::UINT32: return 2;
+        case ExtractionPlan::NodeType::UINT64: return 3;
+        case ExtractionPlan::NodeType::BOOL: return 4;
+        case ExtractionPlan::NodeType::STRING: return 5;
+        case ExtractionPlan::NodeType::FLOAT: return 6;
+        case ExtractionPlan::NodeType::DOUBLE: return 7;
+        case ExtractionPlan::NodeType::MESSAGE: return message_column_index;
+        case ExtractionPlan::NodeType::OMITTED: break;
+    }
+    return -1;
+}
+
+std::vector<const google::protobuf::FieldDescriptor*>
+find_extensions(const google::protobuf::Descriptor* desc)
+{
+    std::vector<const google::protobuf::FieldDescriptor*> extensions;
+    google::protobuf::DescriptorPool::generated_pool()->FindAllExtensions(desc, &extensions);
+#ifdef DCCL_VERSION_4_1_OR_NEWER
+    dccl::DynamicProtobufManager::user_descriptor_pool_call(
+        &google::protobuf::DescriptorPool::FindAllExtensions, desc, &extensions);
+#else
+    dccl::DynamicProtobufManager::user_descriptor_pool().FindAllExtensions(desc, &extensions);
+#endif
+
+    // an extension may be found in both pools (if the user pool is layered on the generated pool)
+    std::vector<const google::protobuf::FieldDescriptor*> unique_extensions;
+    for (auto extension : extensions)
+    {
+        if (std::find(unique_extensions.begin(), unique_extensions.end(), extension) ==
+            unique_extensions.end())
+            unique_extensions.push_back(extension);
+    }
+    return unique_extensions;
+}
+
+template <typename T> void resize_columns(std::vector<std::vector<T>>& columns, int count)
+{
+    if (static_cast<int>(columns.size()) != count)
+        columns.resize(count);
+}
+
+// fills values (and dims) for a scalar field of the parent messages, using get (singular) to read each value or get_repeated to read each message's values
+template <typename T, typename Get, typename GetRepeated>
+void extract_column(const std::vector<const google::protobuf::Message*>& parents,
+                    const std::vector<hsize_t>& parent_dims,
+                    const google::protobuf::FieldDescriptor* field_desc, bool check_presence,
+                    std::vector<hsize_t>& dims, std::vector<T>& values, Get get,
+                    GetRepeated get_repeated)
+{
+    const T empty_value = goby::middleware::hdf5::retrieve_empty_value<T>();
+    dims = parent_dims;
+    if (field_desc->is_repeated())
+    {
+        int max_field_size = 0;
+        for (auto message : parents)
+        {
+            if (message)
+                max_field_size = std::max(
+                    max_field_size, message->GetReflection()->FieldSize(*message, field_desc));
+        }
+        dims.push_back(max_field_size);
+        values.assign(parents.size() * max_field_size, empty_value);
+
+        for (std::size_t i = 0, n = parents.size(); i < n; ++i)
+        {
+            if (parents[i])
+            {
+                get_repeated(parents[i]->GetReflection(), *parents[i], field_desc,
+                             &values[i * max_field_size]);
+            }
+        }
+    }
+    else
+    {
+        values.assign(parents.size(), empty_value);
+        for (std::size_t i = 0, n = parents.size(); i < n; ++i)
+        {
+            if (parents[i])
+            {
+                const google::protobuf::Reflection* refl = parents[i]->GetReflection();
+                if (!check_presence || refl->HasField(*parents[i], field_desc))
+                    get(refl, *parents[i], field_desc, &values[i]);
+            }
+        }
+    }
+}
+
+using Refl = google::protobuf::Reflection;
+using Msg = google::protobuf::Message;
+using Field = google::protobuf::FieldDescriptor;
+
+// reads all the values of a repeated field (through a single reference to the field, rather than looking up the field for each value)
+template <typename FieldType, typename T>
+void get_repeated_values(const Refl* r, const Msg& m, const Field* f, T* row)
+{
+    const auto field = r->GetRepeatedFieldRef<FieldType>(m, f);
+    for (int j = 0, n = field.size(); j < n; ++j) row[j] = field.Get(j);
+}
+
+} // namespace
+
+goby::middleware::hdf5::ExtractionPlan::ExtractionPlan(const google::protobuf::Descriptor* desc)
+    : desc_(desc), column_count_(message_column_index + 1, 0)
+{
+    std::vector<const google::protobuf::Descriptor*> stack;
+    add_fields(desc, "", -1, stack);
+}
+
+void goby::middleware::hdf5::ExtractionPlan::add_fields(
+    const google::protobuf::Descriptor* desc, const std::string& group, int parent,
+    std::vector<const google::protobuf::Descriptor*>& stack)
+{
+    stack.push_back(desc);
+    for (int i = 0, n = desc->field_count(); i < n; ++i)
+        add_field(desc->field(i), group, parent, stack);
+    for (auto field_desc : find_extensions(desc)) add_field(field_desc, group, parent, stack);
+    stack.pop_back();
+}
+
+void goby::middleware::hdf5::ExtractionPlan::add_field(
+    const google::protobuf::FieldDescriptor* field_desc, const std::string& group, int parent,
+    std::vector<const google::protobuf::Descriptor*>& stack)
+{
+    Node node;
+    node.field_desc = field_desc;
+    node.group = group;
+    node.parent = parent;
+
+    switch (field_desc->cpp_type())
+    {
+        case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+            if (field_desc->message_type()->full_name() == "google.protobuf.FileDescriptorProto")
+            {
+                glog.is_warn() && glog << "Omitting google.protobuf.FileDescriptorProto"
+                                       << std::endl;
+            }
+            else if (std::find(stack.begin(), stack.end(), field_desc->message_type()) !=
+                     stack.end())
+            {
+                glog.is_warn() && glog << "Omitting recursive field \""
+                                       << field_desc->full_name() << "\"" << std::endl;
+            }
+            else
+            {
+                node.type = NodeType::MESSAGE;
+            }
+            break;
+
+        // google uses int for the enum value type, we'll assume that's an int32 here
+        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: node.type = NodeType::ENUM; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT32: node.type = NodeType::INT32; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT64: node.type = NodeType::INT64; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: node.type = NodeType::UINT32; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: node.type = NodeType::UINT64; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: node.type = NodeType::BOOL; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_STRING: node.type = NodeType::STRING; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: node.type = NodeType::FLOAT; break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: node.type = NodeType::DOUBLE; break;
+    }
+
+    if (node.type != NodeType::OMITTED)
+        node.column = column_count_[column_index(node.type)]++;
+
+    nodes_.push_back(node);
+
+    if (node.type == NodeType::MESSAGE)
+        add_fields(field_desc->message_type(),
+                   group + "/" +
+                       (field_desc->is_extension() ? field_desc->full_name() : field_desc->name()),
+                   nodes_.size() - 1, stack);
+}
+
+void goby::middleware::hdf5::ExtractionPlan::extract(
+    const std::vector<const google::protobuf::Message*>& messages, ColumnBuffers* buffers) const
+{
+    buffers->nodes_.resize(nodes_.size());
+    buffers->submessages_.resize(column_count_[message_column_index]);
+    resize_columns(std::get<0>(buffers->values_), column_count_[0]);
+    resize_columns(std::get<1>(buffers->values_), column_count_[1]);
+    resize_columns(std::get<2>(buffers->values_), column_count_[2]);
+    resize_columns(std::get<3>(buffers->values_), column_count_[3]);
+    resize_columns(std::get<4>(buffers->values_), column_count_[4]);
+    resize_columns(std::get<5>(buffers->values_), column_count_[5]);
+    resize_columns(std::get<6>(buffers->values_), column_count_[6]);
+    resize_columns(std::get<7>(buffers->values_), column_count_[7]);
+
+    const std::vector<hsize_t> root_dims(1, messages.size());
+
+    for (int i = 0, n = nodes_.size(); i < n; ++i)
+    {
+        const Node& node = nodes_[i];
+        ColumnBuffers::NodeState& state = buffers->nodes_[i];
+
+        const std::vector<const google::protobuf::Message*>* parents = &messages;
+        const std::vector<hsize_t>* parent_dims = &root_dims;
+        state.present = true;
+        if (node.parent >= 0)
+        {
+            const ColumnBuffers::NodeState& parent_state = buffers->nodes_[node.parent];
+            // as before, fields of an embedded message are written if any of the enclosing messages exist
+            state.present = parent_state.present && parent_state.expanded;
+            parents = &buffers->submessages_[nodes_[node.parent].column];
+            parent_dims = &parent_state.dims;
+        }
+        state.expanded = false;
+
+        if (!state.present)
+            continue;
+
+        const bool check_presence = node.field_desc->is_optional();
+        switch (node.type)
+        {
+            case NodeType::MESSAGE:
+                extract_message(node, *parents, *parent_dims, state, buffers);
+                break;
+
+            case NodeType::OMITTED: state.present = false; break;
+
+            case NodeType::ENUM:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<std::int32_t>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, std::int32_t* v) {
+                        *v = r->GetEnum(m, f)->number();
+                    },
+                    get_repeated_values<std::int32_t, std::int32_t>);
+                break;
+
+            case NodeType::INT32:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<std::int32_t>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, std::int32_t* v) {
+                        *v = r->GetInt32(m, f);
+                    },
+                    get_repeated_values<std::int32_t, std::int32_t>);
+                break;
+
+            case NodeType::INT64:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<std::int64_t>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, std::int64_t* v) {
+                        *v = r->GetInt64(m, f);
+                    },
+                    get_repeated_values<std::int64_t, std::int64_t>);
+                break;
+
+            case NodeType::UINT32:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<std::uint32_t>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, std::uint32_t* v) {
+                        *v = r->GetUInt32(m, f);
+                    },
+                    get_repeated_values<std::uint32_t, std::uint32_t>);
+                break;
+
+            case NodeType::UINT64:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<std::uint64_t>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, std::uint64_t* v) {
+                        *v = r->GetUInt64(m, f);
+                    },
+                    get_repeated_values<std::uint64_t, std::uint64_t>);
+                break;
+
+            case NodeType::BOOL:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<unsigned char>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, unsigned char* v) {
+                        *v = r->GetBool(m, f);
+                    },
+                    get_repeated_values<bool, unsigned char>);
+                break;
+
+            case NodeType::STRING:
+                // unset strings are written as their default value rather than empty
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, false, state.dims,
+                    buffers->values<std::string>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, std::string* v) {
+                        // assigning into the existing string reuses its storage
+                        *v = r->GetStringReference(m, f, v);
+                    },
+                    [](const Refl* r, const Msg& m, const Field* f, std::string* row) {
+                        for (int j = 0, n = r->FieldSize(m, f); j < n; ++j)
+                            row[j] = r->GetRepeatedStringReference(m, f, j, &row[j]);
+                    });
+                break;
+
+            case NodeType::FLOAT:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<float>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, float* v) {
+                        *v = r->GetFloat(m, f);
+                    },
+                    get_repeated_values<float, float>);
+                break;
+
+            case NodeType::DOUBLE:
+                extract_column(
+                    *parents, *parent_dims, node.field_desc, check_presence, state.dims,
+                    buffers->values<double>(node.column),
+                    [](const Refl* r, const Msg& m, const Field* f, double* v) {
+                        *v = r->GetDouble(m, f);
+                    },
+                    get_repeated_values<double, double>);
+                break;
+        }
+    }
+}
+
+void goby::middleware::hdf5::ExtractionPlan::extract_message(
+    const Node& node, const std::vector<const google::protobuf::Message*>& parents,
+    const std::vector<hsize_t>& parent_dims, ColumnBuffers::NodeState& state,
+    ColumnBuffers* buffers) const
+{
+    std::vector<const google::protobuf::Message*>& sub_messages =
+        buffers->submessages_[node.column];
+    const google::protobuf::FieldDescriptor* field_desc = node.field_desc;
+
+    state.dims = parent_dims;
+    if (field_desc->is_repeated())
+    {
+        int max_field_size = 0;
+        for (auto message : parents)
+        {
+            if (message)
+                max_field_size = std::max(
+                    max_field_size, message->GetReflection()->FieldSize(*message, field_desc));
+        }
+        state.dims.push_back(max_field_size);
+        sub_messages.assign(parents.size() * max_field_size, nullptr);
+
+        for (std::size_t i = 0, n = parents.size(); i < n; ++i)
+        {
+            if (parents[i])
+            {
+                const google::protobuf::Reflection* refl = parents[i]->GetReflection();
+                for (int j = 0, m = refl->FieldSize(*parents[i], field_desc); j < m; ++j)
+                    sub_messages[i * max_field_size + j] =
+                        &refl->GetRepeatedMessage(*parents[i], field_desc, j);
+                state.expanded = true;
+            }
+        }
+    }
+    else
+    {
+        sub_messages.assign(parents.size(), nullptr);
+        for (std::size_t i = 0, n = parents.size(); i < n; ++i)
+        {
+            if (parents[i])
+            {
+                sub_messages[i] =
+                    &parents[i]->GetReflection()->GetMessage(*parents[i], field_desc);
+                state.expanded = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_HDF5_HDF5_PLAN_H
+#define GOBY_MIDDLEWARE_LOG_HDF5_HDF5_PLAN_H
+
+#include <cstdint> // for int32_t, uint64_t
+#include <string>  // for string
+#include <tuple>   // for tuple, get
+#include <vector>  // for vector
+
+#include <H5Cpp.h>                      // for hsize_t
+#include <google/protobuf/descriptor.h> // for Descriptor, FieldDescriptor
+#include <google/protobuf/message.h>    // for Message
+
+namespace goby
+{
+namespace middleware
+{
+namespace hdf5
+{
+/// \brief Column buffers filled by ExtractionPlan::extract(). Kept between batches of the same message type so that the vectors' storage is reused rather than reallocated for each batch.
+class ColumnBuffers
+{
+  public:
+    /// \brief Extracted values for the given leaf column (ExtractionPlan::Node::column), in row-major order with dimensions dims()
+    template <typename T> std::vector<T>& values(int column)
+    {
+        return std::get<std::vector<std::vector<T>>>(values_)[column];
+    }
+
+    /// \brief Dimensions of the node's data: the number of messages in the batch followed by the maximum size of each repeated field (if any) on the path to this node
+    const std::vector<hsize_t>& dims(int node) const { return nodes_[node].dims; }
+
+    /// \brief If false, the node was not extracted (and should not be written) as none of the enclosing messages were present
+    bool present(int node) const { return nodes_[node].present; }
+
+  private:
+    friend class ExtractionPlan;
+
+    struct NodeState
+    {
+        std::vector<hsize_t> dims;
+        bool present{false};
+        // for MESSAGE nodes: at least one of the enclosing messages exists, so the fields of this message are extracted
+        bool expanded{false};
+    };
+
+    std::vector<NodeState> nodes_;
+    // sub-messages for each embedded message node (nullptr where the enclosing message is not present)
+    std::vector<std::vector<const google::protobuf::Message*>> submessages_;
+    std::tuple<std::vector<std::vector<std::int32_t>>, std::vector<std::vector<std::int64_t>>,
+               std::vector<std::vector<std::uint32_t>>, std::vector<std::vector<std::uint64_t>>,
+               std::vector<std::vector<unsigned char>>, std::vector<std::vector<std::string>>,
+               std::vector<std::vector<float>>, std::vector<std::vector<double>>>
+        values_;
+};
+
+/// \brief Flattened set of columns (one per scalar field, including those within embedded messages and extensions) to extract from a given Protobuf message type for writing to HDF5.
+///
+/// The plan is compiled once per message type, so the descriptor walk (including the extension lookup) is not repeated for each batch of messages, and the extraction fills each column directly using a getter selected for the field's type. The extraction only reads the messages so separate batches may be extracted concurrently (using separate ColumnBuffers).
+class ExtractionPlan
+{
+  public:
+    enum class NodeType
+    {
+        INT32,
+        INT64,
+        UINT32,
+        UINT64,
+        BOOL,
+        STRING,
+        FLOAT,
+        DOUBLE,
+        ENUM,
+        MESSAGE,
+        OMITTED
+    };
+
+    struct Node
+    {
+        const google::protobuf::FieldDescriptor* field_desc{nullptr};
+        NodeType type{NodeType::OMITTED};
+        /// group of the enclosing message, relative to the message collection group (e.g. "" for top level fields, "/b/f" for fields of message "f" embedded in message "b")
+        std::string group;
+        /// index of the enclosing message's node, or -1 for top level fields
+        int parent{-1};
+        /// index into the ColumnBuffers values for the node's type (or the sub-messages for MESSAGE nodes)
+        int column{-1};
+    };
+
+    /// \brief Compiles the plan for the given type. Extensions are found from both the generated and the DCCL user descriptor pools (at the time the plan is compiled).
+    explicit ExtractionPlan(const google::protobuf::Descriptor* desc);
+
+    const google::protobuf::Descriptor* descriptor() const { return desc_; }
+
+    /// \brief Nodes in the order they should be written (depth first, fields then extensions). Embedded messages precede their fields.
+    const std::vector<Node>& nodes() const { return nodes_; }
+
+    /// \brief Extracts the columns for a batch of messages (all of type descriptor())
+    void extract(const std::vector<const google::protobuf::Message*>& messages,
+                 ColumnBuffers* buffers) const;
+
+  private:
+    void add_fields(const google::protobuf::Descriptor* desc, const std::string& group,
+                    int parent, std::vector<const google::protobuf::Descriptor*>& stack);
+    void add_field(const google::protobuf::FieldDescriptor* field_desc, const std::string& group,
+                   int parent, std::vector<const google::protobuf::Descriptor*>& stack);
+
+    void extract_message(const Node& node,
+                         const std::vector<const google::protobuf::Message*>& parents,
+                         const std::vector<hsize_t>& parent_dims, ColumnBuffers::NodeState& state,
+                         ColumnBuffers* buffers) const;
+
+  private:
+    const google::protobuf::Descriptor* desc_;
+    std::vector<Node> nodes_;
+    // number of columns of each NodeType
+    std::vector<int> column_count_;
+};
+
+} // namespace hdf5
+} // namespace middleware
+} // namespace goby
+
+#endif
@@ -49,7 +49,8 @@ struct PBMeta
 };
 
 template <typename T>
-void retrieve_default_value(T* val, const google::protobuf::FieldDescriptor* field_desc);
+inline void retrieve_default_value(T* val,
+                                   const google::protobuf::FieldDescriptor* field_desc);
 
 template <typename T> void retrieve_empty_value(T* val);
 template <typename T> T retrieve_empty_value()
@@ -71,7 +72,8 @@ template <typename T> void retrieve_single_present_value(T* val, PBMeta meta);
 template <typename T> void retrieve_repeated_value(T* val, int index, PBMeta meta);
 
 template <>
-void retrieve_default_value(std::int32_t* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(std::int32_t* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     if (field_desc->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_INT32)
     {
@@ -83,11 +85,11 @@ void retrieve_default_value(std::int32_t* val, const google::protobuf::FieldDesc
         *val = enum_desc->number();
     }
 }
-template <> void retrieve_empty_value(std::int32_t* val)
+template <> inline void retrieve_empty_value(std::int32_t* val)
 {
     *val = std::numeric_limits<std::int32_t>::max();
 }
-template <> void retrieve_single_present_value(std::int32_t* val, PBMeta m)
+template <> inline void retrieve_single_present_value(std::int32_t* val, PBMeta m)
 {
     if (m.field_desc->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_INT32)
     {
@@ -100,7 +102,7 @@ template <> void retrieve_single_present_value(std::int32_t* val, PBMeta m)
         *val = enum_desc->number();
     }
 }
-template <> void retrieve_repeated_value(std::int32_t* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(std::int32_t* val, int index, PBMeta m)
 {
     if (m.field_desc->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_INT32)
     {
@@ -115,128 +117,135 @@ template <> void retrieve_repeated_value(std::int32_t* val, int index, PBMeta m)
 }
 
 template <>
-void retrieve_default_value(std::uint32_t* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(std::uint32_t* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     *val = field_desc->default_value_uint32();
 }
-template <> void retrieve_empty_value(std::uint32_t* val)
+template <> inline void retrieve_empty_value(std::uint32_t* val)
 {
     *val = std::numeric_limits<std::uint32_t>::max();
 }
-template <> void retrieve_single_present_value(std::uint32_t* val, PBMeta m)
+template <> inline void retrieve_single_present_value(std::uint32_t* val, PBMeta m)
 {
     *val = m.refl->GetUInt32(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(std::uint32_t* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(std::uint32_t* val, int index, PBMeta m)
 {
     *val = m.refl->GetRepeatedUInt32(m.msg, m.field_desc, index);
 }
 
 template <>
-void retrieve_default_value(std::int64_t* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(std::int64_t* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     *val = field_desc->default_value_int64();
 }
-template <> void retrieve_empty_value(std::int64_t* val)
+template <> inline void retrieve_empty_value(std::int64_t* val)
 {
     *val = std::numeric_limits<std::int64_t>::max();
 }
-template <> void retrieve_single_present_value(std::int64_t* val, PBMeta m)
+template <> inline void retrieve_single_present_value(std::int64_t* val, PBMeta m)
 {
     *val = m.refl->GetInt64(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(std::int64_t* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(std::int64_t* val, int index, PBMeta m)
 {
     *val = m.refl->GetRepeatedInt64(m.msg, m.field_desc, index);
 }
 
 template <>
-void retrieve_default_value(std::uint64_t* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(std::uint64_t* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     *val = field_desc->default_value_uint64();
 }
-template <> void retrieve_empty_value(std::uint64_t* val)
+template <> inline void retrieve_empty_value(std::uint64_t* val)
 {
     *val = std::numeric_limits<std::uint64_t>::max();
 }
-template <> void retrieve_single_present_value(std::uint64_t* val, PBMeta m)
+template <> inline void retrieve_single_present_value(std::uint64_t* val, PBMeta m)
 {
     *val = m.refl->GetUInt64(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(std::uint64_t* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(std::uint64_t* val, int index, PBMeta m)
 {
     *val = m.refl->GetRepeatedUInt64(m.msg, m.field_desc, index);
 }
 
 template <>
-void retrieve_default_value(double* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(double* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     *val = field_desc->default_value_double();
 }
-template <> void retrieve_empty_value(double* val)
+template <> inline void retrieve_empty_value(double* val)
 {
     *val = std::numeric_limits<double>::quiet_NaN();
 }
-template <> void retrieve_single_present_value(double* val, PBMeta m)
+template <> inline void retrieve_single_present_value(double* val, PBMeta m)
 {
     *val = m.refl->GetDouble(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(double* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(double* val, int index, PBMeta m)
 {
     *val = m.refl->GetRepeatedDouble(m.msg, m.field_desc, index);
 }
 
 template <>
-void retrieve_default_value(float* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(float* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     *val = field_desc->default_value_float();
 }
-template <> void retrieve_empty_value(float* val)
+template <> inline void retrieve_empty_value(float* val)
 {
     *val = std::numeric_limits<float>::quiet_NaN();
 }
-template <> void retrieve_single_present_value(float* val, PBMeta m)
+template <> inline void retrieve_single_present_value(float* val, PBMeta m)
 {
     *val = m.refl->GetFloat(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(float* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(float* val, int index, PBMeta m)
 {
     *val = m.refl->GetRepeatedFloat(m.msg, m.field_desc, index);
 }
 
 // used for bool
 template <>
-void retrieve_default_value(unsigned char* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(unsigned char* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     if (field_desc->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_BOOL)
         *val = field_desc->default_value_bool();
 }
-template <> void retrieve_empty_value(unsigned char* val)
+template <> inline void retrieve_empty_value(unsigned char* val)
 {
     *val = std::numeric_limits<unsigned char>::max();
 }
-template <> void retrieve_single_present_value(unsigned char* val, PBMeta m)
+template <> inline void retrieve_single_present_value(unsigned char* val, PBMeta m)
 {
     if (m.field_desc->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_BOOL)
         *val = m.refl->GetBool(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(unsigned char* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(unsigned char* val, int index, PBMeta m)
 {
     if (m.field_desc->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_BOOL)
         *val = m.refl->GetRepeatedBool(m.msg, m.field_desc, index);
 }
 
 template <>
-void retrieve_default_value(std::string* val, const google::protobuf::FieldDescriptor* field_desc)
+inline void retrieve_default_value(std::string* val,
+                                   const google::protobuf::FieldDescriptor* field_desc)
 {
     *val = field_desc->default_value_string();
 }
-template <> void retrieve_empty_value(std::string* val) { val->clear(); }
-template <> void retrieve_single_value(std::string* val, PBMeta m)
+template <> inline void retrieve_empty_value(std::string* val) { val->clear(); }
+template <> inline void retrieve_single_value(std::string* val, PBMeta m)
 {
     *val = m.refl->GetString(m.msg, m.field_desc);
 }
-template <> void retrieve_repeated_value(std::string* val, int index, PBMeta m)
+template <> inline void retrieve_repeated_value(std::string* val, int index, PBMeta m)
 {
     *val = m.refl->GetRepeatedString(m.msg, m.field_desc, index);
 }
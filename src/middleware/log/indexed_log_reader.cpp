@@ -0,0 +1,184 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "indexed_log_reader.h"
+
+#include <algorithm> // for lower_bound
+
+#include "goby/util/debug_logger/flex_ostream.h" // for glog
+
+using goby::glog;
+using goby::middleware::log::IndexedLogReader;
+
+IndexedLogReader::IndexedLogReader(const std::string& file_name, std::size_t prefetch_depth)
+    : file_name_(file_name),
+      prefetch_depth_(std::max<std::size_t>(prefetch_depth, 1)),
+      index_stream_(file_name)
+{
+    if (!index_stream_.is_open())
+        throw(log::LogException("Failed to open log file: " + file_name));
+}
+
+IndexedLogReader::~IndexedLogReader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    prefetch_cv_.notify_all();
+    if (prefetch_thread_)
+        prefetch_thread_->join();
+}
+
+void IndexedLogReader::build_index()
+{
+    LogEntry entry;
+
+    // read the version first so that the offset of the first entry points to its magic word
+    if (LogEntry::version_ == LogEntry::invalid_version)
+        entry.parse_version(&index_stream_);
+
+    for (;;)
+    {
+        try
+        {
+            // parse() also reads (and runs the hooks for) any index or filtered entries before the data entry, so index the data entry's own frame
+            entry.parse(&index_stream_);
+            index_.push_back({entry.timestamp(), entry.offset()});
+        }
+        catch (log::LogException& e)
+        {
+            glog.is_warn() && glog << "Exception indexing input log (will attempt to continue): "
+                                   << e.what() << std::endl;
+        }
+        catch (std::exception& e)
+        {
+            if (!index_stream_.eof())
+                glog.is_warn() && glog << "Error indexing input log: " << e.what() << std::endl;
+            break;
+        }
+    }
+
+    glog.is_verbose() && glog << "Indexed " << index_.size() << " entries from " << file_name_
+                              << std::endl;
+
+    prefetch_thread_.reset(new std::thread([this]() { prefetch_loop(); }));
+}
+
+void IndexedLogReader::seek(goby::time::SystemClock::time_point t)
+{
+    auto it = std::lower_bound(index_.begin(), index_.end(), t,
+                               [](const IndexEntry& entry, goby::time::SystemClock::time_point t)
+                               { return entry.timestamp < t; });
+    seek_index(it - index_.begin());
+}
+
+void IndexedLogReader::seek_index(std::size_t index_position)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        queue_.clear();
+        prefetch_index_ = index_position;
+        next_index_ = index_position;
+    }
+    prefetch_cv_.notify_all();
+}
+
+bool IndexedLogReader::next(LogEntry* entry)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+        if (next_index_ >= index_.size())
+            return false;
+
+        consumer_cv_.wait(lock, [this]() { return !queue_.empty(); });
+
+        Prefetched prefetched = std::move(queue_.front());
+        queue_.pop_front();
+        ++next_index_;
+        prefetch_cv_.notify_all();
+
+        if (prefetched.valid)
+        {
+            *entry = std::move(prefetched.entry);
+            return true;
+        }
+    }
+}
+
+void IndexedLogReader::prefetch_loop()
+{
+    LogIFStream in(file_name_);
+    std::streamoff in_offset = -1;
+
+    for (;;)
+    {
+        std::size_t i;
+        std::uint64_t generation;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            prefetch_cv_.wait(lock,
+                              [this]()
+                              {
+                                  return quit_ || (prefetch_index_ < index_.size() &&
+                                                   queue_.size() < prefetch_depth_);
+                              });
+            if (quit_)
+                return;
+            i = prefetch_index_++;
+            generation = generation_;
+        }
+
+        // avoid seeking (which discards the stream buffer) when reading sequentially
+        if (in_offset != index_[i].offset)
+        {
+            in.clear();
+            in.seekg(index_[i].offset);
+        }
+
+        Prefetched prefetched{LogEntry(), true};
+        try
+        {
+            // build_index() has read all the group/type index entries and run the hooks
+            prefetched.entry.parse_data(&in);
+            in_offset = in.tellg();
+        }
+        catch (std::exception& e)
+        {
+            glog.is_warn() && glog << "Error reading indexed entry " << i << ": " << e.what()
+                                   << std::endl;
+            prefetched.valid = false;
+            in_offset = -1;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (generation != generation_)
+                continue;
+            queue_.push_back(std::move(prefetched));
+        }
+        consumer_cv_.notify_all();
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_INDEXED_LOG_READER_H
+#define GOBY_MIDDLEWARE_LOG_INDEXED_LOG_READER_H
+
+#include <condition_variable> // for condition_variable
+#include <cstdint>            // for uint64_t
+#include <deque>              // for deque
+#include <fstream>            // for ifstream
+#include <memory>             // for unique_ptr
+#include <mutex>              // for mutex
+#include <string>             // for string
+#include <thread>             // for thread
+#include <vector>             // for vector
+
+#include "goby/middleware/log/compressed_log.h"
+#include "goby/middleware/log/log_entry.h"
+#include "goby/time/system_clock.h"
+
+namespace goby
+{
+namespace middleware
+{
+namespace log
+{
+/// \brief Random access reader for .goby files (uncompressed or compressed, see LogIFStream) using an index of (timestamp, file offset) for every data entry.
+///
+/// Entries are read and parsed ahead of the consumer by a background thread into a bounded queue, so the caller of next() (e.g. goby_playback) only pays for the copy out of the queue.
+///
+/// Usage:
+/// 1. Construct with the file name.
+/// 2. Register any plugin read hooks on stream().
+/// 3. Call build_index(), which reads the entire file once (running all the hooks) and starts the prefetch thread. The prefetch thread only reads the indexed data entries, without running the hooks or modifying LogEntry's group/type indices, so LogEntry must not be used to parse or serialize other files while the reader exists.
+/// 4. Call next() to read entries in order, and seek() to reposition.
+class IndexedLogReader
+{
+  public:
+    struct IndexEntry
+    {
+        goby::time::SystemClock::time_point timestamp;
+        std::streamoff offset;
+    };
+
+    /// \param file_name .goby file to read
+    /// \param prefetch_depth Maximum number of entries parsed ahead of the consumer
+    IndexedLogReader(const std::string& file_name, std::size_t prefetch_depth = 1000);
+    ~IndexedLogReader();
+
+    IndexedLogReader(const IndexedLogReader&) = delete;
+    IndexedLogReader& operator=(const IndexedLogReader&) = delete;
+
+    /// \brief Stream used for building the index, for passing to LogPlugin::register_read_hooks()
+    const std::ifstream& stream() const { return index_stream_; }
+
+    /// \brief Read the entire file to build the index and start prefetching from the first entry
+    void build_index();
+
+    const std::vector<IndexEntry>& index() const { return index_; }
+    bool empty() const { return index_.empty(); }
+
+    /// \brief Timestamp of the first data entry (index must be built and non-empty)
+    goby::time::SystemClock::time_point begin_time() const { return index_.front().timestamp; }
+    /// \brief Timestamp of the last data entry (index must be built and non-empty)
+    goby::time::SystemClock::time_point end_time() const { return index_.back().timestamp; }
+
+    /// \brief Position the reader so that the next call to next() returns the first entry with timestamp >= \c t
+    ///
+    /// Entries are indexed in file order, which is assumed to be non-decreasing in time (as written by goby_logger)
+    void seek(goby::time::SystemClock::time_point t);
+    /// \brief Position the reader so that the next call to next() returns the entry at \c index_position
+    void seek_index(std::size_t index_position);
+
+    /// \brief Read the next entry, blocking until the prefetch thread has parsed it.
+    ///
+    /// \return true if \c entry was set, false if the end of the index has been reached
+    bool next(LogEntry* entry);
+
+    /// \brief Index position of the entry that will be returned by the next call to next()
+    std::size_t position() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return next_index_;
+    }
+
+  private:
+    void prefetch_loop();
+
+    struct Prefetched
+    {
+        LogEntry entry;
+        bool valid;
+    };
+
+  private:
+    std::string file_name_;
+    std::size_t prefetch_depth_;
+
+    LogIFStream index_stream_;
+    std::vector<IndexEntry> index_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable prefetch_cv_;
+    std::condition_variable consumer_cv_;
+    std::deque<Prefetched> queue_;
+    // next index to be parsed by the prefetch thread
+    std::size_t prefetch_index_{0};
+    // next index to be returned by next()
+    std::size_t next_index_{0};
+    // incremented on each seek so the prefetch thread can discard entries it read before the seek
+    std::uint64_t generation_{0};
+    bool quit_{false};
+
+    std::unique_ptr<std::thread> prefetch_thread_;
+};
+
+} // namespace log
+} // namespace middleware
+} // namespace goby
+
+#endif
@@ -63,6 +63,8 @@ goby::middleware::log::uint<LogEntry::version_bytes_>::type
 
 int LogEntry::current_version_(LogEntry::compiled_current_version);
 
+const std::string LogEntry::magic_{"GBY3"};
+
 void LogEntry::parse_version(std::istream* s)
 {
     version_ = read_one<uint<version_bytes_>::type>(s);
@@ -135,6 +137,7 @@ void LogEntry::parse(std::istream* s)
         if (discarded != 0)
             glog.is(WARN) && glog << "Found next magic word after skipping " << discarded
                                   << " bytes" << std::endl;
+        offset_ = s->tellg() - std::streamoff(magic_.size());
 
         boost::crc_32_type crc;
         crc.process_bytes(&magic_read[0], magic_.size());
@@ -339,7 +342,7 @@ void LogEntry::serialize(std::ostream* s) const
         std::string scheme_str(netint_to_string(scheme_));
         std::string scheme_plus_group =
             (version_ >= VERSION_ADD_SCHEME_TO_GROUP_TYPE_MAPPING) ? scheme_str + group : group;
-        _serialize(s, scheme_group_index_, index, 0, scheme_plus_group.data(),
+        _serialize(s, version_, scheme_group_index_, index, 0, scheme_plus_group.data(),
                    scheme_plus_group.size());
 
         if (version_ >= VERSION_ADD_TYPE_GROUP_HOOKS && new_group_hook[scheme_mapping])
@@ -353,7 +356,7 @@ void LogEntry::serialize(std::ostream* s) const
         std::string scheme_str(netint_to_string(scheme_));
         std::string scheme_plus_type =
             (version_ >= VERSION_ADD_SCHEME_TO_GROUP_TYPE_MAPPING) ? scheme_str + type_ : type_;
-        _serialize(s, scheme_type_index_, 0, index, scheme_plus_type.data(),
+        _serialize(s, version_, scheme_type_index_, 0, index, scheme_plus_type.data(),
                    scheme_plus_type.size());
 
         if (version_ >= VERSION_ADD_TYPE_GROUP_HOOKS && new_type_hook[scheme_mapping])
@@ -364,15 +367,153 @@ void LogEntry::serialize(std::ostream* s) const
     auto type_index = types_[scheme_mapping].left.at(type_);
 
     // insert actual data
-    _serialize(s, scheme_, group_index, type_index, reinterpret_cast<const char*>(&data_[0]),
+    _serialize(s, version_, scheme_, group_index, type_index, reinterpret_cast<const char*>(&data_[0]),
                data_.size());
 
     s->exceptions(old_except_mask);
 }
 
-void LogEntry::_serialize(std::ostream* s, uint<scheme_bytes_>::type scheme,
-                          uint<group_bytes_>::type group_index, uint<type_bytes_>::type type_index,
-                          const char* data, int data_size) const
+void LogEntry::serialize_standalone(std::ostream* s) const
+{
+    auto old_except_mask = s->exceptions();
+    s->exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+    const uint<group_bytes_>::type group_index = 1;
+    const uint<type_bytes_>::type type_index = 1;
+
+    std::string scheme_str(netint_to_string(scheme_));
+    std::string scheme_plus_group = scheme_str + std::string(group_);
+    std::string scheme_plus_type = scheme_str + type_;
+
+    _serialize(s, compiled_current_version, scheme_group_index_, group_index, 0,
+               scheme_plus_group.data(), scheme_plus_group.size());
+    _serialize(s, compiled_current_version, scheme_type_index_, 0, type_index,
+               scheme_plus_type.data(), scheme_plus_type.size());
+    _serialize(s, compiled_current_version, scheme_, group_index, type_index,
+               reinterpret_cast<const char*>(data_.data()), data_.size());
+
+    s->exceptions(old_except_mask);
+}
+
+void LogEntry::parse_standalone(std::istream* s)
+{
+    auto old_except_mask = s->exceptions();
+    s->exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+    uint<scheme_bytes_>::type scheme(0);
+    uint<group_bytes_>::type group_index(0);
+    uint<type_bytes_>::type type_index(0);
+
+    std::vector<unsigned char> index_data;
+
+    _parse_frame(s, compiled_current_version, &scheme, &group_index, &type_index, &index_data);
+    if (scheme != scheme_group_index_ || index_data.size() < scheme_bytes_)
+        throw(log::LogException("Standalone record does not begin with a group index entry"));
+    std::string group(index_data.begin() + scheme_bytes_, index_data.end());
+
+    _parse_frame(s, compiled_current_version, &scheme, &group_index, &type_index, &index_data);
+    if (scheme != scheme_type_index_ || index_data.size() < scheme_bytes_)
+        throw(log::LogException("Standalone record is missing the type index entry"));
+    type_ = std::string(index_data.begin() + scheme_bytes_, index_data.end());
+
+    _parse_frame(s, compiled_current_version, &scheme, &group_index, &type_index, &data_);
+    if (scheme == scheme_group_index_ || scheme == scheme_type_index_)
+        throw(log::LogException("Standalone record is missing the data entry"));
+
+    scheme_ = scheme;
+    group_ = goby::middleware::DynamicGroup(group);
+
+    s->exceptions(old_except_mask);
+}
+
+void LogEntry::parse_data(std::istream* s)
+{
+    auto old_except_mask = s->exceptions();
+    s->exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+    uint<scheme_bytes_>::type scheme(0);
+    uint<group_bytes_>::type group_index(0);
+    uint<type_bytes_>::type type_index(0);
+
+    _parse_frame(s, version_, &scheme, &group_index, &type_index, &data_);
+    if (scheme == scheme_group_index_ || scheme == scheme_type_index_)
+        throw(log::LogException("Expected a data entry but read an index entry"));
+
+    scheme_ = scheme;
+    int mapping_scheme = (version_ < VERSION_ADD_SCHEME_TO_GROUP_TYPE_MAPPING)
+                             ? goby::middleware::MarshallingScheme::NULL_SCHEME
+                             : scheme;
+
+    type_ = "_unknown" + std::to_string(type_index) + "_";
+    auto types_it = types_.find(mapping_scheme);
+    if (types_it != types_.end())
+    {
+        auto type_it = types_it->second.right.find(type_index);
+        if (type_it != types_it->second.right.end())
+            type_ = type_it->second;
+    }
+
+    std::string group = "_unknown" + std::to_string(group_index) + "_";
+    auto groups_it = groups_.find(mapping_scheme);
+    if (groups_it != groups_.end())
+    {
+        auto group_it = groups_it->second.right.find(group_index);
+        if (group_it != groups_it->second.right.end())
+            group = group_it->second;
+    }
+    group_ = goby::middleware::DynamicGroup(group);
+
+    s->exceptions(old_except_mask);
+}
+
+void LogEntry::_parse_frame(std::istream* s, uint<version_bytes_>::type version,
+                            uint<scheme_bytes_>::type* scheme,
+                            uint<group_bytes_>::type* group_index,
+                            uint<type_bytes_>::type* type_index, std::vector<unsigned char>* data)
+{
+    std::string magic_read(magic_.size(), '\0');
+    s->read(&magic_read[0], magic_.size());
+    if (magic_read != magic_)
+        throw(log::LogException("Invalid magic word: " + magic_read));
+
+    boost::crc_32_type crc;
+    crc.process_bytes(&magic_read[0], magic_.size());
+
+    auto size(read_one<uint<size_bytes_>::type>(s, &crc));
+    decltype(size) fixed_field_size = scheme_bytes_ + group_bytes_ + type_bytes_ + crc_bytes_;
+    if (version >= VERSION_ADD_TIMESTAMP)
+        fixed_field_size += timestamp_bytes_;
+
+    if (size < fixed_field_size)
+        throw(log::LogException("Invalid size read: " + std::to_string(size) +
+                                " as message must be at least " +
+                                std::to_string(fixed_field_size) + " bytes long"));
+
+    *scheme = read_one<uint<scheme_bytes_>::type>(s, &crc);
+    *group_index = read_one<uint<group_bytes_>::type>(s, &crc);
+    *type_index = read_one<uint<type_bytes_>::type>(s, &crc);
+    if (version >= VERSION_ADD_TIMESTAMP)
+    {
+        auto timestamp(read_one<uint<timestamp_bytes_>::type>(s, &crc));
+        timestamp_ = goby::time::convert<decltype(timestamp_)>(
+            timestamp * boost::units::si::micro * boost::units::si::seconds);
+    }
+
+    data->resize(size - fixed_field_size);
+    s->read(reinterpret_cast<char*>(data->data()), data->size());
+    crc.process_bytes(data->data(), data->size());
+
+    auto calculated_crc = crc.checksum();
+    auto given_crc(read_one<uint<crc_bytes_>::type>(s));
+    if (calculated_crc != given_crc)
+        throw(log::LogException("Invalid CRC on packet: given: " + std::to_string(given_crc) +
+                                ", calculated: " + std::to_string(calculated_crc)));
+}
+
+void LogEntry::_serialize(std::ostream* s, uint<version_bytes_>::type version,
+                          uint<scheme_bytes_>::type scheme, uint<group_bytes_>::type group_index,
+                          uint<type_bytes_>::type type_index, const char* data,
+                          int data_size) const
 {
     std::string group_str(netint_to_string(group_index));
     std::string type_str(netint_to_string(type_index));
@@ -381,13 +522,13 @@ void LogEntry::_serialize(std::ostream* s, uint<scheme_bytes_>::type scheme,
     uint<size_bytes_>::type size =
         scheme_bytes_ + group_bytes_ + type_bytes_ + data_size + crc_bytes_;
 
-    if (version_ >= VERSION_ADD_TIMESTAMP)
+    if (version >= VERSION_ADD_TIMESTAMP)
         size += timestamp_bytes_;
 
     std::string size_str(netint_to_string(size));
 
     auto header = magic_ + size_str + scheme_str + group_str + type_str;
-    if (version_ >= VERSION_ADD_TIMESTAMP)
+    if (version >= VERSION_ADD_TIMESTAMP)
     {
         std::uint64_t timestamp = goby::time::convert<goby::time::MicroTime>(timestamp_).value();
         std::string timestamp_str(netint_to_string(timestamp));
@@ -145,6 +145,22 @@ class LogEntry
     // if scheme == 0xFFFE what follows is not data, but the string value for the group index
     void serialize(std::ostream* s) const;
 
+    // Writes [group index][type index][data] for this entry using the current version's framing,
+    // without using or modifying the static group/type indices, so that each record can be
+    // parsed on its own (e.g. by readers joining a LogTail at an arbitrary point)
+    void serialize_standalone(std::ostream* s) const;
+    // Reads a record written by serialize_standalone()
+    void parse_standalone(std::istream* s);
+
+    // Reads the data entry frame at the current position of s (e.g. the offset() of an entry
+    // read earlier by parse()), without running any hooks and only looking up (not modifying) the
+    // static group/type indices, so that once parse() has read all the index entries this can be
+    // called from another thread
+    void parse_data(std::istream* s);
+
+    // stream position of the start of the frame of the entry last read by parse()
+    std::streamoff offset() const { return offset_; }
+
     const std::vector<unsigned char>& data() const { return data_; }
     int scheme() const { return scheme_; }
     const std::string& type() const { return type_; }
@@ -166,9 +182,14 @@ class LogEntry
     }
 
   private:
-    void _serialize(std::ostream* s, uint<scheme_bytes_>::type scheme,
-                    uint<group_bytes_>::type group_index, uint<type_bytes_>::type type_index,
-                    const char* data, int data_size) const;
+    void _serialize(std::ostream* s, uint<version_bytes_>::type version,
+                    uint<scheme_bytes_>::type scheme, uint<group_bytes_>::type group_index,
+                    uint<type_bytes_>::type type_index, const char* data, int data_size) const;
+
+    // reads a single frame (magic word through CRC) with no resynchronization
+    void _parse_frame(std::istream* s, uint<version_bytes_>::type version,
+                      uint<scheme_bytes_>::type* scheme, uint<group_bytes_>::type* group_index,
+                      uint<type_bytes_>::type* type_index, std::vector<unsigned char>* data);
 
     template <typename Unsigned>
     Unsigned read_one(std::istream* s, boost::crc_32_type* crc = nullptr)
@@ -210,6 +231,7 @@ class LogEntry
     std::string type_;
     DynamicGroup group_;
     goby::time::SystemClock::time_point timestamp_;
+    std::streamoff offset_{-1};
 
     // map (scheme -> map (group_name -> group_index)
     static std::map<int, boost::bimap<std::string, uint<group_bytes_>::type>> groups_;
@@ -219,7 +241,7 @@ class LogEntry
     static std::map<int, boost::bimap<std::string, uint<type_bytes_>::type>> types_;
     static uint<type_bytes_>::type type_index_;
 
-    const std::string magic_{"GBY3"};
+    static const std::string magic_;
 };
 
 } // namespace log
@@ -24,10 +24,15 @@
 #ifndef GOBY_MIDDLEWARE_LOG_LOG_PLUGIN_H
 #define GOBY_MIDDLEWARE_LOG_LOG_PLUGIN_H
 
+#include <ostream> // for ostream
+#include <string>  // for string
+
 #include "goby/middleware/log/log_entry.h"
+#include "goby/middleware/log/protobuf_json.h"
 #include "goby/middleware/marshalling/interface.h"
 #include "goby/middleware/marshalling/json.h"
 #include "goby/middleware/protobuf/log_tool_config.pb.h"
+#include "goby/time/convert.h"
 
 #include "goby/middleware/log/hdf5/hdf5_plugin.h"
 
@@ -60,6 +65,42 @@ class LogPlugin
     {
         throw(log::LogException("JSON is not supported by the scheme's plugin"));
     }
+
+    /// \brief Writes the entry to the stream as JSON (one object per line), including the log entry metadata (see add_json_metadata())
+    ///
+    /// The default implementation adds the metadata to json_message() and dumps the result. Plugins can override this to write directly to the stream without building an intermediate JSON document.
+    virtual void write_json(LogEntry& log_entry, std::ostream& os)
+    {
+        auto j = json_message(log_entry);
+        add_json_metadata(log_entry, *j);
+        os << j->dump() << '\n';
+    }
+
+    /// \brief Adds the log entry metadata keys ("_scheme_", "_utime_", "_strtime_", "_group_", "_type_") to a JSON object
+    static void add_json_metadata(const LogEntry& log_entry, nlohmann::json& j)
+    {
+        j["_scheme_"] = log_entry.scheme();
+        j["_utime_"] = goby::time::convert<goby::time::MicroTime>(log_entry.timestamp()).value();
+        j["_strtime_"] = goby::time::str(log_entry.timestamp());
+        j["_group_"] = static_cast<std::string>(log_entry.group());
+        j["_type_"] = log_entry.type();
+    }
+
+    /// \brief Appends the same metadata as add_json_metadata() as "key":value pairs (without the enclosing braces) to a JSON object being written
+    static void append_json_metadata(const LogEntry& log_entry, std::string& out)
+    {
+        out += "\"_scheme_\":";
+        out += std::to_string(log_entry.scheme());
+        out += ",\"_utime_\":";
+        out += std::to_string(
+            goby::time::convert<goby::time::MicroTime>(log_entry.timestamp()).value());
+        out += ",\"_strtime_\":";
+        protobuf_json::append_string(goby::time::str(log_entry.timestamp()), out);
+        out += ",\"_group_\":";
+        protobuf_json::append_string(static_cast<std::string>(log_entry.group()), out);
+        out += ",\"_type_\":";
+        protobuf_json::append_string(log_entry.type(), out);
+    }
 };
 
 } // namespace log
@@ -0,0 +1,275 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "log_tail.h"
+
+#include <cerrno>     // for errno
+#include <cstring>    // for memcpy, strerror
+#include <fcntl.h>    // for O_CREAT, O_RDWR
+#include <new>        // for placement new
+#include <sys/mman.h> // for mmap, shm_open
+#include <sys/stat.h> // for fstat
+#include <unistd.h>   // for ftruncate, close
+
+#include "goby/util/debug_logger/flex_ostream.h" // for glog
+
+using goby::glog;
+using goby::middleware::log::LogException;
+using goby::middleware::log::LogTailReader;
+using goby::middleware::log::LogTailWriter;
+using goby::middleware::log::detail::LogTailHeader;
+
+namespace
+{
+std::uint64_t align(std::uint64_t n)
+{
+    return (n + LogTailHeader::alignment - 1) / LogTailHeader::alignment *
+           LogTailHeader::alignment;
+}
+
+constexpr std::uint64_t record_size_bytes{sizeof(std::uint32_t)};
+} // namespace
+
+LogTailWriter::LogTailWriter(const std::string& name, std::uint64_t capacity)
+    : name_(detail::log_tail_shm_name(name))
+{
+    capacity = align(capacity);
+    map_size_ = align(sizeof(LogTailHeader)) + capacity;
+
+    // remove any stale segment from a previous writer so that existing readers don't see our data with their old read position
+    shm_unlink(name_.c_str());
+
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP);
+    if (fd < 0)
+        throw(LogException("Failed to create shared memory log tail " + name_ + ": " +
+                           std::strerror(errno)));
+
+    if (ftruncate(fd, map_size_) != 0)
+    {
+        int err = errno;
+        close(fd);
+        shm_unlink(name_.c_str());
+        throw(LogException("Failed to size shared memory log tail " + name_ + ": " +
+                           std::strerror(err)));
+    }
+
+    map_ = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map_ == MAP_FAILED)
+    {
+        map_ = nullptr;
+        shm_unlink(name_.c_str());
+        throw(LogException("Failed to map shared memory log tail " + name_ + ": " +
+                           std::strerror(errno)));
+    }
+
+    header_ = new (map_) LogTailHeader;
+    header_->entry_version = LogEntry::compiled_current_version;
+    header_->capacity = capacity;
+    header_->write_begin.store(0, std::memory_order_relaxed);
+    header_->write_end.store(0, std::memory_order_relaxed);
+    ring_ = static_cast<char*>(map_) + align(sizeof(LogTailHeader));
+
+    // readers check magic before anything else
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = LogTailHeader::magic_value;
+
+    glog.is_verbose() && glog << "Opened shared memory log tail " << name_ << " (" << capacity
+                              << " bytes)" << std::endl;
+}
+
+LogTailWriter::~LogTailWriter()
+{
+    if (map_)
+        munmap(map_, map_size_);
+    shm_unlink(name_.c_str());
+}
+
+void LogTailWriter::write(const LogEntry& entry)
+{
+    buffer_.str(std::string());
+    buffer_.clear();
+    entry.serialize_standalone(&buffer_);
+    write_record(buffer_.str());
+    ++entries_written_;
+}
+
+void LogTailWriter::write_record(const std::string& record)
+{
+    const auto capacity = header_->capacity;
+    const std::uint64_t total = align(record_size_bytes + record.size());
+    if (total > capacity)
+        throw(LogException("Entry of " + std::to_string(record.size()) +
+                           " bytes does not fit in log tail of " + std::to_string(capacity) +
+                           " bytes"));
+
+    auto pos = header_->write_end.load(std::memory_order_relaxed);
+    auto remaining = capacity - pos % capacity;
+    auto skip = (remaining < total) ? remaining : 0;
+    auto next_pos = pos + skip + total;
+
+    // announce the region we're about to overwrite before touching it
+    header_->write_begin.store(next_pos, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (skip)
+    {
+        std::uint32_t marker = LogTailHeader::wrap_marker;
+        std::memcpy(ring_ + pos % capacity, &marker, record_size_bytes);
+        pos += skip;
+    }
+
+    char* dest = ring_ + pos % capacity;
+    std::uint32_t size = record.size();
+    std::memcpy(dest, &size, record_size_bytes);
+    std::memcpy(dest + record_size_bytes, record.data(), record.size());
+
+    header_->write_end.store(next_pos, std::memory_order_release);
+}
+
+LogTailReader::LogTailReader(const std::string& name)
+{
+    auto shm_name = detail::log_tail_shm_name(name);
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        throw(LogException("Failed to open shared memory log tail " + shm_name + ": " +
+                           std::strerror(errno)));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(align(sizeof(LogTailHeader))))
+    {
+        close(fd);
+        throw(LogException("Shared memory log tail " + shm_name +
+                           " is not initialized (is the writer running?)"));
+    }
+
+    map_size_ = st.st_size;
+    map_ = mmap(nullptr, map_size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map_ == MAP_FAILED)
+    {
+        map_ = nullptr;
+        throw(LogException("Failed to map shared memory log tail " + shm_name + ": " +
+                           std::strerror(errno)));
+    }
+
+    // the destructor doesn't run if we throw, so unmap here
+    try
+    {
+        header_ = static_cast<const LogTailHeader*>(map_);
+        if (header_->magic != LogTailHeader::magic_value)
+            throw(LogException("Shared memory log tail " + shm_name + " has an invalid header"));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (header_->entry_version != LogEntry::compiled_current_version)
+            throw(LogException("Shared memory log tail " + shm_name + " uses LogEntry version " +
+                               std::to_string(header_->entry_version) +
+                               " but we expect version " +
+                               std::to_string(LogEntry::compiled_current_version)));
+
+        if (align(sizeof(LogTailHeader)) + header_->capacity > map_size_)
+            throw(LogException("Shared memory log tail " + shm_name + " is truncated"));
+    }
+    catch (...)
+    {
+        munmap(map_, map_size_);
+        map_ = nullptr;
+        header_ = nullptr;
+        throw;
+    }
+
+    ring_ = static_cast<const char*>(map_) + align(sizeof(LogTailHeader));
+    read_pos_ = header_->write_end.load(std::memory_order_acquire);
+}
+
+LogTailReader::~LogTailReader()
+{
+    if (map_)
+        munmap(map_, map_size_);
+}
+
+bool LogTailReader::read(LogEntry* entry)
+{
+    const auto capacity = header_->capacity;
+
+    for (;;)
+    {
+        auto end = header_->write_end.load(std::memory_order_acquire);
+        if (read_pos_ == end)
+            return false;
+
+        if (end - read_pos_ > capacity)
+        {
+            resync(end);
+            continue;
+        }
+
+        std::uint32_t size;
+        const char* src = ring_ + read_pos_ % capacity;
+        std::memcpy(&size, src, record_size_bytes);
+
+        bool valid_size = true;
+        if (size == LogTailHeader::wrap_marker)
+        {
+            read_pos_ += capacity - read_pos_ % capacity;
+            // the marker itself may have been overwritten
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header_->write_begin.load(std::memory_order_relaxed) > read_pos_ + capacity)
+                resync(header_->write_end.load(std::memory_order_acquire));
+            continue;
+        }
+        else if (align(record_size_bytes + size) > capacity - read_pos_ % capacity)
+        {
+            valid_size = false;
+        }
+        else
+        {
+            record_.assign(src + record_size_bytes, size);
+        }
+
+        // check that the writer didn't overwrite any of the record while we were copying it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!valid_size ||
+            header_->write_begin.load(std::memory_order_relaxed) > read_pos_ + capacity)
+        {
+            resync(header_->write_end.load(std::memory_order_acquire));
+            continue;
+        }
+
+        read_pos_ += align(record_size_bytes + size);
+
+        std::istringstream record_stream(record_);
+        try
+        {
+            entry->parse_standalone(&record_stream);
+        }
+        catch (std::exception& e)
+        {
+            glog.is_warn() && glog << "Failed to parse log tail entry: " << e.what() << std::endl;
+            continue;
+        }
+
+        ++entries_read_;
+        return true;
+    }
+}
@@ -0,0 +1,150 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_LOG_TAIL_H
+#define GOBY_MIDDLEWARE_LOG_LOG_TAIL_H
+
+#include <atomic>  // for atomic
+#include <cstdint> // for uint64_t, uint32_t
+#include <sstream> // for stringstream
+#include <string>  // for string
+
+#include "goby/middleware/log/log_entry.h"
+
+namespace goby
+{
+namespace middleware
+{
+namespace log
+{
+namespace detail
+{
+/// \brief Layout of the start of the shared memory segment used by LogTailWriter / LogTailReader
+///
+/// The remainder of the segment (after this header) is a ring of \c capacity bytes containing records of
+/// [size: 4][LogEntry::serialize_standalone() bytes][padding to 8 bytes]. A size of \c wrap_marker means the writer continued at the start of the ring.
+struct LogTailHeader
+{
+    static constexpr std::uint32_t magic_value{0x47425954}; // "GBYT"
+    static constexpr std::uint32_t wrap_marker{0xFFFFFFFF};
+    static constexpr std::uint32_t alignment{8};
+
+    std::uint32_t magic;
+    std::uint32_t entry_version;
+    std::uint64_t capacity;
+    // total bytes (monotonically increasing) that the writer has started to write (reserved)
+    std::atomic<std::uint64_t> write_begin;
+    // total bytes (monotonically increasing) that the writer has finished writing (committed)
+    std::atomic<std::uint64_t> write_end;
+};
+
+#if ATOMIC_LLONG_LOCK_FREE != 2
+#error "LogTail requires lock-free 64-bit atomics to share them across processes"
+#endif
+
+inline std::string log_tail_shm_name(const std::string& name)
+{
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+} // namespace detail
+
+/// \brief Writes LogEntry records into a POSIX shared memory ring buffer that can be tailed by any number of LogTailReader instances (in other processes) without affecting the writer.
+///
+/// There can only be a single writer for a given name. The writer never blocks on readers: slow readers are overrun and resynchronize to the newest data (see LogTailReader::overruns()).
+class LogTailWriter
+{
+  public:
+    /// \param name Shared memory name (see shm_open(3)). A leading '/' is added if omitted.
+    /// \param capacity Size of the ring buffer in bytes (rounded up to a multiple of 8)
+    LogTailWriter(const std::string& name, std::uint64_t capacity);
+    ~LogTailWriter();
+
+    LogTailWriter(const LogTailWriter&) = delete;
+    LogTailWriter& operator=(const LogTailWriter&) = delete;
+
+    /// \brief Write an entry into the ring. Throws LogException if the entry is larger than the ring capacity.
+    void write(const LogEntry& entry);
+
+    std::uint64_t entries_written() const { return entries_written_; }
+    const std::string& name() const { return name_; }
+
+  private:
+    void write_record(const std::string& record);
+
+  private:
+    std::string name_;
+    std::size_t map_size_{0};
+    void* map_{nullptr};
+    detail::LogTailHeader* header_{nullptr};
+    char* ring_{nullptr};
+
+    std::stringstream buffer_;
+    std::uint64_t entries_written_{0};
+};
+
+/// \brief Reads LogEntry records from a LogTailWriter's shared memory ring, starting at the newest data at the time of construction.
+class LogTailReader
+{
+  public:
+    /// \param name Shared memory name used by the LogTailWriter
+    LogTailReader(const std::string& name);
+    ~LogTailReader();
+
+    LogTailReader(const LogTailReader&) = delete;
+    LogTailReader& operator=(const LogTailReader&) = delete;
+
+    /// \brief Read the next entry, if available.
+    ///
+    /// \return true if an entry was read into \c entry, false if no new entries are available
+    bool read(LogEntry* entry);
+
+    /// \brief Number of times this reader fell behind the writer by more than the ring capacity (data was lost and the reader skipped to the newest data)
+    std::uint64_t overruns() const { return overruns_; }
+    std::uint64_t entries_read() const { return entries_read_; }
+
+  private:
+    void resync(std::uint64_t position)
+    {
+        ++overruns_;
+        read_pos_ = position;
+    }
+
+  private:
+    std::size_t map_size_{0};
+    void* map_{nullptr};
+    const detail::LogTailHeader* header_{nullptr};
+    const char* ring_{nullptr};
+
+    std::uint64_t read_pos_{0};
+    std::string record_;
+
+    std::uint64_t overruns_{0};
+    std::uint64_t entries_read_{0};
+};
+
+} // namespace log
+} // namespace middleware
+} // namespace goby
+
+#endif
@@ -0,0 +1,115 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_PLAYBACK_CLOCK_H
+#define GOBY_MIDDLEWARE_LOG_PLAYBACK_CLOCK_H
+
+#include <algorithm> // for max
+#include <chrono>    // for duration_cast
+
+#include "goby/time/system_clock.h"
+
+namespace goby
+{
+namespace middleware
+{
+namespace log
+{
+/// \brief Maps wall time to log time for playback, allowing the rate to be changed, paused, and repositioned (seek) at runtime without discontinuities.
+///
+/// Log time advances as: log_now = log_anchor + (wall_now - wall_anchor) * rate. Changing the rate or seeking moves the anchors to the current time.
+class PlaybackClock
+{
+  public:
+    using time_point = goby::time::SystemClock::time_point;
+    using duration = goby::time::SystemClock::duration;
+
+    /// \param log_start Log time corresponding to \c wall_start
+    /// \param wall_start Wall time at which playback starts (log time is held at log_start until then)
+    /// \param rate Multiple of real time to play back at
+    PlaybackClock(time_point log_start, time_point wall_start, double rate)
+        : log_anchor_(log_start), wall_anchor_(wall_start), rate_(rate)
+    {
+    }
+
+    /// \brief Current log time
+    time_point log_now(time_point wall_now = goby::time::SystemClock::now()) const
+    {
+        if (paused_ || wall_now <= wall_anchor_)
+            return log_anchor_;
+        return log_anchor_ + std::chrono::duration_cast<duration>((wall_now - wall_anchor_) * rate_);
+    }
+
+    /// \brief Wall time at which the given log time will be reached (or time_point::max() if paused)
+    time_point wall_time(time_point log_time) const
+    {
+        if (paused_ || rate_ <= 0)
+            return time_point::max();
+        if (log_time <= log_anchor_)
+            return wall_anchor_;
+        return wall_anchor_ + std::chrono::duration_cast<duration>((log_time - log_anchor_) / rate_);
+    }
+
+    /// \brief Change the playback rate, continuing from the current log time
+    void set_rate(double rate, time_point wall_now = goby::time::SystemClock::now())
+    {
+        reanchor(log_now(wall_now), wall_now);
+        rate_ = rate;
+    }
+
+    /// \brief Continue playback from the given log time
+    void seek(time_point log_time, time_point wall_now = goby::time::SystemClock::now())
+    {
+        reanchor(log_time, wall_now);
+    }
+
+    /// \brief Pause or resume playback (log time does not advance while paused)
+    void set_paused(bool paused, time_point wall_now = goby::time::SystemClock::now())
+    {
+        reanchor(log_now(wall_now), wall_now);
+        paused_ = paused;
+    }
+
+    double rate() const { return rate_; }
+    bool paused() const { return paused_; }
+
+  private:
+    void reanchor(time_point log_time, time_point wall_now)
+    {
+        log_anchor_ = log_time;
+        // preserve any remaining start delay
+        wall_anchor_ = std::max(wall_now, wall_anchor_);
+    }
+
+  private:
+    time_point log_anchor_;
+    time_point wall_anchor_;
+    double rate_;
+    bool paused_{false};
+};
+
+} // namespace log
+} // namespace middleware
+} // namespace goby
+
+#endif
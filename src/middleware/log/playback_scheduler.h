@@ -0,0 +1,118 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_PLAYBACK_SCHEDULER_H
+#define GOBY_MIDDLEWARE_LOG_PLAYBACK_SCHEDULER_H
+
+#include "goby/middleware/log/indexed_log_reader.h"
+#include "goby/middleware/log/log_entry.h"
+#include "goby/middleware/log/playback_clock.h"
+#include "goby/time/system_clock.h"
+
+namespace goby
+{
+namespace middleware
+{
+namespace log
+{
+/// \brief Plays back the entries of an IndexedLogReader in order as the PlaybackClock reaches their timestamps (the scheduling used by goby_playback).
+///
+/// Call play_due() periodically: each call plays back all the entries due by the current log time.
+class PlaybackScheduler
+{
+  public:
+    using time_point = PlaybackClock::time_point;
+
+    /// \param reader Indexed reader (build_index() must already have been called)
+    /// \param log_start Log time to start playback from
+    /// \param wall_start Wall time at which playback starts
+    /// \param rate Multiple of real time to play back at
+    /// \param log_end Log time to end playback at
+    PlaybackScheduler(IndexedLogReader& reader, time_point log_start, time_point wall_start,
+                      double rate, time_point log_end = time_point::max())
+        : reader_(reader), log_start_(log_start), log_end_(log_end),
+          clock_(log_start, wall_start, rate)
+    {
+        reader_.seek(log_start_);
+        read_next_entry();
+    }
+
+    /// \brief Calls play(entry) for each entry due by the log time at wall_now, in order
+    /// \return number of entries played
+    template <typename Function>
+    int play_due(Function play, time_point wall_now = goby::time::SystemClock::now())
+    {
+        auto log_now = clock_.log_now(wall_now);
+        int played = 0;
+        while (has_next_entry_ && next_log_entry_.timestamp() <= log_now &&
+               next_log_entry_.timestamp() <= log_end_)
+        {
+            play(static_cast<const LogEntry&>(next_log_entry_));
+            ++played;
+            read_next_entry();
+        }
+        return played;
+    }
+
+    /// \brief Have all the entries in the playback window been played by wall_now?
+    bool end_of_window(time_point wall_now = goby::time::SystemClock::now()) const
+    {
+        return !has_next_entry_ ||
+               (next_log_entry_.timestamp() > log_end_ && clock_.log_now(wall_now) >= log_end_);
+    }
+
+    /// \brief Continue playback from the given log time
+    void seek(time_point log_time, time_point wall_now = goby::time::SystemClock::now())
+    {
+        reader_.seek(log_time);
+        clock_.seek(log_time, wall_now);
+        read_next_entry();
+    }
+
+    /// \brief Continue playback from the start of the window (for looping)
+    void restart(time_point wall_now = goby::time::SystemClock::now())
+    {
+        seek(log_start_, wall_now);
+    }
+
+    /// \brief The clock, for changing the rate or pausing
+    PlaybackClock& clock() { return clock_; }
+
+  private:
+    void read_next_entry() { has_next_entry_ = reader_.next(&next_log_entry_); }
+
+  private:
+    IndexedLogReader& reader_;
+    time_point log_start_;
+    time_point log_end_;
+    PlaybackClock clock_;
+
+    LogEntry next_log_entry_;
+    bool has_next_entry_{false};
+};
+
+} // namespace log
+} // namespace middleware
+} // namespace goby
+
+#endif
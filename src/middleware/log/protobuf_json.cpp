@@ -0,0 +1,413 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cinttypes> // for PRId64, PRIu64
+#include <cmath>     // for isnan, isinf
+#include <cstdint>   // for uint8_t, uint32_t
+#include <cstdio>    // for snprintf
+#include <cstdlib>   // for strtod, strtof
+#include <deque>     // for deque
+#include <vector>    // for vector
+
+#include <google/protobuf/descriptor.h>     // for FieldDescriptor
+#include <google/protobuf/message.h>        // for Message, Reflection
+#include <google/protobuf/util/json_util.h> // for MessageToJsonString
+
+#include "protobuf_json.h"
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+namespace
+{
+template <typename... Args> void append_printf(std::string& out, const char* format, Args... args)
+{
+    char buffer[32];
+    int len = std::snprintf(buffer, sizeof(buffer), format, args...);
+    out.append(buffer, len);
+}
+
+// shortest representation (of at least 15 significant digits) that reads back to the same value, as used by the Protobuf JSON printer
+void append_double(double value, std::string& out)
+{
+    if (std::isnan(value))
+        out += "\"NaN\"";
+    else if (std::isinf(value))
+        out += value > 0 ? "\"Infinity\"" : "\"-Infinity\"";
+    else
+    {
+        char buffer[32];
+        int len = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+        if (std::strtod(buffer, nullptr) != value)
+            len = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        out.append(buffer, len);
+    }
+}
+
+void append_float(float value, std::string& out)
+{
+    if (std::isnan(value) || std::isinf(value))
+        append_double(value, out);
+    else
+    {
+        char buffer[32];
+        int len = std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        if (std::strtof(buffer, nullptr) != value)
+            len = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+        out.append(buffer, len);
+    }
+}
+
+void append_base64(const std::string& value, std::string& out)
+{
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    out += '"';
+    std::size_t i = 0, n = value.size();
+    for (; i + 2 < n; i += 3)
+    {
+        std::uint32_t triple = static_cast<std::uint8_t>(value[i]) << 16 |
+                               static_cast<std::uint8_t>(value[i + 1]) << 8 |
+                               static_cast<std::uint8_t>(value[i + 2]);
+        out += alphabet[(triple >> 18) & 0x3F];
+        out += alphabet[(triple >> 12) & 0x3F];
+        out += alphabet[(triple >> 6) & 0x3F];
+        out += alphabet[triple & 0x3F];
+    }
+    if (i < n)
+    {
+        std::uint32_t triple = static_cast<std::uint8_t>(value[i]) << 16;
+        if (i + 1 < n)
+            triple |= static_cast<std::uint8_t>(value[i + 1]) << 8;
+        out += alphabet[(triple >> 18) & 0x3F];
+        out += alphabet[(triple >> 12) & 0x3F];
+        out += (i + 1 < n) ? alphabet[(triple >> 6) & 0x3F] : '=';
+        out += '=';
+    }
+    out += '"';
+}
+
+// length of the valid UTF-8 sequence starting at s[i], or 0 if invalid
+std::size_t utf8_sequence_length(const std::string& s, std::size_t i)
+{
+    auto byte = [&](std::size_t j) { return static_cast<std::uint8_t>(s[j]); };
+    auto continuation = [&](std::size_t j, std::uint8_t min = 0x80, std::uint8_t max = 0xBF)
+    { return j < s.size() && byte(j) >= min && byte(j) <= max; };
+
+    std::uint8_t c = byte(i);
+    if (c < 0x80)
+        return 1;
+    else if (c >= 0xC2 && c <= 0xDF)
+        return continuation(i + 1) ? 2 : 0;
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+        // no overlong encodings or surrogates
+        std::uint8_t min = (c == 0xE0) ? 0xA0 : 0x80, max = (c == 0xED) ? 0x9F : 0xBF;
+        return continuation(i + 1, min, max) && continuation(i + 2) ? 3 : 0;
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+        // no overlong encodings or code points beyond U+10FFFF
+        std::uint8_t min = (c == 0xF0) ? 0x90 : 0x80, max = (c == 0xF4) ? 0x8F : 0xBF;
+        return continuation(i + 1, min, max) && continuation(i + 2) && continuation(i + 3) ? 4
+                                                                                           : 0;
+    }
+    return 0;
+}
+
+bool is_well_known_type(const google::protobuf::Descriptor* desc)
+{
+    const std::string& file = desc->file()->name();
+    return file == "google/protobuf/any.proto" || file == "google/protobuf/duration.proto" ||
+           file == "google/protobuf/field_mask.proto" || file == "google/protobuf/struct.proto" ||
+           file == "google/protobuf/timestamp.proto" || file == "google/protobuf/wrappers.proto";
+}
+
+void append_key(const FieldDescriptor* field_desc, std::string& out)
+{
+    out += '"';
+    if (field_desc->is_extension())
+    {
+        out += '[';
+        out += field_desc->full_name();
+        out += ']';
+    }
+    else
+    {
+        out += field_desc->json_name();
+    }
+    out += "\":";
+}
+
+void append_value(const Message& msg, const Reflection* refl, const FieldDescriptor* field_desc,
+                  int index, std::string& out);
+
+// map keys are always strings in JSON
+void append_map_key(const Message& entry, std::string& out)
+{
+    const auto* key_desc = entry.GetDescriptor()->map_key();
+    const auto* refl = entry.GetReflection();
+    switch (key_desc->cpp_type())
+    {
+        case FieldDescriptor::CPPTYPE_STRING:
+            goby::middleware::log::protobuf_json::append_string(refl->GetString(entry, key_desc),
+                                                                out);
+            break;
+        case FieldDescriptor::CPPTYPE_BOOL:
+            out += refl->GetBool(entry, key_desc) ? "\"true\"" : "\"false\"";
+            break;
+        case FieldDescriptor::CPPTYPE_INT32:
+            append_printf(out, "\"%" PRId32 "\"", refl->GetInt32(entry, key_desc));
+            break;
+        case FieldDescriptor::CPPTYPE_UINT32:
+            append_printf(out, "\"%" PRIu32 "\"", refl->GetUInt32(entry, key_desc));
+            break;
+        default:
+            // 64-bit integers are already quoted
+            append_value(entry, refl, key_desc, -1, out);
+            break;
+    }
+}
+
+void append_field(const Message& msg, const Reflection* refl, const FieldDescriptor* field_desc,
+                  std::string& out)
+{
+    append_key(field_desc, out);
+
+    if (field_desc->is_map())
+    {
+        out += '{';
+        for (int i = 0, n = refl->FieldSize(msg, field_desc); i < n; ++i)
+        {
+            if (i)
+                out += ',';
+            const Message& entry = refl->GetRepeatedMessage(msg, field_desc, i);
+            append_map_key(entry, out);
+            out += ':';
+            const auto* value_desc = entry.GetDescriptor()->map_value();
+            append_value(entry, entry.GetReflection(), value_desc, -1, out);
+        }
+        out += '}';
+    }
+    else if (field_desc->is_repeated())
+    {
+        out += '[';
+        for (int i = 0, n = refl->FieldSize(msg, field_desc); i < n; ++i)
+        {
+            if (i)
+                out += ',';
+            append_value(msg, refl, field_desc, i, out);
+        }
+        out += ']';
+    }
+    else
+    {
+        append_value(msg, refl, field_desc, -1, out);
+    }
+}
+
+// index == -1 for non-repeated fields
+void append_value(const Message& msg, const Reflection* refl, const FieldDescriptor* field_desc,
+                  int index, std::string& out)
+{
+    bool repeated = index >= 0;
+    switch (field_desc->cpp_type())
+    {
+        case FieldDescriptor::CPPTYPE_INT32:
+            append_printf(out, "%" PRId32,
+                          repeated ? refl->GetRepeatedInt32(msg, field_desc, index)
+                                   : refl->GetInt32(msg, field_desc));
+            break;
+        case FieldDescriptor::CPPTYPE_UINT32:
+            append_printf(out, "%" PRIu32,
+                          repeated ? refl->GetRepeatedUInt32(msg, field_desc, index)
+                                   : refl->GetUInt32(msg, field_desc));
+            break;
+        // 64-bit integers are quoted as they can't be represented exactly by a double
+        case FieldDescriptor::CPPTYPE_INT64:
+            append_printf(out, "\"%" PRId64 "\"",
+                          static_cast<std::int64_t>(
+                              repeated ? refl->GetRepeatedInt64(msg, field_desc, index)
+                                       : refl->GetInt64(msg, field_desc)));
+            break;
+        case FieldDescriptor::CPPTYPE_UINT64:
+            append_printf(out, "\"%" PRIu64 "\"",
+                          static_cast<std::uint64_t>(
+                              repeated ? refl->GetRepeatedUInt64(msg, field_desc, index)
+                                       : refl->GetUInt64(msg, field_desc)));
+            break;
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+            append_double(repeated ? refl->GetRepeatedDouble(msg, field_desc, index)
+                                   : refl->GetDouble(msg, field_desc),
+                          out);
+            break;
+        case FieldDescriptor::CPPTYPE_FLOAT:
+            append_float(repeated ? refl->GetRepeatedFloat(msg, field_desc, index)
+                                  : refl->GetFloat(msg, field_desc),
+                         out);
+            break;
+        case FieldDescriptor::CPPTYPE_BOOL:
+            out += (repeated ? refl->GetRepeatedBool(msg, field_desc, index)
+                             : refl->GetBool(msg, field_desc))
+                       ? "true"
+                       : "false";
+            break;
+        case FieldDescriptor::CPPTYPE_ENUM:
+        {
+            int value = repeated ? refl->GetRepeatedEnumValue(msg, field_desc, index)
+                                 : refl->GetEnumValue(msg, field_desc);
+            const auto* value_desc = field_desc->enum_type()->FindValueByNumber(value);
+            // unknown (open) enum values are written as numbers
+            if (value_desc)
+                goby::middleware::log::protobuf_json::append_string(value_desc->name(), out);
+            else
+                append_printf(out, "%d", value);
+            break;
+        }
+        case FieldDescriptor::CPPTYPE_STRING:
+        {
+            std::string scratch;
+            const std::string& value =
+                repeated ? refl->GetRepeatedStringReference(msg, field_desc, index, &scratch)
+                         : refl->GetStringReference(msg, field_desc, &scratch);
+            if (field_desc->type() == FieldDescriptor::TYPE_BYTES)
+                append_base64(value, out);
+            else
+                goby::middleware::log::protobuf_json::append_string(value, out);
+            break;
+        }
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+            goby::middleware::log::protobuf_json::append_message(
+                repeated ? refl->GetRepeatedMessage(msg, field_desc, index)
+                         : refl->GetMessage(msg, field_desc),
+                out);
+            break;
+    }
+}
+} // namespace
+
+void goby::middleware::log::protobuf_json::append_message(const google::protobuf::Message& msg,
+                                                          std::string& out)
+{
+    if (is_well_known_type(msg.GetDescriptor()))
+    {
+        // these have special representations (e.g. Timestamp as an RFC 3339 string) and are rare in logs, so leave them to libprotobuf
+        std::string json;
+        google::protobuf::util::MessageToJsonString(msg, &json);
+        out += json;
+        return;
+    }
+
+    out += '{';
+    append_fields(msg, out, false);
+    out += '}';
+}
+
+int goby::middleware::log::protobuf_json::append_fields(const google::protobuf::Message& msg,
+                                                        std::string& out, bool leading_comma)
+{
+    if (is_well_known_type(msg.GetDescriptor()))
+    {
+        if (leading_comma)
+            out += ',';
+        out += "\"value\":";
+        append_message(msg, out);
+        return 1;
+    }
+
+    const auto* refl = msg.GetReflection();
+    // reuse the field lists (one per nesting depth, as this is called recursively); deque so that resizing doesn't move the lists in use by the callers
+    thread_local std::deque<std::vector<const FieldDescriptor*>> fields_by_depth;
+    thread_local std::size_t depth = 0;
+    if (fields_by_depth.size() <= depth)
+        fields_by_depth.resize(depth + 1);
+    auto& fields = fields_by_depth[depth];
+
+    // set fields (and extensions) in field number order
+    fields.clear();
+    refl->ListFields(msg, &fields);
+
+    ++depth;
+    int written = 0;
+    for (const auto* field_desc : fields)
+    {
+        if (written > 0 || leading_comma)
+            out += ',';
+        append_field(msg, refl, field_desc, out);
+        ++written;
+    }
+    --depth;
+    return written;
+}
+
+void goby::middleware::log::protobuf_json::append_string(const std::string& value,
+                                                         std::string& out)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    out += '"';
+    for (std::size_t i = 0, n = value.size(); i < n;)
+    {
+        char c = value[i];
+        switch (c)
+        {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<std::uint8_t>(c) < 0x20)
+                {
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0xF];
+                    out += hex[c & 0xF];
+                }
+                else if (static_cast<std::uint8_t>(c) < 0x80)
+                {
+                    out += c;
+                }
+                else
+                {
+                    std::size_t len = utf8_sequence_length(value, i);
+                    if (len)
+                    {
+                        out.append(value, i, len);
+                        i += len;
+                        continue;
+                    }
+                    else
+                    {
+                        out += "\\ufffd";
+                    }
+                }
+                break;
+        }
+        ++i;
+    }
+    out += '"';
+}
@@ -0,0 +1,64 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_LOG_PROTOBUF_JSON_H
+#define GOBY_MIDDLEWARE_LOG_PROTOBUF_JSON_H
+
+#include <string> // for string
+
+namespace google
+{
+namespace protobuf
+{
+class Message;
+} // namespace protobuf
+} // namespace google
+
+namespace goby
+{
+namespace middleware
+{
+namespace log
+{
+/// \brief Writes Protobuf messages as JSON in a single pass over the message (using reflection), appending to a string buffer.
+///
+/// The output follows the Protobuf JSON mapping with the default options of google::protobuf::util::MessageToJsonString (lowerCamelCase field names, only fields that are set, 64-bit integers as strings, enums by name, bytes as base64, NaN/Infinity as strings), and extensions are written as "[full.extension.name]". Unlike MessageToJsonString, the message is not serialized and re-parsed to do the conversion.
+namespace protobuf_json
+{
+/// \brief Appends the message as a JSON object
+void append_message(const google::protobuf::Message& msg, std::string& out);
+
+/// \brief Appends the fields that are set in the message as comma separated "name":value pairs, without the enclosing braces, so that other keys can be written to the same object
+/// \param leading_comma Write a comma before the first field (if any)
+/// \return Number of fields written
+int append_fields(const google::protobuf::Message& msg, std::string& out, bool leading_comma);
+
+/// \brief Appends the (UTF-8) string as a quoted and escaped JSON string. Invalid UTF-8 sequences are replaced with U+FFFD.
+void append_string(const std::string& value, std::string& out);
+
+} // namespace protobuf_json
+} // namespace log
+} // namespace middleware
+} // namespace goby
+
+#endif
@@ -27,10 +27,12 @@
 #include <google/protobuf/util/json_util.h>
 
 #include "goby/middleware/log.h"
+#include "goby/middleware/log/protobuf_json.h"
 #include "goby/middleware/marshalling/protobuf.h"
 #include "goby/middleware/protobuf/log_tool_config.pb.h"
 #include "goby/time/convert.h"
 #include "goby/util/dccl_compat.h"
+#include "goby/util/debug_logger.h"
 #include "log_plugin.h"
 
 #if GOOGLE_PROTOBUF_VERSION < 3001000
@@ -97,13 +99,29 @@ template <int scheme> class ProtobufPluginBase : public LogPlugin
             google::protobuf::util::MessageToJsonString(*msgs[i], &jstr);
 
             if (n > 1)
-                (*j)[n] = nlohmann::json::parse(jstr);
+                (*j)[i] = nlohmann::json::parse(jstr);
             else
                 (*j) = nlohmann::json::parse(jstr);
         }
         return j;
     }
 
+    /// \brief Writes each message in the entry (DCCL entries may contain several) as a JSON object on its own line, in a single pass from the parsed message to the stream
+    void write_json(LogEntry& log_entry, std::ostream& os) override
+    {
+        auto msgs = parse_message(log_entry);
+
+        for (const auto& msg : msgs)
+        {
+            json_buffer_.clear();
+            json_buffer_ += '{';
+            append_json_metadata(log_entry, json_buffer_);
+            protobuf_json::append_fields(*msg, json_buffer_, true);
+            json_buffer_ += "}\n";
+            os.write(json_buffer_.data(), json_buffer_.size());
+        }
+    }
+
     void register_read_hooks(const std::ifstream& in_log_file) override
     {
         LogEntry::filter_hook[{static_cast<int>(scheme), static_cast<std::string>(file_desc_group),
@@ -313,6 +331,8 @@ template <int scheme> class ProtobufPluginBase : public LogPlugin
     std::set<const google::protobuf::Descriptor*> written_desc_;
     std::set<std::string> read_file_desc_names_;
     bool user_pool_first_;
+    // reused by write_json() to avoid allocating for each entry
+    std::string json_buffer_;
 };
 
 class ProtobufPlugin : public ProtobufPluginBase<goby::middleware::MarshallingScheme::PROTOBUF>
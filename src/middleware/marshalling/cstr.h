@@ -24,6 +24,7 @@
 #ifndef GOBY_MIDDLEWARE_MARSHALLING_CSTR_H
 #define GOBY_MIDDLEWARE_MARSHALLING_CSTR_H
 
+#include <algorithm>
 #include <vector>
 
 #include "interface.h"
@@ -42,6 +43,14 @@ template <> struct SerializerParserHelper<std::string, MarshallingScheme::CSTR>
         return bytes;
     }
 
+    static std::size_t serialized_size(const std::string& msg) { return msg.size() + 1; }
+
+    static void serialize(const std::string& msg, char* buffer, std::size_t size)
+    {
+        std::copy(msg.begin(), msg.end(), buffer);
+        buffer[size - 1] = '\0';
+    }
+
     static std::string type_name(const std::string& d = std::string()) { return "CSTR"; }
 
     template <typename CharIterator>
@@ -56,7 +56,7 @@ std::unordered_map<
 std::mutex goby::middleware::detail::DCCLSerializerParserHelperBase::dccl_mutex_;
 std::set<std::string> goby::middleware::detail::DCCLSerializerParserHelperBase::loaded_proto_files_;
 
-void goby::middleware::detail::DCCLSerializerParserHelperBase::load_metadata(
+bool goby::middleware::detail::DCCLSerializerParserHelperBase::load_metadata(
     const goby::middleware::protobuf::SerializerProtobufMetadata& meta)
 {
     std::lock_guard<std::mutex> lock(dccl_mutex_);
@@ -65,6 +65,7 @@ void goby::middleware::detail::DCCLSerializerParserHelperBase::load_metadata(
     if (auto* desc = dccl::DynamicProtobufManager::find_descriptor(meta.protobuf_name()))
     {
         check_load(desc);
+        return true;
     }
     else
     {
@@ -78,11 +79,17 @@ void goby::middleware::detail::DCCLSerializerParserHelperBase::load_metadata(
         }
 
         if (auto* desc = dccl::DynamicProtobufManager::find_descriptor(meta.protobuf_name()))
+        {
             check_load(desc);
+            return true;
+        }
         else
+        {
             glog.is(goby::util::logger::DEBUG3) &&
                 glog << "Failed to load DCCL message via metadata: " << meta.protobuf_name()
                      << std::endl;
+            return false;
+        }
     }
 }
 
@@ -153,7 +153,15 @@ struct DCCLSerializerParserHelperBase
         }
     }
 
-    static void load_metadata(const goby::middleware::protobuf::SerializerProtobufMetadata& meta);
+    /// \brief Descriptor of the given message if it is available (compiled in or previously loaded from metadata), otherwise nullptr
+    static const google::protobuf::Descriptor* find_descriptor(const std::string& full_name)
+    {
+        std::lock_guard<std::mutex> lock(dccl_mutex_);
+        return dccl::DynamicProtobufManager::find_descriptor(full_name);
+    }
+
+    /// \brief Load the DCCL message described by meta (if not already loaded). Returns false if the message couldn't be found
+    static bool load_metadata(const goby::middleware::protobuf::SerializerProtobufMetadata& meta);
     static goby::middleware::intervehicle::protobuf::DCCLForwardedData
     unpack(const std::string& bytes);
 
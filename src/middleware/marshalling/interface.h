@@ -24,6 +24,8 @@
 #ifndef GOBY_MIDDLEWARE_MARSHALLING_INTERFACE_H
 #define GOBY_MIDDLEWARE_MARSHALLING_INTERFACE_H
 
+#include <algorithm>   // for copy
+#include <cstddef>     // for size_t
 #include <map>         // for map
 #include <memory>      // for share...
 #include <string>      // for string
@@ -135,6 +137,73 @@ template <typename DataType, int scheme, class Enable = void> struct SerializerP
     }
 };
 
+namespace detail
+{
+template <typename Helper, typename DataType, typename = void>
+struct has_buffer_serialize : std::false_type
+{
+};
+
+template <typename Helper, typename DataType>
+struct has_buffer_serialize<
+    Helper, DataType,
+    decltype(void(Helper::serialized_size(std::declval<const DataType&>())),
+             void(Helper::serialize(std::declval<const DataType&>(), std::declval<char*>(),
+                                    std::size_t(0))))> : std::true_type
+{
+};
+} // namespace detail
+
+/// \brief Serializes data directly into a caller-provided buffer (e.g. an outgoing network message) rather than the std::vector<char> returned by SerializerParserHelper::serialize()
+///
+/// Specializations of SerializerParserHelper support this by also defining:
+/// \code
+/// static std::size_t serialized_size(const DataType& d);
+/// // size == serialized_size(d)
+/// static void serialize(const DataType& d, char* buffer, std::size_t size);
+/// \endcode
+/// For those that do not, serialize() is called once on construction and the result copied by write().
+///
+/// \code
+/// BufferSerializer<DataType, scheme> serializer(d);
+/// std::vector<char> buffer(header_size + serializer.size());
+/// serializer.write(buffer.data() + header_size);
+/// \endcode
+template <typename DataType, int scheme, class Enable = void> class BufferSerializer
+{
+  public:
+    explicit BufferSerializer(const DataType& d)
+        : bytes_(SerializerParserHelper<DataType, scheme>::serialize(d))
+    {
+    }
+
+    /// \brief Number of bytes that write() will write
+    std::size_t size() const { return bytes_.size(); }
+    /// \brief Write the serialized data to buffer, which must be at least size() bytes
+    void write(char* buffer) const { std::copy(bytes_.begin(), bytes_.end(), buffer); }
+
+  private:
+    std::vector<char> bytes_;
+};
+
+template <typename DataType, int scheme>
+class BufferSerializer<DataType, scheme,
+                       std::enable_if_t<detail::has_buffer_serialize<
+                           SerializerParserHelper<DataType, scheme>, DataType>::value>>
+{
+  public:
+    /// \brief d must outlive this object and not be modified until write() is called
+    explicit BufferSerializer(const DataType& d) : d_(d), size_(Helper::serialized_size(d)) {}
+
+    std::size_t size() const { return size_; }
+    void write(char* buffer) const { Helper::serialize(d_, buffer, size_); }
+
+  private:
+    using Helper = SerializerParserHelper<DataType, scheme>;
+    const DataType& d_;
+    std::size_t size_;
+};
+
 //
 // scheme
 //
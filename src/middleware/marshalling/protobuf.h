@@ -24,6 +24,7 @@
 #ifndef GOBY_MIDDLEWARE_MARSHALLING_PROTOBUF_H
 #define GOBY_MIDDLEWARE_MARSHALLING_PROTOBUF_H
 
+#include <cstdint>
 #include <mutex>
 
 #include <dccl/dynamic_protobuf_manager.h>
@@ -55,6 +56,15 @@ struct SerializerParserHelper<
         return bytes;
     }
 
+    /// \brief Encoded size of the Protobuf message (also caches the size for serialize(msg, buffer, size))
+    static std::size_t serialized_size(const DataType& msg) { return msg.ByteSizeLong(); }
+
+    /// \brief Serialize Protobuf message into buffer, which must be serialized_size(msg) bytes (computed immediately before, without modifying msg in between)
+    static void serialize(const DataType& msg, char* buffer, std::size_t /*size*/)
+    {
+        msg.SerializeWithCachedSizesToArray(reinterpret_cast<std::uint8_t*>(buffer));
+    }
+
     /// \brief Full protobuf Message name, including package (if one is defined).
     ///
     /// For example, returns "foo.Bar" for the following .proto:
@@ -91,6 +101,18 @@ template <> struct SerializerParserHelper<google::protobuf::Message, Marshalling
         return bytes;
     }
 
+    /// \brief Encoded size of the Protobuf message (also caches the size for serialize(msg, buffer, size))
+    static std::size_t serialized_size(const google::protobuf::Message& msg)
+    {
+        return msg.ByteSizeLong();
+    }
+
+    /// \brief Serialize Protobuf message into buffer, which must be serialized_size(msg) bytes (computed immediately before, without modifying msg in between)
+    static void serialize(const google::protobuf::Message& msg, char* buffer, std::size_t /*size*/)
+    {
+        msg.SerializeWithCachedSizesToArray(reinterpret_cast<std::uint8_t*>(buffer));
+    }
+
     /// \brief Full protobuf name from message instantiation, including package (if one is defined).
     ///
     /// \param d Protobuf message
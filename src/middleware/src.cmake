@@ -29,10 +29,16 @@ set(MIDDLEWARE_SRC
   middleware/marshalling/interface.cpp
   middleware/marshalling/detail/dccl_serializer_parser.cpp 
   middleware/transport/interthread.cpp
+  middleware/transport/poller_wakeup.cpp
   middleware/transport/intervehicle/driver_thread.cpp
+  middleware/transport/intervehicle/metadata.cpp
   middleware/application/configuration_reader.cpp
   middleware/application/tool.cpp
   middleware/log/log_entry.cpp
+  middleware/log/log_tail.cpp
+  middleware/log/indexed_log_reader.cpp
+  middleware/log/compressed_log.cpp
+  middleware/log/protobuf_json.cpp
   middleware/frontseat/interface.cpp
   middleware/coroner/health_monitor_thread.cpp
   ${MIDDLEWARE_PROTO_SRCS} ${MIDDLEWARE_PROTO_HDRS} 
@@ -48,6 +54,7 @@ endif()
 if(enable_hdf5)
   set(MIDDLEWARE_SRC
     middleware/log/hdf5/hdf5.cpp
+    middleware/log/hdf5/hdf5_plan.cpp
     ${MIDDLEWARE_SRC}
     )
 endif()
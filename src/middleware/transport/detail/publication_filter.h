@@ -0,0 +1,109 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_TRANSPORT_DETAIL_PUBLICATION_FILTER_H
+#define GOBY_MIDDLEWARE_TRANSPORT_DETAIL_PUBLICATION_FILTER_H
+
+#include <functional>   // for function
+#include <map>          // for multimap
+#include <mutex>        // for lock_guard
+#include <shared_mutex> // for shared_timed_mutex
+#include <string>       // for string
+
+#include "goby/middleware/protobuf/layer.pb.h"
+
+namespace goby
+{
+namespace middleware
+{
+namespace detail
+{
+/// \brief Registry that allows a Portal to tell the Forwarders in the same process (which run in other threads) whether a given publication has any subscribers, so that they can skip serializing publications that the Portal would discard anyway.
+///
+/// If no Portal has registered a filter for a given layer, all publications are assumed to have subscribers.
+class PublicationFilter
+{
+  public:
+    /// \brief Returns false if a publication of the given type, scheme and group is known to have no subscribers. Must be thread-safe.
+    using HasSubscribers =
+        std::function<bool(const std::string& type_name, int scheme, const std::string& group)>;
+
+    static void add(protobuf::Layer layer, const void* owner, HasSubscribers has_subscribers)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(mutex());
+        filters().insert(std::make_pair(layer, Filter{owner, std::move(has_subscribers)}));
+    }
+
+    static void remove(const void* owner)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(mutex());
+        for (auto it = filters().begin(); it != filters().end();)
+        {
+            if (it->second.owner == owner)
+                it = filters().erase(it);
+            else
+                ++it;
+        }
+    }
+
+    static bool has_subscribers(protobuf::Layer layer, const std::string& type_name, int scheme,
+                                const std::string& group)
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex());
+        auto range = filters().equal_range(layer);
+        if (range.first == range.second)
+            return true;
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second.has_subscribers(type_name, scheme, group))
+                return true;
+        }
+        return false;
+    }
+
+  private:
+    struct Filter
+    {
+        const void* owner;
+        HasSubscribers has_subscribers;
+    };
+
+    static std::multimap<protobuf::Layer, Filter>& filters()
+    {
+        static std::multimap<protobuf::Layer, Filter> filters;
+        return filters;
+    }
+
+    static std::shared_timed_mutex& mutex()
+    {
+        static std::shared_timed_mutex mutex;
+        return mutex;
+    }
+};
+
+} // namespace detail
+} // namespace middleware
+} // namespace goby
+
+#endif
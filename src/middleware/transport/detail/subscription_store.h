@@ -24,7 +24,8 @@
 #ifndef GOBY_MIDDLEWARE_TRANSPORT_DETAIL_SUBSCRIPTION_STORE_H
 #define GOBY_MIDDLEWARE_TRANSPORT_DETAIL_SUBSCRIPTION_STORE_H
 
-#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -35,6 +36,11 @@
 #include <unordered_map>
 #include <vector>
 
+#include <boost/core/demangle.hpp>
+
+#include "goby/middleware/protobuf/coroner.pb.h"
+#include "goby/middleware/protobuf/transporter_config.pb.h"
+#include "goby/middleware/transport/poller_wakeup.h"
 #include "goby/middleware/transport/publisher.h"
 
 namespace goby
@@ -57,8 +63,7 @@ class SubscriptionStoreBase
     virtual ~SubscriptionStoreBase() = default;
 
     // returns number of data items posted to callbacks
-    static int poll_all(std::thread::id thread_id,
-                        std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    static int poll_all(std::thread::id thread_id)
     {
         // make a copy so that other threads can subscribe if
         // necessary in their callbacks
@@ -70,10 +75,23 @@ class SubscriptionStoreBase
         }
 
         int poll_items = 0;
-        for (auto const& s : stores) poll_items += s.second->poll(thread_id, lock);
+        for (auto const& s : stores) poll_items += s.second->poll(thread_id);
         return poll_items;
     }
 
+    /// \brief Adds the state of the given thread's bounded subscription queues (those with a SubscriptionQueue max_depth or overflow policy KEEP_LATEST) to health
+    static void queue_health(std::thread::id thread_id, protobuf::ThreadHealth& health)
+    {
+        StoresMap stores;
+        {
+            std::shared_lock<std::shared_timed_mutex> stores_lock(stores_mutex_);
+            if (stores_.count(thread_id))
+                stores = stores_.at(thread_id);
+        }
+
+        for (auto const& s : stores) s.second->subscription_queue_health(thread_id, health);
+    }
+
     static void unsubscribe_all(std::thread::id thread_id)
     {
         std::shared_lock<std::shared_timed_mutex> stores_lock(stores_mutex_);
@@ -105,22 +123,21 @@ class SubscriptionStoreBase
     }
 
   protected:
-    virtual int poll(std::thread::id thread_id,
-                     std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock) = 0;
+    virtual int poll(std::thread::id thread_id) = 0;
     virtual void unsubscribe_all_groups(std::thread::id thread_id) = 0;
+    virtual void subscription_queue_health(std::thread::id thread_id,
+                                           protobuf::ThreadHealth& health) = 0;
 };
 
 struct DataProtection
 {
-    DataProtection(std::shared_ptr<std::mutex> dm, std::shared_ptr<std::condition_variable_any> pcv,
-                   std::shared_ptr<std::timed_mutex> pm)
-        : data_mutex(dm), poller_cv(pcv), poller_mutex(pm)
+    DataProtection(std::shared_ptr<std::mutex> dm, std::shared_ptr<PollerWakeup> pw)
+        : data_mutex(dm), poller_wakeup(pw)
     {
     }
 
     std::shared_ptr<std::mutex> data_mutex;
-    std::shared_ptr<std::condition_variable_any> poller_cv;
-    std::shared_ptr<std::timed_mutex> poller_mutex;
+    std::shared_ptr<PollerWakeup> poller_wakeup;
 };
 
 /// \brief Storage class for a specific interthread subscription (and related data). Used by InterThreadTransporter
@@ -129,31 +146,23 @@ template <typename Data> class SubscriptionStore : public SubscriptionStoreBase
   public:
     static void subscribe(std::function<void(std::shared_ptr<const Data>)> func, const Group& group,
                           std::thread::id thread_id, std::shared_ptr<std::mutex> data_mutex,
-                          std::shared_ptr<std::condition_variable_any> cv,
-                          std::shared_ptr<std::timed_mutex> poller_mutex)
+                          std::shared_ptr<PollerWakeup> poller_wakeup,
+                          const protobuf::TransporterConfig::SubscriptionQueue& queue_cfg =
+                              protobuf::TransporterConfig::SubscriptionQueue())
     {
         {
             std::lock_guard<std::shared_timed_mutex> lock(subscription_mutex_);
 
-            // insert callback
-            auto it =
-                subscription_callbacks_.insert(std::make_pair(thread_id, Callback(group, func)));
+            // insert callback (which owns the queue of data for this subscription)
+            auto it = subscription_callbacks_.insert(
+                std::make_pair(thread_id, Callback(group, func, queue_cfg)));
             // insert group with iterator to callback
             subscription_groups_.insert(std::make_pair(group, it));
 
-            // if necessary, create a DataQueue for this thread
-            auto queue_it = data_.find(thread_id);
-            if (queue_it == data_.end())
-            {
-                auto bool_it_pair = data_.insert(std::make_pair(thread_id, DataQueue()));
-                queue_it = bool_it_pair.first;
-            }
-            queue_it->second.create(group);
-
-            // if we don't have a condition variable already for this thread, store it
+            // if we don't have a wakeup already for this thread, store it
             if (!data_protection_.count(thread_id))
                 data_protection_.insert(std::make_pair(
-                    thread_id, detail::DataProtection(data_mutex, cv, poller_mutex)));
+                    thread_id, detail::DataProtection(data_mutex, poller_wakeup)));
         }
 
         // try inserting a copy of this templated class via the base class for SubscriptionStoreBase::poll_all to use
@@ -181,10 +190,6 @@ template <typename Data> class SubscriptionStore : public SubscriptionStoreBase
                     ++it;
                 }
             }
-
-            // remove the dataqueue for this group
-            auto queue_it = data_.find(thread_id);
-            queue_it->second.remove(group);
         }
     }
 
@@ -192,8 +197,10 @@ template <typename Data> class SubscriptionStore : public SubscriptionStoreBase
                         const Publisher<Data>& publisher)
     {
         // push new data
-        // build up local vector of relevant condition variables while locked
-        std::vector<detail::DataProtection> cv_to_notify;
+        // build up local vector of relevant wakeups while locked
+        // (reused between calls to avoid allocating on every publication)
+        static thread_local std::vector<std::shared_ptr<PollerWakeup>> to_notify;
+        to_notify.clear();
         {
             std::shared_lock<std::shared_timed_mutex> lock(subscription_mutex_);
 
@@ -205,72 +212,57 @@ template <typename Data> class SubscriptionStore : public SubscriptionStoreBase
                 // don't store a copy if publisher == subscriber, and echo is false
                 if (thread_id != std::this_thread::get_id() || publisher.cfg().echo())
                 {
-                    // protect the DataQueue we are writing to
-                    std::unique_lock<std::mutex> lock(*(data_protection_.at(thread_id).data_mutex));
-                    auto queue_it = data_.find(thread_id);
-                    queue_it->second.insert(group, data);
-                    cv_to_notify.push_back(data_protection_.at(thread_id));
+                    // protect the queue we are writing to
+                    const auto& protection = data_protection_.at(thread_id);
+                    {
+                        std::lock_guard<std::mutex> lock(*protection.data_mutex);
+                        it->second->second.push(data);
+                    }
+                    to_notify.push_back(protection.poller_wakeup);
                 }
             }
         }
 
-        // unlock and notify condition variables from local vector
-        for (const auto& data_protection : cv_to_notify)
-        {
-            {
-                // lock to ensure the other thread isn't in the limbo region
-                // between _poll_all() and wait(), where the condition variable
-                // signal would be lost
-
-                std::lock_guard<std::timed_mutex>(*data_protection.poller_mutex);
-            }
-            data_protection.poller_cv->notify_all();
-        }
+        // notify after unlocking: the wakeup's sequence counter ensures the notification isn't lost even if the other thread is between polling and waiting
+        for (const auto& wakeup : to_notify) wakeup->notify();
+        to_notify.clear();
     }
 
   private:
-    int poll(std::thread::id thread_id,
-             std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock) override
+    int poll(std::thread::id thread_id) override
     {
-        std::vector<std::pair<std::shared_ptr<typename Callback::CallbackType>,
-                              std::shared_ptr<const Data>>>
-            data_callbacks;
+        using DataCallbacks = std::vector<std::pair<std::shared_ptr<typename Callback::CallbackType>,
+                                                    std::shared_ptr<const Data>>>;
+        // reuse the capacity from the previous poll (swapped out, as callbacks may poll again)
+        static thread_local DataCallbacks data_callbacks_cache;
+        DataCallbacks data_callbacks;
+        data_callbacks.swap(data_callbacks_cache);
         int poll_items_count = 0;
 
         {
             std::shared_lock<std::shared_timed_mutex> sub_lock(subscription_mutex_);
 
-            auto queue_it = data_.find(thread_id);
-            if (queue_it == data_.end())
+            auto protection_it = data_protection_.find(thread_id);
+            if (protection_it == data_protection_.end())
+            {
+                data_callbacks_cache.swap(data_callbacks);
                 return 0; // no subscriptions
+            }
 
-            std::unique_lock<std::mutex> data_lock(
-                *(data_protection_.find(thread_id)->second.data_mutex));
+            std::unique_lock<std::mutex> data_lock(*(protection_it->second.data_mutex));
 
-            // loop over all Groups stored in this DataQueue
-            for (auto data_it = queue_it->second.cbegin(), end = queue_it->second.cend();
-                 data_it != end; ++data_it)
+            // loop over all the subscriptions for this thread
+            auto range = subscription_callbacks_.equal_range(thread_id);
+            for (auto it = range.first; it != range.second; ++it)
             {
-                const Group& group = data_it->first;
-                auto group_range = subscription_groups_.equal_range(group);
-                // For a given Group, loop over all subscriptions to this Group
-                for (auto group_it = group_range.first; group_it != group_range.second; ++group_it)
+                auto& queue = it->second.queue;
+                // store the callback function and datum for all the elements queued
+                for (auto& datum : queue)
                 {
-                    if (group_it->second->first != thread_id)
-                        continue;
-
-                    // store the callback function and datum for all the elements queued
-                    for (auto& datum : data_it->second)
-                    {
-                        ++poll_items_count;
-                        // we have data, no need to keep this lock any longer
-                        if (lock)
-                            lock.reset();
-                        data_callbacks.push_back(
-                            std::make_pair(group_it->second->second.callback, datum));
-                    }
+                    ++poll_items_count;
+                    data_callbacks.push_back(std::make_pair(it->second.callback, std::move(datum)));
                 }
-                queue_it->second.clear(group);
+                queue.clear();
             }
         }
 
@@ -278,6 +270,10 @@ template <typename Data> class SubscriptionStore : public SubscriptionStoreBase
         for (const auto& callback_datum_pair : data_callbacks)
             (*callback_datum_pair.first)(std::move(callback_datum_pair.second));
 
+        // release the data (e.g. back to a MessagePool) before caching the vector
+        data_callbacks.clear();
+        data_callbacks_cache.swap(data_callbacks);
+
         return poll_items_count;
     }
 
@@ -301,73 +297,106 @@ template <typename Data> class SubscriptionStore : public SubscriptionStoreBase
                 }
             }
 
-            data_.erase(thread_id);
             data_protection_.erase(thread_id);
         }
     }
 
-  private:
-    struct Callback
+    void subscription_queue_health(std::thread::id thread_id,
+                                   protobuf::ThreadHealth& health) override
     {
-        using CallbackType = std::function<void(std::shared_ptr<const Data>)>;
-        Callback(const Group& g, const std::function<void(std::shared_ptr<const Data>)>& c)
-            : group(g), callback(new CallbackType(c))
+        std::shared_lock<std::shared_timed_mutex> sub_lock(subscription_mutex_);
+        auto protection_it = data_protection_.find(thread_id);
+        if (protection_it == data_protection_.end())
+            return;
+
+        std::lock_guard<std::mutex> data_lock(*(protection_it->second.data_mutex));
+        auto range = subscription_callbacks_.equal_range(thread_id);
+        for (auto it = range.first; it != range.second; ++it)
         {
+            const Callback& sub = it->second;
+            if (!sub.bounded())
+                continue;
+
+            auto& queue_health = *health.add_subscription_queue();
+            queue_health.set_group(std::string(sub.group));
+            queue_health.set_type(boost::core::demangle(typeid(Data).name()));
+            queue_health.set_max_depth(sub.max_depth);
+            queue_health.set_overflow(sub.overflow);
+            queue_health.set_depth(sub.queue.size());
+            queue_health.set_dropped(sub.dropped);
         }
-        Group group;
-        std::shared_ptr<CallbackType> callback;
-    };
+    }
 
-    class DataQueue
+  private:
+    struct Callback
     {
-      private:
-        std::unordered_map<Group, std::vector<std::shared_ptr<const Data>>> data_;
-
-      public:
-        void create(const Group& g)
+        using CallbackType = std::function<void(std::shared_ptr<const Data>)>;
+        using QueueConfig = protobuf::TransporterConfig::SubscriptionQueue;
+
+        Callback(const Group& g, const std::function<void(std::shared_ptr<const Data>)>& c,
+                 const QueueConfig& queue_cfg)
+            : group(g),
+              callback(new CallbackType(c)),
+              max_depth(queue_cfg.overflow() == QueueConfig::KEEP_LATEST ? 1
+                                                                         : queue_cfg.max_depth()),
+              overflow(queue_cfg.overflow())
         {
-            auto it = data_.find(g);
-            if (it == data_.end())
-                data_.insert(std::make_pair(g, std::vector<std::shared_ptr<const Data>>()));
         }
-        void remove(const Group& g) { data_.erase(g); }
 
-        void insert(const Group& g, std::shared_ptr<const Data> datum)
+        // the rest is protected by the subscribing thread's data mutex
+        void push(std::shared_ptr<const Data> datum)
         {
-            data_.find(g)->second.push_back(datum);
+            if (max_depth == 0 || queue.size() < max_depth)
+            {
+                queue.push_back(std::move(datum));
+                return;
+            }
+
+            ++dropped;
+            switch (overflow)
+            {
+                case QueueConfig::DROP_NEWEST: break;
+                case QueueConfig::DROP_OLDEST:
+                    queue.pop_front();
+                    queue.push_back(std::move(datum));
+                    break;
+                case QueueConfig::KEEP_LATEST:
+                    // conflate: replace the pending value
+                    queue.back() = std::move(datum);
+                    break;
+            }
         }
-        void clear(const Group& g) { data_.find(g)->second.clear(); }
-        bool empty() { return data_.empty(); }
-        typename decltype(data_)::const_iterator cbegin() { return data_.begin(); }
-        typename decltype(data_)::const_iterator cend() { return data_.end(); }
+
+        bool bounded() const { return max_depth > 0; }
+
+        Group group;
+        std::shared_ptr<CallbackType> callback;
+        // zero for unbounded
+        std::uint32_t max_depth;
+        QueueConfig::OverflowPolicy overflow;
+        // data awaiting poll() by the subscribing thread
+        std::deque<std::shared_ptr<const Data>> queue;
+        std::uint64_t dropped{0};
     };
 
     // subscriptions for a given thread
     static std::unordered_multimap<std::thread::id, Callback> subscription_callbacks_;
     // threads that are subscribed to a given group
-    static std::unordered_multimap<Group,
-                                   typename decltype(subscription_callbacks_)::const_iterator>
+    static std::unordered_multimap<Group, typename decltype(subscription_callbacks_)::iterator>
         subscription_groups_;
-    // condition variable to use for data
+    // mutex and wakeup to use for data
     static std::unordered_map<std::thread::id, detail::DataProtection> data_protection_;
 
     static std::shared_timed_mutex
-        subscription_mutex_; // protects subscription_callbacks, subscription_groups, data_protection, and the overarching data_ map (but not the DataQueues within it, which are protected by the mutexes stored in data_protection_))
-
-    // data for a given thread
-    static std::unordered_map<std::thread::id, DataQueue> data_;
+        subscription_mutex_; // protects subscription_callbacks, subscription_groups, and data_protection (but not the queues within the subscription callbacks, which are protected by the mutexes stored in data_protection_))
 };
 
 template <typename Data>
 std::unordered_multimap<std::thread::id, typename SubscriptionStore<Data>::Callback>
     SubscriptionStore<Data>::subscription_callbacks_;
 template <typename Data>
-std::unordered_map<std::thread::id, typename SubscriptionStore<Data>::DataQueue>
-    SubscriptionStore<Data>::data_;
-template <typename Data>
 std::unordered_multimap<goby::middleware::Group,
-                        typename decltype(
-                            SubscriptionStore<Data>::subscription_callbacks_)::const_iterator>
+                        typename decltype(SubscriptionStore<Data>::subscription_callbacks_)::iterator>
     SubscriptionStore<Data>::subscription_groups_;
 template <typename Data>
 std::unordered_map<std::thread::id, detail::DataProtection>
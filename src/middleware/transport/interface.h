@@ -37,6 +37,7 @@
 #include "goby/middleware/protobuf/intervehicle.pb.h"
 #include "goby/middleware/protobuf/transporter_config.pb.h"
 #include "goby/middleware/transport/detail/type_helpers.h"
+#include "goby/middleware/transport/poller_wakeup.h"
 #include "goby/middleware/transport/publisher.h"
 #include "goby/middleware/transport/subscriber.h"
 #include "goby/util/debug_logger.h"
@@ -154,37 +155,46 @@ class PollerInterface
     template <class Clock = std::chrono::system_clock, class Duration = typename Clock::duration>
     int poll(Duration wait_for);
 
-    /// \brief access the mutex used for poll synchronization
+    /// \brief access the wakeup used for poll synchronization
     ///
-    /// \return pointer to the mutex used for polling
-    std::shared_ptr<std::timed_mutex> poll_mutex() { return poll_mutex_; }
+    /// Notifications on this wakeup will cause the poll() loop to assume there is incoming data available (typically this is notified by the publishing thread in InterThreadTransporter, but can be used to synchronize the Goby poller infrastructure with other synchronous events, such as boost::asio, file descriptors, etc. For an example, see io::IOThread)
+    /// \return pointer to the wakeup used for polling
+    std::shared_ptr<PollerWakeup> wakeup() { return wakeup_; }
 
-    /// \brief access the condition variable used for poll synchronization
-    ///
-    /// Notifications on this condition variable will cause the poll() loop to assume there is incoming data available (typically this is notified by the publishing thread in InterThreadTransporter, but can be used to synchronize the Goby poller infrastructure with other synchronous events, such as boost::asio, file descriptors, etc. For an example, see io::IOThread)
-    /// \return pointer to the condition variable used for polling
-    std::shared_ptr<std::condition_variable_any> cv() { return cv_; }
+    /// \brief Previously the mutex locked by poll() while checking for data. No longer used by poll(), so locking it before notifying cv() is unnecessary (but harmless).
+    [[deprecated("use wakeup()")]] std::shared_ptr<std::timed_mutex> poll_mutex()
+    {
+        return poll_mutex_;
+    }
+
+    /// \brief Previously the condition variable waited on by poll(). Now an adapter whose notify_one() and notify_all() call wakeup()->notify(), and whose wait(lock, ...) functions return after the next notification.
+    [[deprecated("use wakeup()->notify()")]] std::shared_ptr<PollerWakeupCondition> cv()
+    {
+        return cv_;
+    }
 
   protected:
-    PollerInterface(std::shared_ptr<std::timed_mutex> poll_mutex,
-                    std::shared_ptr<std::condition_variable_any> cv)
-        : poll_mutex_(poll_mutex), cv_(cv)
+    PollerInterface(std::shared_ptr<PollerWakeup> wakeup)
+        : wakeup_(wakeup), cv_(std::make_shared<PollerWakeupCondition>(wakeup))
     {
     }
 
   private:
     template <typename Transporter> friend class Poller;
     // poll the transporter for data
-    virtual int _transporter_poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock) = 0;
+    virtual int _transporter_poll() = 0;
 
   private:
     // poll all the transporters for data, including a timeout (only called by the outside-most Poller)
     template <class Clock = std::chrono::system_clock, class Duration = typename Clock::duration>
     int _poll_all(const std::chrono::time_point<Clock, Duration>& timeout);
 
-    std::shared_ptr<std::timed_mutex> poll_mutex_;
-    // signaled when there's no data for this thread to read during _poll()
-    std::shared_ptr<std::condition_variable_any> cv_;
+    // notified when there's data for this thread to read during _poll()
+    std::shared_ptr<PollerWakeup> wakeup_;
+
+    // for the deprecated poll_mutex() and cv()
+    std::shared_ptr<std::timed_mutex> poll_mutex_{std::make_shared<std::timed_mutex>()};
+    std::shared_ptr<PollerWakeupCondition> cv_;
 };
 
 /// \brief Used to tag subscriptions based on their necessity (e.g. required for correct functioning, or optional)
@@ -360,40 +370,17 @@ template <class Clock, class Duration>
 int goby::middleware::PollerInterface::_poll_all(
     const std::chrono::time_point<Clock, Duration>& timeout)
 {
-    // hold this lock until either we find a polled item or we wait on the condition variable
-    std::unique_ptr<std::unique_lock<std::timed_mutex>> lock(
-        new std::unique_lock<std::timed_mutex>(*poll_mutex_));
-    //    std::cout << std::this_thread::get_id() <<  " _poll_all locking: " << poll_mutex_.get() << std::endl;
-
-    int poll_items = _transporter_poll(lock);
-    while (poll_items == 0)
+    for (;;)
     {
-        if (!lock)
-            throw(goby::Exception(
-                "Poller lock was released by poll() but no poll items were returned"));
-
-        if (timeout == Clock::time_point::max())
-        {
-            cv_->wait(*lock); // wait_until doesn't work well with time_point::max()
-            poll_items = _transporter_poll(lock);
-
-            // TODO: fix this message now that zeromq::InterProcessPortal can have
-            // a condition_variable trigger for REQUEST_HOLD_STATE
-            //if (poll_items == 0)
-            //                goby::glog.is(goby::util::logger::DEBUG3) &&
-            //                    goby::glog << "PollerInterface condition_variable: no data (spurious?) wakeup"
-            //                               << std::endl;
-        }
-        else
-        {
-            if (cv_->wait_until(*lock, timeout) == std::cv_status::no_timeout)
-                poll_items = _transporter_poll(lock);
-            else
-                return poll_items;
-        }
+        // read before polling: any data published after this point changes the sequence, so the wait below returns immediately rather than missing it
+        auto seq = wakeup_->sequence();
+        int poll_items = _transporter_poll();
+        if (poll_items > 0)
+            return poll_items;
+
+        if (!wakeup_->wait_until(seq, timeout))
+            return 0;
     }
-
-    return poll_items;
 }
 
 #endif
@@ -76,12 +76,23 @@ class InterModuleForwarder
     InterModuleForwarder(InnerTransporter& inner) : Base(inner) {}
     virtual ~InterModuleForwarder() { this->unsubscribe_all(); }
 
+    /// \brief Number of publications that were not serialized or forwarded as the Portal reported that no module is subscribed to them
+    std::uint64_t publications_skipped() const { return publications_skipped_; }
+
     friend Base;
 
   private:
     template <typename Data, int scheme>
     void _publish(const Data& d, const Group& group, const Publisher<Data>& publisher)
     {
+        std::string type_name = SerializerParserHelper<Data, scheme>::type_name(d);
+        if (!detail::PublicationFilter::has_subscribers(protobuf::LAYER_INTERMODULE, type_name,
+                                                        scheme, group))
+        {
+            ++publications_skipped_;
+            return;
+        }
+
         //create and forward publication to edge
 
         std::vector<char> bytes(SerializerParserHelper<Data, scheme>::serialize(d));
@@ -90,7 +101,7 @@ class InterModuleForwarder
         auto* key = msg.mutable_key();
 
         key->set_marshalling_scheme(scheme);
-        key->set_type(SerializerParserHelper<Data, scheme>::type_name(d));
+        key->set_type(type_name);
         key->set_group(std::string(group));
         msg.set_allocated_data(sbytes);
 
@@ -172,7 +183,7 @@ class InterModuleForwarder
     // {
     // }
 
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    int _poll()
     {
         return 0;
     } // A forwarder is a shell, only the inner Transporter has data
@@ -181,6 +192,7 @@ class InterModuleForwarder
     std::multimap<protobuf::SerializerTransporterKey,
                   std::shared_ptr<const middleware::SerializationHandlerBase<>>>
         subscriptions_;
+    std::uint64_t publications_skipped_{0};
 };
 
 template <typename Derived, typename InnerTransporter>
@@ -194,6 +206,9 @@ class InterModulePortalBase : public InterModuleTransporterBase<Derived, InnerTr
 
     virtual ~InterModulePortalBase() {}
 
+    /// \brief Layer used to register with detail::PublicationFilter
+    static constexpr protobuf::Layer layer() { return protobuf::LAYER_INTERMODULE; }
+
   private:
     void _init()
     {
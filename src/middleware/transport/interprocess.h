@@ -26,7 +26,9 @@
 #define GOBY_MIDDLEWARE_TRANSPORT_INTERPROCESS_H
 
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <future>
 #include <sys/types.h>
 #include <thread>
 #include <tuple>
@@ -35,6 +37,7 @@
 #include "goby/middleware/group.h"
 
 #include "goby/middleware/marshalling/interface.h"
+#include "goby/middleware/transport/detail/publication_filter.h"
 #include "goby/middleware/transport/null.h"
 #include "goby/middleware/transport/poller.h"
 #include "goby/middleware/transport/serialization_handlers.h"
@@ -138,6 +141,39 @@ class InterProcessTransporterBase
         static_cast<Derived*>(this)->_publish_serialized(type_name, scheme, bytes, group);
     }
 
+    /// \brief Publish a message along with its bytes, already serialized for the given scheme by the caller (e.g. by an outer layer that also needed them). Equivalent to publish_dynamic() without serializing again.
+    ///
+    /// \param data Message to publish to the inner layer
+    /// \param bytes \c data serialized using \c scheme, published on this layer
+    /// \param group group to publish this message to (typically a DynamicGroup)
+    /// \param publisher Optional metadata that controls the publication or sets callbacks to monitor the result. Typically unnecessary for interprocess and inner layers.
+    template <typename Data, int scheme>
+    void publish_dynamic_serialized(std::shared_ptr<const Data> data,
+                                    const std::vector<char>& bytes, const Group& group,
+                                    const Publisher<Data>& publisher = Publisher<Data>())
+    {
+        if (data)
+        {
+            check_validity_runtime(group);
+            static_cast<Derived*>(this)->_publish_serialized(
+                SerializerParserHelper<Data, scheme>::type_name(*data), scheme, bytes, group);
+            this->inner().template publish_dynamic<Data, scheme>(data, group, publisher);
+        }
+    }
+
+    /// \brief Publish a message on this layer only, not to the inner layer (for an additional scheme of data that the inner layer has already received). As with publish_dynamic(), the message is only serialized if it has subscribers.
+    ///
+    /// \param data Message to publish
+    /// \param group group to publish this message to (typically a DynamicGroup)
+    /// \param publisher Optional metadata that controls the publication or sets callbacks to monitor the result. Typically unnecessary for interprocess and inner layers.
+    template <typename Data, int scheme>
+    void publish_dynamic_no_inner(const Data& data, const Group& group,
+                                  const Publisher<Data>& publisher = Publisher<Data>())
+    {
+        check_validity_runtime(group);
+        static_cast<Derived*>(this)->template _publish<Data, scheme>(data, group, publisher);
+    }
+
     /// \brief Subscribe to a specific run-time defined group and data type (const reference variant). Where possible, prefer the static variant in StaticTransporterInterface::subscribe()
     ///
     /// \tparam Data data type to subscribe to.
@@ -273,9 +309,9 @@ class InterProcessTransporterBase
 
   private:
     friend PollerType;
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    int _poll()
     {
-        return static_cast<Derived*>(this)->_poll(lock);
+        return static_cast<Derived*>(this)->_poll();
     }
 };
 
@@ -315,53 +351,48 @@ class InterProcessForwarder
     }
     virtual ~InterProcessForwarder()
     {
-        this->unsubscribe_all();
-
-        // TODO - remove by adding in an explicit handshake with the unsubscribe_all publication so that we don't delete ourself (and thus our inner()) before the Portal has deleted all the subscriptions
-        usleep(1e5);
+        // wait until the Portal has deleted all the subscriptions (which refer to our inner()) before deleting ourself. The wait ends immediately if no Portal received the unsubscription, and is bounded in case the Portal thread isn't polling (e.g. is joining this thread)
+        auto acknowledgment = _publish_unsubscribe_all();
+        acknowledgment.wait_for(unsubscribe_all_timeout_);
     }
 
+    /// \brief Number of publications that were not serialized or forwarded as the Portal reported that no process is subscribed to them
+    std::uint64_t publications_skipped() const { return publications_skipped_; }
+
     friend Base;
 
   private:
     template <typename Data, int scheme>
-    void _publish(const Data& d, const Group& group, const Publisher<Data>& publisher)
+    void _publish(const Data& d, const Group& group, const Publisher<Data>& /*publisher*/)
     {
-        // create and forward publication to edge
-        std::vector<char> bytes(SerializerParserHelper<Data, scheme>::serialize(d));
-        std::string* sbytes = new std::string(bytes.begin(), bytes.end());
-        auto msg = std::make_shared<goby::middleware::protobuf::SerializerTransporterMessage>();
-        auto* key = msg->mutable_key();
-
-        key->set_marshalling_scheme(scheme);
-        key->set_type(SerializerParserHelper<Data, scheme>::type_name(d));
-        key->set_group(std::string(group));
-        msg->set_allocated_data(sbytes);
-
-        *key->mutable_cfg() = publisher.cfg();
+        std::string type_name = SerializerParserHelper<Data, scheme>::type_name(d);
+        if (!_has_subscribers(type_name, scheme, group))
+            return;
 
-        this->inner().template publish<Base::to_portal_group_>(msg);
+        // create and forward publication to edge
+        auto publication = std::make_shared<const SerializedPublication>(
+            type_name, scheme, std::string(group),
+            SerializerParserHelper<Data, scheme>::serialize(d));
+        this->inner().template publish<Base::to_portal_group_>(publication);
     }
 
     void _publish_serialized(std::string type_name, int scheme, const std::vector<char>& bytes,
                              const goby::middleware::Group& group)
     {
-        auto msg = std::make_shared<goby::middleware::protobuf::SerializerTransporterMessage>();
-        auto* key = msg->mutable_key();
-
-        key->set_marshalling_scheme(scheme);
-        key->set_type(type_name);
-        key->set_group(std::string(group));
-        msg->set_data(std::string(bytes.begin(), bytes.end()));
+        if (!_has_subscribers(type_name, scheme, group))
+            return;
 
-        this->inner().template publish<Base::to_portal_group_>(msg);
+        auto publication = std::make_shared<const SerializedPublication>(
+            type_name, scheme, std::string(group), bytes);
+        this->inner().template publish<Base::to_portal_group_>(publication);
     }
 
     template <typename Data, int scheme>
     void _subscribe(std::function<void(std::shared_ptr<const Data> d)> f, const Group& group,
                     const Subscriber<Data>& subscriber)
     {
-        this->inner().template subscribe_dynamic<Data, scheme>(f, group);
+        // the subscriber's SubscriptionQueue (if any) applies to the interthread queue of data from the portal
+        this->inner().template subscribe_dynamic<Data, scheme>(f, group, subscriber);
 
         // forward subscription to edge
         auto inner_publication_lambda = [=](std::shared_ptr<const Data> d) {
@@ -389,11 +420,15 @@ class InterProcessForwarder
             unsubscription);
     }
 
-    void _unsubscribe_all()
+    void _unsubscribe_all() { _publish_unsubscribe_all(); }
+
+    std::future<void> _publish_unsubscribe_all()
     {
         regex_subscriptions_.clear();
         auto all = std::make_shared<SerializationUnSubscribeAll>();
+        auto acknowledgment = all->acknowledgment();
         this->inner().template publish<Base::to_portal_group_, SerializationUnSubscribeAll>(all);
+        return acknowledgment;
     }
 
     std::shared_ptr<SerializationSubscriptionRegex>
@@ -434,15 +469,31 @@ class InterProcessForwarder
                       msg->key().type(), msg->key().group());
     }
 
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    int _poll()
     {
         return 0;
     } // A forwarder is a shell, only the inner Transporter has data
 
+    bool _has_subscribers(const std::string& type_name, int scheme, const Group& group)
+    {
+        if (detail::PublicationFilter::has_subscribers(protobuf::LAYER_INTERPROCESS, type_name,
+                                                       scheme, group))
+            return true;
+        ++publications_skipped_;
+        return false;
+    }
+
   private:
     std::set<std::shared_ptr<const SerializationSubscriptionRegex>> regex_subscriptions_;
+    std::uint64_t publications_skipped_{0};
+    // longest wait in the destructor for the Portal to acknowledge the unsubscription
+    static constexpr std::chrono::milliseconds unsubscribe_all_timeout_{100};
 };
 
+template <typename InnerTransporter>
+constexpr std::chrono::milliseconds
+    InterProcessForwarder<InnerTransporter>::unsubscribe_all_timeout_;
+
 template <typename Derived, typename InnerTransporter>
 class InterProcessPortalBase : public InterProcessTransporterBase<Derived, InnerTransporter>
 {
@@ -454,12 +505,14 @@ class InterProcessPortalBase : public InterProcessTransporterBase<Derived, Inner
 
     virtual ~InterProcessPortalBase() {}
 
+    /// \brief Layer used to register with detail::PublicationFilter
+    static constexpr protobuf::Layer layer() { return protobuf::LAYER_INTERPROCESS; }
+
   private:
     void _init()
     {
-        using goby::middleware::protobuf::SerializerTransporterMessage;
-        this->inner().template subscribe<Base::to_portal_group_, SerializerTransporterMessage>(
-            [this](std::shared_ptr<const SerializerTransporterMessage> d) {
+        this->inner().template subscribe<Base::to_portal_group_, SerializedPublication>(
+            [this](std::shared_ptr<const SerializedPublication> d) {
                 static_cast<Derived*>(this)->_receive_publication_forwarded(*d);
             });
 
@@ -476,6 +529,7 @@ class InterProcessPortalBase : public InterProcessTransporterBase<Derived, Inner
         this->inner().template subscribe<Base::to_portal_group_, SerializationUnSubscribeAll>(
             [this](std::shared_ptr<const middleware::SerializationUnSubscribeAll> s) {
                 static_cast<Derived*>(this)->_unsubscribe_all(s->subscriber_id());
+                s->acknowledge();
             });
     }
 };
@@ -34,6 +34,7 @@
 #include "goby/middleware/marshalling/interface.h"               // for Mar...
 #include "goby/middleware/transport/detail/subscription_store.h" // for Sub...
 #include "goby/middleware/transport/interface.h"                 // for Sta...
+#include "goby/middleware/transport/message_pool.h"              // for Mes...
 #include "goby/middleware/transport/null.h"                      // for Nul...
 #include "goby/middleware/transport/poller.h"                    // for Poller
 #include "goby/middleware/transport/publisher.h"                 // for Pub...
@@ -53,6 +54,15 @@ namespace middleware
 /// interthread.publish<groups::nav>(data);
 /// // after this point 'data' should not be mutated (but may be read or re-published)
 /// \endcode
+///
+/// Data published to a subscriber are queued until the subscribing thread polls. By default the queue is unbounded; to limit it (e.g. for a slow thread, or a state topic where only the newest value is needed), set the SubscriptionQueue in the Subscriber's TransporterConfig. Discarded data are counted in the thread's health report (ThreadHealth::subscription_queue).
+/// \code
+/// protobuf::TransporterConfig cfg;
+/// cfg.mutable_queue()->set_overflow(protobuf::TransporterConfig::SubscriptionQueue::KEEP_LATEST);
+/// interthread.subscribe<groups::nav, protobuf::NavigationReport>(
+///     [](const protobuf::NavigationReport& nav) { /* ... */ },
+///     Subscriber<protobuf::NavigationReport>(cfg));
+/// \endcode
 class InterThreadTransporter
     : public StaticTransporterInterface<InterThreadTransporter, NullTransporter>,
       public Poller<InterThreadTransporter>
@@ -134,6 +144,43 @@ class InterThreadTransporter
         publish_dynamic<Data, scheme>(std::shared_ptr<const Data>(data), group, publisher);
     }
 
+    /// \brief Returns a mutable message from this thread's MessagePool for \c Data, to be filled in and then published using one of the shared pointer publish() overloads.
+    ///
+    /// The message is returned to the pool (rather than deleted) once it has been released by all subscribers, so high rate publishers avoid heap allocation in the steady state.
+    /// \code
+    /// auto imu = interthread.acquire_pooled<protobuf::IMUData>();
+    /// imu->set_angular_velocity(0.1);
+    /// interthread.publish<groups::imu>(imu);
+    /// \endcode
+    template <typename Data> static std::shared_ptr<Data> acquire_pooled()
+    {
+        return pool<Data>().acquire();
+    }
+
+    /// \brief Publish a copy of \c data made into a message from this thread's MessagePool. Unlike publish(const Data&), this does not allocate in the steady state (for Protobuf messages, the recycled message retains its string capacity).
+    ///
+    /// \tparam group group to publish this message to (reference to constexpr Group)
+    /// \tparam Data data type to publish. Can usually be inferred from the \c data parameter.
+    /// \tparam scheme Marshalling scheme id (typically MarshallingScheme::MarshallingSchemeEnum). Can usually be inferred from the Data type.
+    /// \param data Message to publish
+    /// \param publisher Optional metadata that controls the publication or sets callbacks to monitor the result.
+    template <const Group& group, typename Data, int scheme = scheme<Data>()>
+    void publish_pooled(const Data& data, const Publisher<Data>& publisher = Publisher<Data>())
+    {
+        check_validity<group>();
+        publish_dynamic_pooled<Data, scheme>(data, group, publisher);
+    }
+
+    /// \brief Publish a copy of \c data made into a message from this thread's MessagePool using a run-time defined DynamicGroup. Where possible, prefer the static variant publish_pooled()
+    template <typename Data, int scheme = scheme<Data>()>
+    void publish_dynamic_pooled(const Data& data, const Group& group,
+                                const Publisher<Data>& publisher = Publisher<Data>())
+    {
+        std::shared_ptr<Data> data_ptr = acquire_pooled<Data>();
+        *data_ptr = data;
+        publish_dynamic<Data, scheme>(data_ptr, group, publisher);
+    }
+
     /// \brief Publish with no data (used to signal another thread)
     template <const Group& group> void publish_empty()
     {
@@ -149,13 +196,12 @@ class InterThreadTransporter
     /// \param group group to subscribe to (typically a DynamicGroup)
     template <typename Data, int scheme = scheme<Data>()>
     void subscribe_dynamic(std::function<void(const Data&)> f, const Group& group,
-                           const Subscriber<Data>& /*subscriber*/ = Subscriber<Data>())
+                           const Subscriber<Data>& subscriber = Subscriber<Data>())
     {
         check_validity_runtime(group);
-        detail::SubscriptionStore<Data>::subscribe([=](std::shared_ptr<const Data> pd) { f(*pd); },
-                                                   group, std::this_thread::get_id(), data_mutex_,
-                                                   Poller<InterThreadTransporter>::cv(),
-                                                   Poller<InterThreadTransporter>::poll_mutex());
+        detail::SubscriptionStore<Data>::subscribe(
+            [=](std::shared_ptr<const Data> pd) { f(*pd); }, group, std::this_thread::get_id(),
+            data_mutex_, Poller<InterThreadTransporter>::wakeup(), subscriber.cfg().queue());
     }
 
     /// \brief Subscribe to a specific run-time defined group and data type (shared pointer variant). Where possible, prefer the static variant in StaticTransporterInterface::subscribe()
@@ -166,12 +212,13 @@ class InterThreadTransporter
     /// \param group group to subscribe to (typically a DynamicGroup)
     template <typename Data, int scheme = scheme<Data>()>
     void subscribe_dynamic(std::function<void(std::shared_ptr<const Data>)> f, const Group& group,
-                           const Subscriber<Data>& /*subscriber*/ = Subscriber<Data>())
+                           const Subscriber<Data>& subscriber = Subscriber<Data>())
     {
         check_validity_runtime(group);
-        detail::SubscriptionStore<Data>::subscribe(
-            f, group, std::this_thread::get_id(), data_mutex_, Poller<InterThreadTransporter>::cv(),
-            Poller<InterThreadTransporter>::poll_mutex());
+        detail::SubscriptionStore<Data>::subscribe(f, group, std::this_thread::get_id(),
+                                                   data_mutex_,
+                                                   Poller<InterThreadTransporter>::wakeup(),
+                                                   subscriber.cfg().queue());
     }
 
     /// \brief Subscribe with no data (used to receive a signal from another thread)
@@ -202,9 +249,15 @@ class InterThreadTransporter
 
   private:
     friend Poller<InterThreadTransporter>;
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    int _poll()
+    {
+        return detail::SubscriptionStoreBase::poll_all(std::this_thread::get_id());
+    }
+
+    template <typename Data> static MessagePool<Data>& pool()
     {
-        return detail::SubscriptionStoreBase::poll_all(std::this_thread::get_id(), lock);
+        static thread_local MessagePool<Data> pool;
+        return pool;
     }
 
   private:
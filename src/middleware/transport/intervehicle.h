@@ -38,6 +38,7 @@
 #include "goby/middleware/transport/interthread.h" // used for InterVehiclePortal implementation
 #include "goby/middleware/transport/intervehicle/driver_thread.h"
 #include "goby/middleware/transport/intervehicle/groups.h"
+#include "goby/middleware/transport/intervehicle/metadata.h"
 #include "goby/middleware/transport/serialization_handlers.h"
 
 namespace goby
@@ -101,6 +102,7 @@ class InterVehicleTransporterBase
                     {
                         case protobuf::SerializerMetadataRequest::METADATA_INCLUDE:
                             omit_publish_metadata_.erase(request.key().type());
+                            full_metadata_published_.erase(request.key().type());
                             break;
                         case protobuf::SerializerMetadataRequest::METADATA_EXCLUDE:
                             omit_publish_metadata_.insert(request.key().type());
@@ -145,15 +147,7 @@ class InterVehicleTransporterBase
         static_assert(scheme == MarshallingScheme::DCCL,
                       "Can only use DCCL messages with InterVehicleTransporters");
 
-        Data data_with_group = data;
-        publisher.set_group(data_with_group, group);
-
-        static_cast<Derived*>(this)->template _publish<Data>(data_with_group, group, publisher);
-        // publish to interprocess as both DCCL and Protobuf
-        this->inner().template publish_dynamic<Data, MarshallingScheme::DCCL>(data_with_group,
-                                                                              group, publisher);
-        this->inner().template publish_dynamic<Data, MarshallingScheme::PROTOBUF>(data_with_group,
-                                                                                  group, publisher);
+        _publish_with_group(std::make_shared<Data>(data), group, publisher);
     }
 
     /// \brief Publish a message using a run-time defined DynamicGroup (shared pointer to const data variant). Where possible, prefer the static variant in StaticTransporterInterface::publish()
@@ -175,16 +169,7 @@ class InterVehicleTransporterBase
             std::shared_ptr<Data> data_with_group(data->New());
             data_with_group->CopyFrom(*data);
 
-            publisher.set_group(*data_with_group, group);
-
-            static_cast<Derived*>(this)->template _publish<Data>(*data_with_group, group,
-                                                                 publisher);
-
-            // publish to interprocess as both DCCL and Protobuf
-            this->inner().template publish_dynamic<Data, MarshallingScheme::DCCL>(data_with_group,
-                                                                                  group, publisher);
-            this->inner().template publish_dynamic<Data, MarshallingScheme::PROTOBUF>(
-                data_with_group, group, publisher);
+            _publish_with_group(data_with_group, group, publisher);
         }
     }
 
@@ -258,7 +243,8 @@ class InterVehicleTransporterBase
   protected:
     template <typename Data>
     std::shared_ptr<goby::middleware::protobuf::SerializerTransporterMessage>
-    _set_up_publish(const Data& d, const Group& group, const Publisher<Data>& publisher)
+    _set_up_publish(const Data& d, const std::vector<char>& bytes, const Group& group,
+                    const Publisher<Data>& publisher)
     {
         if (group.numeric() != Group::broadcast_group && !publisher.has_set_group_func())
         {
@@ -271,7 +257,7 @@ class InterVehicleTransporterBase
             throw(InvalidPublication(ss.str()));
         }
 
-        auto data = intervehicle::serialize_publication(d, group, publisher);
+        auto data = intervehicle::serialize_publication(d, bytes, group, publisher);
 
         if (publisher.cfg().intervehicle().buffer().ack_required())
         {
@@ -288,8 +274,16 @@ class InterVehicleTransporterBase
                                       data, ack_handler, expire_handler);
         }
 
-        if (!omit_publish_metadata_.count(data->key().type()))
-            _set_protobuf_metadata<Data>(data->mutable_key()->mutable_metadata(), d);
+        const auto& type = data->key().type();
+        if (!omit_publish_metadata_.count(type))
+        {
+            const auto& metadata = intervehicle::type_metadata(d.GetDescriptor());
+            // the file descriptors are only needed once, after which the ModemDriverThread recognizes the fingerprint
+            if (full_metadata_published_.insert(type).second)
+                *data->mutable_key()->mutable_metadata() = metadata.full;
+            else
+                *data->mutable_key()->mutable_metadata() = metadata.fingerprint_only;
+        }
 
         goby::glog.is_debug3() &&
             goby::glog << "Set up publishing for: " << data->ShortDebugString() << std::endl;
@@ -460,7 +454,8 @@ class InterVehicleTransporterBase
                                           ? intervehicle::protobuf::Subscription::SUBSCRIBE
                                           : intervehicle::protobuf::Subscription::UNSUBSCRIBE);
 
-        _set_protobuf_metadata<Data>(dccl_subscription->mutable_metadata());
+        *dccl_subscription->mutable_metadata() =
+            intervehicle::type_metadata(Data::descriptor()).full;
         *dccl_subscription->mutable_intervehicle() = subscriber.cfg().intervehicle();
         return dccl_subscription;
     }
@@ -487,37 +482,31 @@ class InterVehicleTransporterBase
         subscriptions_;
 
   private:
-    friend PollerType;
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
-    {
-        _expire_pending_ack();
-
-        return static_cast<Derived*>(this)->_poll(lock);
-    }
-
-    template <typename Data> void _set_protobuf_metadata(protobuf::SerializerProtobufMetadata* meta)
-    {
-        meta->set_protobuf_name(SerializerParserHelper<Data, MarshallingScheme::DCCL>::type_name());
-        _insert_file_desc_with_dependencies(Data::descriptor()->file(), meta);
-    }
-
     template <typename Data>
-    void _set_protobuf_metadata(protobuf::SerializerProtobufMetadata* meta, const Data& d)
-    {
-        meta->set_protobuf_name(
-            SerializerParserHelper<Data, MarshallingScheme::DCCL>::type_name(d));
-        _insert_file_desc_with_dependencies(d.GetDescriptor()->file(), meta);
+    void _publish_with_group(std::shared_ptr<Data> data, const Group& group,
+                             const Publisher<Data>& publisher)
+    {
+        publisher.set_group(*data, group);
+
+        // serialize once for both the modem drivers and the interprocess DCCL publication
+        std::vector<char> bytes(
+            SerializerParserHelper<Data, MarshallingScheme::DCCL>::serialize(*data));
+        static_cast<Derived*>(this)->template _publish<Data>(*data, bytes, group, publisher);
+
+        // publish to interprocess as both DCCL and Protobuf, and to the inner layers once
+        this->inner().template publish_dynamic_serialized<Data, MarshallingScheme::DCCL>(
+            data, bytes, group, publisher);
+        // only serialized if there is an interprocess subscriber
+        this->inner().template publish_dynamic_no_inner<Data, MarshallingScheme::PROTOBUF>(
+            *data, group, publisher);
     }
 
-    // used to populated InterVehicleSubscription file_descriptor fields
-    void _insert_file_desc_with_dependencies(const google::protobuf::FileDescriptor* file_desc,
-                                             protobuf::SerializerProtobufMetadata* meta)
+    friend PollerType;
+    int _poll()
     {
-        for (int i = 0, n = file_desc->dependency_count(); i < n; ++i)
-            _insert_file_desc_with_dependencies(file_desc->dependency(i), meta);
+        _expire_pending_ack();
 
-        google::protobuf::FileDescriptorProto* file_desc_proto = meta->add_file_descriptor();
-        file_desc->CopyTo(file_desc_proto);
+        return static_cast<Derived*>(this)->_poll();
     }
 
     // expire any pending_ack entries that are no longer relevant
@@ -566,6 +555,9 @@ class InterVehicleTransporterBase
 
     // map of Protobuf names where we can omit metadata on publication
     std::set<std::string> omit_publish_metadata_;
+
+    // Protobuf names for which we have published the full metadata (subsequent publications carry the fingerprint only)
+    std::set<std::string> full_metadata_published_;
 };
 
 /// \brief Implements the forwarder concept for the intervehicle layer
@@ -608,10 +600,11 @@ class InterVehicleForwarder
 
   private:
     template <typename Data>
-    void _publish(const Data& d, const Group& group, const Publisher<Data>& publisher)
+    void _publish(const Data& d, const std::vector<char>& bytes, const Group& group,
+                  const Publisher<Data>& publisher)
     {
         this->inner().template publish<intervehicle::groups::modem_data_out>(
-            this->_set_up_publish(d, group, publisher));
+            this->_set_up_publish(d, bytes, group, publisher));
     }
 
     template <typename Data>
@@ -632,7 +625,7 @@ class InterVehicleForwarder
         }
     }
 
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock) { return 0; }
+    int _poll() { return 0; }
 };
 
 /// \brief Implements a portal for the intervehicle layer based on Goby Acomms.
@@ -677,10 +670,11 @@ class InterVehiclePortal
 
   private:
     template <typename Data>
-    void _publish(const Data& d, const Group& group, const Publisher<Data>& publisher)
+    void _publish(const Data& d, const std::vector<char>& bytes, const Group& group,
+                  const Publisher<Data>& publisher)
     {
         this->innermost().template publish<intervehicle::groups::modem_data_out>(
-            this->_set_up_publish(d, group, publisher));
+            this->_set_up_publish(d, bytes, group, publisher));
     }
 
     template <typename Data>
@@ -700,7 +694,7 @@ class InterVehiclePortal
         }
     }
 
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    int _poll()
     {
         int items = 0;
         goby::acomms::protobuf::ModemTransmission msg;
@@ -709,8 +703,6 @@ class InterVehiclePortal
             this->_receive(received_.front());
             received_.pop_front();
             ++items;
-            if (lock)
-                lock.reset();
         }
         return items;
     }
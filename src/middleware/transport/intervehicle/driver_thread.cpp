@@ -52,6 +52,7 @@
 #include "goby/exception.h"                                 // for Exception
 #include "goby/middleware/protobuf/transporter_config.pb.h" // for Transpor...
 #include "goby/middleware/transport/intervehicle/groups.h"  // for metadata...
+#include "goby/middleware/transport/intervehicle/metadata.h" // for type_metadata
 #include "goby/middleware/transport/publisher.h"            // for Publisher
 #include "goby/util/debug_logger/flex_ostreambuf.h"         // for DEBUG1
 #include "goby/util/debug_logger/logger_manipulators.h"     // for operator<<
@@ -368,7 +369,7 @@ void goby::middleware::intervehicle::ModemDriverThread::_forward_subscription(
     intervehicle::protobuf::Subscription subscription)
 {
     if (subscription.has_metadata())
-        detail::DCCLSerializerParserHelperBase::load_metadata(subscription.metadata());
+        _load_metadata(subscription.metadata());
 
     if (subscription.intervehicle().broadcast())
         subscription.mutable_header()->set_src(_broadcast_id());
@@ -625,7 +626,7 @@ void goby::middleware::intervehicle::ModemDriverThread::_buffer_message(
     const std::shared_ptr<const SerializerTransporterMessage>& msg)
 {
     if (msg->key().has_metadata())
-        detail::DCCLSerializerParserHelperBase::load_metadata(msg->key().metadata());
+        _load_metadata(msg->key().metadata());
 
     // check if we have this message loaded
     auto dccl_id = detail::DCCLSerializerParserHelperBase::id(msg->key().type());
@@ -634,6 +635,7 @@ void goby::middleware::intervehicle::ModemDriverThread::_buffer_message(
         // start sending metadata
         middleware::protobuf::SerializerMetadataRequest meta_request;
         *meta_request.mutable_key() = msg->key();
+        meta_request.mutable_key()->clear_metadata();
         meta_request.set_request(middleware::protobuf::SerializerMetadataRequest::METADATA_INCLUDE);
         interprocess_->publish<groups::metadata_request>(meta_request);
         glog.is_warn() &&
@@ -642,7 +644,7 @@ void goby::middleware::intervehicle::ModemDriverThread::_buffer_message(
                  << meta_request.ShortDebugString() << std::endl;
         return;
     }
-    else if (msg->key().has_metadata())
+    else if (msg->key().metadata().file_descriptor_size() > 0)
     {
         // stop sending metadata
         middleware::protobuf::SerializerMetadataRequest meta_request;
@@ -656,23 +658,35 @@ void goby::middleware::intervehicle::ModemDriverThread::_buffer_message(
         interprocess_->publish<groups::metadata_request>(meta_request);
     }
 
-    auto buffer_id = _create_buffer_id(dccl_id, msg->key().group_numeric());
+    // the metadata have been loaded, so they needn't be kept with the buffered data
+    std::shared_ptr<const SerializerTransporterMessage> buffered = msg;
+    if (msg->key().has_metadata())
+    {
+        auto stripped = std::make_shared<SerializerTransporterMessage>();
+        *stripped->mutable_key() = msg->key();
+        stripped->mutable_key()->clear_metadata();
+        stripped->set_data(msg->data());
+        buffered = stripped;
+    }
+
+    auto buffer_id = _create_buffer_id(dccl_id, buffered->key().group_numeric());
 
     glog.is_debug3() && glog << group(glog_group_) << "Buffering message with id: " << buffer_id
-                             << " from " << msg->ShortDebugString() << std::endl;
+                             << " from " << buffered->ShortDebugString() << std::endl;
 
     bool is_new_cfg = true;
     auto it_pair = publisher_buffer_cfg_.equal_range(buffer_id);
     for (auto it = it_pair.first, end = it_pair.second; it != end; ++it)
     {
-        if (it->second.cfg().intervehicle().buffer() == msg->key().cfg().intervehicle().buffer())
+        if (it->second.cfg().intervehicle().buffer() ==
+            buffered->key().cfg().intervehicle().buffer())
             is_new_cfg = false;
         break;
     }
 
     if (is_new_cfg)
     {
-        publisher_buffer_cfg_.insert(std::make_pair(buffer_id, msg->key()));
+        publisher_buffer_cfg_.insert(std::make_pair(buffer_id, buffered->key()));
 
         // check for new subbuffers from all existing subscribers
         for (const auto& sub_id_p : subscriber_buffer_cfg_)
@@ -691,7 +705,7 @@ void goby::middleware::intervehicle::ModemDriverThread::_buffer_message(
                 continue;
 
             auto exceeded =
-                buffer_.push({dest_id, buffer_id, goby::time::SteadyClock::now(), *msg});
+                buffer_.push({dest_id, buffer_id, goby::time::SteadyClock::now(), *buffered});
             if (!exceeded.empty())
             {
                 auto now = goby::time::SteadyClock::now();
@@ -704,11 +718,34 @@ void goby::middleware::intervehicle::ModemDriverThread::_buffer_message(
     else
     {
         auto now = goby::time::SteadyClock::now();
-        _expire_value(now, {cfg().driver().modem_id(), buffer_id, now, *msg},
+        _expire_value(now, {cfg().driver().modem_id(), buffer_id, now, *buffered},
                       intervehicle::protobuf::ExpireData::EXPIRED_NO_SUBSCRIBERS);
     }
 }
 
+bool goby::middleware::intervehicle::ModemDriverThread::_load_metadata(
+    const goby::middleware::protobuf::SerializerProtobufMetadata& meta)
+{
+    // already loaded: avoids taking the DCCL mutex to look up the descriptors for every message
+    if (meta.has_fingerprint() && loaded_metadata_.count(meta.fingerprint()))
+        return true;
+
+    // fingerprint only, and we haven't seen the full metadata: the type may still be available (compiled in, or loaded from the full metadata by another thread), in which case we can use it if its files match the fingerprint
+    if (meta.file_descriptor_size() == 0)
+    {
+        const auto* desc =
+            detail::DCCLSerializerParserHelperBase::find_descriptor(meta.protobuf_name());
+        if (!desc || !meta.has_fingerprint() ||
+            intervehicle::type_metadata(desc).full.fingerprint() != meta.fingerprint())
+            return false;
+    }
+
+    bool loaded = detail::DCCLSerializerParserHelperBase::load_metadata(meta);
+    if (loaded && meta.has_fingerprint())
+        loaded_metadata_.insert(meta.fingerprint());
+    return loaded;
+}
+
 void goby::middleware::intervehicle::ModemDriverThread::_receive(
     const goby::acomms::protobuf::ModemTransmission& rx_msg)
 {
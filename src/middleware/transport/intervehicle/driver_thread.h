@@ -27,11 +27,13 @@
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <ostream>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/units/quantity.hpp>
@@ -107,11 +109,12 @@ inline bool operator==(const TransporterConfig& a, const TransporterConfig& b)
 
 } // namespace protobuf
 
+/// \brief Creates the publication of \c d for the modem drivers from its DCCL serialization \c bytes
 template <typename Data>
 std::shared_ptr<goby::middleware::protobuf::SerializerTransporterMessage>
-serialize_publication(const Data& d, const Group& group, const Publisher<Data>& publisher)
+serialize_publication(const Data& d, const std::vector<char>& bytes, const Group& group,
+                      const Publisher<Data>& publisher)
 {
-    std::vector<char> bytes(SerializerParserHelper<Data, MarshallingScheme::DCCL>::serialize(d));
     auto* sbytes = new std::string(bytes.begin(), bytes.end());
     auto msg = std::make_shared<goby::middleware::protobuf::SerializerTransporterMessage>();
 
@@ -127,6 +130,14 @@ serialize_publication(const Data& d, const Group& group, const Publisher<Data>&
     return msg;
 }
 
+template <typename Data>
+std::shared_ptr<goby::middleware::protobuf::SerializerTransporterMessage>
+serialize_publication(const Data& d, const Group& group, const Publisher<Data>& publisher)
+{
+    return serialize_publication(
+        d, SerializerParserHelper<Data, MarshallingScheme::DCCL>::serialize(d), group, publisher);
+}
+
 class ModemDriverThread
     : public goby::middleware::Thread<intervehicle::protobuf::PortalConfig::LinkConfig,
                                       InterProcessForwarder<InterThreadTransporter>>
@@ -190,6 +201,9 @@ class ModemDriverThread
 
     void _publish_subscription_report(const intervehicle::protobuf::Subscription& changed);
 
+    // returns true if the DCCL message described by meta is loaded
+    bool _load_metadata(const goby::middleware::protobuf::SerializerProtobufMetadata& meta);
+
   private:
     std::unique_ptr<InterThreadTransporter> interthread_;
     std::unique_ptr<InterProcessForwarder<InterThreadTransporter>> interprocess_;
@@ -207,6 +221,9 @@ class ModemDriverThread
 
     goby::acomms::DynamicBuffer<buffer_data_type> buffer_;
 
+    // fingerprints (SerializerProtobufMetadata::fingerprint) of metadata that have been loaded
+    std::unordered_set<std::uint64_t> loaded_metadata_;
+
     using frame_type = int;
     std::map<frame_type, std::vector<goby::acomms::DynamicBuffer<buffer_data_type>::Value>>
         pending_ack_;
@@ -0,0 +1,88 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <memory>        // for unique_ptr
+#include <mutex>         // for mutex, lock_guard
+#include <set>           // for set
+#include <string>        // for string
+#include <unordered_map> // for unordered_map
+
+#include <google/protobuf/descriptor.h>    // for Descriptor, FileDescriptor
+#include <google/protobuf/descriptor.pb.h> // for FileDescriptorProto
+
+#include "metadata.h"
+
+namespace
+{
+std::mutex metadata_mutex;
+std::unordered_map<const google::protobuf::Descriptor*,
+                   std::unique_ptr<goby::middleware::intervehicle::TypeMetadata>>
+    metadata_cache;
+
+void insert_file_desc_with_dependencies(
+    const google::protobuf::FileDescriptor* file_desc,
+    goby::middleware::protobuf::SerializerProtobufMetadata* meta, std::set<std::string>& inserted)
+{
+    if (!inserted.insert(file_desc->name()).second)
+        return;
+
+    for (int i = 0, n = file_desc->dependency_count(); i < n; ++i)
+        insert_file_desc_with_dependencies(file_desc->dependency(i), meta, inserted);
+
+    file_desc->CopyTo(meta->add_file_descriptor());
+}
+} // namespace
+
+const goby::middleware::intervehicle::TypeMetadata&
+goby::middleware::intervehicle::type_metadata(const google::protobuf::Descriptor* desc)
+{
+    std::lock_guard<std::mutex> lock(metadata_mutex);
+    auto& metadata = metadata_cache[desc];
+    if (!metadata)
+    {
+        metadata.reset(new TypeMetadata);
+        std::set<std::string> inserted;
+        insert_file_desc_with_dependencies(desc->file(), &metadata->full, inserted);
+        metadata->full.set_protobuf_name(desc->full_name());
+        metadata->full.set_fingerprint(metadata_fingerprint(metadata->full));
+
+        metadata->fingerprint_only.set_protobuf_name(metadata->full.protobuf_name());
+        metadata->fingerprint_only.set_fingerprint(metadata->full.fingerprint());
+    }
+    return *metadata;
+}
+
+std::uint64_t goby::middleware::intervehicle::metadata_fingerprint(
+    const goby::middleware::protobuf::SerializerProtobufMetadata& meta)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const auto& file_desc_proto : meta.file_descriptor())
+    {
+        for (char c : file_desc_proto.SerializeAsString())
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,65 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_TRANSPORT_INTERVEHICLE_METADATA_H
+#define GOBY_MIDDLEWARE_TRANSPORT_INTERVEHICLE_METADATA_H
+
+#include <cstdint> // for uint64_t
+
+#include "goby/middleware/protobuf/serializer_transporter.pb.h" // for SerializerProtobufMetadata
+
+namespace google
+{
+namespace protobuf
+{
+class Descriptor;
+} // namespace protobuf
+} // namespace google
+
+namespace goby
+{
+namespace middleware
+{
+namespace intervehicle
+{
+/// \brief Metadata describing a DCCL message type to the ModemDriverThread, built once per type per process
+struct TypeMetadata
+{
+    /// \brief Name, fingerprint, and the FileDescriptorProto of the type's file and all its dependencies (dependencies first)
+    goby::middleware::protobuf::SerializerProtobufMetadata full;
+    /// \brief Name and fingerprint only, for publications after the full metadata has been sent
+    goby::middleware::protobuf::SerializerProtobufMetadata fingerprint_only;
+};
+
+/// \brief Returns the (cached) metadata for the given message type. Thread safe.
+const TypeMetadata& type_metadata(const google::protobuf::Descriptor* desc);
+
+/// \brief Fingerprint (64-bit FNV-1a hash of the serialized file descriptors) of meta.file_descriptor(). This is the same in every process for the same set of .proto files.
+std::uint64_t
+metadata_fingerprint(const goby::middleware::protobuf::SerializerProtobufMetadata& meta);
+
+} // namespace intervehicle
+} // namespace middleware
+} // namespace goby
+
+#endif
@@ -0,0 +1,236 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_TRANSPORT_MESSAGE_POOL_H
+#define GOBY_MIDDLEWARE_TRANSPORT_MESSAGE_POOL_H
+
+#include <atomic>      // for atomic
+#include <cstddef>     // for size_t
+#include <memory>      // for shared_ptr
+#include <mutex>       // for mutex
+#include <new>         // for operator new
+#include <type_traits> // for enable_if
+#include <vector>      // for vector
+
+namespace goby
+{
+namespace middleware
+{
+namespace detail
+{
+template <typename...> struct make_void
+{
+    using type = void;
+};
+
+template <typename Data, typename = void> struct has_clear : std::false_type
+{
+};
+template <typename Data>
+struct has_clear<Data, typename make_void<decltype(std::declval<Data&>().Clear())>::type>
+    : std::true_type
+{
+};
+
+/// \brief Default action to reset a recycled object before it is reused: Clear() for Protobuf messages (which retains the allocated capacity of strings and submessages) or assignment of a default constructed object otherwise.
+template <typename Data, typename std::enable_if<has_clear<Data>::value>::type* = nullptr>
+void reset_pooled(Data& data)
+{
+    data.Clear();
+}
+
+template <typename Data, typename std::enable_if<!has_clear<Data>::value>::type* = nullptr>
+void reset_pooled(Data& data)
+{
+    data = Data();
+}
+
+/// \brief Shared state of a MessagePool, kept alive by the pool and by every message it has handed out (as these may outlive the pool)
+template <typename Data> class MessagePoolState
+{
+  public:
+    MessagePoolState(std::size_t max_size) : max_size_(max_size)
+    {
+        objects_.reserve(max_size_);
+        blocks_.reserve(max_size_);
+    }
+
+    ~MessagePoolState()
+    {
+        for (auto* object : objects_) delete object;
+        for (auto* block : blocks_) ::operator delete(block);
+    }
+
+    Data* acquire_object()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!objects_.empty())
+            {
+                Data* object = objects_.back();
+                objects_.pop_back();
+                return object;
+            }
+        }
+        ++allocations_;
+        return new Data;
+    }
+
+    void release_object(Data* object)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (objects_.size() < max_size_)
+            {
+                objects_.push_back(object);
+                return;
+            }
+        }
+        delete object;
+    }
+
+    // storage for the shared_ptr control blocks (all of the same size for a given Data)
+    void* allocate_block(std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (size == block_size_ && !blocks_.empty())
+            {
+                void* block = blocks_.back();
+                blocks_.pop_back();
+                return block;
+            }
+        }
+        ++allocations_;
+        return ::operator new(size);
+    }
+
+    void deallocate_block(void* block, std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (block_size_ == 0)
+                block_size_ = size;
+            if (size == block_size_ && blocks_.size() < max_size_)
+            {
+                blocks_.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    std::size_t allocations() const { return allocations_; }
+
+  private:
+    const std::size_t max_size_;
+    std::mutex mutex_;
+    std::vector<Data*> objects_;
+    std::vector<void*> blocks_;
+    std::size_t block_size_{0};
+    std::atomic<std::size_t> allocations_{0};
+};
+
+/// \brief Allocator for shared_ptr control blocks that recycles storage through the MessagePoolState
+template <typename T, typename Data> class MessagePoolAllocator
+{
+  public:
+    using value_type = T;
+
+    MessagePoolAllocator(std::shared_ptr<MessagePoolState<Data>> state) : state_(std::move(state))
+    {
+    }
+    template <typename U>
+    MessagePoolAllocator(const MessagePoolAllocator<U, Data>& other) : state_(other.state_)
+    {
+    }
+
+    T* allocate(std::size_t n) { return static_cast<T*>(state_->allocate_block(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t n) { state_->deallocate_block(p, n * sizeof(T)); }
+
+    template <typename U> struct rebind
+    {
+        using other = MessagePoolAllocator<U, Data>;
+    };
+
+    template <typename U> bool operator==(const MessagePoolAllocator<U, Data>& other) const
+    {
+        return state_ == other.state_;
+    }
+    template <typename U> bool operator!=(const MessagePoolAllocator<U, Data>& other) const
+    {
+        return !(*this == other);
+    }
+
+  private:
+    template <typename U, typename D> friend class MessagePoolAllocator;
+    std::shared_ptr<MessagePoolState<Data>> state_;
+};
+
+} // namespace detail
+
+/// \brief Pool of reusable messages for high rate publication on the interthread layer without heap allocation in the steady state.
+///
+/// acquire() returns a std::shared_ptr to a (reset) message. When the last copy of this pointer is released (by the publisher and all the subscribers), the message is returned to the pool rather than deleted, retaining any allocated memory (e.g. Protobuf string capacity). The shared_ptr control block is also recycled.
+///
+/// \code
+/// goby::middleware::MessagePool<protobuf::IMUData> pool;
+/// auto imu = pool.acquire();
+/// imu->set_angular_velocity(0.1);
+/// interthread.publish<groups::imu>(imu);
+/// // after this point 'imu' should not be mutated (as with any interthread publication)
+/// \endcode
+///
+/// acquire() may be called from any thread, and messages may be released from any thread. See also InterThreadTransporter::publish_pooled() and InterThreadTransporter::acquire_pooled(), which use a per-thread pool for each type.
+template <typename Data> class MessagePool
+{
+  public:
+    /// \param max_size Maximum number of unused messages retained for reuse. Messages released when the pool is full are deleted.
+    explicit MessagePool(std::size_t max_size = 64)
+        : state_(std::make_shared<detail::MessagePoolState<Data>>(max_size))
+    {
+    }
+
+    /// \brief Returns a message from the pool (or a newly allocated message if none are available), reset to its default state
+    std::shared_ptr<Data> acquire()
+    {
+        Data* object = state_->acquire_object();
+        detail::reset_pooled(*object);
+
+        auto state = state_;
+        return std::shared_ptr<Data>(
+            object, [state](Data* object) { state->release_object(object); },
+            detail::MessagePoolAllocator<Data, Data>(state_));
+    }
+
+    /// \brief Total number of heap allocations made by this pool (messages and shared_ptr control blocks). Stops increasing in the steady state.
+    std::size_t allocations() const { return state_->allocations(); }
+
+  private:
+    std::shared_ptr<detail::MessagePoolState<Data>> state_;
+};
+
+} // namespace middleware
+} // namespace goby
+
+#endif
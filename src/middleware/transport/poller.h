@@ -25,6 +25,9 @@
 #ifndef GOBY_MIDDLEWARE_TRANSPORT_POLLER_H
 #define GOBY_MIDDLEWARE_TRANSPORT_POLLER_H
 
+#include <memory> // for unique_ptr
+#include <mutex>  // for unique_lock, timed_mutex
+
 #include "interface.h"
 
 namespace goby
@@ -39,10 +42,9 @@ template <typename Transporter> class Poller : public PollerInterface
   protected:
     /// Construct this Poller with a pointer to the inner Poller (unless this is the innermost Poller)
     Poller(PollerInterface* inner_poller = nullptr)
-        : // we want the same mutex and cv all the way up
-          PollerInterface(
-              inner_poller ? inner_poller->poll_mutex() : std::make_shared<std::timed_mutex>(),
-              inner_poller ? inner_poller->cv() : std::make_shared<std::condition_variable_any>()),
+        : // we want the same wakeup all the way up
+          PollerInterface(inner_poller ? inner_poller->wakeup()
+                                       : std::make_shared<PollerWakeup>()),
           inner_poller_(inner_poller)
     {
     }
@@ -51,23 +53,41 @@ template <typename Transporter> class Poller : public PollerInterface
     PollerInterface* inner_poller() { return inner_poller_; }
 
   private:
-    int _transporter_poll(std::unique_ptr<std::unique_lock<std::timed_mutex> >& lock) override
+    int _transporter_poll() override
     {
         // work from the inside out
         int inner_poll_items = 0;
         if (inner_poller_) // recursively call inner poll
             inner_poll_items +=
-                static_cast<PollerInterface*>(inner_poller_)->_transporter_poll(lock);
+                static_cast<PollerInterface*>(inner_poller_)->_transporter_poll();
 
         int poll_items = 0;
         if (!inner_poll_items)
-            poll_items += static_cast<Transporter*>(this)->_poll(lock);
+            poll_items += transporter_poll(static_cast<Transporter*>(this), 0);
 
         //            goby::glog.is(goby::util::logger::DEBUG3) && goby::glog << "Poller::transporter_poll(): " << typeid(*this).name() << " this: " << this << " (" << poll_items << " items) "<< " inner_poller_: " << inner_poller_ << " (" << inner_poll_items << " items) " << std::endl;
 
         return inner_poll_items + poll_items;
     }
 
+    // called with 0, so this overload (int) is preferred whenever the transporter has _poll()
+    template <typename T>
+    auto transporter_poll(T* transporter, int) -> decltype(transporter->_poll())
+    {
+        return transporter->_poll();
+    }
+
+    // transporters written before _poll() lost its lock argument
+    template <typename T>
+    [[deprecated("override _poll() without arguments: poll() no longer holds a lock")]] int
+    transporter_poll(T* transporter, long)
+    {
+        // the lock is no longer used by poll(), but the transporter may still release it
+        std::unique_ptr<std::unique_lock<std::timed_mutex>> lock(
+            new std::unique_lock<std::timed_mutex>(*this->poll_mutex_));
+        return transporter->_poll(lock);
+    }
+
   private:
     PollerInterface* inner_poller_;
 };
@@ -0,0 +1,176 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cerrno>   // for errno, EINTR
+#include <cstring>  // for strerror
+#include <fcntl.h>  // for fcntl, O_NONBLOCK
+#include <poll.h>   // for poll, pollfd
+#include <string>   // for string
+#include <thread>   // for sleep_for
+#include <unistd.h> // for read, write, close
+
+#ifdef __linux__
+#include <climits>       // for INT_MAX
+#include <linux/futex.h> // for FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <sys/eventfd.h> // for eventfd
+#include <sys/syscall.h> // for SYS_futex
+#include <time.h>        // for timespec
+#endif
+
+#include "goby/exception.h" // for Exception
+
+#include "poller_wakeup.h"
+
+goby::middleware::PollerWakeup::PollerWakeup()
+{
+#ifdef __linux__
+    read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (read_fd_ < 0)
+        throw(goby::Exception(std::string("PollerWakeup: failed to create eventfd: ") +
+                              std::strerror(errno)));
+    write_fd_ = read_fd_;
+#else
+    int fds[2];
+    if (pipe(fds) < 0)
+        throw(goby::Exception(std::string("PollerWakeup: failed to create pipe: ") +
+                              std::strerror(errno)));
+    for (int fd : fds)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+#endif
+}
+
+goby::middleware::PollerWakeup::~PollerWakeup()
+{
+    close(read_fd_);
+    if (write_fd_ != read_fd_)
+        close(write_fd_);
+}
+
+void goby::middleware::PollerWakeup::wake_waiters()
+{
+#ifdef __linux__
+    ++wake_count_;
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence_), FUTEX_WAKE_PRIVATE, INT_MAX,
+            nullptr, nullptr, 0);
+#else
+    if (!fd_signaled_.exchange(true))
+        signal_fd();
+#endif
+}
+
+void goby::middleware::PollerWakeup::signal_fd()
+{
+    ++wake_count_;
+#ifdef __linux__
+    std::uint64_t one = 1;
+    // EAGAIN (counter overflow) still leaves the eventfd readable
+    while (write(write_fd_, &one, sizeof(one)) < 0 && errno == EINTR) {}
+#else
+    char byte = 0;
+    // EAGAIN (pipe full) still leaves the pipe readable
+    while (write(write_fd_, &byte, 1) < 0 && errno == EINTR) {}
+#endif
+}
+
+void goby::middleware::PollerWakeup::clear_fd()
+{
+#ifdef __linux__
+    std::uint64_t count;
+    while (read(read_fd_, &count, sizeof(count)) < 0 && errno == EINTR) {}
+#else
+    char buffer[64];
+    for (;;)
+    {
+        auto bytes = read(read_fd_, buffer, sizeof(buffer));
+        if (bytes == sizeof(buffer) || (bytes < 0 && errno == EINTR))
+            continue;
+        break;
+    }
+#endif
+    // after draining, so that a notify() in between (that didn't signal) is still seen by the caller polling for data
+    fd_signaled_ = false;
+}
+
+bool goby::middleware::PollerWakeup::wait_for(Sequence seq, std::int64_t timeout_ns)
+{
+    if (++wait_epoch_ == 0)
+        ++wait_epoch_;
+    sleeping_ = wait_epoch_;
+#ifdef __linux__
+    // the kernel only sleeps if the sequence still equals seq, so a notify() after sleeping_ was set either changes the sequence first (no sleep) or wakes us
+    timespec timeout{timeout_ns / 1000000000, timeout_ns % 1000000000};
+    int rc = syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence_), FUTEX_WAIT_PRIVATE,
+                     seq, timeout_ns < 0 ? nullptr : &timeout, nullptr, 0);
+    sleeping_ = 0;
+    if (rc < 0 && errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT)
+        throw(goby::Exception(std::string("PollerWakeup: futex wait failed: ") +
+                              std::strerror(errno)));
+#else
+    if (sequence_.load() != seq)
+    {
+        sleeping_ = 0;
+        return true;
+    }
+
+    pollfd pfd{read_fd_, POLLIN, 0};
+    // round up so that we don't return early and spin
+    int rc = poll(&pfd, 1, timeout_ns < 0 ? -1 : (timeout_ns + 999999) / 1000000);
+    sleeping_ = 0;
+
+    if (rc > 0)
+        clear_fd();
+    else if (rc < 0 && errno != EINTR)
+        throw(goby::Exception(std::string("PollerWakeup: poll failed: ") + std::strerror(errno)));
+#endif
+
+    return sequence_.load() != seq;
+}
+
+bool goby::middleware::PollerWakeup::shared_wait_for(Sequence seq, std::int64_t timeout_ns)
+{
+    // pairs with the check of shared_waiters_ in notify(), as for sleeping_ in wait_for()
+    ++shared_waiters_;
+#ifdef __linux__
+    timespec timeout{timeout_ns / 1000000000, timeout_ns % 1000000000};
+    int rc = syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence_), FUTEX_WAIT_PRIVATE,
+                     seq, timeout_ns < 0 ? nullptr : &timeout, nullptr, 0);
+    --shared_waiters_;
+    if (rc < 0 && errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT)
+        throw(goby::Exception(std::string("PollerWakeup: futex wait failed: ") +
+                              std::strerror(errno)));
+#else
+    // the descriptor is cleared by the owner of the poller, so we can't wait on it here: sleep in short slices and recheck the sequence instead
+    const std::int64_t max_slice_ns = 1000000;
+    if (sequence_.load() == seq)
+        std::this_thread::sleep_for(std::chrono::nanoseconds(
+            (timeout_ns < 0 || timeout_ns > max_slice_ns) ? max_slice_ns : timeout_ns));
+    --shared_waiters_;
+#endif
+
+    return sequence_.load() != seq;
+}
@@ -0,0 +1,241 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MIDDLEWARE_TRANSPORT_POLLER_WAKEUP_H
+#define GOBY_MIDDLEWARE_TRANSPORT_POLLER_WAKEUP_H
+
+#include <atomic>             // for atomic
+#include <chrono>             // for time_point, nanoseconds
+#include <condition_variable> // for cv_status
+#include <cstdint>            // for uint64_t
+#include <memory>             // for shared_ptr
+#include <utility>            // for move
+
+namespace goby
+{
+namespace middleware
+{
+/// \brief Wakes up a thread blocked in PollerInterface::poll() when there is new data for it to poll (one per thread, shared by all the transporter layers of that thread)
+///
+/// The wakeup is a sequence counter incremented by notify(). The poller reads sequence() before polling the transporters and, if they have nothing, waits until the sequence changes (on Linux, using a futex on the counter itself). Any notify() after the sequence was read ends the wait, so no notification is lost, and notify() never takes a lock (or makes a system call unless the poller is asleep).
+///
+/// The wakeup also has a file descriptor (an eventfd on Linux, a pipe elsewhere, where it is also used for wait()) that is signaled by notify() once it has been armed with arm_fd().
+///
+/// As the descriptor is readable whenever a notification is pending, it can be waited on by other event loops (e.g. boost::asio, see io::IOThread) in place of a blocking poll():
+///
+/// \code
+/// auto wakeup = interthread().wakeup();
+/// wakeup->arm_fd(); // signal fd() on every notify(), not only while a thread is in wait()
+/// // ... add wakeup->fd() to select/poll/asio, and when readable:
+/// wakeup->clear_fd();
+/// interthread().poll(std::chrono::seconds(0));
+/// \endcode
+class PollerWakeup
+{
+  public:
+    using Sequence = std::uint32_t;
+
+    PollerWakeup();
+    ~PollerWakeup();
+    PollerWakeup(const PollerWakeup&) = delete;
+    PollerWakeup& operator=(const PollerWakeup&) = delete;
+
+    /// \brief Signals that there is new data to poll. Safe to call from any thread; never blocks.
+    void notify()
+    {
+        sequence_.fetch_add(1);
+        // pairs with the setting of sleeping_ and re-check of sequence_ in wait_for(): either the waiter sees the new sequence or we see the waiter. Only the first notify() after the waiter went to sleep makes the system call. A notify() that read the epoch of an earlier wait can't clear the flag of a later one (whose wait already sees the new sequence).
+        auto epoch = sleeping_.load();
+        if ((epoch != 0 && sleeping_.compare_exchange_strong(epoch, 0)) ||
+            shared_waiters_.load() > 0)
+            wake_waiters();
+        if (fd_armed_.load() > 0 && !fd_signaled_.exchange(true))
+            signal_fd();
+    }
+
+    /// \brief Current value of the notification sequence (read before polling for data)
+    Sequence sequence() const { return sequence_.load(); }
+
+    /// \brief Blocks until sequence() differs from seq. Only one thread (the owner of the poller) may wait at a time.
+    void wait(Sequence seq)
+    {
+        while (!wait_for(seq, -1)) {}
+    }
+
+    /// \brief Blocks until sequence() differs from seq (returns true) or timeout is reached (returns false)
+    template <class Clock, class Duration>
+    bool wait_until(Sequence seq, const std::chrono::time_point<Clock, Duration>& timeout)
+    {
+        if (timeout == std::chrono::time_point<Clock, Duration>::max())
+        {
+            wait(seq);
+            return true;
+        }
+
+        for (;;)
+        {
+            if (sequence() != seq)
+                return true;
+            auto now = Clock::now();
+            if (now >= timeout)
+                return false;
+            // not converted directly to system time, so this also works for clocks with a different rate (e.g. warped SystemClock)
+            auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - now);
+            if (wait_for(seq, remaining.count()))
+                return true;
+        }
+    }
+
+    /// \brief As wait_until(), but any number of threads (besides the owner of the poller) may wait at once. Every notify() makes a system call while any of them are waiting. Used by PollerWakeupCondition.
+    template <class Clock, class Duration>
+    bool shared_wait_until(Sequence seq, const std::chrono::time_point<Clock, Duration>& timeout)
+    {
+        for (;;)
+        {
+            if (sequence() != seq)
+                return true;
+
+            std::int64_t timeout_ns = -1;
+            if (timeout != std::chrono::time_point<Clock, Duration>::max())
+            {
+                auto now = Clock::now();
+                if (now >= timeout)
+                    return false;
+                timeout_ns =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - now).count();
+            }
+            if (shared_wait_for(seq, timeout_ns))
+                return true;
+        }
+    }
+
+    /// \brief File descriptor that is readable after notify() while armed, until clear_fd() is called
+    int fd() const { return read_fd_; }
+
+    /// \brief Signal fd() on notify(), for use by another event loop. Calls nest.
+    void arm_fd() { fd_armed_.fetch_add(1); }
+    void disarm_fd() { fd_armed_.fetch_sub(1); }
+
+    /// \brief Resets fd() to not readable. Poll the transporters after calling this so that no pending data are missed.
+    void clear_fd();
+
+    /// \brief Number of system calls made by notify() (to wake a waiting thread or signal fd())
+    std::uint64_t wake_count() const { return wake_count_; }
+
+  private:
+    // waits up to timeout_ns (-1 for no timeout) for the sequence to differ from seq
+    bool wait_for(Sequence seq, std::int64_t timeout_ns);
+    bool shared_wait_for(Sequence seq, std::int64_t timeout_ns);
+    void wake_waiters();
+    void signal_fd();
+
+  private:
+    // 32 bits for use as a futex
+    std::atomic<Sequence> sequence_{0};
+    // epoch of the wait_for() call that is (about to be) blocked and hasn't been woken yet, or 0
+    std::atomic<std::uint32_t> sleeping_{0};
+    // incremented by (the one) waiting thread for each wait_for()
+    std::uint32_t wait_epoch_{0};
+    // threads in shared_wait_for()
+    std::atomic<int> shared_waiters_{0};
+    std::atomic<int> fd_armed_{0};
+    // fd has been signaled and not yet cleared, so further notify() calls needn't signal it again
+    std::atomic<bool> fd_signaled_{false};
+    std::atomic<std::uint64_t> wake_count_{0};
+    int read_fd_{-1};
+    int write_fd_{-1};
+};
+
+/// \brief Stand-in for the std::condition_variable_any previously returned by PollerInterface::cv(), so that existing callers of notify_one() / notify_all() still wake the poller, and existing callers of wait(lock, ...) still wake up on each notification of the poller
+class PollerWakeupCondition
+{
+  public:
+    explicit PollerWakeupCondition(std::shared_ptr<PollerWakeup> wakeup)
+        : wakeup_(std::move(wakeup))
+    {
+    }
+
+    void notify_one() { wakeup_->notify(); }
+    void notify_all() { wakeup_->notify(); }
+
+    template <class Lock> void wait(Lock& lock)
+    {
+        wait_until(lock, std::chrono::steady_clock::time_point::max());
+    }
+
+    template <class Lock, class Predicate> void wait(Lock& lock, Predicate pred)
+    {
+        while (!pred()) wait(lock);
+    }
+
+    template <class Lock, class Clock, class Duration>
+    std::cv_status wait_until(Lock& lock, const std::chrono::time_point<Clock, Duration>& timeout)
+    {
+        // read before unlocking, so that a notify() by a thread that takes the lock first isn't missed
+        auto seq = wakeup_->sequence();
+        Relock<Lock> relock(lock);
+        return wakeup_->shared_wait_until(seq, timeout) ? std::cv_status::no_timeout
+                                                        : std::cv_status::timeout;
+    }
+
+    template <class Lock, class Clock, class Duration, class Predicate>
+    bool wait_until(Lock& lock, const std::chrono::time_point<Clock, Duration>& timeout,
+                    Predicate pred)
+    {
+        while (!pred())
+        {
+            if (wait_until(lock, timeout) == std::cv_status::timeout)
+                return pred();
+        }
+        return true;
+    }
+
+    template <class Lock, class Rep, class Period>
+    std::cv_status wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& duration)
+    {
+        return wait_until(lock, std::chrono::steady_clock::now() + duration);
+    }
+
+    template <class Lock, class Rep, class Period, class Predicate>
+    bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& duration, Predicate pred)
+    {
+        return wait_until(lock, std::chrono::steady_clock::now() + duration, std::move(pred));
+    }
+
+  private:
+    // unlocks for the duration of the wait (and relocks if the wait throws)
+    template <class Lock> struct Relock
+    {
+        explicit Relock(Lock& l) : lock(l) { lock.unlock(); }
+        ~Relock() { lock.lock(); }
+        Lock& lock;
+    };
+
+  private:
+    std::shared_ptr<PollerWakeup> wakeup_;
+};
+
+} // namespace middleware
+} // namespace goby
+
+#endif
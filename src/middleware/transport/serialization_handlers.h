@@ -26,10 +26,14 @@
 #define GOBY_MIDDLEWARE_TRANSPORT_SERIALIZATION_HANDLERS_H
 
 #include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "goby/exception.h"
 #include "goby/util/binary.h"
@@ -439,6 +443,20 @@ class SerializationSubscriptionRegex
     const std::string subscriber_id_{goby::middleware::thread_id(thread_id_)};
 };
 
+/// \brief Represents a publication serialized by an InterProcessForwarder for its InterProcessPortal to send. Passed to the portal by shared pointer on the inner layer so that the serialized data are not copied in between.
+struct SerializedPublication
+{
+    SerializedPublication(std::string type, int scheme, std::string group, std::vector<char> bytes)
+        : type(std::move(type)), scheme(scheme), group(std::move(group)), bytes(std::move(bytes))
+    {
+    }
+
+    std::string type;
+    int scheme;
+    std::string group;
+    std::vector<char> bytes;
+};
+
 /// \brief Represents an unsubscription to all subscribed data for a given thread
 class SerializationUnSubscribeAll
 {
@@ -446,9 +464,20 @@ class SerializationUnSubscribeAll
     std::thread::id thread_id() const { return thread_id_; }
     std::string subscriber_id() const { return subscriber_id_; }
 
+    /// \brief Called by the Portal once it has removed all the subscriptions of this subscriber
+    void acknowledge() const
+    {
+        std::call_once(acknowledge_flag_, [this]() { acknowledged_.set_value(); });
+    }
+
+    /// \brief Ready when acknowledge() is called, or when this is destroyed without being acknowledged (e.g. no Portal received it). May only be called once.
+    std::future<void> acknowledgment() { return acknowledged_.get_future(); }
+
   private:
     const std::thread::id thread_id_{std::this_thread::get_id()};
     const std::string subscriber_id_{goby::middleware::thread_id(thread_id_)};
+    mutable std::promise<void> acknowledged_;
+    mutable std::once_flag acknowledge_flag_;
 };
 
 /// \brief Represents a(n) (un)subscription from an InterModuleForwarder
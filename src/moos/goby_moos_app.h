@@ -89,7 +89,8 @@
 #include "goby/util/debug_logger/term_color.h"                // for esc_no...
 #include "goby/util/protobuf/debug_logger.pb.h"               // for GLogCo...
 
-#include "dynamic_moos_vars.h" // for Dynami...
+#include "dynamic_moos_vars.h"       // for Dynami...
+#include "wildcard_mail_handlers.h" // for Wildca...
 
 namespace goby
 {
@@ -314,9 +315,7 @@ template <class MOOSAppType = MOOSAppShell> class GobyMOOSAppSelector : public M
     std::map<std::string, std::shared_ptr<boost::signals2::signal<void(const CMOOSMsg& msg)>>>
         mail_handlers_;
 
-    std::map<std::pair<std::string, std::string>,
-             std::shared_ptr<boost::signals2::signal<void(const CMOOSMsg& msg)>>>
-        wildcard_mail_handlers_;
+    goby::moos::WildcardMailHandlers wildcard_mail_handlers_;
 
     // CMOOSApp::OnConnectToServer()
     bool connected_;
@@ -453,15 +452,14 @@ bool goby::moos::GobyMOOSAppSelector<MOOSAppType>::OnNewMail(MOOSMSG_LIST& NewMa
                 goby::glog << "ignoring normal mail from " << msg.GetKey()
                            << " from before we started (dynamics still updated)" << std::endl;
         }
-        else if (mail_handlers_.count(msg.GetKey()))
-            (*mail_handlers_[msg.GetKey()])(msg);
-
-        for (auto& wildcard_mail_handler : wildcard_mail_handlers_)
+        else
         {
-            if (MOOSWildCmp(wildcard_mail_handler.first.first, msg.GetKey()) &&
-                MOOSWildCmp(wildcard_mail_handler.first.second, msg.GetSource()))
-                (*(wildcard_mail_handler.second))(msg);
+            auto it = mail_handlers_.find(msg.GetKey());
+            if (it != mail_handlers_.end())
+                (*it->second)(msg);
         }
+
+        wildcard_mail_handlers_.dispatch(msg);
     }
 
     return true;
@@ -558,12 +556,9 @@ void goby::moos::GobyMOOSAppSelector<MOOSAppType>::subscribe(const std::string&
     wildcard_pending_subscriptions_.emplace_back(key, blackout);
     try_subscribing();
 
-    if (!wildcard_mail_handlers_.count(key))
-        wildcard_mail_handlers_.insert(std::make_pair(
-            key, std::make_shared<boost::signals2::signal<void(const CMOOSMsg& msg)>>()));
-
+    auto& signal = wildcard_mail_handlers_.add(var_pattern, app_pattern);
     if (handler)
-        wildcard_mail_handlers_[key]->connect(handler);
+        signal.connect(handler);
 }
 
 template <class MOOSAppType> void goby::moos::GobyMOOSAppSelector<MOOSAppType>::try_subscribing()
@@ -21,9 +21,823 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with Goby.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <cstdio>    // for snprintf
+#include <regex>     // for sregex_iterator
+#include <set>       // for set
+#include <stdexcept> // for runtime_error
+
+#include <boost/algorithm/string/replace.hpp>      // for replace_all
+#include <boost/lexical_cast.hpp>                  // for lexical_cast
+#include <boost/lexical_cast/bad_lexical_cast.hpp> // for bad_lexical_cast
+
 #include "moos_protobuf_helpers.h"
 
+using FormatTranslation =
+    goby::moos::MOOSTranslation<goby::moos::protobuf::TranslatorEntry::TECHNIQUE_FORMAT>;
+
 std::mutex goby::moos::dynamic_parse_mutex;
 std::mutex goby::moos::moos_technique_mutex;
 goby::moos::protobuf::TranslatorEntry::ParserSerializerTechnique goby::moos::moos_technique =
     goby::moos::protobuf::TranslatorEntry::TECHNIQUE_PREFIXED_PROTOBUF_TEXT_FORMAT;
+
+namespace
+{
+// as written to a std::ostream with std::setprecision(std::numeric_limits<Float>::digits10)
+template <typename Float> std::string float_to_string(Float value)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*g", std::numeric_limits<Float>::digits10,
+                  static_cast<double>(value));
+    return buffer;
+}
+
+// appends a value as boost::format writes it for %N%
+struct AppendValue
+{
+    std::string* out;
+
+    void operator()(const std::string& value) const { out->append(value); }
+    void operator()(float value) const { out->append(float_to_string(value)); }
+    void operator()(double value) const { out->append(float_to_string(value)); }
+    template <typename Integer> void operator()(Integer value) const
+    {
+        out->append(std::to_string(value));
+    }
+};
+
+// feeds a value to boost::format, for formats with other directives than %N%
+struct FeedFormat
+{
+    boost::format* format;
+
+    void operator()(float value) const
+    {
+        *format % boost::io::group(std::setprecision(std::numeric_limits<float>::digits10), value);
+    }
+    void operator()(double value) const
+    {
+        *format % boost::io::group(std::setprecision(std::numeric_limits<double>::digits10), value);
+    }
+    template <typename T> void operator()(const T& value) const { *format % value; }
+};
+
+template <typename Function>
+void visit_singular_field(const google::protobuf::Message& in,
+                          const google::protobuf::FieldDescriptor* field_desc,
+                          bool use_short_enum, Function f)
+{
+    const google::protobuf::Reflection* refl = in.GetReflection();
+    switch (field_desc->cpp_type())
+    {
+        case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+            f(goby::util::hex_encode(refl->GetMessage(in, field_desc).SerializeAsString()));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+            f(refl->GetInt32(in, field_desc));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+            f(refl->GetInt64(in, field_desc));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+            f(refl->GetUInt32(in, field_desc));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+            f(refl->GetUInt64(in, field_desc));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+            f(goby::util::as<std::string>(refl->GetBool(in, field_desc)));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+            if (field_desc->type() == google::protobuf::FieldDescriptor::TYPE_STRING)
+                f(refl->GetString(in, field_desc));
+            else if (field_desc->type() == google::protobuf::FieldDescriptor::TYPE_BYTES)
+                f(goby::util::hex_encode(refl->GetString(in, field_desc)));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+            f(refl->GetFloat(in, field_desc));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+            f(refl->GetDouble(in, field_desc));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+            f(use_short_enum ? goby::moos::strip_name_from_enum(
+                                   refl->GetEnum(in, field_desc)->name(), field_desc->name())
+                             : refl->GetEnum(in, field_desc)->name());
+            break;
+    }
+}
+
+// all the values (joined by repeated_delimiter), or the value at index (default if out of range)
+std::string repeated_field_value(const google::protobuf::Message& in,
+                                 const google::protobuf::FieldDescriptor* field_desc, int index,
+                                 const std::string& repeated_delimiter, bool use_short_enum)
+{
+    const google::protobuf::Reflection* refl = in.GetReflection();
+    bool is_indexed_repeated_field = index >= 0;
+    int size = refl->FieldSize(in, field_desc);
+    int start = is_indexed_repeated_field ? index : 0;
+    int end = is_indexed_repeated_field ? index + 1 : size;
+
+    std::string value;
+    for (int j = start; j < end; ++j)
+    {
+        if (j && !is_indexed_repeated_field)
+            value += repeated_delimiter;
+
+        bool in_range = j < size;
+        switch (field_desc->cpp_type())
+        {
+            case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+                value += goby::util::hex_encode(
+                    refl->GetRepeatedMessage(in, field_desc, j).SerializeAsString());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+                value += std::to_string(in_range ? refl->GetRepeatedInt32(in, field_desc, j)
+                                                 : std::numeric_limits<std::int32_t>::max());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+                value += std::to_string(in_range ? refl->GetRepeatedInt64(in, field_desc, j)
+                                                 : std::numeric_limits<std::int64_t>::max());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+                value += std::to_string(in_range ? refl->GetRepeatedUInt32(in, field_desc, j)
+                                                 : std::numeric_limits<std::uint32_t>::max());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+                value += std::to_string(in_range ? refl->GetRepeatedUInt64(in, field_desc, j)
+                                                 : std::numeric_limits<std::uint64_t>::max());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+                value += (in_range ? refl->GetRepeatedBool(in, field_desc, j)
+                                   : field_desc->default_value_bool())
+                             ? "true"
+                             : "false";
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+                if (field_desc->type() == google::protobuf::FieldDescriptor::TYPE_STRING)
+                    value += in_range ? refl->GetRepeatedString(in, field_desc, j)
+                                      : field_desc->default_value_string();
+                else if (field_desc->type() == google::protobuf::FieldDescriptor::TYPE_BYTES)
+                    value += goby::util::hex_encode(in_range
+                                                        ? refl->GetRepeatedString(in, field_desc, j)
+                                                        : field_desc->default_value_string());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+                value += float_to_string(in_range ? refl->GetRepeatedFloat(in, field_desc, j)
+                                                  : std::numeric_limits<float>::quiet_NaN());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+                value += float_to_string(in_range ? refl->GetRepeatedDouble(in, field_desc, j)
+                                                  : std::numeric_limits<double>::quiet_NaN());
+                break;
+
+            case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+            {
+                const google::protobuf::EnumValueDescriptor* enum_val =
+                    in_range ? refl->GetRepeatedEnum(in, field_desc, j)
+                             : field_desc->default_value_enum();
+                value += use_short_enum ? goby::moos::strip_name_from_enum(enum_val->name(),
+                                                                           field_desc->name())
+                                        : enum_val->name();
+            }
+            break;
+        }
+    }
+    return value;
+}
+
+// sets index value_index (adding default values as needed) of a repeated field, adds to a repeated field, or sets a singular field
+void set_field(google::protobuf::Message* out, const google::protobuf::FieldDescriptor* field_desc,
+               bool is_indexed_repeated_field, int value_index, const std::string& part,
+               bool use_short_enum)
+{
+    const google::protobuf::Reflection* refl = out->GetReflection();
+    switch (field_desc->cpp_type())
+    {
+        case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddMessage(out, field_desc);
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->MutableRepeatedMessage(out, field_desc, value_index)
+                             ->ParseFromString(goby::util::hex_decode(part))
+                       : refl->AddMessage(out, field_desc)
+                             ->ParseFromString(goby::util::hex_decode(part)))
+                : refl->MutableMessage(out, field_desc)
+                      ->ParseFromString(goby::util::hex_decode(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddInt32(out, field_desc, field_desc->default_value_int32());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedInt32(out, field_desc, value_index,
+                                                goby::util::as<google::protobuf::int32>(part))
+                       : refl->AddInt32(out, field_desc,
+                                        goby::util::as<google::protobuf::int32>(part)))
+                : refl->SetInt32(out, field_desc, goby::util::as<google::protobuf::int32>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddInt64(out, field_desc, field_desc->default_value_int64());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedInt64(out, field_desc, value_index,
+                                                goby::util::as<google::protobuf::int64>(part))
+                       : refl->AddInt64(out, field_desc,
+                                        goby::util::as<google::protobuf::int64>(part)))
+                : refl->SetInt64(out, field_desc, goby::util::as<google::protobuf::int64>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddUInt32(out, field_desc, field_desc->default_value_uint32());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedUInt32(out, field_desc, value_index,
+                                                 goby::util::as<google::protobuf::uint32>(part))
+                       : refl->AddUInt32(out, field_desc,
+                                         goby::util::as<google::protobuf::uint32>(part)))
+                : refl->SetUInt32(out, field_desc, goby::util::as<google::protobuf::uint32>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddUInt64(out, field_desc, field_desc->default_value_uint64());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedUInt64(out, field_desc, value_index,
+                                                 goby::util::as<google::protobuf::uint64>(part))
+                       : refl->AddUInt64(out, field_desc,
+                                         goby::util::as<google::protobuf::uint64>(part)))
+                : refl->SetUInt64(out, field_desc, goby::util::as<google::protobuf::uint64>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddBool(out, field_desc, field_desc->default_value_bool());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedBool(out, field_desc, value_index,
+                                               goby::util::as<bool>(part))
+                       : refl->AddBool(out, field_desc, goby::util::as<bool>(part)))
+                : refl->SetBool(out, field_desc, goby::util::as<bool>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddString(out, field_desc, field_desc->default_value_string());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedString(out, field_desc, value_index, part)
+                       : refl->AddString(out, field_desc, part))
+                : refl->SetString(out, field_desc, part);
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddFloat(out, field_desc, field_desc->default_value_float());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedFloat(out, field_desc, value_index,
+                                                goby::util::as<float>(part))
+                       : refl->AddFloat(out, field_desc, goby::util::as<float>(part)))
+                : refl->SetFloat(out, field_desc, goby::util::as<float>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddDouble(out, field_desc, field_desc->default_value_double());
+            }
+            field_desc->is_repeated()
+                ? (is_indexed_repeated_field
+                       ? refl->SetRepeatedDouble(out, field_desc, value_index,
+                                                 goby::util::as<double>(part))
+                       : refl->AddDouble(out, field_desc, goby::util::as<double>(part)))
+                : refl->SetDouble(out, field_desc, goby::util::as<double>(part));
+            break;
+
+        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+        {
+            if (is_indexed_repeated_field)
+            {
+                while (refl->FieldSize(*out, field_desc) <= value_index)
+                    refl->AddEnum(out, field_desc, field_desc->default_value_enum());
+            }
+            std::string enum_value =
+                ((use_short_enum) ? goby::moos::add_name_to_enum(part, field_desc->name())
+                                  : part);
+
+            const google::protobuf::EnumDescriptor* enum_type = field_desc->enum_type();
+            const google::protobuf::EnumValueDescriptor* enum_desc =
+                enum_type->FindValueByName(enum_value);
+
+            // try upper case
+            if (!enum_desc)
+                enum_desc = enum_type->FindValueByName(boost::to_upper_copy(enum_value));
+            // try lower case
+            if (!enum_desc)
+                enum_desc = enum_type->FindValueByName(boost::to_lower_copy(enum_value));
+            if (enum_desc)
+            {
+                field_desc->is_repeated()
+                    ? (is_indexed_repeated_field
+                           ? refl->SetRepeatedEnum(out, field_desc, value_index, enum_desc)
+                           : refl->AddEnum(out, field_desc, enum_desc))
+                    : refl->SetEnum(out, field_desc, enum_desc);
+            }
+        }
+        break;
+    }
+}
+} // namespace
+
+FormatTranslation::Serializer::Serializer(const std::string& format,
+                                          const google::protobuf::Descriptor* desc,
+                                          const SerializerAlgorithms& algorithms)
+    : desc_(desc), algorithms_(algorithms)
+{
+    std::string mutable_format = format;
+
+    int max_field_number = 1;
+    for (int i = 1, n = desc->field_count(); i < n; ++i)
+    {
+        const google::protobuf::FieldDescriptor* field_desc = desc->field(i);
+        if (field_desc->number() > max_field_number)
+            max_field_number = field_desc->number();
+    }
+
+    // virtual fields that run_serialize_algorithms() will return
+    std::set<int> algorithm_outputs;
+    for (const auto& algorithm : algorithms)
+    {
+        const google::protobuf::FieldDescriptor* primary_field_desc =
+            desc->FindFieldByNumber(algorithm.primary_field());
+        if (!primary_field_desc || primary_field_desc->is_repeated())
+            continue;
+
+        algorithm_outputs.insert(algorithm.output_virtual_field());
+        if (algorithm.output_virtual_field() > max_field_number)
+            max_field_number = algorithm.output_virtual_field();
+    }
+
+    // arguments added by rewriting "%a:b%" and "%a.b%" to "%N%"
+    std::map<int, Argument> added_arguments;
+
+    std::string mutable_format_temp = mutable_format;
+
+    std::regex moos_index_regex("%([0-9\\.]+:)+[0-9\\.]+%");
+    for (std::sregex_iterator it(mutable_format.begin(), mutable_format.end(), moos_index_regex),
+         end;
+         it != end; ++it)
+    {
+        std::string match = (*it)[0];
+
+        boost::trim_if(match, boost::is_any_of("%"));
+        std::vector<std::string> subfields;
+        boost::split(subfields, match, boost::is_any_of(":"));
+
+        ++max_field_number;
+
+        Argument& argument = added_arguments[max_field_number];
+        argument.source = Source::EMBEDDED_MESSAGE;
+
+        const google::protobuf::Descriptor* sub_desc = desc;
+        for (int i = 0, n = subfields.size() - 1; i < n; ++i)
+        {
+            std::vector<std::string> field_and_index;
+            boost::split(field_and_index, subfields[i], boost::is_any_of("."));
+
+            const google::protobuf::FieldDescriptor* field_desc =
+                sub_desc->FindFieldByNumber(goby::util::as<int>(field_and_index[0]));
+            if (!field_desc ||
+                field_desc->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
+            {
+                throw(std::runtime_error(
+                    "Invalid ':' syntax given for format: " + match +
+                    ". All field indices except the last must be embedded messages"));
+            }
+            if (field_desc->is_repeated() && field_and_index.size() != 2)
+            {
+                throw(std::runtime_error("Invalid '.' syntax given for format: " + match +
+                                         ". Repeated message, but no valid index given. E.g., "
+                                         "use '3.4' for index 4 of field 3."));
+            }
+
+            argument.path.emplace_back(
+                field_desc,
+                field_desc->is_repeated() ? goby::util::as<int>(field_and_index[1]) : -1);
+            sub_desc = field_desc->message_type();
+        }
+
+        argument.embedded = std::make_shared<const Serializer>(
+            "%" + subfields[subfields.size() - 1] + "%", sub_desc, algorithms);
+
+        boost::replace_all(mutable_format_temp, std::string("%" + match + "%"),
+                           std::string("%" + goby::util::as<std::string>(max_field_number) + "%"));
+    }
+
+    mutable_format = mutable_format_temp;
+
+    std::map<int, RepeatedFieldKey> indexed_repeated_fields;
+
+    std::regex repeated_field_regex("%[0-9]+\\.[0-9]+%");
+    for (std::sregex_iterator it(mutable_format.begin(), mutable_format.end(),
+                                 repeated_field_regex),
+         end;
+         it != end; ++it)
+    {
+        std::string match = (*it)[0];
+        boost::trim_if(match, boost::is_any_of("%"));
+
+        ++max_field_number;
+
+        boost::replace_all(mutable_format_temp, std::string("%" + match + "%"),
+                           std::string("%" + goby::util::as<std::string>(max_field_number) + "%"));
+
+        RepeatedFieldKey key;
+
+        std::vector<std::string> field_and_index;
+        boost::split(field_and_index, match, boost::is_any_of("."));
+
+        key.field = goby::util::as<int>(field_and_index[0]);
+        key.index = goby::util::as<int>(field_and_index[1]);
+
+        indexed_repeated_fields[max_field_number] = key;
+    }
+
+    mutable_format = mutable_format_temp;
+
+    // fields take precedence over the values of algorithms and embedded messages
+    for (int i = 1; i <= max_field_number; ++i)
+    {
+        bool is_indexed_repeated_field = indexed_repeated_fields.count(i);
+
+        Argument argument;
+        const google::protobuf::FieldDescriptor* field_desc = desc->FindFieldByNumber(
+            is_indexed_repeated_field ? indexed_repeated_fields[i].field : i);
+        if (field_desc)
+        {
+            argument.source = Source::FIELD;
+            argument.field_desc = field_desc;
+            argument.index = is_indexed_repeated_field ? indexed_repeated_fields[i].index : -1;
+        }
+        else if (algorithm_outputs.count(i))
+        {
+            argument.source = Source::ALGORITHM_OUTPUT;
+            argument.number = i;
+        }
+        else if (added_arguments.count(i))
+        {
+            argument = added_arguments[i];
+        }
+        arguments_.push_back(argument);
+    }
+
+    if (!tokenize(mutable_format))
+    {
+        auto boost_format = std::make_shared<boost::format>(mutable_format);
+        boost_format->exceptions(boost::io::all_error_bits ^
+                                 (boost::io::too_many_args_bit | boost::io::too_few_args_bit));
+        boost_format_ = boost_format;
+    }
+}
+
+bool FormatTranslation::Serializer::tokenize(const std::string& format)
+{
+    Token token;
+    for (std::string::size_type i = 0, n = format.size(); i < n;)
+    {
+        if (format[i] != '%')
+        {
+            token.literal += format[i++];
+            continue;
+        }
+
+        if (i + 1 < n && format[i + 1] == '%')
+        {
+            token.literal += '%';
+            i += 2;
+            continue;
+        }
+
+        // only %N% (N >= 1, no leading zero); anything else is left to boost::format
+        std::string::size_type close = format.find('%', i + 1);
+        if (close == std::string::npos)
+            return false;
+        std::string number = format.substr(i + 1, close - i - 1);
+        if (number.empty() || number.size() > 9 || number[0] == '0' ||
+            number.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+
+        token.argument = std::stoi(number);
+        tokens_.push_back(token);
+        token = Token();
+        i = close + 1;
+    }
+    if (!token.literal.empty())
+        tokens_.push_back(token);
+    return true;
+}
+
+template <typename Function>
+void FormatTranslation::Serializer::visit(const Argument& argument,
+                                          const google::protobuf::Message& in,
+                                          const std::map<int, std::string>& algorithm_outputs,
+                                          const std::string& repeated_delimiter,
+                                          bool use_short_enum, Function f) const
+{
+    switch (argument.source)
+    {
+        case Source::FIELD:
+            if (argument.field_desc->is_repeated())
+                f(repeated_field_value(in, argument.field_desc, argument.index, repeated_delimiter,
+                                       use_short_enum));
+            else
+                visit_singular_field(in, argument.field_desc, use_short_enum, f);
+            break;
+
+        case Source::ALGORITHM_OUTPUT:
+        {
+            auto it = algorithm_outputs.find(argument.number);
+            f(it != algorithm_outputs.end() ? it->second : std::string("unknown"));
+        }
+        break;
+
+        case Source::EMBEDDED_MESSAGE:
+        {
+            const google::protobuf::Message* sub_message = &in;
+            for (const auto& field_and_index : argument.path)
+            {
+                const google::protobuf::Reflection* sub_refl = sub_message->GetReflection();
+                sub_message = (field_and_index.first->is_repeated())
+                                  ? &sub_refl->GetRepeatedMessage(
+                                        *sub_message, field_and_index.first, field_and_index.second)
+                                  : &sub_refl->GetMessage(*sub_message, field_and_index.first);
+            }
+
+            std::string value;
+            argument.embedded->serialize(&value, *sub_message, repeated_delimiter, use_short_enum);
+            f(value);
+        }
+        break;
+
+        case Source::UNKNOWN: f(std::string("unknown")); break;
+    }
+}
+
+void FormatTranslation::Serializer::serialize(std::string* out,
+                                              const google::protobuf::Message& in,
+                                              const std::string& repeated_delimiter,
+                                              bool use_short_enum) const
+{
+    if (in.GetDescriptor() != desc_)
+        throw(std::runtime_error("Format compiled for " + desc_->full_name() +
+                                 " cannot serialize message: " + in.GetDescriptor()->full_name()));
+
+    std::map<int, std::string> algorithm_outputs;
+    if (!algorithms_.empty())
+        algorithm_outputs = run_serialize_algorithms(in, algorithms_);
+
+    if (boost_format_)
+    {
+        boost::format out_format(*boost_format_);
+        for (const Argument& argument : arguments_)
+            visit(argument, in, algorithm_outputs, repeated_delimiter, use_short_enum,
+                  FeedFormat{&out_format});
+        *out = out_format.str();
+    }
+    else
+    {
+        std::string value;
+        for (const Token& token : tokens_)
+        {
+            value += token.literal;
+            // arguments past the last are empty, as with boost::format
+            if (token.argument > 0 && token.argument <= static_cast<int>(arguments_.size()))
+                visit(arguments_[token.argument - 1], in, algorithm_outputs, repeated_delimiter,
+                      use_short_enum, AppendValue{&value});
+        }
+        *out = std::move(value);
+    }
+}
+
+FormatTranslation::Parser::Parser(std::string format, const google::protobuf::Descriptor* desc)
+    : desc_(desc)
+{
+    boost::to_lower(format);
+
+    std::string::const_iterator i = format.begin();
+    while (i != format.end())
+    {
+        Step step;
+        if (*i == '%')
+        {
+            ++i; // now *i is the conversion specifier
+            while (i != format.end() && *i != '%') step.specifier += *i++;
+            if (i == format.end())
+                throw(std::runtime_error("Unterminated specifier: %" + step.specifier +
+                                         " in format: " + format));
+
+            ++i; // now *i is the next separator
+            step.is_field = true;
+            step.separator = (i != format.end()) ? *i : '\0';
+
+            if (step.specifier.find(':') != std::string::npos)
+            {
+                std::vector<std::string> subfields;
+                boost::split(subfields, step.specifier, boost::is_any_of(":"));
+
+                const google::protobuf::Descriptor* sub_desc = desc;
+                for (int j = 0, n = subfields.size() - 1; j < n; ++j)
+                {
+                    std::vector<std::string> field_and_index;
+                    boost::split(field_and_index, subfields[j], boost::is_any_of("."));
+
+                    const google::protobuf::FieldDescriptor* field_desc =
+                        sub_desc->FindFieldByNumber(goby::util::as<int>(field_and_index[0]));
+                    if (!field_desc || field_desc->cpp_type() !=
+                                           google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
+                    {
+                        throw(std::runtime_error(
+                            "Invalid ':' syntax given for format: " + step.specifier +
+                            ". All field indices except the last must be singular embedded "
+                            "messages"));
+                    }
+
+                    int index = -1;
+                    if (field_desc->is_repeated())
+                    {
+                        if (field_and_index.size() != 2)
+                            throw(std::runtime_error(
+                                "Invalid '.' syntax given for format: " + step.specifier +
+                                ". Repeated message, but no valid index given. E.g., use '3.4' "
+                                "for index 4 of field 3."));
+                        index = goby::util::as<int>(field_and_index.at(1));
+                    }
+
+                    step.path.emplace_back(field_desc, index);
+                    sub_desc = field_desc->message_type();
+                }
+
+                step.embedded = std::make_shared<const Parser>(
+                    "%" + subfields[subfields.size() - 1] + "%", sub_desc);
+            }
+            else
+            {
+                try
+                {
+                    std::vector<std::string> field_and_index;
+                    boost::split(field_and_index, step.specifier, boost::is_any_of("."));
+
+                    step.field_index = boost::lexical_cast<int>(field_and_index[0]);
+                    step.is_indexed_repeated_field = field_and_index.size() == 2;
+
+                    if (step.is_indexed_repeated_field)
+                        step.value_index = boost::lexical_cast<int>(field_and_index[1]);
+
+                    step.field_desc = desc->FindFieldByNumber(step.field_index);
+
+                    if (!step.field_desc)
+                        throw(std::runtime_error("Bad field: " + step.specifier +
+                                                 " not in message " + desc->full_name()));
+                }
+                catch (boost::bad_lexical_cast&)
+                {
+                    throw(std::runtime_error("Bad specifier: " + step.specifier +
+                                             ", must be an integer. For message: " +
+                                             desc->full_name()));
+                }
+            }
+        }
+        else
+        {
+            // not a %, so skipped past when parsing
+            step.separator = *i++;
+        }
+        steps_.push_back(step);
+    }
+}
+
+void FormatTranslation::Parser::parse(const std::string& in, google::protobuf::Message* out,
+                                      const std::string& repeated_delimiter,
+                                      const ParserAlgorithms& algorithms,
+                                      bool use_short_enum) const
+{
+    if (out->GetDescriptor() != desc_)
+        throw(std::runtime_error("Format compiled for " + desc_->full_name() +
+                                 " cannot parse message: " + out->GetDescriptor()->full_name()));
+
+    std::string lower_str = boost::to_lower_copy(in);
+    // start of the part of in not yet eaten
+    std::string::size_type offset = 0;
+
+    for (const Step& step : steps_)
+    {
+        std::string::size_type separator_pos = lower_str.find(step.separator, offset);
+        if (!step.is_field)
+        {
+            // if it's not a %, eat!
+            if (separator_pos != std::string::npos)
+                offset = separator_pos + 1;
+            continue;
+        }
+
+        std::string extract =
+            in.substr(offset, separator_pos == std::string::npos ? std::string::npos
+                                                                 : separator_pos - offset);
+
+        if (step.embedded)
+        {
+            google::protobuf::Message* sub_message = out;
+            for (const auto& field_and_index : step.path)
+            {
+                const google::protobuf::FieldDescriptor* field_desc = field_and_index.first;
+                const google::protobuf::Reflection* sub_refl = sub_message->GetReflection();
+                if (field_desc->is_repeated())
+                {
+                    while (sub_refl->FieldSize(*sub_message, field_desc) <= field_and_index.second)
+                        sub_refl->AddMessage(sub_message, field_desc);
+                    sub_message = sub_refl->MutableRepeatedMessage(sub_message, field_desc,
+                                                                   field_and_index.second);
+                }
+                else
+                {
+                    sub_message = sub_refl->MutableMessage(sub_message, field_desc);
+                }
+            }
+
+            step.embedded->parse(extract, sub_message, repeated_delimiter, algorithms,
+                                 use_short_enum);
+            continue;
+        }
+
+        // run algorithms
+        for (const auto& algorithm : algorithms)
+        {
+            goby::moos::transitional::DCCLMessageVal extract_val(extract);
+
+            if (algorithm.primary_field() == step.field_index)
+                goby::moos::transitional::DCCLAlgorithmPerformer::getInstance()->run_algorithm(
+                    algorithm.name(), extract_val,
+                    std::vector<goby::moos::transitional::DCCLMessageVal>());
+
+            extract = std::string(extract_val);
+        }
+
+        std::vector<std::string> parts;
+        if (step.is_indexed_repeated_field || !step.field_desc->is_repeated())
+            parts.push_back(extract);
+        else
+            boost::split(parts, extract, boost::is_any_of(repeated_delimiter));
+
+        for (const auto& part : parts)
+            set_field(out, step.field_desc, step.is_indexed_repeated_field, step.value_index, part,
+                      use_short_enum);
+    }
+}
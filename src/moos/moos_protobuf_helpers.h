@@ -34,7 +34,6 @@
 #include <map>       // for map, map<>::c...
 #include <memory>    // for allocator
 #include <mutex>     // for mutex, lock_g...
-#include <regex>     // for sregex_iterator
 #include <sstream>   // for basic_ostream
 #include <stdexcept> // for runtime_error
 #include <string>    // for string, opera...
@@ -44,13 +43,10 @@
 #include <boost/algorithm/string/case_conv.hpp>      // for to_lower_copy
 #include <boost/algorithm/string/classification.hpp> // for is_any_ofF
 #include <boost/algorithm/string/erase.hpp>          // for ierase_first_...
-#include <boost/algorithm/string/replace.hpp>        // for replace_all
 #include <boost/algorithm/string/split.hpp>          // for split
 #include <boost/algorithm/string/trim.hpp>           // for trim_if
 #include <boost/core/enable_if.hpp>                  // for enable_if_c<>...
 #include <boost/format.hpp>                          // for basic_altstri...
-#include <boost/lexical_cast.hpp>                    // for lexical_cast
-#include <boost/lexical_cast/bad_lexical_cast.hpp>   // for bad_lexical_cast
 #include <google/protobuf/descriptor.h>              // for FieldDescriptor
 #include <google/protobuf/message.h>                 // for Reflection
 #include <google/protobuf/text_format.h>             // for TextFormat
@@ -831,671 +827,131 @@ class MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_COMMA_SEPARATED_KEY_E
 template <> class MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_FORMAT>
 {
   public:
+    using SerializerAlgorithms = google::protobuf::RepeatedPtrField<
+        protobuf::TranslatorEntry::PublishSerializer::Algorithm>;
+    using ParserAlgorithms =
+        google::protobuf::RepeatedPtrField<protobuf::TranslatorEntry::CreateParser::Algorithm>;
+
     struct RepeatedFieldKey
     {
         int field;
         int index;
     };
 
-    static void serialize(std::string* out, const google::protobuf::Message& in,
-                          const google::protobuf::RepeatedPtrField<
-                              protobuf::TranslatorEntry::PublishSerializer::Algorithm>& algorithms,
-                          const std::string& format, const std::string& repeated_delimiter,
-                          bool use_short_enum = false)
+    /// \brief Format string compiled for serializing messages of one Protobuf type
+    ///
+    /// The format is scanned once (on construction) into literal text and the source of each value (a field, an index of a repeated field, a field of an embedded message, or the output of an algorithm), which serialize() then reads from each message.
+    class Serializer
     {
-        std::string mutable_format = format;
-
-        const google::protobuf::Descriptor* desc = in.GetDescriptor();
-        const google::protobuf::Reflection* refl = in.GetReflection();
-
-        int max_field_number = 1;
-        for (int i = 1, n = desc->field_count(); i < n; ++i)
-        {
-            const google::protobuf::FieldDescriptor* field_desc = desc->field(i);
-            if (field_desc->number() > max_field_number)
-                max_field_number = field_desc->number();
-        }
+      public:
+        Serializer(const std::string& format, const google::protobuf::Descriptor* desc,
+                   const SerializerAlgorithms& algorithms);
 
-        // run algorithms
-        std::map<int, std::string> modified_values = run_serialize_algorithms(in, algorithms);
+        void serialize(std::string* out, const google::protobuf::Message& in,
+                       const std::string& repeated_delimiter, bool use_short_enum = false) const;
 
-        for (const auto& modified_value : modified_values)
+      private:
+        enum class Source
         {
-            if (modified_value.first > max_field_number)
-                max_field_number = modified_value.first;
-        }
-
-        std::string mutable_format_temp = mutable_format;
-
-        std::regex moos_index_regex("%([0-9\\.]+:)+[0-9\\.]+%");
-        for (std::sregex_iterator
-                 it(mutable_format.begin(), mutable_format.end(), moos_index_regex),
-             end;
-             it != end; ++it)
+            FIELD,
+            ALGORITHM_OUTPUT,
+            EMBEDDED_MESSAGE,
+            UNKNOWN
+        };
+
+        // where the value of one argument of the format (%N%) comes from
+        struct Argument
         {
-            std::string match = (*it)[0];
-
-            boost::trim_if(match, boost::is_any_of("%"));
-            std::vector<std::string> subfields;
-            boost::split(subfields, match, boost::is_any_of(":"));
-
-            ++max_field_number;
-
-            const google::protobuf::FieldDescriptor* field_desc = nullptr;
-            const google::protobuf::Reflection* sub_refl = refl;
-            const google::protobuf::Message* sub_message = &in;
-
-            for (int i = 0, n = subfields.size() - 1; i < n; ++i)
-            {
-                std::vector<std::string> field_and_index;
-                boost::split(field_and_index, subfields[i], boost::is_any_of("."));
-
-                field_desc = sub_message->GetDescriptor()->FindFieldByNumber(
-                    goby::util::as<int>(field_and_index[0]));
-                if (!field_desc ||
-                    field_desc->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
-                {
-                    throw(std::runtime_error(
-                        "Invalid ':' syntax given for format: " + match +
-                        ". All field indices except the last must be embedded messages"));
-                }
-                if (field_desc->is_repeated() && field_and_index.size() != 2)
-                {
-                    throw(std::runtime_error("Invalid '.' syntax given for format: " + match +
-                                             ". Repeated message, but no valid index given. E.g., "
-                                             "use '3.4' for index 4 of field 3."));
-                }
-
-                sub_message =
-                    (field_desc->is_repeated())
-                        ? &sub_refl->GetRepeatedMessage(*sub_message, field_desc,
-                                                        goby::util::as<int>(field_and_index[1]))
-                        : &sub_refl->GetMessage(*sub_message, field_desc);
-                sub_refl = sub_message->GetReflection();
-            }
-
-            serialize(&modified_values[max_field_number], *sub_message, algorithms,
-                      "%" + subfields[subfields.size() - 1] + "%", repeated_delimiter,
-                      use_short_enum);
-
-            boost::replace_all(
-                mutable_format_temp, std::string("%" + match + "%"),
-                std::string("%" + goby::util::as<std::string>(max_field_number) + "%"));
-        }
-
-        mutable_format = mutable_format_temp;
-
-        std::map<int, RepeatedFieldKey> indexed_repeated_fields;
-
-        std::regex repeated_field_regex("%[0-9]+\\.[0-9]+%");
-        for (std::sregex_iterator
-                 it(mutable_format.begin(), mutable_format.end(), repeated_field_regex),
-             end;
-             it != end; ++it)
+            Source source{Source::UNKNOWN};
+            // virtual field number, for ALGORITHM_OUTPUT
+            int number{0};
+            const google::protobuf::FieldDescriptor* field_desc{nullptr};
+            // index of a repeated field (%N.M%), or -1 for all the values
+            int index{-1};
+            // path to the embedded message (field, index if repeated), for "%a:b%"
+            std::vector<std::pair<const google::protobuf::FieldDescriptor*, int>> path;
+            // compiled "%b%" for the embedded message
+            std::shared_ptr<const Serializer> embedded;
+        };
+
+        // literal text followed by the argument %N% (or none if 0)
+        struct Token
         {
-            std::string match = (*it)[0];
-            boost::trim_if(match, boost::is_any_of("%"));
-
-            ++max_field_number;
-
-            boost::replace_all(
-                mutable_format_temp, std::string("%" + match + "%"),
-                std::string("%" + goby::util::as<std::string>(max_field_number) + "%"));
-
-            RepeatedFieldKey key;
-
-            std::vector<std::string> field_and_index;
-            boost::split(field_and_index, match, boost::is_any_of("."));
-
-            key.field = goby::util::as<int>(field_and_index[0]);
-            key.index = goby::util::as<int>(field_and_index[1]);
-
-            indexed_repeated_fields[max_field_number] = key;
-        }
+            std::string literal;
+            int argument{0};
+        };
+
+        void compile_embedded_message(const std::string& match, int number);
+        bool tokenize(const std::string& format);
+
+        // calls f with the value of argument (as it is given to boost::format)
+        template <typename Function>
+        void visit(const Argument& argument, const google::protobuf::Message& in,
+                   const std::map<int, std::string>& algorithm_outputs,
+                   const std::string& repeated_delimiter, bool use_short_enum,
+                   Function f) const;
+
+      private:
+        const google::protobuf::Descriptor* desc_;
+        SerializerAlgorithms algorithms_;
+        // arguments %1% to %N% (index N - 1)
+        std::vector<Argument> arguments_;
+        std::vector<Token> tokens_;
+        // used in place of tokens_ when the format has boost::format directives other than %N% (e.g., printf style)
+        std::shared_ptr<const boost::format> boost_format_;
+    };
 
-        mutable_format = mutable_format_temp;
+    /// \brief Format string compiled for parsing strings into messages of one Protobuf type
+    ///
+    /// As with Serializer, the format is scanned once into the literal characters to skip and the field (or repeated field index, or field of an embedded message) to set from the text before each separator.
+    class Parser
+    {
+      public:
+        Parser(std::string format, const google::protobuf::Descriptor* desc);
 
-        boost::format out_format(mutable_format);
-        out_format.exceptions(boost::io::all_error_bits ^
-                              (boost::io::too_many_args_bit | boost::io::too_few_args_bit));
+        void parse(const std::string& in, google::protobuf::Message* out,
+                   const std::string& repeated_delimiter,
+                   const ParserAlgorithms& algorithms = ParserAlgorithms(),
+                   bool use_short_enum = false) const;
 
-        for (int i = 1; i <= max_field_number; ++i)
+      private:
+        struct Step
         {
-            bool is_indexed_repeated_field = indexed_repeated_fields.count(i);
-
-            const google::protobuf::FieldDescriptor* field_desc = desc->FindFieldByNumber(
-                is_indexed_repeated_field ? indexed_repeated_fields[i].field : i);
-            std::map<int, std::string>::const_iterator mod_it = modified_values.find(i);
-            if (field_desc)
-            {
-                if (field_desc->is_repeated())
-                {
-                    int start = (is_indexed_repeated_field) ? indexed_repeated_fields[i].index : 0;
-                    int end = (is_indexed_repeated_field) ? indexed_repeated_fields[i].index + 1
-                                                          : refl->FieldSize(in, field_desc);
-
-                    std::stringstream out_repeated;
-                    for (int j = start; j < end; ++j)
-                    {
-                        if (j && !is_indexed_repeated_field)
-                            out_repeated << repeated_delimiter;
-                        switch (field_desc->cpp_type())
-                        {
-                            case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
-                                out_repeated << goby::util::hex_encode(
-                                    refl->GetRepeatedMessage(in, field_desc, j)
-                                        .SerializeAsString());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
-                                out_repeated << ((j < refl->FieldSize(in, field_desc))
-                                                     ? refl->GetRepeatedInt32(in, field_desc, j)
-                                                     : std::numeric_limits<std::int32_t>::max());
-
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
-                                out_repeated << ((j < refl->FieldSize(in, field_desc))
-                                                     ? refl->GetRepeatedInt64(in, field_desc, j)
-                                                     : std::numeric_limits<std::int64_t>::max());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
-                                out_repeated << ((j < refl->FieldSize(in, field_desc))
-                                                     ? refl->GetRepeatedUInt32(in, field_desc, j)
-                                                     : std::numeric_limits<std::uint32_t>::max());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
-                                out_repeated << ((j < refl->FieldSize(in, field_desc))
-                                                     ? refl->GetRepeatedUInt64(in, field_desc, j)
-                                                     : std::numeric_limits<std::uint64_t>::max());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
-                                out_repeated << std::boolalpha
-                                             << ((j < refl->FieldSize(in, field_desc))
-                                                     ? refl->GetRepeatedBool(in, field_desc, j)
-                                                     : field_desc->default_value_bool());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
-                                if (field_desc->type() ==
-                                    google::protobuf::FieldDescriptor::TYPE_STRING)
-                                    out_repeated
-                                        << ((j < refl->FieldSize(in, field_desc))
-                                                ? refl->GetRepeatedString(in, field_desc, j)
-                                                : field_desc->default_value_string());
-                                else if (field_desc->type() ==
-                                         google::protobuf::FieldDescriptor::TYPE_BYTES)
-                                    out_repeated << goby::util::hex_encode(
-                                        ((j < refl->FieldSize(in, field_desc))
-                                             ? refl->GetRepeatedString(in, field_desc, j)
-                                             : field_desc->default_value_string()));
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
-                                out_repeated
-                                    << std::setprecision(std::numeric_limits<float>::digits10)
-                                    << ((j < refl->FieldSize(in, field_desc))
-                                            ? refl->GetRepeatedFloat(in, field_desc, j)
-                                            : std::numeric_limits<float>::quiet_NaN());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
-                                out_repeated
-                                    << std::setprecision(std::numeric_limits<double>::digits10)
-                                    << ((j < refl->FieldSize(in, field_desc))
-                                            ? refl->GetRepeatedDouble(in, field_desc, j)
-                                            : std::numeric_limits<double>::quiet_NaN());
-                                break;
-
-                            case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
-                            {
-                                const google::protobuf::EnumValueDescriptor* enum_val =
-                                    ((j < refl->FieldSize(in, field_desc))
-                                         ? refl->GetRepeatedEnum(in, field_desc, j)
-                                         : field_desc->default_value_enum());
-                                out_repeated
-                                    << ((use_short_enum) ? strip_name_from_enum(enum_val->name(),
-                                                                                field_desc->name())
-                                                         : enum_val->name());
-                            }
-                            break;
-                        }
-                    }
-                    out_format % out_repeated.str();
-                }
-                else
-                {
-                    switch (field_desc->cpp_type())
-                    {
-                        case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
-                            out_format % goby::util::hex_encode(
-                                             refl->GetMessage(in, field_desc).SerializeAsString());
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
-                            out_format % refl->GetInt32(in, field_desc);
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
-                            out_format % refl->GetInt64(in, field_desc);
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
-                            out_format % refl->GetUInt32(in, field_desc);
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
-                            out_format % refl->GetUInt64(in, field_desc);
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
-                            out_format % goby::util::as<std::string>(refl->GetBool(in, field_desc));
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
-                            if (field_desc->type() ==
-                                google::protobuf::FieldDescriptor::TYPE_STRING)
-                                out_format % refl->GetString(in, field_desc);
-                            else if (field_desc->type() ==
-                                     google::protobuf::FieldDescriptor::TYPE_BYTES)
-                                out_format %
-                                    goby::util::hex_encode(refl->GetString(in, field_desc));
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
-                            out_format % boost::io::group(std::setprecision(
-                                                              std::numeric_limits<float>::digits10),
-                                                          refl->GetFloat(in, field_desc));
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
-                            out_format %
-                                boost::io::group(
-                                    std::setprecision(std::numeric_limits<double>::digits10),
-                                    refl->GetDouble(in, field_desc));
-                            break;
-
-                        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
-
-                            out_format %
-                                ((use_short_enum)
-                                     ? strip_name_from_enum(refl->GetEnum(in, field_desc)->name(),
-                                                            field_desc->name())
-                                     : refl->GetEnum(in, field_desc)->name());
-                            break;
-                    }
-                }
-            }
-            else if (mod_it != modified_values.end())
-            {
-                out_format % mod_it->second;
-            }
-            else
-            {
-                out_format % "unknown";
-            }
-        }
+            // for a field: the separator that ends its value; otherwise: literal character to skip past
+            char separator{0};
+            bool is_field{false};
+            std::string specifier;
+            int field_index{0};
+            const google::protobuf::FieldDescriptor* field_desc{nullptr};
+            bool is_indexed_repeated_field{false};
+            int value_index{0};
+            // path to the embedded message (field, index if repeated) and its compiled "%b%", for "%a:b%"
+            std::vector<std::pair<const google::protobuf::FieldDescriptor*, int>> path;
+            std::shared_ptr<const Parser> embedded;
+        };
+
+      private:
+        const google::protobuf::Descriptor* desc_;
+        std::vector<Step> steps_;
+    };
 
-        *out = out_format.str();
+    /// \brief Serializes using a format compiled for this call only. When serializing many messages, prefer to keep a Serializer.
+    static void serialize(std::string* out, const google::protobuf::Message& in,
+                          const SerializerAlgorithms& algorithms, const std::string& format,
+                          const std::string& repeated_delimiter, bool use_short_enum = false)
+    {
+        Serializer(format, in.GetDescriptor(), algorithms)
+            .serialize(out, in, repeated_delimiter, use_short_enum);
     }
 
+    /// \brief Parses using a format compiled for this call only. When parsing many messages, prefer to keep a Parser.
     static void parse(const std::string& in, google::protobuf::Message* out, std::string format,
                       const std::string& repeated_delimiter,
-                      const google::protobuf::RepeatedPtrField<
-                          protobuf::TranslatorEntry::CreateParser::Algorithm>& algorithms =
-                          google::protobuf::RepeatedPtrField<
-                              protobuf::TranslatorEntry::CreateParser::Algorithm>(),
+                      const ParserAlgorithms& algorithms = ParserAlgorithms(),
                       bool use_short_enum = false)
     {
-        const google::protobuf::Descriptor* desc = out->GetDescriptor();
-        const google::protobuf::Reflection* refl = out->GetReflection();
-        boost::to_lower(format);
-        std::string str = in;
-        std::string lower_str = boost::to_lower_copy(in);
-
-        //    goby::glog.is(DEBUG1) && goby::glog << "Format: " << format << std::endl;
-        //   goby::glog.is(DEBUG1) && goby::glog << "String: " << str << std::endl;
-        //    goby::glog.is(DEBUG1) && goby::glog << "Lower String: " << lower_str << std::endl;
-
-        std::string::const_iterator i = format.begin();
-
-        while (i != format.end())
-        {
-            if (*i == '%')
-            {
-                ++i; // now *i is the conversion specifier
-                std::string specifier;
-                while (*i != '%') specifier += *i++;
-
-                ++i; // now *i is the next separator
-                std::string extract = str.substr(0, lower_str.find(*i));
-
-                if (specifier.find(':') != std::string::npos)
-                {
-                    std::vector<std::string> subfields;
-                    boost::split(subfields, specifier, boost::is_any_of(":"));
-                    const google::protobuf::FieldDescriptor* field_desc = nullptr;
-                    const google::protobuf::Reflection* sub_refl = refl;
-                    google::protobuf::Message* sub_message = out;
-
-                    for (int i = 0, n = subfields.size() - 1; i < n; ++i)
-                    {
-                        std::vector<std::string> field_and_index;
-                        boost::split(field_and_index, subfields[i], boost::is_any_of("."));
-
-                        field_desc = sub_message->GetDescriptor()->FindFieldByNumber(
-                            goby::util::as<int>(field_and_index[0]));
-                        if (!field_desc || field_desc->cpp_type() !=
-                                               google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
-                        {
-                            throw(std::runtime_error(
-                                "Invalid ':' syntax given for format: " + specifier +
-                                ". All field indices except the last must be singular embedded "
-                                "messages"));
-                        }
-
-                        int index = -1;
-                        if (field_desc->is_repeated())
-                        {
-                            if (field_and_index.size() != 2)
-                                throw(std::runtime_error(
-                                    "Invalid '.' syntax given for format: " + specifier +
-                                    ". Repeated message, but no valid index given. E.g., use '3.4' "
-                                    "for index 4 of field 3."));
-                            index = goby::util::as<int>(field_and_index.at(1));
-                            while (sub_refl->FieldSize(*sub_message, field_desc) <= index)
-                                sub_refl->AddMessage(sub_message, field_desc);
-                        }
-
-                        sub_message =
-                            (field_desc->is_repeated())
-                                ? sub_refl->MutableRepeatedMessage(sub_message, field_desc, index)
-                                : sub_refl->MutableMessage(sub_message, field_desc);
-                        sub_refl = sub_message->GetReflection();
-                    }
-
-                    parse(extract, sub_message, "%" + subfields[subfields.size() - 1] + "%",
-                          repeated_delimiter, algorithms, use_short_enum);
-                }
-                else
-                {
-                    try
-                    {
-                        std::vector<std::string> field_and_index;
-                        boost::split(field_and_index, specifier, boost::is_any_of("."));
-
-                        int field_index = boost::lexical_cast<int>(field_and_index[0]);
-                        bool is_indexed_repeated_field = field_and_index.size() == 2;
-
-                        int value_index = 0;
-                        if (is_indexed_repeated_field)
-                            value_index = boost::lexical_cast<int>(field_and_index[1]);
-
-                        const google::protobuf::FieldDescriptor* field_desc =
-                            desc->FindFieldByNumber(field_index);
-
-                        if (!field_desc)
-                            throw(std::runtime_error("Bad field: " + specifier +
-                                                     " not in message " + desc->full_name()));
-
-                        // run algorithms
-                        for (const auto& algorithm : algorithms)
-                        {
-                            goby::moos::transitional::DCCLMessageVal extract_val(extract);
-
-                            if (algorithm.primary_field() == field_index)
-                                moos::transitional::DCCLAlgorithmPerformer::getInstance()
-                                    ->run_algorithm(
-                                        algorithm.name(), extract_val,
-                                        std::vector<goby::moos::transitional::DCCLMessageVal>());
-
-                            extract = std::string(extract_val);
-                        }
-
-                        std::vector<std::string> parts;
-                        if (is_indexed_repeated_field || !field_desc->is_repeated())
-                            parts.push_back(extract);
-                        else
-                            boost::split(parts, extract, boost::is_any_of(repeated_delimiter));
-
-                        for (auto& part : parts)
-                        {
-                            switch (field_desc->cpp_type())
-                            {
-                                case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddMessage(out, field_desc);
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->MutableRepeatedMessage(out, field_desc,
-                                                                              value_index)
-                                                     ->ParseFromString(goby::util::hex_decode(part))
-                                               : refl->AddMessage(out, field_desc)
-                                                     ->ParseFromString(
-                                                         goby::util::hex_decode(part)))
-                                        : refl->MutableMessage(out, field_desc)
-                                              ->ParseFromString(goby::util::hex_decode(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddInt32(out, field_desc,
-                                                           field_desc->default_value_int32());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedInt32(
-                                                     out, field_desc, value_index,
-                                                     goby::util::as<google::protobuf::int32>(part))
-                                               : refl->AddInt32(
-                                                     out, field_desc,
-                                                     goby::util::as<google::protobuf::int32>(part)))
-                                        : refl->SetInt32(
-                                              out, field_desc,
-                                              goby::util::as<google::protobuf::int32>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddInt64(out, field_desc,
-                                                           field_desc->default_value_int64());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedInt64(
-                                                     out, field_desc, value_index,
-                                                     goby::util::as<google::protobuf::int64>(part))
-                                               : refl->AddInt64(
-                                                     out, field_desc,
-                                                     goby::util::as<google::protobuf::int64>(part)))
-                                        : refl->SetInt64(
-                                              out, field_desc,
-                                              goby::util::as<google::protobuf::int64>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddUInt32(out, field_desc,
-                                                            field_desc->default_value_uint32());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedUInt32(
-                                                     out, field_desc, value_index,
-                                                     goby::util::as<google::protobuf::uint32>(part))
-                                               : refl->AddUInt32(
-                                                     out, field_desc,
-                                                     goby::util::as<google::protobuf::uint32>(
-                                                         part)))
-                                        : refl->SetUInt32(
-                                              out, field_desc,
-                                              goby::util::as<google::protobuf::uint32>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddUInt64(out, field_desc,
-                                                            field_desc->default_value_uint64());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedUInt64(
-                                                     out, field_desc, value_index,
-                                                     goby::util::as<google::protobuf::uint64>(part))
-                                               : refl->AddUInt64(
-                                                     out, field_desc,
-                                                     goby::util::as<google::protobuf::uint64>(
-                                                         part)))
-                                        : refl->SetUInt64(
-                                              out, field_desc,
-                                              goby::util::as<google::protobuf::uint64>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddBool(out, field_desc,
-                                                          field_desc->default_value_bool());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedBool(out, field_desc, value_index,
-                                                                       goby::util::as<bool>(part))
-                                               : refl->AddBool(out, field_desc,
-                                                               goby::util::as<bool>(part)))
-                                        : refl->SetBool(out, field_desc,
-                                                        goby::util::as<bool>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddString(out, field_desc,
-                                                            field_desc->default_value_string());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedString(out, field_desc,
-                                                                         value_index, part)
-                                               : refl->AddString(out, field_desc, part))
-                                        : refl->SetString(out, field_desc, part);
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddFloat(out, field_desc,
-                                                           field_desc->default_value_float());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedFloat(out, field_desc,
-                                                                        value_index,
-                                                                        goby::util::as<float>(part))
-                                               : refl->AddFloat(out, field_desc,
-                                                                goby::util::as<float>(part)))
-                                        : refl->SetFloat(out, field_desc,
-                                                         goby::util::as<float>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddDouble(out, field_desc,
-                                                            field_desc->default_value_double());
-                                    }
-                                    field_desc->is_repeated()
-                                        ? (is_indexed_repeated_field
-                                               ? refl->SetRepeatedDouble(
-                                                     out, field_desc, value_index,
-                                                     goby::util::as<double>(part))
-                                               : refl->AddDouble(out, field_desc,
-                                                                 goby::util::as<double>(part)))
-                                        : refl->SetDouble(out, field_desc,
-                                                          goby::util::as<double>(part));
-                                    break;
-
-                                case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
-                                {
-                                    if (is_indexed_repeated_field)
-                                    {
-                                        while (refl->FieldSize(*out, field_desc) <= value_index)
-                                            refl->AddEnum(out, field_desc,
-                                                          field_desc->default_value_enum());
-                                    }
-                                    std::string enum_value =
-                                        ((use_short_enum)
-                                             ? add_name_to_enum(part, field_desc->name())
-                                             : part);
-
-                                    const google::protobuf::EnumValueDescriptor* enum_desc =
-                                        refl->GetEnum(*out, field_desc)
-                                            ->type()
-                                            ->FindValueByName(enum_value);
-
-                                    // try upper case
-                                    if (!enum_desc)
-                                        enum_desc =
-                                            refl->GetEnum(*out, field_desc)
-                                                ->type()
-                                                ->FindValueByName(boost::to_upper_copy(enum_value));
-                                    // try lower case
-                                    if (!enum_desc)
-                                        enum_desc =
-                                            refl->GetEnum(*out, field_desc)
-                                                ->type()
-                                                ->FindValueByName(boost::to_lower_copy(enum_value));
-                                    if (enum_desc)
-                                    {
-                                        field_desc->is_repeated()
-                                            ? (is_indexed_repeated_field
-                                                   ? refl->SetRepeatedEnum(out, field_desc,
-                                                                           value_index, enum_desc)
-                                                   : refl->AddEnum(out, field_desc, enum_desc))
-                                            : refl->SetEnum(out, field_desc, enum_desc);
-                                    }
-                                }
-                                break;
-                            }
-                        }
-                    }
-                    catch (boost::bad_lexical_cast&)
-                    {
-                        throw(std::runtime_error(
-                            "Bad specifier: " + specifier +
-                            ", must be an integer. For message: " + desc->full_name()));
-                    }
-                }
-
-                // goby::glog.is(DEBUG1) && goby::glog << "field: [" << field_index << "], parts[j]: [" << parts[j] << "]" << std::endl;
-            }
-            else
-            {
-                // if it's not a %, eat!
-                std::string::size_type pos_to_remove = lower_str.find(*i) + 1;
-                lower_str.erase(0, pos_to_remove);
-                str.erase(0, pos_to_remove);
-                ++i;
-            }
-        }
+        Parser(format, out->GetDescriptor())
+            .parse(in, out, repeated_delimiter, algorithms, use_short_enum);
     }
 };
 } // namespace moos
@@ -32,6 +32,7 @@
 #include <set>       // for set
 #include <stdexcept> // for runtime_error
 #include <string>    // for basic_string
+#include <tuple>     // for forward_as_tuple
 #include <utility>   // for pair, make_pair
 #include <vector>    // for vector
 
@@ -112,13 +113,18 @@ class MOOSTranslator
         add_entry(entries);
     }
 
-    void clear_entry(const std::string& protobuf_name) { dictionary_.erase(protobuf_name); }
+    void clear_entry(const std::string& protobuf_name)
+    {
+        dictionary_.erase(protobuf_name);
+        compiled_formats_.erase(protobuf_name);
+    }
 
     void add_entry(const goby::moos::protobuf::TranslatorEntry& entry)
     {
         if (dictionary_.count(entry.protobuf_name()))
             throw(std::runtime_error("Duplicate translator entry for " + entry.protobuf_name()));
         dictionary_[entry.protobuf_name()] = entry;
+        compiled_formats_.erase(entry.protobuf_name());
     }
 
     void add_entry(const std::set<goby::moos::protobuf::TranslatorEntry>& entries)
@@ -184,6 +190,43 @@ class MOOSTranslator
     void update_utm_datum(double lat_origin, double lon_origin);
 
   private:
+    using FormatTranslation = MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_FORMAT>;
+
+    // TECHNIQUE_FORMAT formats of one entry (keyed by index of publish or create), compiled on first use
+    struct CompiledFormats
+    {
+        const google::protobuf::Descriptor* descriptor{nullptr};
+        std::map<int, FormatTranslation::Serializer> publish_moos_var;
+        std::map<int, FormatTranslation::Serializer> publish_format;
+        std::map<int, FormatTranslation::Serializer> create_format;
+        std::map<int, FormatTranslation::Parser> create_parser;
+    };
+
+    CompiledFormats& compiled_formats(const std::string& protobuf_name,
+                                      const google::protobuf::Descriptor* desc)
+    {
+        CompiledFormats& formats = compiled_formats_[protobuf_name];
+        if (formats.descriptor != desc)
+        {
+            formats = CompiledFormats();
+            formats.descriptor = desc;
+        }
+        return formats;
+    }
+
+    template <typename Compiled, typename... Args>
+    static const Compiled& compiled_format(std::map<int, Compiled>& formats, int index,
+                                           Args&&... args)
+    {
+        auto it = formats.find(index);
+        if (it == formats.end())
+            it = formats
+                     .emplace(std::piecewise_construct, std::forward_as_tuple(index),
+                              std::forward_as_tuple(std::forward<Args>(args)...))
+                     .first;
+        return it->second;
+    }
+
     void initialize(double lat_origin = std::numeric_limits<double>::quiet_NaN(),
                     double lon_origin = std::numeric_limits<double>::quiet_NaN(),
                     const std::string& modem_id_lookup_path = "");
@@ -206,6 +249,7 @@ class MOOSTranslator
 
   private:
     std::map<std::string, goby::moos::protobuf::TranslatorEntry> dictionary_;
+    std::map<std::string, CompiledFormats> compiled_formats_;
     CMOOSGeodesy geodesy_;
     goby::moos::ModemIdConvert modem_lookup_;
 };
@@ -308,17 +352,21 @@ goby::moos::MOOSTranslator::protobuf_to_moos(const google::protobuf::Message& pr
                 break;
 
             case protobuf::TranslatorEntry::TECHNIQUE_FORMAT:
+            {
+                const google::protobuf::Descriptor* desc = protobuf_msg.GetDescriptor();
+                CompiledFormats& formats = compiled_formats(pb_name, desc);
                 // process moos_variable too (can be a format string itself!)
-                goby::moos::MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_FORMAT>::serialize(
-                    &moos_var, protobuf_msg, entry.publish(i).algorithm(),
-                    entry.publish(i).moos_var(), entry.publish(i).repeated_delimiter(),
-                    entry.use_short_enum());
+                compiled_format(formats.publish_moos_var, i, entry.publish(i).moos_var(), desc,
+                                entry.publish(i).algorithm())
+                    .serialize(&moos_var, protobuf_msg, entry.publish(i).repeated_delimiter(),
+                               entry.use_short_enum());
                 // now do the format values
-                goby::moos::MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_FORMAT>::serialize(
-                    &return_string, protobuf_msg, entry.publish(i).algorithm(),
-                    entry.publish(i).format(), entry.publish(i).repeated_delimiter(),
-                    entry.use_short_enum());
-                break;
+                compiled_format(formats.publish_format, i, entry.publish(i).format(), desc,
+                                entry.publish(i).algorithm())
+                    .serialize(&return_string, protobuf_msg, entry.publish(i).repeated_delimiter(),
+                               entry.use_short_enum());
+            }
+            break;
         }
 
         moos_msgs.insert(
@@ -409,13 +457,12 @@ goby::moos::MOOSTranslator::protobuf_to_inverse_moos(const google::protobuf::Mes
 
             case protobuf::TranslatorEntry::TECHNIQUE_FORMAT:
             {
-                google::protobuf::RepeatedPtrField<
-                    protobuf::TranslatorEntry::PublishSerializer::Algorithm>
-                    empty_algorithms;
-
-                goby::moos::MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_FORMAT>::serialize(
-                    &return_string, protobuf_msg, empty_algorithms, entry.create(i).format(),
-                    entry.create(i).repeated_delimiter(), entry.use_short_enum());
+                const google::protobuf::Descriptor* desc = protobuf_msg.GetDescriptor();
+                compiled_format(compiled_formats(pb_name, desc).create_format, i,
+                                entry.create(i).format(), desc,
+                                FormatTranslation::SerializerAlgorithms())
+                    .serialize(&return_string, protobuf_msg, entry.create(i).repeated_delimiter(),
+                               entry.use_short_enum());
             }
             break;
         }
@@ -527,11 +574,14 @@ goby::moos::MOOSTranslator::moos_to_protobuf(const StringCMOOSMsgMap& moos_varia
                 break;
 
             case protobuf::TranslatorEntry::TECHNIQUE_FORMAT:
-                goby::moos::MOOSTranslation<protobuf::TranslatorEntry::TECHNIQUE_FORMAT>::parse(
-                    source_string, &*msg, entry.create(i).format(),
-                    entry.create(i).repeated_delimiter(), entry.create(i).algorithm(),
-                    entry.use_short_enum());
-                break;
+            {
+                const google::protobuf::Descriptor* desc = msg->GetDescriptor();
+                compiled_format(compiled_formats(protobuf_name, desc).create_parser, i,
+                                entry.create(i).format(), desc)
+                    .parse(source_string, &*msg, entry.create(i).repeated_delimiter(),
+                           entry.create(i).algorithm(), entry.use_short_enum());
+            }
+            break;
         }
     }
 
@@ -0,0 +1,118 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Libraries
+// ("The Goby Libraries").
+//
+// The Goby Libraries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// The Goby Libraries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_MOOS_WILDCARD_MAIL_HANDLERS_H
+#define GOBY_MOOS_WILDCARD_MAIL_HANDLERS_H
+
+#include <cstddef>       // for size_t
+#include <map>           // for map
+#include <memory>        // for shared_ptr
+#include <string>        // for string
+#include <unordered_map> // for unordered_map
+#include <utility>       // for pair
+#include <vector>        // for vector
+
+#include <MOOS/libMOOS/Comms/MOOSMsg.h>              // for CMOOSMsg
+#include <MOOS/libMOOS/Utils/MOOSUtilityFunctions.h> // for MOOSWildCmp
+#include <boost/signals2/signal.hpp>                 // for signal
+
+namespace goby
+{
+namespace moos
+{
+/// \brief Handlers for wildcard subscriptions (MOOS variable pattern, MOOS app pattern)
+///
+/// The patterns matching a given (variable, source) are found once (using MOOSWildCmp) and kept until the patterns change, so dispatching mail doesn't test every pattern for every message.
+class WildcardMailHandlers
+{
+  public:
+    using Signal = boost::signals2::signal<void(const CMOOSMsg& msg)>;
+
+    /// \brief Signal for a pattern, added if needed
+    Signal& add(const std::string& var_pattern, const std::string& app_pattern)
+    {
+        auto key = std::make_pair(var_pattern, app_pattern);
+        auto it = handlers_.find(key);
+        if (it == handlers_.end())
+        {
+            it = handlers_.insert(std::make_pair(key, std::make_shared<Signal>())).first;
+            // cleared on the next dispatch, as we may be within a handler
+            matches_valid_ = false;
+        }
+        return *it->second;
+    }
+
+    /// \brief Calls the handlers of all the patterns matching the variable and source of msg
+    void dispatch(const CMOOSMsg& msg)
+    {
+        if (handlers_.empty())
+            return;
+
+        for (const auto& signal : matches(msg.GetKey(), msg.GetSource())) (*signal)(msg);
+    }
+
+    /// \brief Signals for all the patterns matching var and source (in order of pattern)
+    const std::vector<std::shared_ptr<Signal>>& matches(const std::string& var,
+                                                        const std::string& source)
+    {
+        // bound the memory used if there are many distinct variable names
+        if (!matches_valid_ || matches_.size() > max_cached_vars)
+        {
+            matches_.clear();
+            matches_valid_ = true;
+        }
+
+        auto& source_matches = matches_[var];
+        auto it = source_matches.find(source);
+        if (it == source_matches.end())
+        {
+            std::vector<std::shared_ptr<Signal>> signals;
+            for (const auto& handler : handlers_)
+            {
+                if (MOOSWildCmp(handler.first.first, var) &&
+                    MOOSWildCmp(handler.first.second, source))
+                    signals.push_back(handler.second);
+            }
+            it = source_matches.insert(std::make_pair(source, std::move(signals))).first;
+        }
+        return it->second;
+    }
+
+    std::size_t size() const { return handlers_.size(); }
+
+  private:
+    static constexpr std::size_t max_cached_vars{10000};
+
+    // (MOOS variable pattern, MOOS app pattern) -> handlers
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<Signal>> handlers_;
+
+    // MOOS variable -> source -> handlers of all matching patterns
+    std::unordered_map<std::string,
+                       std::unordered_map<std::string, std::vector<std::shared_ptr<Signal>>>>
+        matches_;
+    bool matches_valid_{true};
+};
+} // namespace moos
+} // namespace goby
+
+#endif
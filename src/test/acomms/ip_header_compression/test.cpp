@@ -0,0 +1,421 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <dccl/codec.h>
+
+#include "dccl/arithmetic/field_codec_arithmetic.h"
+
+#include "goby/acomms/ip_codecs.h"
+#include "goby/acomms/ip_header_compression.h"
+#include "goby/util/dccl_compat.h"
+#include "goby/util/debug_logger.h"
+
+// tests the stateful NetworkHeader compression used by goby_ip_gateway over a simulated link (no tun interface) carrying the UDP packets of several flows between gateways, with and without packet loss, and compares the encoded header sizes with those of the (stateless) NetworkHeader
+
+using goby::acomms::IPHeaderCompressor;
+using goby::acomms::IPHeaderDecompressor;
+using goby::acomms::net_checksum;
+using goby::acomms::protobuf::CompressedNetworkHeader;
+using goby::acomms::protobuf::NetworkHeader;
+
+enum
+{
+    IPV4_HEADER_SIZE = 20,
+    UDP_HEADER_SIZE = 8,
+    MAX_MODEM_ID = 15
+};
+
+const std::string subnet = "192.168.1.";
+const std::vector<int> udp_ports = {5000, 5001, 6000, 6001};
+const int refresh_interval = 8;
+
+struct Flow
+{
+    int src;
+    int dest;
+    int src_port;
+    int dest_port;
+};
+
+void write_short(std::string* data, int offset, unsigned value)
+{
+    (*data)[offset] = (value >> 8) & 0xFF;
+    (*data)[offset + 1] = value & 0xFF;
+}
+
+unsigned read_short(const std::string& data, int offset)
+{
+    return (static_cast<unsigned char>(data[offset]) << 8) |
+           static_cast<unsigned char>(data[offset + 1]);
+}
+
+void write_address(std::string* data, int offset, int modem_id)
+{
+    in_addr addr;
+    inet_aton((subnet + std::to_string(modem_id)).c_str(), &addr);
+    data->replace(offset, 4, reinterpret_cast<const char*>(&addr.s_addr), 4);
+}
+
+// IPv4/UDP packet as read from the tun interface by the sending goby_ip_gateway and written by the receiving one
+std::string make_udp_packet(const Flow& flow, const std::string& payload)
+{
+    std::string ip_header(IPV4_HEADER_SIZE, '\0'), udp_header(UDP_HEADER_SIZE, '\0');
+    ip_header[0] = 0x45; // version 4, IHL 5
+    write_short(&ip_header, 2, IPV4_HEADER_SIZE + UDP_HEADER_SIZE + payload.size());
+    ip_header[8] = 63; // TTL
+    ip_header[9] = IPPROTO_UDP;
+    write_address(&ip_header, 12, flow.src);
+    write_address(&ip_header, 16, flow.dest);
+    write_short(&ip_header, 10, net_checksum(ip_header));
+
+    write_short(&udp_header, 0, flow.src_port);
+    write_short(&udp_header, 2, flow.dest_port);
+    write_short(&udp_header, 4, UDP_HEADER_SIZE + payload.size());
+    std::string pseudo_header = ip_header.substr(12, 8) + char(0) + char(IPPROTO_UDP) +
+                                udp_header.substr(4, 2);
+    write_short(&udp_header, 6, net_checksum(pseudo_header + udp_header + payload));
+
+    return ip_header + udp_header + payload;
+}
+
+Flow parse_udp_packet(const std::string& packet, std::string* payload)
+{
+    std::string ip_header = packet.substr(0, IPV4_HEADER_SIZE);
+    std::string udp_header = packet.substr(IPV4_HEADER_SIZE, UDP_HEADER_SIZE);
+    *payload = packet.substr(IPV4_HEADER_SIZE + UDP_HEADER_SIZE);
+
+    std::string pseudo_header = ip_header.substr(12, 8) + char(0) + char(IPPROTO_UDP) +
+                                udp_header.substr(4, 2);
+    assert(net_checksum(ip_header) == 0);
+    assert(net_checksum(pseudo_header + udp_header + *payload) == 0);
+
+    Flow flow;
+    flow.src = static_cast<unsigned char>(ip_header[15]);
+    flow.dest = static_cast<unsigned char>(ip_header[19]);
+    flow.src_port = read_short(udp_header, 0);
+    flow.dest_port = read_short(udp_header, 2);
+    return flow;
+}
+
+int port_index(int port)
+{
+    return std::find(udp_ports.begin(), udp_ports.end(), port) - udp_ports.begin();
+}
+
+NetworkHeader to_network_header(const Flow& flow)
+{
+    NetworkHeader header;
+    header.set_protocol(NetworkHeader::UDP);
+    header.set_srcdest_addr(flow.src * (MAX_MODEM_ID + 1) + flow.dest);
+    header.mutable_udp()->add_srcdest_port(port_index(flow.src_port));
+    header.mutable_udp()->add_srcdest_port(port_index(flow.dest_port));
+    return header;
+}
+
+Flow to_flow(const NetworkHeader& header)
+{
+    Flow flow;
+    flow.src = header.srcdest_addr() / (MAX_MODEM_ID + 1);
+    flow.dest = header.srcdest_addr() % (MAX_MODEM_ID + 1);
+    flow.src_port = udp_ports[header.udp().srcdest_port(0)];
+    flow.dest_port = udp_ports[header.udp().srcdest_port(1)];
+    return flow;
+}
+
+struct LinkStats
+{
+    int sent{0};
+    int full{0};
+    int lost_on_link{0};
+    int delivered{0};
+    std::uint64_t detected_lost{0};
+    std::uint64_t dropped{0};
+};
+
+// sends npackets of the flows given by next_flow(i) from their source gateways (each with its own compressor) to their destination gateways (each with its own decompressor), losing those for which lose() is true, and checks that each packet a receiver decompresses is rebuilt exactly, and that packets are only dropped until a full header of their flow's current context is received
+LinkStats simulate(const std::vector<Flow>& flows, int npackets, std::function<int(int)> next_flow,
+                   std::function<bool()> lose)
+{
+    LinkStats stats;
+    std::map<int, IPHeaderCompressor> compressors;
+    std::map<int, IPHeaderDecompressor> decompressors;
+    // (src, dest, context) -> flow currently assigned to it
+    std::map<std::tuple<int, int, int>, int> assigned;
+    // flows for which the receiver has the full header of their current context
+    std::set<int> synchronized;
+
+    for (int i = 0; i < npackets; ++i)
+    {
+        int f = next_flow(i);
+        std::string packet = make_udp_packet(flows[f], "packet " + std::to_string(i));
+
+        // sender
+        std::string payload;
+        Flow flow = parse_udp_packet(packet, &payload);
+        auto compressor_it = compressors.emplace(flow.src, refresh_interval).first;
+        CompressedNetworkHeader compressed =
+            compressor_it->second.compress(flow.dest, to_network_header(flow));
+        ++stats.sent;
+        if (compressed.has_full())
+            ++stats.full;
+
+        auto& assigned_flow =
+            assigned[std::make_tuple(flow.src, flow.dest, int(compressed.context()))];
+        if (compressed.has_full() && assigned_flow != f)
+        {
+            synchronized.erase(assigned_flow);
+            synchronized.erase(f);
+        }
+        assigned_flow = f;
+
+        if (lose())
+        {
+            ++stats.lost_on_link;
+            continue;
+        }
+
+        // receiver
+        NetworkHeader header;
+        if (!decompressors[flow.dest].decompress(flow.src, flow.dest, compressed, &header))
+        {
+            assert(!synchronized.count(f));
+            continue;
+        }
+        if (compressed.has_full())
+            synchronized.insert(f);
+        assert(make_udp_packet(to_flow(header), payload) == packet);
+        ++stats.delivered;
+    }
+
+    for (const auto& d : decompressors)
+    {
+        stats.detected_lost += d.second.packets_lost();
+        stats.dropped += d.second.packets_dropped();
+    }
+    return stats;
+}
+
+// nflows from nsources, to ndests destinations per source
+std::vector<Flow> make_flows(int nflows, int nsources, int ndests = 1)
+{
+    std::vector<Flow> flows;
+    for (int i = 0; i < nflows; ++i)
+    {
+        int src = 1 + i % nsources;
+        // skipping src
+        int dest = 1 + (i / nsources) % ndests;
+        if (dest >= src)
+            ++dest;
+        // distinct ports for each flow between the same src and dest
+        int j = i / (nsources * ndests);
+        flows.push_back({src, dest, udp_ports[j % udp_ports.size()],
+                         udp_ports[(j / udp_ports.size()) % udp_ports.size()]});
+    }
+    return flows;
+}
+
+std::ostream& operator<<(std::ostream& os, const LinkStats& stats)
+{
+    return os << "sent: " << stats.sent << " (" << stats.full << " full headers), lost on link: "
+              << stats.lost_on_link << ", delivered: " << stats.delivered
+              << ", dropped: " << stats.dropped << ", detected lost: " << stats.detected_lost;
+}
+
+void test_no_loss()
+{
+    std::mt19937 rng(1);
+    auto flows = make_flows(6, 2);
+    std::uniform_int_distribution<int> flow_dist(0, flows.size() - 1);
+    auto stats = simulate(
+        flows, 1000, [&](int) { return flow_dist(rng); }, []() { return false; });
+    std::cout << "no loss: " << stats << std::endl;
+
+    assert(stats.delivered == stats.sent);
+    assert(stats.dropped == 0);
+    assert(stats.detected_lost == 0);
+    // the first packet of each flow, then one in every refresh_interval
+    assert(stats.full <= static_cast<int>(flows.size()) + stats.sent / refresh_interval);
+}
+
+void test_more_flows_than_contexts()
+{
+    // round robin through more flows than contexts from one source: each reuses the least recently used context, so every header is full
+    auto flows = make_flows(goby::acomms::IP_HEADER_COMPRESSION_CONTEXTS + 4, 1);
+    auto stats = simulate(
+        flows, 200, [&](int i) { return i % flows.size(); }, []() { return false; });
+    std::cout << "more flows than contexts: " << stats << std::endl;
+
+    assert(stats.delivered == stats.sent);
+    assert(stats.full == stats.sent);
+}
+
+void test_more_flows_than_contexts_with_loss()
+{
+    // random flows, more than the contexts for each destination, from several sources to several destinations: contexts are often reassigned while their full headers are lost, so the receivers often hold stale contexts, which must never be used to rebuild a header
+    std::mt19937 rng(4);
+    const int nsources = 2, ndests = 3;
+    auto flows =
+        make_flows((goby::acomms::IP_HEADER_COMPRESSION_CONTEXTS + 4) * nsources * ndests,
+                   nsources, ndests);
+    std::uniform_int_distribution<int> flow_dist(0, flows.size() - 1);
+    std::bernoulli_distribution loss_dist(0.5);
+    auto stats = simulate(
+        flows, 50000, [&](int) { return flow_dist(rng); }, [&]() { return loss_dist(rng); });
+    std::cout << "more flows than contexts, " << nsources << " sources, " << ndests
+              << " destinations, 50% loss: " << stats << std::endl;
+
+    assert(stats.delivered > 0);
+    assert(stats.dropped > 0);
+    assert(stats.delivered + static_cast<int>(stats.dropped) + stats.lost_on_link == stats.sent);
+}
+
+void test_loss()
+{
+    std::mt19937 rng(2);
+    auto flows = make_flows(6, 2);
+    std::uniform_int_distribution<int> flow_dist(0, flows.size() - 1);
+    std::bernoulli_distribution loss_dist(0.25);
+    auto stats = simulate(
+        flows, 5000, [&](int) { return flow_dist(rng); }, [&]() { return loss_dist(rng); });
+    std::cout << "25% loss: " << stats << std::endl;
+
+    assert(stats.lost_on_link > 0);
+    assert(stats.delivered + static_cast<int>(stats.dropped) + stats.lost_on_link == stats.sent);
+    assert(stats.detected_lost > 0);
+    assert(stats.detected_lost <= static_cast<std::uint64_t>(stats.lost_on_link));
+}
+
+// as goby_ip_gateway (UNIFORM model)
+void set_models(dccl::Codec& codec)
+{
+    dccl_arithmetic_load(&codec);
+
+    dccl::arith::protobuf::ArithmeticModel addr_model;
+    addr_model.set_name("goby.acomms.NetworkHeader.AddrModel");
+    for (int i = 0, n = (MAX_MODEM_ID + 1) * (MAX_MODEM_ID + 1); i <= n; ++i)
+    {
+        addr_model.add_value_bound(i);
+        if (i != n)
+            addr_model.add_frequency(10);
+    }
+    addr_model.set_eof_frequency(0);
+    addr_model.set_out_of_range_frequency(0);
+    dccl::arith::ModelManager::set_model(codec, addr_model);
+
+    dccl::arith::protobuf::ArithmeticModel port_model;
+    port_model.set_name("goby.acomms.NetworkHeader.PortModel");
+    for (int i = 0, n = udp_ports.size(); i <= n; ++i)
+    {
+        port_model.add_value_bound(i);
+        if (i != n)
+            port_model.add_frequency(10);
+    }
+    port_model.set_eof_frequency(0);
+    port_model.set_out_of_range_frequency(0);
+    dccl::arith::ModelManager::set_model(codec, port_model);
+}
+
+void compare_sizes()
+{
+#ifdef DCCL_VERSION_4_1_OR_NEWER
+    dccl::Codec nh_codec("ip_gateway_id_codec_0",
+                         goby::acomms::IPGatewayEmptyIdentifierCodec<0xF000>());
+    dccl::Codec compressed_codec("ip_gateway_id_codec_4",
+                                 goby::acomms::IPGatewayEmptyIdentifierCodec<0xF004>());
+#else
+    dccl::FieldCodecManager::add<goby::acomms::IPGatewayEmptyIdentifierCodec<0xF000>>(
+        "ip_gateway_id_codec_0");
+    dccl::FieldCodecManager::add<goby::acomms::IPGatewayEmptyIdentifierCodec<0xF004>>(
+        "ip_gateway_id_codec_4");
+    dccl::Codec nh_codec("ip_gateway_id_codec_0");
+    dccl::Codec compressed_codec("ip_gateway_id_codec_4");
+#endif
+    set_models(nh_codec);
+    set_models(compressed_codec);
+    nh_codec.load<NetworkHeader>();
+    compressed_codec.load<CompressedNetworkHeader>();
+
+    std::mt19937 rng(3);
+    auto flows = make_flows(6, 1);
+    std::uniform_int_distribution<int> flow_dist(0, flows.size() - 1);
+    IPHeaderCompressor compressor(refresh_interval);
+    IPHeaderDecompressor decompressor;
+    const int npackets = 1000;
+    std::size_t nh_bytes = 0, compressed_bytes = 0;
+    for (int i = 0; i < npackets; ++i)
+    {
+        auto header = to_network_header(flows[flow_dist(rng)]);
+
+        std::string nh;
+        nh_codec.encode(&nh, header);
+        nh_bytes += nh.size();
+
+        std::string compressed_nh;
+        compressed_codec.encode(&compressed_nh, compressor.compress(flows[0].dest, header));
+        compressed_bytes += compressed_nh.size();
+
+        CompressedNetworkHeader compressed;
+        compressed_codec.decode(compressed_nh, &compressed);
+        NetworkHeader decompressed;
+        bool decompressed_ok =
+            decompressor.decompress(flows[0].src, flows[0].dest, compressed, &decompressed);
+        assert(decompressed_ok);
+        assert(decompressed.SerializeAsString() == header.SerializeAsString());
+    }
+
+    std::cout << "header bytes per packet: NetworkHeader: " << double(nh_bytes) / npackets
+              << ", CompressedNetworkHeader: " << double(compressed_bytes) / npackets
+              << std::endl;
+    assert(compressed_bytes < nh_bytes);
+
+    dccl_arithmetic_unload(&nh_codec);
+    dccl_arithmetic_unload(&compressed_codec);
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_no_loss();
+    test_more_flows_than_contexts();
+    test_more_flows_than_contexts_with_loss();
+    test_loss();
+    compare_sizes();
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,170 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <set>
+
+#include "goby/acomms/connect.h"
+#include "goby/acomms/dccl/dccl.h"
+#include "goby/acomms/protobuf/modem_message.pb.h"
+#include "goby/acomms/queue.h"
+#include "goby/util/debug_logger.h"
+
+#include "goby/test/acomms/queue7/test.pb.h"
+
+// tests packing many small messages into a single frame, and compares the cost of the frame size accounting (using the encoded sizes cached at push) with the previous re-sizing of the whole frame after each message was added
+using goby::test::acomms::protobuf::GobyMessage;
+using clock_type = std::chrono::steady_clock;
+
+goby::acomms::QueueManager q_manager;
+const int MY_MODEM_ID = 1;
+const unsigned TEST_MESSAGE_SIZE = 3;
+const int nbenchmark = 20;
+
+std::multiset<int> received_telegrams;
+
+void handle_receive(const google::protobuf::Message& msg)
+{
+    received_telegrams.insert(dynamic_cast<const GobyMessage&>(msg).telegram());
+}
+
+void push(int n)
+{
+    GobyMessage test_msg;
+    test_msg.set_dest(0);
+    for (int i = 0; i < n; ++i)
+    {
+        test_msg.set_telegram(i % 256);
+        q_manager.push_message(test_msg);
+    }
+}
+
+// returns the size of the data frame given max_frame_bytes
+unsigned request(unsigned max_frame_bytes)
+{
+    goby::acomms::protobuf::ModemTransmission msg;
+    msg.set_max_frame_bytes(max_frame_bytes);
+    q_manager.handle_modem_data_request(&msg);
+    unsigned frame_size = msg.frame(0).size();
+
+    received_telegrams.clear();
+    q_manager.handle_modem_receive(msg);
+    return frame_size;
+}
+
+void test_pack(int n, unsigned max_frame_bytes)
+{
+    push(n);
+    unsigned expected = std::min<unsigned>(n, max_frame_bytes / TEST_MESSAGE_SIZE);
+
+    unsigned frame_size = request(max_frame_bytes);
+    assert(frame_size == expected * TEST_MESSAGE_SIZE);
+    assert(received_telegrams.size() == expected);
+
+    // rest remain queued
+    unsigned remaining = n - expected;
+    while (remaining > 0)
+    {
+        unsigned next = std::min<unsigned>(remaining, max_frame_bytes / TEST_MESSAGE_SIZE);
+        assert(request(max_frame_bytes) == next * TEST_MESSAGE_SIZE);
+        assert(received_telegrams.size() == next);
+        remaining -= next;
+    }
+    assert(request(max_frame_bytes) == 0);
+
+    std::cout << "pack " << n << " messages into " << max_frame_bytes << " bytes: passed"
+              << std::endl;
+}
+
+void benchmark(int n)
+{
+    unsigned max_frame_bytes = n * TEST_MESSAGE_SIZE;
+    std::chrono::duration<double> pack_dt(0);
+    for (int i = 0; i < nbenchmark; ++i)
+    {
+        push(n);
+        goby::acomms::protobuf::ModemTransmission msg;
+        msg.set_max_frame_bytes(max_frame_bytes);
+        auto start = clock_type::now();
+        q_manager.handle_modem_data_request(&msg);
+        pack_dt += clock_type::now() - start;
+        assert(msg.frame(0).size() == max_frame_bytes);
+    }
+
+    // the size accounting the previous loop did for each frame: the size of all the messages in the frame, each time a message was added
+    GobyMessage test_msg;
+    test_msg.set_dest(0);
+    test_msg.set_telegram(1);
+    auto* codec = goby::acomms::DCCLCodec::get();
+    unsigned total = 0;
+    auto start = clock_type::now();
+    for (int i = 0; i < nbenchmark; ++i)
+    {
+        for (int k = 1; k <= n; ++k)
+        {
+            for (int j = 0; j < k; ++j) total += codec->size(test_msg);
+        }
+    }
+    std::chrono::duration<double> previous_dt = clock_type::now() - start;
+    assert(total == nbenchmark * TEST_MESSAGE_SIZE * n * (n + 1) / 2);
+
+    double pack_us = pack_dt.count() / nbenchmark * 1e6;
+    double previous_us = previous_dt.count() / nbenchmark * 1e6;
+    std::cout << n << " messages/frame: pack: " << pack_us
+              << " us/frame, previous size accounting alone: " << previous_us << " us/frame ("
+              << (pack_us + previous_us) / pack_us << "x)" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    goby::acomms::protobuf::QueueManagerConfig cfg;
+    cfg.set_modem_id(MY_MODEM_ID);
+    goby::acomms::protobuf::QueuedMessageEntry* q_entry = cfg.add_message_entry();
+    q_entry->set_protobuf_name("goby.test.acomms.protobuf.GobyMessage");
+    goby::acomms::protobuf::QueuedMessageEntry::Role* dest_role = q_entry->add_role();
+    dest_role->set_type(goby::acomms::protobuf::QueuedMessageEntry::DESTINATION_ID);
+    dest_role->set_field("dest");
+    q_entry->set_ack(false);
+    q_entry->set_max_queue(0);
+    q_manager.set_cfg(cfg);
+
+    goby::acomms::connect(&q_manager.signal_receive, &handle_receive);
+
+    test_pack(1, 32);
+    test_pack(10, 32);
+    test_pack(11, 32);
+    test_pack(150, 1024);
+    test_pack(400, 1024);
+
+    for (int n : {100, 200, 400}) benchmark(n);
+
+    dccl::DynamicProtobufManager::protobuf_shutdown();
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,361 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <google/protobuf/descriptor.pb.h>
+
+#include "dccl/dynamic_protobuf_manager.h"
+#include "goby/acomms/acomms_constants.h"
+#include "goby/acomms/connect.h"
+#include "goby/acomms/dccl/dccl.h"
+#include "goby/acomms/protobuf/modem_message.pb.h"
+#include "goby/acomms/queue.h"
+#include "goby/util/debug_logger.h"
+
+#include "goby/test/acomms/queue8/test.pb.h"
+
+// tests the priority contest and acknowledgments across many queues (one for each of the DCCL types created at runtime from GobyMessage), and benchmarks packing frames and clearing acknowledgments with up to max_queues queues, compared to the previous linear scan of all the queues for each message added to a frame
+using goby::acomms::QueueManager;
+using goby::test::acomms::protobuf::GobyMessage;
+using clock_type = std::chrono::steady_clock;
+
+const int MY_MODEM_ID = 1;
+const int UNICORN_MODEM_ID = 2;
+const unsigned TEST_MESSAGE_SIZE = 3;
+const int max_queues = 300;
+const int first_dccl_id = 100;
+
+std::vector<const google::protobuf::Descriptor*> types;
+
+// queue (index into types) of each message received
+std::vector<int> received_queues;
+int ack_count = 0;
+std::map<unsigned, unsigned> queue_sizes;
+
+void handle_receive(const google::protobuf::Message& msg)
+{
+    received_queues.push_back(goby::acomms::DCCLCodec::get()->id(msg.GetDescriptor()) -
+                              first_dccl_id);
+}
+
+void handle_ack(const goby::acomms::protobuf::ModemTransmission& /*ack_msg*/,
+                const google::protobuf::Message& /*orig_msg*/)
+{
+    ++ack_count;
+}
+
+void qsize(const goby::acomms::protobuf::QueueSize& size)
+{
+    queue_sizes[size.dccl_id()] = size.size();
+}
+
+unsigned total_queued()
+{
+    unsigned total = 0;
+    for (const auto& size : queue_sizes) total += size.second;
+    return total;
+}
+
+// creates max_queues copies of GobyMessage, with DCCL ids from first_dccl_id
+void make_types()
+{
+    google::protobuf::FileDescriptorProto file_proto;
+    GobyMessage::descriptor()->file()->CopyTo(&file_proto);
+    file_proto.set_name("goby/test/acomms/queue8/generated.proto");
+
+    google::protobuf::DescriptorProto template_proto = file_proto.message_type(0);
+    file_proto.clear_message_type();
+    for (int i = 0; i < max_queues; ++i)
+    {
+        google::protobuf::DescriptorProto* type_proto = file_proto.add_message_type();
+        *type_proto = template_proto;
+        type_proto->set_name("GobyMessage" + std::to_string(i));
+        type_proto->mutable_options()->MutableExtension(dccl::msg)->set_id(first_dccl_id + i);
+    }
+
+    const google::protobuf::FileDescriptor* file =
+        dccl::DynamicProtobufManager::add_protobuf_file(file_proto);
+    assert(file);
+    for (int i = 0; i < max_queues; ++i) types.push_back(file->message_type(i));
+}
+
+std::shared_ptr<google::protobuf::Message> make_message(int queue, int dest, int telegram)
+{
+    auto msg = dccl::DynamicProtobufManager::new_protobuf_message<
+        std::shared_ptr<google::protobuf::Message>>(types[queue]);
+    const google::protobuf::Reflection* refl = msg->GetReflection();
+    refl->SetInt32(msg.get(), types[queue]->FindFieldByName("dest"), dest);
+    refl->SetInt32(msg.get(), types[queue]->FindFieldByName("telegram"), telegram % 256);
+    return msg;
+}
+
+goby::acomms::protobuf::QueuedMessageEntry queue_entry(int queue, bool ack, double value_base)
+{
+    goby::acomms::protobuf::QueuedMessageEntry q_entry;
+    q_entry.set_protobuf_name(types[queue]->full_name());
+    goby::acomms::protobuf::QueuedMessageEntry::Role* dest_role = q_entry.add_role();
+    dest_role->set_type(goby::acomms::protobuf::QueuedMessageEntry::DESTINATION_ID);
+    dest_role->set_field("dest");
+    q_entry.set_ack(ack);
+    q_entry.set_max_queue(0);
+    q_entry.set_value_base(value_base);
+    return q_entry;
+}
+
+// value_base of each queue is 2^queue if increasing_value, otherwise 1
+void configure(QueueManager& q_manager, int nqueues, bool ack, bool increasing_value)
+{
+    goby::acomms::protobuf::QueueManagerConfig cfg;
+    cfg.set_modem_id(MY_MODEM_ID);
+    for (int i = 0; i < nqueues; ++i)
+        *cfg.add_message_entry() = queue_entry(i, ack, increasing_value ? std::pow(2, i) : 1);
+    q_manager.set_cfg(cfg);
+
+    goby::acomms::connect(&q_manager.signal_receive, &handle_receive);
+    goby::acomms::connect(&q_manager.signal_ack, &handle_ack);
+    goby::acomms::connect(&q_manager.signal_queue_size_change, &qsize);
+    queue_sizes.clear();
+}
+
+// returns the total size of the data frames
+unsigned request(QueueManager& q_manager, unsigned max_frame_bytes, int max_num_frames = 1,
+                 int dest = goby::acomms::QUERY_DESTINATION_ID)
+{
+    goby::acomms::protobuf::ModemTransmission msg;
+    msg.set_max_frame_bytes(max_frame_bytes);
+    msg.set_max_num_frames(max_num_frames);
+    msg.set_dest(dest);
+    q_manager.handle_modem_data_request(&msg);
+
+    unsigned size = 0;
+    for (const auto& frame : msg.frame()) size += frame.size();
+
+    received_queues.clear();
+    q_manager.handle_modem_receive(msg);
+    return size;
+}
+
+void ack(QueueManager& q_manager, const std::vector<int>& frames)
+{
+    goby::acomms::protobuf::ModemTransmission ack_msg;
+    ack_msg.set_type(goby::acomms::protobuf::ModemTransmission::ACK);
+    ack_msg.set_src(UNICORN_MODEM_ID);
+    ack_msg.set_dest(MY_MODEM_ID);
+    for (int frame : frames) ack_msg.add_acked_frame(frame);
+    q_manager.handle_modem_receive(ack_msg);
+}
+
+void test_priority()
+{
+    const int nqueues = 20;
+    QueueManager q_manager;
+    configure(q_manager, nqueues, false, true);
+
+    // with (nearly) the same time since the last send, the order is that of value_base
+    for (int i = 0; i < nqueues; ++i) q_manager.push_message(*make_message(i, 0, i));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(request(q_manager, nqueues * TEST_MESSAGE_SIZE) == nqueues * TEST_MESSAGE_SIZE);
+    assert(received_queues.size() == nqueues);
+    for (int i = 0; i < nqueues; ++i) assert(received_queues[i] == nqueues - 1 - i);
+
+    // a queue that just sent is last, within the frame and in the next one
+    q_manager.push_message(*make_message(nqueues - 1, 0, 0));
+    q_manager.push_message(*make_message(nqueues - 1, 0, 1));
+    q_manager.push_message(*make_message(nqueues - 2, 0, 2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(request(q_manager, 2 * TEST_MESSAGE_SIZE) == 2 * TEST_MESSAGE_SIZE);
+    assert((received_queues == std::vector<int>{nqueues - 1, nqueues - 2}));
+    assert(request(q_manager, 2 * TEST_MESSAGE_SIZE) == TEST_MESSAGE_SIZE);
+    assert((received_queues == std::vector<int>{nqueues - 1}));
+    assert(request(q_manager, 2 * TEST_MESSAGE_SIZE) == 0);
+
+    std::cout << "priority: passed" << std::endl;
+}
+
+void test_ack()
+{
+    const int nqueues = 100;
+    const unsigned frame_messages = 10;
+    QueueManager q_manager;
+    configure(q_manager, nqueues, true, false);
+    ack_count = 0;
+
+    for (int i = 0; i < nqueues; ++i)
+    {
+        q_manager.push_message(*make_message(i, UNICORN_MODEM_ID, 0));
+        q_manager.push_message(*make_message(i, UNICORN_MODEM_ID, 1));
+    }
+    assert(total_queued() == 2 * nqueues);
+
+    // 4 frames waiting for ack
+    assert(request(q_manager, frame_messages * TEST_MESSAGE_SIZE, 4, UNICORN_MODEM_ID) ==
+           4 * frame_messages * TEST_MESSAGE_SIZE);
+    assert(total_queued() == 2 * nqueues);
+
+    ack(q_manager, {0, 2});
+    assert(ack_count == 2 * frame_messages);
+    assert(total_queued() == 2 * nqueues - 2 * frame_messages);
+
+    // frames 1 and 3 are cleared by the next request (from frame 0) and sent again, with the rest
+    unsigned remaining = total_queued();
+    assert(request(q_manager, frame_messages * TEST_MESSAGE_SIZE, 20, UNICORN_MODEM_ID) ==
+           remaining * TEST_MESSAGE_SIZE);
+
+    std::vector<int> all_frames;
+    for (int frame = 0; frame < 20; ++frame) all_frames.push_back(frame);
+    ack(q_manager, all_frames);
+    assert(ack_count == 2 * nqueues);
+    assert(total_queued() == 0);
+
+    std::cout << "ack: passed" << std::endl;
+}
+
+void benchmark_pack(int nqueues)
+{
+    const int nframes = 50;
+    const unsigned frame_messages = 20;
+    const unsigned max_frame_bytes = frame_messages * TEST_MESSAGE_SIZE;
+
+    QueueManager q_manager;
+    configure(q_manager, nqueues, false, false);
+    for (int i = 0; i < nqueues; ++i)
+    {
+        for (int j = 0, n = nframes * frame_messages / nqueues + 1; j < n; ++j)
+            q_manager.push_message(*make_message(i, 0, j));
+    }
+
+    std::chrono::duration<double> pack_dt(0);
+    for (int i = 0; i < nframes; ++i)
+    {
+        goby::acomms::protobuf::ModemTransmission msg;
+        msg.set_max_frame_bytes(max_frame_bytes);
+        auto start = clock_type::now();
+        q_manager.handle_modem_data_request(&msg);
+        pack_dt += clock_type::now() - start;
+        assert(msg.frame(0).size() == max_frame_bytes);
+    }
+
+    // the previous priority contest, for each message added to the frame: get_priority_values() for every queue
+    QueueManager parent;
+    std::vector<std::unique_ptr<goby::acomms::Queue>> queues;
+    for (int i = 0; i < nqueues; ++i)
+    {
+        queues.emplace_back(new goby::acomms::Queue(types[i], &parent, queue_entry(i, false, 1)));
+        queues.back()->push_message(make_message(i, 0, 0));
+    }
+    goby::acomms::protobuf::ModemTransmission request_msg;
+    request_msg.set_max_frame_bytes(max_frame_bytes);
+    std::string data;
+    int winners = 0;
+    auto start = clock_type::now();
+    for (int i = 0; i < nframes * frame_messages; ++i)
+    {
+        goby::acomms::Queue* winner = nullptr;
+        double winning_priority = 0;
+        for (auto& queue : queues)
+        {
+            double priority;
+            boost::posix_time::ptime last_send_time;
+            if (queue->get_priority_values(&priority, &last_send_time, request_msg, data) &&
+                (!winner || priority > winning_priority))
+            {
+                winning_priority = priority;
+                winner = queue.get();
+            }
+        }
+        if (winner)
+            ++winners;
+    }
+    std::chrono::duration<double> previous_dt = clock_type::now() - start;
+    assert(winners == nframes * frame_messages);
+
+    double pack_us = pack_dt.count() / nframes * 1e6;
+    double previous_us = previous_dt.count() / nframes * 1e6;
+    std::cout << nqueues << " queues, " << frame_messages << " messages/frame: pack: " << pack_us
+              << " us/frame, previous priority contests alone: " << previous_us << " us/frame"
+              << std::endl;
+}
+
+void benchmark_ack(int nqueues)
+{
+    const int ncycles = 20;
+    const int nframes = 8;
+    const unsigned frame_messages = 20;
+
+    QueueManager q_manager;
+    configure(q_manager, nqueues, true, false);
+    ack_count = 0;
+    for (int i = 0; i < nqueues; ++i)
+    {
+        for (int j = 0, n = ncycles * nframes * frame_messages / nqueues + 1; j < n; ++j)
+            q_manager.push_message(*make_message(i, UNICORN_MODEM_ID, j));
+    }
+
+    std::vector<int> all_frames;
+    for (int frame = 0; frame < nframes; ++frame) all_frames.push_back(frame);
+
+    std::chrono::duration<double> dt(0);
+    for (int i = 0; i < ncycles; ++i)
+    {
+        goby::acomms::protobuf::ModemTransmission msg;
+        msg.set_max_frame_bytes(frame_messages * TEST_MESSAGE_SIZE);
+        msg.set_max_num_frames(nframes);
+        msg.set_dest(UNICORN_MODEM_ID);
+        auto start = clock_type::now();
+        q_manager.handle_modem_data_request(&msg);
+        ack(q_manager, all_frames);
+        dt += clock_type::now() - start;
+    }
+    assert(ack_count == ncycles * nframes * frame_messages);
+
+    std::cout << nqueues << " queues, " << nframes << " frames of " << frame_messages
+              << " messages, all acknowledged: " << dt.count() / ncycles * 1e6 << " us/packet"
+              << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    make_types();
+
+    test_priority();
+    test_ack();
+
+    for (int nqueues : {10, 100, max_queues}) benchmark_pack(nqueues);
+    for (int nqueues : {10, 100, max_queues}) benchmark_ack(nqueues);
+
+    dccl::DynamicProtobufManager::protobuf_shutdown();
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,272 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "goby/middleware/marshalling/cstr.h"
+#include "goby/middleware/marshalling/protobuf.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/middleware/transport/serialization_handlers.h"
+#include "goby/util/debug_logger.h"
+
+// tests BufferSerializer, and compares the cost of building an outgoing (identifier + data) message by serializing into a std::vector and copying vs. serializing in place, and of handing forwarded publications to the portal thread as a SerializerTransporterMessage vs. a SerializedPublication
+
+using goby::middleware::BufferSerializer;
+using goby::middleware::MarshallingScheme;
+using goby::middleware::SerializedPublication;
+using goby::middleware::SerializerParserHelper;
+using goby::middleware::protobuf::SerializerTransporterMessage;
+using clock_type = std::chrono::steady_clock;
+
+constexpr goby::middleware::Group to_portal_group{"goby::test::buffer_serializer::to_portal"};
+
+// a scheme that only implements serialize() into a std::vector
+struct Legacy
+{
+    int a{0};
+};
+constexpr int legacy_scheme = 1000;
+
+namespace goby
+{
+namespace middleware
+{
+template <> struct SerializerParserHelper<Legacy, legacy_scheme>
+{
+    static std::vector<char> serialize(const Legacy& d)
+    {
+        return std::vector<char>(d.a, static_cast<char>(d.a));
+    }
+    static std::string type_name(const Legacy& d = Legacy()) { return "Legacy"; }
+};
+} // namespace middleware
+} // namespace goby
+
+static_assert(goby::middleware::detail::has_buffer_serialize<
+                  SerializerParserHelper<SerializerTransporterMessage, MarshallingScheme::PROTOBUF>,
+                  SerializerTransporterMessage>::value,
+              "protobuf serializes into a buffer");
+static_assert(goby::middleware::detail::has_buffer_serialize<
+                  SerializerParserHelper<std::string, MarshallingScheme::CSTR>, std::string>::value,
+              "CSTR serializes into a buffer");
+static_assert(!goby::middleware::detail::has_buffer_serialize<
+                  SerializerParserHelper<Legacy, legacy_scheme>, Legacy>::value,
+              "Legacy uses the fallback");
+
+const std::string identifier = "/goby::test::buffer_serializer/2/goby.middleware.protobuf."
+                               "SerializerTransporterMessage/1234/5678/";
+
+SerializerTransporterMessage make_message(std::size_t data_size)
+{
+    SerializerTransporterMessage msg;
+    msg.mutable_key()->set_marshalling_scheme(MarshallingScheme::PROTOBUF);
+    msg.mutable_key()->set_type("goby.test.Foo");
+    msg.mutable_key()->set_group("goby::test::buffer_serializer");
+    msg.mutable_key()->set_serialize_time(1234567890);
+    msg.set_data(std::string(data_size, 'x'));
+    return msg;
+}
+
+template <typename DataType, int scheme> void check_serializer(const DataType& d)
+{
+    std::vector<char> expected = SerializerParserHelper<DataType, scheme>::serialize(d);
+    BufferSerializer<DataType, scheme> serializer(d);
+    assert(serializer.size() == expected.size());
+
+    // written at an offset, as after the identifier of an outgoing message
+    std::vector<char> buffer(identifier.size() + serializer.size() + 1, '#');
+    serializer.write(buffer.data() + identifier.size());
+    assert(std::equal(expected.begin(), expected.end(), buffer.begin() + identifier.size()));
+    // nothing written past the end
+    assert(buffer.back() == '#');
+}
+
+void test_serializers()
+{
+    check_serializer<SerializerTransporterMessage, MarshallingScheme::PROTOBUF>(make_message(0));
+    check_serializer<SerializerTransporterMessage, MarshallingScheme::PROTOBUF>(
+        make_message(100000));
+
+    // runtime introspection
+    auto msg = make_message(100);
+    check_serializer<google::protobuf::Message, MarshallingScheme::PROTOBUF>(msg);
+
+    check_serializer<std::string, MarshallingScheme::CSTR>("hello world");
+    check_serializer<std::string, MarshallingScheme::CSTR>("");
+
+    Legacy legacy;
+    legacy.a = 10;
+    check_serializer<Legacy, legacy_scheme>(legacy);
+
+    // parses back
+    BufferSerializer<SerializerTransporterMessage, MarshallingScheme::PROTOBUF> serializer(msg);
+    std::vector<char> buffer(serializer.size());
+    serializer.write(buffer.data());
+    SerializerTransporterMessage parsed;
+    assert(parsed.ParseFromArray(buffer.data(), buffer.size()));
+    assert(parsed.SerializeAsString() == msg.SerializeAsString());
+
+    std::cout << "serializers: passed" << std::endl;
+}
+
+// stands in for zmq::message_t(size)
+std::unique_ptr<char[]> make_outgoing(std::size_t size)
+{
+    return std::unique_ptr<char[]>(new char[size]);
+}
+
+std::atomic<int> sink{0};
+
+// as InterProcessPortal::_publish did: serialize into a vector, then copy identifier and data into the outgoing message
+void publish_copy(const SerializerTransporterMessage& msg)
+{
+    std::vector<char> bytes(
+        SerializerParserHelper<SerializerTransporterMessage, MarshallingScheme::PROTOBUF>::serialize(
+            msg));
+    auto outgoing = make_outgoing(identifier.size() + bytes.size());
+    std::memcpy(outgoing.get(), identifier.data(), identifier.size());
+    std::memcpy(outgoing.get() + identifier.size(), bytes.data(), bytes.size());
+    sink += outgoing[identifier.size() + bytes.size() - 1];
+}
+
+// serialize directly into the outgoing message
+void publish_in_place(const SerializerTransporterMessage& msg)
+{
+    BufferSerializer<SerializerTransporterMessage, MarshallingScheme::PROTOBUF> serializer(msg);
+    auto outgoing = make_outgoing(identifier.size() + serializer.size());
+    std::copy(identifier.begin(), identifier.end(), outgoing.get());
+    serializer.write(outgoing.get() + identifier.size());
+    sink += outgoing[identifier.size() + serializer.size() - 1];
+}
+
+template <typename Publish> double publish_rate(Publish publish, std::size_t data_size, int n)
+{
+    auto msg = make_message(data_size);
+    auto start = clock_type::now();
+    for (int i = 0; i < n; ++i) publish(msg);
+    std::chrono::duration<double> dt = clock_type::now() - start;
+    return n / dt.count();
+}
+
+void benchmark_publish(const std::string& name, std::size_t data_size, int n)
+{
+    double copy_rate = publish_rate(publish_copy, data_size, n);
+    double in_place_rate = publish_rate(publish_in_place, data_size, n);
+    std::cout << "portal publish, " << name << ": serialize + copy: " << copy_rate
+              << " msg/s, serialize in place: " << in_place_rate << " msg/s ("
+              << in_place_rate / copy_rate << "x)" << std::endl;
+}
+
+// forwarder thread publishes to the portal thread, which builds the outgoing message
+template <typename Forwarded, typename MakeForwarded, typename ForwardedBytes>
+double forward_rate(MakeForwarded make_forwarded, ForwardedBytes forwarded_bytes,
+                    std::size_t data_size, int n)
+{
+    goby::middleware::InterThreadTransporter portal;
+    int received = 0;
+    portal.subscribe<to_portal_group, Forwarded>(
+        [&](std::shared_ptr<const Forwarded> forwarded)
+        {
+            const auto& bytes = forwarded_bytes(*forwarded);
+            auto outgoing = make_outgoing(identifier.size() + bytes.size());
+            std::memcpy(outgoing.get(), identifier.data(), identifier.size());
+            std::memcpy(outgoing.get() + identifier.size(), bytes.data(), bytes.size());
+            ++received;
+        });
+
+    auto start = clock_type::now();
+    std::thread forwarder(
+        [&]()
+        {
+            goby::middleware::InterThreadTransporter interthread;
+            auto msg = make_message(data_size);
+            for (int i = 0; i < n; ++i)
+                interthread.publish<to_portal_group>(make_forwarded(msg));
+        });
+    while (received < n) portal.poll();
+    std::chrono::duration<double> dt = clock_type::now() - start;
+    forwarder.join();
+    return n / dt.count();
+}
+
+void benchmark_forward(const std::string& name, std::size_t data_size, int n)
+{
+    using Helper =
+        SerializerParserHelper<SerializerTransporterMessage, MarshallingScheme::PROTOBUF>;
+
+    // as InterProcessForwarder::_publish did: serialize, then copy into the data of a SerializerTransporterMessage
+    double message_rate = forward_rate<SerializerTransporterMessage>(
+        [](const SerializerTransporterMessage& msg)
+        {
+            std::vector<char> bytes(Helper::serialize(msg));
+            auto forwarded = std::make_shared<SerializerTransporterMessage>();
+            auto* key = forwarded->mutable_key();
+            key->set_marshalling_scheme(MarshallingScheme::PROTOBUF);
+            key->set_type(Helper::type_name(msg));
+            key->set_group(std::string(to_portal_group));
+            forwarded->set_allocated_data(new std::string(bytes.begin(), bytes.end()));
+            return std::shared_ptr<const SerializerTransporterMessage>(forwarded);
+        },
+        [](const SerializerTransporterMessage& forwarded) -> const std::string&
+        { return forwarded.data(); },
+        data_size, n);
+
+    double publication_rate = forward_rate<SerializedPublication>(
+        [](const SerializerTransporterMessage& msg)
+        {
+            return std::make_shared<const SerializedPublication>(
+                Helper::type_name(msg), MarshallingScheme::PROTOBUF,
+                std::string(to_portal_group), Helper::serialize(msg));
+        },
+        [](const SerializedPublication& forwarded) -> const std::vector<char>&
+        { return forwarded.bytes; },
+        data_size, n);
+
+    std::cout << "forwarded publish, " << name << ": SerializerTransporterMessage: "
+              << message_rate << " msg/s, SerializedPublication: " << publication_rate
+              << " msg/s (" << publication_rate / message_rate << "x)" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    test_serializers();
+
+    benchmark_publish("small", 16, 1000000);
+    benchmark_publish("1 MB", 1 << 20, 1000);
+    benchmark_forward("small", 16, 200000);
+    benchmark_forward("1 MB", 1 << 20, 200);
+
+    std::cout << "all tests passed" << std::endl;
+}
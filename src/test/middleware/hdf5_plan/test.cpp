@@ -0,0 +1,550 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "goby/middleware/log/hdf5/hdf5.h"
+#include "goby/middleware/log/hdf5/hdf5_plugin.h"
+#include "goby/time.h"
+#include "goby/util/debug_logger.h"
+
+#include "goby/test/middleware/hdf5_plan/test.pb.h"
+
+// tests the precompiled HDF5 ExtractionPlan against the previous reflection walk (one pass over the messages per field) and compares the throughput of the extraction and of the hdf5::Writer (with and without extraction threads) for messages with nested and repeated fields
+
+using goby::middleware::hdf5::ColumnBuffers;
+using goby::middleware::hdf5::ExtractionPlan;
+using goby::test::middleware::protobuf::PlanTestMessage;
+using goby::test::middleware::protobuf::PlanTestTree;
+
+const int nmessages = 20000;
+const int chunk_length = 1000;
+const std::string channel = "plan/test";
+const std::string collection_group =
+    "/" + channel + "/" + PlanTestMessage::descriptor()->full_name();
+
+PlanTestMessage make_message(int i)
+{
+    PlanTestMessage msg;
+    msg.set_int32_field(-i);
+    msg.set_int64_field(-(std::int64_t(1) << 40) + i);
+    msg.set_uint32_field(i);
+    msg.set_uint64_field(std::numeric_limits<std::uint64_t>::max() - i);
+    msg.set_bool_field(i % 2);
+    if (i % 3)
+        msg.set_string_field("sample " + std::to_string(i));
+    msg.set_float_field(i * 0.5f);
+    if (i % 4)
+        msg.set_double_field(i * 0.25);
+    msg.set_mode(i % 2 ? PlanTestMessage::MODE_SURVEY : PlanTestMessage::MODE_IDLE);
+
+    if (i % 5)
+    {
+        auto& nested = *msg.mutable_nested();
+        nested.set_id(i);
+        for (int k = 0; k < 8; ++k) nested.add_readings(i + k);
+        for (int k = 0, n = i % 4; k < n; ++k)
+        {
+            auto& sample = *nested.add_samples();
+            sample.set_index(k);
+            for (int l = 0; l < 6 + k; ++l) sample.add_values(i * 10 + l);
+            sample.set_label("s" + std::to_string(k));
+        }
+    }
+
+    for (int j = 0, n = i % 3 + 1; j < n; ++j)
+    {
+        auto& nested = *msg.add_repeated_nested();
+        nested.set_id(j);
+        for (int k = 0; k < 4; ++k) nested.add_readings(j + k);
+        for (int k = 0; k < 2; ++k)
+        {
+            auto& sample = *nested.add_samples();
+            sample.set_index(k);
+            for (int l = 0; l < 3; ++l) sample.add_values(l);
+        }
+    }
+
+    for (int k = 0; k < 16; ++k) msg.add_repeated_double(i + k / 8.0);
+    for (int k = 0, n = i % 3; k < n; ++k) msg.add_repeated_string(std::string(k + 1, 'a' + k));
+    msg.add_repeated_mode(PlanTestMessage::MODE_SURVEY);
+
+    if (i % 2 == 0)
+        msg.SetExtension(goby::test::middleware::protobuf::test_extension, i);
+
+    return msg;
+}
+
+// the extraction used by hdf5::Writer before ExtractionPlan (values passed to "sink" instead of being written to the file)
+template <typename T, typename Sink>
+void reference_field(const std::string& group, const google::protobuf::FieldDescriptor* field_desc,
+                     const std::vector<const google::protobuf::Message*>& messages,
+                     std::vector<hsize_t>& hs, Sink& sink)
+{
+    using namespace goby::middleware::hdf5;
+    if (field_desc->is_repeated())
+    {
+        int max_field_size = 0;
+        for (auto message : messages)
+        {
+            if (message)
+                max_field_size = std::max(
+                    max_field_size, message->GetReflection()->FieldSize(*message, field_desc));
+        }
+
+        hs.push_back(max_field_size);
+        std::vector<T> values(messages.size() * max_field_size, retrieve_empty_value<T>());
+        for (unsigned i = 0, n = messages.size(); i < n; ++i)
+        {
+            if (messages[i])
+            {
+                const google::protobuf::Reflection* refl = messages[i]->GetReflection();
+                int field_size = refl->FieldSize(*messages[i], field_desc);
+                for (int j = 0; j < field_size; ++j)
+                    retrieve_repeated_value<T>(&values[i * max_field_size + j], j,
+                                               PBMeta(refl, field_desc, (*messages[i])));
+            }
+        }
+        sink(group, field_desc, values, hs);
+        hs.pop_back();
+    }
+    else
+    {
+        std::vector<T> values(messages.size(), retrieve_empty_value<T>());
+        for (unsigned i = 0, n = messages.size(); i < n; ++i)
+        {
+            if (messages[i])
+            {
+                const google::protobuf::Reflection* refl = messages[i]->GetReflection();
+                retrieve_single_value<T>(&values[i], PBMeta(refl, field_desc, (*messages[i])));
+            }
+        }
+        sink(group, field_desc, values, hs);
+    }
+}
+
+std::vector<const google::protobuf::FieldDescriptor*>
+reference_fields(const google::protobuf::Descriptor* desc)
+{
+    std::vector<const google::protobuf::FieldDescriptor*> fields;
+    for (int i = 0, n = desc->field_count(); i < n; ++i) fields.push_back(desc->field(i));
+    google::protobuf::DescriptorPool::generated_pool()->FindAllExtensions(desc, &fields);
+    return fields;
+}
+
+template <typename Sink>
+void reference_selector(const std::string& group,
+                        const google::protobuf::FieldDescriptor* field_desc,
+                        const std::vector<const google::protobuf::Message*>& messages,
+                        std::vector<hsize_t>& hs, Sink& sink);
+
+template <typename Sink>
+void reference_embedded(const std::string& group,
+                        const google::protobuf::FieldDescriptor* field_desc,
+                        const std::vector<const google::protobuf::Message*>& messages,
+                        std::vector<hsize_t>& hs, Sink& sink)
+{
+    const std::string sub_group = group + "/" + field_desc->name();
+    int max_field_size = 0;
+    if (field_desc->is_repeated())
+    {
+        for (auto message : messages)
+        {
+            if (message)
+                max_field_size = std::max(
+                    max_field_size, message->GetReflection()->FieldSize(*message, field_desc));
+        }
+        hs.push_back(max_field_size);
+    }
+
+    // the sub-messages were gathered again for each field of the embedded message
+    for (auto sub_field_desc : reference_fields(field_desc->message_type()))
+    {
+        std::vector<const google::protobuf::Message*> sub_messages;
+        if (field_desc->is_repeated())
+            sub_messages.resize(messages.size() * max_field_size, nullptr);
+        bool has_submessages = false;
+        for (unsigned i = 0, n = messages.size(); i < n; ++i)
+        {
+            if (!messages[i])
+            {
+                if (!field_desc->is_repeated())
+                    sub_messages.push_back(nullptr);
+                continue;
+            }
+            const google::protobuf::Reflection* refl = messages[i]->GetReflection();
+            if (field_desc->is_repeated())
+            {
+                for (int j = 0, m = refl->FieldSize(*messages[i], field_desc); j < m; ++j)
+                    sub_messages[i * max_field_size + j] =
+                        &refl->GetRepeatedMessage(*messages[i], field_desc, j);
+            }
+            else
+            {
+                sub_messages.push_back(&refl->GetMessage(*messages[i], field_desc));
+            }
+            has_submessages = true;
+        }
+        if (has_submessages)
+            reference_selector(sub_group, sub_field_desc, sub_messages, hs, sink);
+    }
+
+    if (field_desc->is_repeated())
+        hs.pop_back();
+}
+
+template <typename Sink>
+void reference_selector(const std::string& group,
+                        const google::protobuf::FieldDescriptor* field_desc,
+                        const std::vector<const google::protobuf::Message*>& messages,
+                        std::vector<hsize_t>& hs, Sink& sink)
+{
+    switch (field_desc->cpp_type())
+    {
+        case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+            reference_embedded(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+            reference_field<std::int32_t>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+            reference_field<std::int64_t>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+            reference_field<std::uint32_t>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+            reference_field<std::uint64_t>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+            reference_field<unsigned char>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+            reference_field<std::string>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+            reference_field<float>(group, field_desc, messages, hs, sink);
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+            reference_field<double>(group, field_desc, messages, hs, sink);
+            break;
+    }
+}
+
+template <typename Sink>
+void reference_extract(const std::vector<const google::protobuf::Message*>& messages, Sink& sink)
+{
+    for (auto field_desc : reference_fields(messages.front()->GetDescriptor()))
+    {
+        std::vector<hsize_t> hs(1, messages.size());
+        reference_selector("", field_desc, messages, hs, sink);
+    }
+}
+
+template <typename T> bool equal(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a == b;
+}
+// compare bitwise so that the empty values (NaN) match
+template <typename T> bool equal_bits(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() &&
+           (a.empty() || std::memcmp(&a[0], &b[0], a.size() * sizeof(T)) == 0);
+}
+bool equal(const std::vector<float>& a, const std::vector<float>& b) { return equal_bits(a, b); }
+bool equal(const std::vector<double>& a, const std::vector<double>& b) { return equal_bits(a, b); }
+
+// checks each column from the reference extraction against the next column written from the plan
+struct CompareWithPlan
+{
+    const ExtractionPlan& plan;
+    ColumnBuffers& columns;
+    int node{0};
+
+    template <typename T>
+    void operator()(const std::string& group, const google::protobuf::FieldDescriptor* field_desc,
+                    const std::vector<T>& values, const std::vector<hsize_t>& hs)
+    {
+        const auto& nodes = plan.nodes();
+        while (node < static_cast<int>(nodes.size()) &&
+               (!columns.present(node) || nodes[node].type == ExtractionPlan::NodeType::MESSAGE))
+            ++node;
+        assert(node < static_cast<int>(nodes.size()));
+        const auto& plan_node = nodes[node];
+        assert(plan_node.field_desc == field_desc);
+        assert(plan_node.group == group);
+        assert(columns.dims(node) == hs);
+        assert(equal(columns.values<T>(plan_node.column), values));
+        ++node;
+    }
+};
+
+struct CountValues
+{
+    std::size_t count{0};
+    template <typename T>
+    void operator()(const std::string&, const google::protobuf::FieldDescriptor*,
+                    const std::vector<T>& values, const std::vector<hsize_t>&)
+    {
+        count += values.size();
+    }
+};
+
+std::vector<std::shared_ptr<google::protobuf::Message>> make_messages()
+{
+    std::vector<std::shared_ptr<google::protobuf::Message>> messages;
+    for (int i = 0; i < nmessages; ++i)
+        messages.push_back(std::make_shared<PlanTestMessage>(make_message(i)));
+    return messages;
+}
+
+std::vector<const google::protobuf::Message*>
+batch(const std::vector<std::shared_ptr<google::protobuf::Message>>& messages, int start)
+{
+    std::vector<const google::protobuf::Message*> batch;
+    for (int i = start, n = std::min<int>(start + chunk_length, messages.size()); i < n; ++i)
+        batch.push_back(messages[i].get());
+    return batch;
+}
+
+void test_plan(const std::vector<std::shared_ptr<google::protobuf::Message>>& messages)
+{
+    ExtractionPlan plan(PlanTestMessage::descriptor());
+
+    // extension is last of the top level fields
+    int extension_count = 0;
+    for (const auto& node : plan.nodes())
+    {
+        if (node.field_desc->is_extension())
+        {
+            ++extension_count;
+            assert(node.group.empty());
+            assert(node.field_desc->full_name() == "goby.test.middleware.protobuf.test_extension");
+        }
+    }
+    assert(extension_count == 1);
+
+    // same columns as the previous extraction, reusing the buffers across batches
+    ColumnBuffers columns;
+    for (int start = 0; start < nmessages; start += chunk_length)
+    {
+        auto messages_batch = batch(messages, start);
+        plan.extract(messages_batch, &columns);
+        CompareWithPlan compare{plan, columns};
+        reference_extract(messages_batch, compare);
+    }
+
+    // an embedded message that is never set is still extracted (as empty values)
+    {
+        std::vector<PlanTestMessage> empty(3);
+        std::vector<const google::protobuf::Message*> empty_batch;
+        for (const auto& msg : empty) empty_batch.push_back(&msg);
+        plan.extract(empty_batch, &columns);
+        CompareWithPlan compare{plan, columns};
+        reference_extract(empty_batch, compare);
+    }
+
+    // recursive types are cut off at the recursion
+    ExtractionPlan tree_plan(PlanTestTree::descriptor());
+    assert(tree_plan.nodes().size() == 2);
+    assert(tree_plan.nodes()[1].type == ExtractionPlan::NodeType::OMITTED);
+
+    std::cout << "plan: passed" << std::endl;
+}
+
+void test_extraction_rate(const std::vector<std::shared_ptr<google::protobuf::Message>>& messages)
+{
+    const int repeats = 5;
+    CountValues reference_count;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (int i = 0; i < nmessages; i += chunk_length)
+            reference_extract(batch(messages, i), reference_count);
+    }
+    std::chrono::duration<double> reference_dt = std::chrono::steady_clock::now() - start;
+
+    ExtractionPlan plan(PlanTestMessage::descriptor());
+    ColumnBuffers columns;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (int i = 0; i < nmessages; i += chunk_length)
+            plan.extract(batch(messages, i), &columns);
+    }
+    std::chrono::duration<double> plan_dt = std::chrono::steady_clock::now() - start;
+
+    double reference_rate = repeats * nmessages / reference_dt.count();
+    double plan_rate = repeats * nmessages / plan_dt.count();
+    std::cout << "extraction (" << nmessages << " messages, " << reference_count.count / repeats
+              << " values): previous: " << reference_rate << " msgs/s, plan: " << plan_rate
+              << " msgs/s (" << plan_rate / reference_rate << "x)" << std::endl;
+}
+
+template <typename T>
+std::vector<T> read_dataset(H5::H5File& file, const std::string& path, std::vector<hsize_t>* dims)
+{
+    H5::DataSet dataset = file.openDataSet(path);
+    H5::DataSpace space = dataset.getSpace();
+    dims->resize(space.getSimpleExtentNdims());
+    space.getSimpleExtentDims(dims->data());
+    hsize_t size = 1;
+    for (auto d : *dims) size *= d;
+    std::vector<T> values(size);
+    if (size)
+        dataset.read(values.data(), goby::middleware::hdf5::predicate<T>());
+    return values;
+}
+
+double write_file(const std::vector<std::shared_ptr<google::protobuf::Message>>& messages,
+                  const std::string& path, bool use_chunks, int threads)
+{
+    auto start = std::chrono::steady_clock::now();
+    {
+        goby::middleware::hdf5::Writer writer(path, true, use_chunks, chunk_length, false, 0,
+                                              threads);
+        auto time = goby::time::SystemClock::now<goby::time::MicroTime>();
+        for (int i = 0; i < nmessages; ++i)
+        {
+            goby::middleware::HDF5ProtobufEntry entry;
+            entry.channel = channel;
+            entry.time = time + goby::time::MicroTime(i * boost::units::si::seconds);
+            entry.msg = messages[i];
+            entry.scheme = 4;
+            writer.add_entry(entry);
+        }
+        writer.write();
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    double rate = nmessages / dt.count();
+    std::cout << "writer (chunks: " << std::boolalpha << use_chunks << ", threads: " << threads
+              << "): " << rate << " msgs/s" << std::endl;
+    return rate;
+}
+
+void check_file(const std::string& path, const std::string& reference_path)
+{
+    H5::H5File file(path, H5F_ACC_RDONLY);
+    std::vector<hsize_t> dims;
+
+    auto utime = read_dataset<std::uint64_t>(file, collection_group + "/_utime_", &dims);
+    assert(dims == std::vector<hsize_t>({nmessages}));
+    for (int i = 1; i < nmessages; ++i) assert(utime[i] - utime[0] == i * 1000000ull);
+
+    auto int32_field = read_dataset<std::int32_t>(file, collection_group + "/int32_field", &dims);
+    for (int i = 0; i < nmessages; ++i) assert(int32_field[i] == -i);
+
+    auto double_field = read_dataset<double>(file, collection_group + "/double_field", &dims);
+    for (int i = 0; i < nmessages; ++i)
+        assert((i % 4) ? double_field[i] == i * 0.25 : std::isnan(double_field[i]));
+
+    auto extension = read_dataset<std::int32_t>(file, collection_group + "/test_extension", &dims);
+    for (int i = 0; i < nmessages; ++i)
+        assert(extension[i] == (i % 2 == 0 ? i : std::numeric_limits<std::int32_t>::max()));
+
+    // nested (singular) -> samples (repeated, up to 3) -> values (repeated, up to 8)
+    auto values = read_dataset<double>(file, collection_group + "/nested/samples/values", &dims);
+    assert(dims == std::vector<hsize_t>({nmessages, 3, 8}));
+    for (int i = 0; i < nmessages; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            for (int l = 0; l < 8; ++l)
+            {
+                double v = values[(i * 3 + k) * 8 + l];
+                bool present = (i % 5) && k < i % 4 && l < 6 + k;
+                assert(present ? v == i * 10 + l : std::isnan(v));
+            }
+        }
+    }
+
+    auto repeated_string_size =
+        read_dataset<std::uint32_t>(file, collection_group + "/repeated_string_size", &dims);
+    assert(dims == std::vector<hsize_t>({nmessages, 2}));
+    for (int i = 0; i < nmessages; ++i)
+    {
+        for (int k = 0; k < 2; ++k)
+            assert(repeated_string_size[i * 2 + k] == (k < i % 3 ? k + 1 : 0));
+    }
+
+    H5::DataSet mode = file.openDataSet(collection_group + "/mode");
+    assert(mode.attrExists("enum_names"));
+
+    // identical to the reference file
+    if (!reference_path.empty())
+    {
+        H5::H5File reference(reference_path, H5F_ACC_RDONLY);
+        std::vector<hsize_t> reference_dims;
+        for (const auto& path : {"/repeated_nested/samples/values", "/nested/readings",
+                                 "/repeated_double", "/float_field"})
+        {
+            auto a = read_dataset<double>(file, collection_group + path, &dims);
+            auto b = read_dataset<double>(reference, collection_group + path, &reference_dims);
+            assert(dims == reference_dims);
+            assert(equal(a, b));
+        }
+        const std::string path = collection_group + "/string_field";
+        assert(read_dataset<unsigned char>(file, path, &dims) ==
+               read_dataset<unsigned char>(reference, path, &reference_dims));
+        assert(dims == reference_dims);
+    }
+}
+
+void test_writer(const std::vector<std::shared_ptr<google::protobuf::Message>>& messages)
+{
+    const std::string single = "/tmp/goby_test_hdf5_plan.h5";
+    const std::string chunked = "/tmp/goby_test_hdf5_plan_chunked.h5";
+    const std::string threaded = "/tmp/goby_test_hdf5_plan_threaded.h5";
+
+    write_file(messages, single, false, 1);
+    check_file(single, "");
+
+    write_file(messages, chunked, true, 1);
+    check_file(chunked, single);
+
+    write_file(messages, threaded, true, 4);
+    check_file(threaded, single);
+
+    for (const auto& path : {single, chunked, threaded}) std::remove(path.c_str());
+    std::cout << "writer: passed" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    auto messages = make_messages();
+    test_plan(messages);
+    test_extraction_rate(messages);
+    test_writer(messages);
+
+    std::cout << "all tests passed" << std::endl;
+}
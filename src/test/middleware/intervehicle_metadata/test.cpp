@@ -0,0 +1,165 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
+
+#include "goby/middleware/protobuf/serializer_transporter.pb.h"
+#include "goby/middleware/transport/intervehicle/metadata.h"
+#include "goby/util/debug_logger.h"
+
+// tests the intervehicle::type_metadata() cache and compares the per-publication CPU time and interprocess bytes of sending the full metadata with every publication vs. the full metadata once and the fingerprint after that
+
+using goby::middleware::intervehicle::metadata_fingerprint;
+using goby::middleware::intervehicle::type_metadata;
+using goby::middleware::protobuf::SerializerProtobufMetadata;
+using goby::middleware::protobuf::SerializerTransporterMessage;
+using clock_type = std::chrono::steady_clock;
+
+const int npublications = 2000;
+const double publish_hertz = 5;
+
+// as InterVehicleTransporterBase::_set_protobuf_metadata did for every publication
+void insert_file_desc_with_dependencies(const google::protobuf::FileDescriptor* file_desc,
+                                        SerializerProtobufMetadata* meta)
+{
+    for (int i = 0, n = file_desc->dependency_count(); i < n; ++i)
+        insert_file_desc_with_dependencies(file_desc->dependency(i), meta);
+    file_desc->CopyTo(meta->add_file_descriptor());
+}
+
+void test_metadata()
+{
+    const auto* desc = SerializerTransporterMessage::descriptor();
+    const auto& metadata = type_metadata(desc);
+    // cached
+    assert(&type_metadata(desc) == &metadata);
+
+    const auto& full = metadata.full;
+    assert(full.protobuf_name() == desc->full_name());
+    assert(full.fingerprint() == metadata_fingerprint(full));
+    assert(full.file_descriptor(full.file_descriptor_size() - 1).name() == desc->file()->name());
+
+    // each file once, with dependencies first (so they can be built in order)
+    std::set<std::string> names;
+    google::protobuf::DescriptorPool pool;
+    for (const auto& file_desc_proto : full.file_descriptor())
+    {
+        assert(names.insert(file_desc_proto.name()).second);
+        assert(pool.BuildFile(file_desc_proto) != nullptr);
+    }
+    assert(pool.FindMessageTypeByName(full.protobuf_name()) != nullptr);
+
+    const auto& fingerprint_only = metadata.fingerprint_only;
+    assert(fingerprint_only.protobuf_name() == full.protobuf_name());
+    assert(fingerprint_only.fingerprint() == full.fingerprint());
+    assert(fingerprint_only.file_descriptor_size() == 0);
+
+    // stable: recomputed from the rebuilt files
+    SerializerProtobufMetadata rebuilt;
+    for (const auto& file_desc_proto : full.file_descriptor())
+        pool.FindFileByName(file_desc_proto.name())->CopyTo(rebuilt.add_file_descriptor());
+    assert(metadata_fingerprint(rebuilt) == full.fingerprint());
+
+    // same files, same fingerprint
+    const auto& key_metadata =
+        type_metadata(goby::middleware::protobuf::SerializerTransporterKey::descriptor());
+    assert(key_metadata.full.fingerprint() == full.fingerprint());
+    assert(key_metadata.full.protobuf_name() != full.protobuf_name());
+
+    // different files, different fingerprint
+    const auto& config_metadata =
+        type_metadata(goby::middleware::protobuf::TransporterConfig::descriptor());
+    assert(config_metadata.full.fingerprint() != full.fingerprint());
+
+    std::cout << "metadata: " << full.file_descriptor_size() << " files, "
+              << full.ByteSizeLong() << " bytes, fingerprint only: "
+              << fingerprint_only.ByteSizeLong() << " bytes" << std::endl;
+    std::cout << "metadata: passed" << std::endl;
+}
+
+// publish a small message npublications times, with set_metadata(i, msg), serializing it for the interprocess layer and parsing it on the other side (as by the ModemDriverThread)
+template <typename SetMetadata> void benchmark(const std::string& name, SetMetadata set_metadata)
+{
+    std::size_t bytes = 0;
+    auto start = clock_type::now();
+    for (int i = 0; i < npublications; ++i)
+    {
+        SerializerTransporterMessage msg;
+        auto* key = msg.mutable_key();
+        key->set_marshalling_scheme(4);
+        key->set_type("goby.test.Status");
+        key->set_group("goby::test::status");
+        key->set_group_numeric(1);
+        key->set_serialize_time(1000000ull * i);
+        msg.set_data(std::string(32, 'x'));
+        set_metadata(i, msg);
+
+        std::string serialized = msg.SerializeAsString();
+        bytes += serialized.size();
+
+        SerializerTransporterMessage received;
+        received.ParseFromString(serialized);
+        assert(received.key().metadata().protobuf_name() == "goby.test.Status");
+    }
+    std::chrono::duration<double, std::micro> dt = clock_type::now() - start;
+    std::cout << name << ": " << dt.count() / npublications << " us/publication, "
+              << bytes / npublications << " bytes/publication ("
+              << bytes / npublications * publish_hertz / 1024 << " kB/s at " << publish_hertz
+              << " Hz)" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_metadata();
+
+    const auto* desc = SerializerTransporterMessage::descriptor();
+    benchmark("full metadata with every publication",
+              [&](int, SerializerTransporterMessage& msg)
+              {
+                  auto* meta = msg.mutable_key()->mutable_metadata();
+                  meta->set_protobuf_name("goby.test.Status");
+                  insert_file_desc_with_dependencies(desc->file(), meta);
+              });
+
+    benchmark("full metadata once, then fingerprint",
+              [&](int i, SerializerTransporterMessage& msg)
+              {
+                  const auto& metadata = type_metadata(desc);
+                  auto* meta = msg.mutable_key()->mutable_metadata();
+                  *meta = (i == 0) ? metadata.full : metadata.fingerprint_only;
+                  meta->set_protobuf_name("goby.test.Status");
+              });
+
+    std::cout << "all tests passed" << std::endl;
+}
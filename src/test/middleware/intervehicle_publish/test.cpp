@@ -0,0 +1,355 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "goby/middleware/marshalling/dccl.h"
+#include "goby/middleware/marshalling/protobuf.h"
+#include "goby/middleware/transport/interprocess.h"
+#include "goby/middleware/transport/intervehicle.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/test/middleware/intervehicle_publish/test.pb.h"
+#include "goby/util/debug_logger.h"
+
+// tests InterProcessTransporterBase::publish_dynamic_serialized() and publish_dynamic_no_inner() (as used by the InterVehicleTransporterBase publish path), and compares the publisher cost of serializing once and publishing the Protobuf copy only when subscribed vs. the previous path (serialize for the modem drivers, then publish_dynamic() for each scheme)
+//
+// As DCCL isn't needed to test the interprocess layer, the PROTOBUF scheme stands in for DCCL, and copy_scheme (also Protobuf encoded) for the PROTOBUF copy. test_intervehicle_publish() then publishes a DCCL message through InterVehicleForwarder itself.
+
+using goby::middleware::InterProcessForwarder;
+using goby::middleware::InterThreadTransporter;
+using goby::middleware::InterVehicleForwarder;
+using goby::middleware::MarshallingScheme;
+using goby::middleware::SerializedPublication;
+using goby::middleware::SerializerParserHelper;
+using goby::middleware::detail::PublicationFilter;
+using goby::middleware::protobuf::SerializerTransporterMessage;
+using clock_type = std::chrono::steady_clock;
+
+constexpr int copy_scheme = 1000;
+constexpr int stand_in_scheme = MarshallingScheme::PROTOBUF;
+
+namespace goby
+{
+namespace middleware
+{
+template <>
+struct SerializerParserHelper<SerializerTransporterMessage, copy_scheme>
+    : public SerializerParserHelper<SerializerTransporterMessage, MarshallingScheme::PROTOBUF>
+{
+};
+} // namespace middleware
+} // namespace goby
+
+constexpr goby::middleware::Group to_portal_group{"goby::middleware::interprocess::to_portal"};
+constexpr goby::middleware::Group data_group{"goby::test::intervehicle_publish::data"};
+constexpr goby::middleware::Group intervehicle_group{"goby::test::intervehicle_publish::sample",
+                                                     goby::middleware::Group::broadcast_group};
+
+const int nbenchmark = 200000;
+
+// schemes that the (simulated) portal reports having subscribers for
+std::set<int> subscribed_schemes;
+
+struct Received
+{
+    std::vector<std::shared_ptr<const SerializedPublication>> publications;
+    int inner{0};
+};
+
+std::shared_ptr<const SerializerTransporterMessage> make_message(std::size_t data_size)
+{
+    auto msg = std::make_shared<SerializerTransporterMessage>();
+    msg->mutable_key()->set_marshalling_scheme(MarshallingScheme::DCCL);
+    msg->mutable_key()->set_type("goby.test.Foo");
+    msg->mutable_key()->set_group(std::string(data_group));
+    msg->mutable_key()->set_serialize_time(1234567890);
+    msg->set_data(std::string(data_size, 'x'));
+    return msg;
+}
+
+void subscribe(InterThreadTransporter& interthread, Received& received)
+{
+    interthread.subscribe<to_portal_group, SerializedPublication>(
+        [&](std::shared_ptr<const SerializedPublication> publication)
+        { received.publications.push_back(publication); });
+    interthread.subscribe<data_group, SerializerTransporterMessage>(
+        [&](std::shared_ptr<const SerializerTransporterMessage>) { ++received.inner; });
+}
+
+// runs publish(interprocess) in another thread (as subscribers don't receive their own thread's publications)
+template <typename Publish> void publish_from_other_thread(Publish publish)
+{
+    std::thread publisher(
+        [&]()
+        {
+            InterThreadTransporter interthread;
+            InterProcessForwarder<InterThreadTransporter> interprocess(interthread);
+            publish(interprocess);
+        });
+    publisher.join();
+}
+
+void test_publish()
+{
+    InterThreadTransporter interthread;
+    Received received;
+    subscribe(interthread, received);
+
+    auto msg = make_message(100);
+    std::vector<char> bytes(
+        SerializerParserHelper<SerializerTransporterMessage, stand_in_scheme>::serialize(*msg));
+
+    // bytes are forwarded as given, and the data published to the inner layer
+    subscribed_schemes = {stand_in_scheme};
+    publish_from_other_thread(
+        [&](InterProcessForwarder<InterThreadTransporter>& interprocess)
+        {
+            interprocess.publish_dynamic_serialized<SerializerTransporterMessage, stand_in_scheme>(
+                msg, bytes, data_group);
+        });
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    assert(received.publications.size() == 1);
+    assert(received.publications[0]->bytes == bytes);
+    assert(received.publications[0]->scheme == stand_in_scheme);
+    assert(received.publications[0]->type ==
+           "goby.middleware.protobuf.SerializerTransporterMessage");
+    assert(received.publications[0]->group == std::string(data_group));
+    assert(received.inner == 1);
+
+    // the copy isn't serialized without subscribers, and never goes to the inner layer
+    publish_from_other_thread(
+        [&](InterProcessForwarder<InterThreadTransporter>& interprocess)
+        {
+            interprocess.publish_dynamic_no_inner<SerializerTransporterMessage, copy_scheme>(
+                *msg, data_group);
+            assert(interprocess.publications_skipped() == 1);
+        });
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    assert(received.publications.size() == 1);
+    assert(received.inner == 1);
+
+    subscribed_schemes = {stand_in_scheme, copy_scheme};
+    publish_from_other_thread(
+        [&](InterProcessForwarder<InterThreadTransporter>& interprocess)
+        {
+            interprocess.publish_dynamic_no_inner<SerializerTransporterMessage, copy_scheme>(
+                *msg, data_group);
+        });
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    assert(received.publications.size() == 2);
+    assert(received.publications[1]->scheme == copy_scheme);
+    assert(received.publications[1]->bytes == bytes);
+    assert(received.inner == 1);
+
+    // the given bytes aren't forwarded without subscribers, but the inner layer still gets the data
+    subscribed_schemes.clear();
+    publish_from_other_thread(
+        [&](InterProcessForwarder<InterThreadTransporter>& interprocess)
+        {
+            interprocess.publish_dynamic_serialized<SerializerTransporterMessage, stand_in_scheme>(
+                msg, bytes, data_group);
+            assert(interprocess.publications_skipped() == 1);
+        });
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    assert(received.publications.size() == 2);
+    assert(received.inner == 2);
+
+    std::cout << "publish: passed" << std::endl;
+}
+
+// each InterVehicleForwarder publication reaches the interthread subscribers once (the previous path's publish_dynamic() for DCCL and PROTOBUF delivered it twice), and the modem drivers and the interprocess DCCL subscribers get the same bytes
+void test_intervehicle_publish()
+{
+    using goby::test::middleware::protobuf::Sample;
+    const int n = 10;
+
+    InterThreadTransporter interthread;
+    std::vector<int> received;
+    std::vector<std::shared_ptr<const SerializedPublication>> forwarded;
+    std::vector<std::shared_ptr<const SerializerTransporterMessage>> modem_data_out;
+    interthread.subscribe<intervehicle_group, Sample>([&](const Sample& s)
+                                                      { received.push_back(s.a()); });
+    interthread.subscribe<to_portal_group, SerializedPublication>(
+        [&](std::shared_ptr<const SerializedPublication> publication)
+        {
+            if (publication->group == std::string(intervehicle_group))
+                forwarded.push_back(publication);
+        });
+    interthread.subscribe<goby::middleware::intervehicle::groups::modem_data_out,
+                          SerializerTransporterMessage>(
+        [&](std::shared_ptr<const SerializerTransporterMessage> msg)
+        { modem_data_out.push_back(msg); });
+
+    auto publish = [&]()
+    {
+        std::thread publisher(
+            [&]()
+            {
+                InterThreadTransporter interthread;
+                InterProcessForwarder<InterThreadTransporter> interprocess(interthread);
+                InterVehicleForwarder<InterProcessForwarder<InterThreadTransporter>> intervehicle(
+                    interprocess);
+                for (int i = 0; i < n; ++i)
+                {
+                    Sample s;
+                    s.set_a(i);
+                    intervehicle.publish<intervehicle_group>(s);
+                }
+            });
+        publisher.join();
+        while (interthread.poll(std::chrono::seconds(0))) {}
+    };
+
+    subscribed_schemes = {MarshallingScheme::DCCL, MarshallingScheme::PROTOBUF};
+    publish();
+    assert(received.size() == n);
+    for (int i = 0; i < n; ++i) assert(received[i] == i);
+    assert(modem_data_out.size() == n);
+    assert(forwarded.size() == 2 * n);
+    for (int i = 0; i < n; ++i)
+    {
+        const auto& dccl = forwarded[2 * i];
+        const auto& protobuf = forwarded[2 * i + 1];
+        assert(dccl->scheme == MarshallingScheme::DCCL);
+        assert(dccl->type == Sample::descriptor()->full_name());
+        assert(std::string(dccl->bytes.begin(), dccl->bytes.end()) == modem_data_out[i]->data());
+        assert(protobuf->scheme == MarshallingScheme::PROTOBUF);
+        Sample s;
+        s.ParseFromArray(protobuf->bytes.data(), protobuf->bytes.size());
+        assert(s.a() == i);
+    }
+
+    // without interprocess subscribers, the inner layers and the modem drivers are still published to
+    received.clear();
+    forwarded.clear();
+    modem_data_out.clear();
+    subscribed_schemes.clear();
+    publish();
+    assert(received.size() == n);
+    assert(modem_data_out.size() == n);
+    assert(forwarded.empty());
+
+    std::cout << "intervehicle publish: passed" << std::endl;
+}
+
+// as InterVehicleTransporterBase::publish_dynamic did: serialize for the modem drivers, then publish_dynamic() for both schemes (each serializes if subscribed, and publishes to the inner layer)
+void publish_previous(InterProcessForwarder<InterThreadTransporter>& interprocess,
+                      std::shared_ptr<const SerializerTransporterMessage> msg)
+{
+    std::vector<char> modem_bytes(
+        SerializerParserHelper<SerializerTransporterMessage, stand_in_scheme>::serialize(*msg));
+    assert(!modem_bytes.empty());
+    interprocess.publish_dynamic<SerializerTransporterMessage, stand_in_scheme>(msg, data_group);
+    interprocess.publish_dynamic<SerializerTransporterMessage, copy_scheme>(msg, data_group);
+}
+
+void publish_once(InterProcessForwarder<InterThreadTransporter>& interprocess,
+                  std::shared_ptr<const SerializerTransporterMessage> msg)
+{
+    std::vector<char> bytes(
+        SerializerParserHelper<SerializerTransporterMessage, stand_in_scheme>::serialize(*msg));
+    interprocess.publish_dynamic_serialized<SerializerTransporterMessage, stand_in_scheme>(
+        msg, bytes, data_group);
+    interprocess.publish_dynamic_no_inner<SerializerTransporterMessage, copy_scheme>(*msg,
+                                                                                     data_group);
+}
+
+// publisher thread cost, with this thread receiving both the inner publications and those forwarded to the portal
+template <typename Publish>
+double publish_rate(Publish publish, std::size_t data_size, int* inner_per_publication)
+{
+    InterThreadTransporter interthread;
+    Received received;
+    subscribe(interthread, received);
+    auto msg = make_message(data_size);
+
+    std::atomic<bool> done{false};
+    std::chrono::duration<double> dt;
+    std::thread publisher(
+        [&]()
+        {
+            InterThreadTransporter interthread;
+            InterProcessForwarder<InterThreadTransporter> interprocess(interthread);
+            auto start = clock_type::now();
+            for (int i = 0; i < nbenchmark; ++i) publish(interprocess, msg);
+            dt = clock_type::now() - start;
+            done = true;
+        });
+
+    while (!done)
+    {
+        interthread.poll(std::chrono::milliseconds(10));
+        received.publications.clear();
+    }
+    publisher.join();
+    while (interthread.poll(std::chrono::seconds(0))) {}
+
+    *inner_per_publication = received.inner / nbenchmark;
+    return nbenchmark / dt.count();
+}
+
+void benchmark(const std::string& name, std::size_t data_size, const std::set<int>& subscribed)
+{
+    subscribed_schemes = subscribed;
+    int previous_inner = 0, once_inner = 0;
+    double previous_rate = publish_rate(publish_previous, data_size, &previous_inner);
+    double once_rate = publish_rate(publish_once, data_size, &once_inner);
+    assert(previous_inner == 2);
+    assert(once_inner == 1);
+
+    std::cout << name << ": previous: " << previous_rate
+              << " publications/s, serialize once: " << once_rate << " publications/s ("
+              << once_rate / previous_rate << "x)" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    int owner;
+    PublicationFilter::add(goby::middleware::protobuf::LAYER_INTERPROCESS, &owner,
+                           [](const std::string& /*type_name*/, int scheme,
+                              const std::string& /*group*/)
+                           { return subscribed_schemes.count(scheme) > 0; });
+
+    test_publish();
+    test_intervehicle_publish();
+
+    benchmark("small, DCCL subscribed", 16, {stand_in_scheme});
+    benchmark("small, DCCL and Protobuf subscribed", 16, {stand_in_scheme, copy_scheme});
+    benchmark("10 kB, DCCL subscribed", 10000, {stand_in_scheme});
+    benchmark("10 kB, DCCL and Protobuf subscribed", 10000, {stand_in_scheme, copy_scheme});
+
+    PublicationFilter::remove(&owner);
+
+    std::cout << "all tests passed" << std::endl;
+}
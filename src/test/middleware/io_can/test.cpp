@@ -0,0 +1,265 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "goby/middleware/io/can.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+
+// tests the batched reads, filtering and counters of the CanThread. The CanThread itself is only tested if the virtual CAN interface exists:
+//   sudo modprobe vcan
+//   sudo ip link add dev vcan0 type vcan
+//   sudo ip link set up vcan0
+
+using goby::middleware::io::PubSubLayer;
+using goby::middleware::protobuf::CanStatistics;
+using goby::middleware::protobuf::IODataBatch;
+using goby::middleware::protobuf::IOStatus;
+
+constexpr goby::middleware::Group can_in{"goby::test::io_can::can_in"};
+constexpr goby::middleware::Group can_out{"goby::test::io_can::can_out"};
+
+using CanThread = goby::middleware::io::CanThread<can_in, can_out, PubSubLayer::INTERTHREAD,
+                                                  PubSubLayer::INTERTHREAD>;
+
+const std::string vcan_interface = "vcan0";
+const int udp_port = 54703;
+
+can_frame make_frame(std::uint32_t pgn, int i)
+{
+    can_frame frame{};
+    frame.can_id = goby::middleware::io::make_extended_format_can_id(pgn, 3, 0x10);
+    frame.can_dlc = sizeof(i);
+    std::memcpy(frame.data, &i, sizeof(i));
+    return frame;
+}
+
+int sequence(const can_frame& frame)
+{
+    int i;
+    std::memcpy(&i, frame.data, sizeof(i));
+    return i;
+}
+
+void test_filter_match()
+{
+    using goby::middleware::io::detail::can_filter_match;
+    using goby::middleware::protobuf::CanConfig;
+
+    auto id = goby::middleware::io::make_extended_format_can_id(130306, 2, 0x20);
+
+    assert(can_filter_match({}, id));
+    assert(can_filter_match({{130306 << 8, CanConfig::CanFilter::PGNOnly}}, id));
+    assert(!can_filter_match({{130311 << 8, CanConfig::CanFilter::PGNOnly}}, id));
+    assert(can_filter_match(
+        {{130311 << 8, CanConfig::CanFilter::PGNOnly}, {130306 << 8, CanConfig::CanFilter::PGNOnly}},
+        id));
+    // inverted filter
+    assert(!can_filter_match({{(130306 << 8) | CAN_INV_FILTER, CanConfig::CanFilter::PGNOnly}}, id));
+    assert(can_filter_match({{(130311 << 8) | CAN_INV_FILTER, CanConfig::CanFilter::PGNOnly}}, id));
+    std::cout << "filter match: passed" << std::endl;
+}
+
+// CanReceiveBatch works on any datagram socket, so test the batching on UDP loopback (UDP doesn't report SO_RXQ_OVFL, so the drop counting is only tested with vcan0)
+void test_receive_batch()
+{
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(udp_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int result = bind(rx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assert(result == 0);
+
+    int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    const int nsent = 200;
+    for (int i = 0; i < nsent; ++i)
+    {
+        auto frame = make_frame(130306, i);
+        sendto(tx, &frame, sizeof(frame), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+
+    goby::middleware::io::detail::CanReceiveBatch batch(32);
+    int received = 0, calls = 0;
+    for (;;)
+    {
+        int n = batch.receive(rx);
+        if (n <= 0)
+            break;
+        ++calls;
+        for (int i = 0; i < n; ++i)
+        {
+            assert(batch.complete(i));
+            assert(sequence(batch.frame(i)) == received);
+            std::uint32_t dropped;
+            assert(!batch.dropped(i, &dropped));
+            ++received;
+        }
+    }
+    close(tx);
+    close(rx);
+
+    std::cout << "receive batch: " << received << " frames received in " << calls << " calls"
+              << std::endl;
+    assert(received == nsent);
+    assert(calls == (nsent + 31) / 32);
+}
+
+void wait_for(goby::middleware::InterThreadTransporter& interthread, std::function<bool()> done)
+{
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!done())
+    {
+        interthread.poll(std::chrono::milliseconds(10));
+        assert(std::chrono::steady_clock::now() < timeout);
+    }
+}
+
+void test_can_thread(bool kernel_filter, int publish_window_ms)
+{
+    goby::middleware::InterThreadTransporter interthread;
+
+    const std::uint32_t wanted_pgn = 130306, other_pgn = 130311;
+    goby::middleware::protobuf::CanConfig cfg;
+    cfg.set_interface(vcan_interface);
+    cfg.add_pgn_filter(wanted_pgn);
+    cfg.set_kernel_filter(kernel_filter);
+    cfg.set_publish_window_ms(publish_window_ms);
+    cfg.set_statistics_interval_ms(50);
+
+    bool open = false;
+    interthread.subscribe<can_in>([&](const IOStatus& status) {
+        if (status.state() == goby::middleware::protobuf::IO__LINK_OPEN)
+            open = true;
+    });
+
+    int received = 0, batches = 0;
+    auto check = [&](const can_frame& frame) {
+        auto pgn = std::get<goby::middleware::io::can_id::pgn_index>(
+            goby::middleware::io::parse_extended_format_can_id(frame.can_id));
+        assert(pgn == wanted_pgn);
+        assert(sequence(frame) == received);
+        ++received;
+    };
+    interthread.subscribe<can_in>([&](const can_frame& frame) {
+        assert(publish_window_ms == 0);
+        check(frame);
+    });
+    interthread.subscribe<can_in>([&](const std::vector<can_frame>& frames) {
+        assert(publish_window_ms > 0);
+        ++batches;
+        for (const auto& frame : frames) check(frame);
+    });
+    CanStatistics statistics;
+    interthread.subscribe<can_in>([&](const CanStatistics& s) { statistics = s; });
+
+    std::thread thread([cfg]() {
+        CanThread can(cfg);
+        std::atomic<bool> alive{true};
+        can.run(alive);
+    });
+    wait_for(interthread, [&]() { return open; });
+
+    int tx = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = if_nametoindex(vcan_interface.c_str());
+    int result = bind(tx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assert(result == 0);
+
+    const int nframes = 2000;
+    for (int i = 0; i < nframes; ++i)
+    {
+        // half the frames are filtered
+        auto frame = make_frame(i % 2 ? other_pgn : wanted_pgn, i / 2);
+        while (write(tx, &frame, sizeof(frame)) != sizeof(frame)) usleep(100);
+        // 8000 frames/s
+        if (i % 8 == 0)
+            usleep(1000);
+    }
+    close(tx);
+
+    wait_for(interthread, [&]() {
+        return received == nframes / 2 && static_cast<int>(statistics.frames_published()) == received;
+    });
+
+    goby::middleware::ThreadIdentifier ti;
+    ti.all_threads = true;
+    interthread.publish<CanThread::shutdown_group_>(ti);
+    thread.join();
+
+    std::cout << "CanThread (kernel_filter: " << std::boolalpha << kernel_filter
+              << ", publish_window_ms: " << publish_window_ms
+              << "): " << statistics.ShortDebugString() << std::endl;
+
+    assert(statistics.frames_dropped() == 0);
+    if (kernel_filter)
+    {
+        assert(statistics.frames_received() == nframes / 2);
+        assert(statistics.frames_filtered() == 0);
+    }
+    else
+    {
+        assert(statistics.frames_received() == nframes);
+        assert(statistics.frames_filtered() == nframes / 2);
+    }
+
+    if (publish_window_ms > 0)
+    {
+        assert(static_cast<int>(statistics.batches_published()) == batches);
+        // several frames per window
+        assert(batches < received / 2);
+    }
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    test_filter_match();
+    test_receive_batch();
+
+    if (if_nametoindex(vcan_interface.c_str()) != 0)
+    {
+        test_can_thread(true, 0);
+        test_can_thread(false, 0);
+        test_can_thread(true, 20);
+    }
+    else
+    {
+        std::cout << vcan_interface << " does not exist, skipping CanThread tests" << std::endl;
+    }
+
+    std::cout << "all tests passed" << std::endl;
+}
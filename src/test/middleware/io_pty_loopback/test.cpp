@@ -0,0 +1,209 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <atomic>
+#include <cassert>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "goby/middleware/io/line_based/pty.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+
+// measures the number of threads and the round trip throughput of N PTYThreads (each looped back to itself)
+
+using goby::middleware::io::PubSubLayer;
+using goby::middleware::protobuf::IOData;
+using goby::middleware::protobuf::IOStatus;
+
+constexpr goby::middleware::Group pty_in{"goby::test::io_pty_loopback::pty_in"};
+constexpr goby::middleware::Group pty_out{"goby::test::io_pty_loopback::pty_out"};
+
+using PTYThread = goby::middleware::io::PTYThreadLineBased<pty_in, pty_out, PubSubLayer::INTERTHREAD,
+                                                           PubSubLayer::INTERTHREAD>;
+
+const int npty = 32;
+const int nrounds = 200;
+
+std::string pty_path(int i) { return "/tmp/goby_test_io_pty_loopback_" + std::to_string(i); }
+
+int count_threads()
+{
+    int n = 0;
+    DIR* dir = opendir("/proc/self/task");
+    assert(dir);
+    while (dirent* entry = readdir(dir))
+    {
+        if (entry->d_name[0] != '.')
+            ++n;
+    }
+    closedir(dir);
+    return n;
+}
+
+// the "devices": opens the other side of each PTY and echoes everything back
+void echo(std::atomic<bool>& quit)
+{
+    std::vector<pollfd> fds;
+    for (int i = 0; i < npty; ++i)
+    {
+        int fd = open(pty_path(i).c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+        assert(fd >= 0);
+        termios ps;
+        tcgetattr(fd, &ps);
+        cfmakeraw(&ps);
+        tcsetattr(fd, TCSANOW, &ps);
+        fds.push_back({fd, POLLIN, 0});
+    }
+
+    char buffer[256];
+    while (!quit)
+    {
+        if (poll(fds.data(), fds.size(), 10) <= 0)
+            continue;
+
+        for (auto& pfd : fds)
+        {
+            if (!(pfd.revents & POLLIN))
+                continue;
+            ssize_t n = read(pfd.fd, buffer, sizeof(buffer));
+            for (ssize_t written = 0; written < n;)
+            {
+                ssize_t w = write(pfd.fd, buffer + written, n - written);
+                if (w > 0)
+                    written += w;
+            }
+        }
+    }
+
+    for (auto& pfd : fds) close(pfd.fd);
+}
+
+void wait_for(goby::middleware::InterThreadTransporter& interthread, std::function<bool()> done)
+{
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!done())
+    {
+        interthread.poll(std::chrono::milliseconds(10));
+        assert(std::chrono::steady_clock::now() < timeout);
+    }
+}
+
+struct Result
+{
+    int threads;
+    double lines_per_second;
+};
+
+Result run()
+{
+    int threads_before = count_threads();
+
+    goby::middleware::InterThreadTransporter interthread;
+
+    int open_count = 0;
+    interthread.subscribe<pty_in>([&](const IOStatus& status) {
+        if (status.state() == goby::middleware::protobuf::IO__LINK_OPEN)
+            ++open_count;
+        else
+            assert(status.state() == goby::middleware::protobuf::IO__LINK_CLOSED);
+    });
+
+    std::vector<int> received(npty, 0);
+    int total_received = 0;
+    interthread.subscribe<pty_in>([&](const IOData& data) {
+        int i = data.index();
+        assert(i >= 0 && i < npty);
+        assert(data.data() == std::to_string(received[i]) + "," + std::to_string(i) + "\n");
+        ++received[i];
+        ++total_received;
+    });
+
+    std::vector<std::thread> endpoints;
+    for (int i = 0; i < npty; ++i)
+    {
+        endpoints.emplace_back([i]() {
+            goby::middleware::protobuf::PTYConfig cfg;
+            cfg.set_port(pty_path(i));
+            PTYThread pty(cfg, i);
+            std::atomic<bool> alive{true};
+            pty.run(alive);
+        });
+    }
+    wait_for(interthread, [&]() { return open_count == npty; });
+
+    std::atomic<bool> quit_echo{false};
+    std::thread echo_thread([&]() { echo(quit_echo); });
+
+    // exclude the echo thread
+    int threads = count_threads() - threads_before - 1;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < nrounds; ++round)
+    {
+        for (int i = 0; i < npty; ++i)
+        {
+            auto io_msg = std::make_shared<IOData>();
+            io_msg->set_index(i);
+            io_msg->set_data(std::to_string(round) + "," + std::to_string(i) + "\n");
+            interthread.publish<pty_out>(io_msg);
+        }
+        wait_for(interthread, [&]() { return total_received == (round + 1) * npty; });
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+
+    goby::middleware::ThreadIdentifier ti;
+    ti.all_threads = true;
+    interthread.publish<PTYThread::shutdown_group_>(ti);
+    for (auto& endpoint : endpoints) endpoint.join();
+
+    quit_echo = true;
+    echo_thread.join();
+    for (int i = 0; i < npty; ++i) unlink(pty_path(i).c_str());
+
+    assert(count_threads() == threads_before);
+
+    Result result{threads, npty * nrounds / dt.count()};
+    std::cout << npty << " PTYs using " << result.threads << " threads, "
+              << result.lines_per_second << " round trips/s" << std::endl;
+    return result;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    Result result = run();
+    // one thread per PTY, running the io_context (which also waits on the interthread poller's wakeup descriptor for outgoing data)
+    assert(result.threads == npty);
+
+    std::cout << "all tests passed" << std::endl;
+}
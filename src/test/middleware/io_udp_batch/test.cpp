@@ -0,0 +1,249 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "goby/middleware/io/udp_one_to_many.h"
+#include "goby/middleware/io/udp_point_to_point.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+
+// tests batched (recvmmsg/sendmmsg) UDP in UDPOneToManyThread/UDPPointToPointThread and compares the loopback throughput with and without batching
+
+using goby::middleware::io::PubSubLayer;
+using goby::middleware::protobuf::IOData;
+using goby::middleware::protobuf::IODataBatch;
+using goby::middleware::protobuf::IOStatus;
+
+constexpr goby::middleware::Group udp_in{"goby::test::io_udp_batch::udp_in"};
+constexpr goby::middleware::Group udp_out{"goby::test::io_udp_batch::udp_out"};
+
+using UDPReceiver = goby::middleware::io::UDPOneToManyThread<udp_in, udp_out, PubSubLayer::INTERTHREAD,
+                                                             PubSubLayer::INTERTHREAD>;
+using UDPSender = goby::middleware::io::UDPPointToPointThread<udp_in, udp_out,
+                                                              PubSubLayer::INTERTHREAD,
+                                                              PubSubLayer::INTERTHREAD>;
+
+const int ndatagrams = 50000;
+// datagrams sent before waiting for them all to be received (small enough to fit in the default socket buffers)
+const int burst = 64;
+const int payload_size = 256;
+const int receiver_port = 54701;
+
+std::string payload(int i)
+{
+    std::string data = std::to_string(i) + ",";
+    data.resize(payload_size, 'x');
+    return data;
+}
+
+int sequence(const std::string& data) { return std::stoi(data); }
+
+void wait_for(goby::middleware::InterThreadTransporter& interthread, std::function<bool()> done)
+{
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!done())
+    {
+        interthread.poll(std::chrono::milliseconds(10));
+        assert(std::chrono::steady_clock::now() < timeout);
+    }
+}
+
+template <typename Thread, typename Config>
+std::thread launch(goby::middleware::InterThreadTransporter& interthread, const Config& cfg)
+{
+    int open_count = 0;
+    interthread.subscribe<udp_in>([&](const IOStatus& status) {
+        if (status.state() == goby::middleware::protobuf::IO__LINK_OPEN)
+            ++open_count;
+    });
+
+    std::thread thread([cfg]() {
+        Thread udp(cfg);
+        std::atomic<bool> alive{true};
+        udp.run(alive);
+    });
+    wait_for(interthread, [&]() { return open_count == 1; });
+    interthread.unsubscribe<udp_in, IOStatus>();
+    return thread;
+}
+
+void shutdown(goby::middleware::InterThreadTransporter& interthread, std::thread& thread)
+{
+    goby::middleware::ThreadIdentifier ti;
+    ti.all_threads = true;
+    interthread.publish<UDPReceiver::shutdown_group_>(ti);
+    thread.join();
+}
+
+double test_receive(int batch_size, bool publish_batch)
+{
+    goby::middleware::InterThreadTransporter interthread;
+
+    goby::middleware::protobuf::UDPOneToManyConfig cfg;
+    cfg.set_bind_port(receiver_port);
+    cfg.set_batch_size(batch_size);
+    cfg.set_publish_batch(publish_batch);
+    cfg.set_max_datagram_size(1024);
+    auto thread = launch<UDPReceiver>(interthread, cfg);
+
+    int received = 0;
+    int max_batch = 0;
+    auto check = [&](const IOData& data) {
+        assert(sequence(data.data()) == received);
+        assert(data.data() == payload(received));
+        assert(data.udp_dest().port() == receiver_port);
+        ++received;
+    };
+    interthread.subscribe<udp_in>(check);
+    interthread.subscribe<udp_in>([&](const IODataBatch& batch) {
+        assert(publish_batch);
+        max_batch = std::max(max_batch, batch.data_size());
+        for (const auto& data : batch.data()) check(data);
+    });
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(receiver_port);
+    dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ndatagrams; ++i)
+    {
+        auto data = payload(i);
+        sendto(fd, data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&dest), sizeof(dest));
+        if ((i + 1) % burst == 0 || i + 1 == ndatagrams)
+            wait_for(interthread, [&]() { return received == i + 1; });
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    close(fd);
+
+    shutdown(interthread, thread);
+
+    double rate = ndatagrams / dt.count();
+    std::cout << "receive (batch_size: " << batch_size << ", publish_batch: " << std::boolalpha
+              << publish_batch << "): " << rate << " datagrams/s";
+    if (publish_batch)
+    {
+        std::cout << ", largest batch: " << max_batch;
+        // bursts arrive faster than they're read, so at least some reads must have returned several datagrams
+        assert(max_batch > 1);
+    }
+    std::cout << std::endl;
+    return rate;
+}
+
+double test_send(int batch_size)
+{
+    goby::middleware::InterThreadTransporter interthread;
+
+    const int sink_port = receiver_port + 1;
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in bind_addr{};
+    bind_addr.sin_family = AF_INET;
+    bind_addr.sin_port = htons(sink_port);
+    bind_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int result = bind(fd, reinterpret_cast<sockaddr*>(&bind_addr), sizeof(bind_addr));
+    assert(result == 0);
+    timeval tv{0, 100000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    std::atomic<int> received{0};
+    std::atomic<bool> quit{false};
+    std::thread sink([&]() {
+        char buffer[1024];
+        while (!quit)
+        {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0)
+                continue;
+            std::string data(buffer, n);
+            assert(sequence(data) == received);
+            assert(data == payload(received));
+            ++received;
+        }
+    });
+
+    goby::middleware::protobuf::UDPPointToPointConfig cfg;
+    cfg.set_remote_address("127.0.0.1");
+    cfg.set_remote_port(sink_port);
+    cfg.set_batch_size(batch_size);
+    auto thread = launch<UDPSender>(interthread, cfg);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ndatagrams; ++i)
+    {
+        auto io_msg = std::make_shared<IOData>();
+        io_msg->set_data(payload(i));
+        interthread.publish<udp_out>(io_msg);
+        if ((i + 1) % burst == 0 || i + 1 == ndatagrams)
+        {
+            // received by the sink thread, so there's nothing to poll for
+            auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+            while (received != i + 1)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+                assert(std::chrono::steady_clock::now() < timeout);
+            }
+        }
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+
+    shutdown(interthread, thread);
+    quit = true;
+    sink.join();
+    close(fd);
+
+    double rate = ndatagrams / dt.count();
+    std::cout << "send (batch_size: " << batch_size << "): " << rate << " datagrams/s"
+              << std::endl;
+    return rate;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    test_receive(1, false);
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+    test_receive(burst, false);
+    test_receive(burst, true);
+#endif
+
+    test_send(1);
+#ifdef GOBY_IO_UDP_BATCH_AVAILABLE
+    test_send(burst);
+#endif
+
+    std::cout << "all tests passed" << std::endl;
+}
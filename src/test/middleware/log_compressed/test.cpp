@@ -0,0 +1,261 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "goby/middleware/log/compressed_log.h"
+#include "goby/middleware/log/indexed_log_reader.h"
+#include "goby/middleware/marshalling/interface.h"
+#include "goby/util/debug_logger.h"
+
+using goby::middleware::log::CompressionType;
+using goby::middleware::log::IndexedLogReader;
+using goby::middleware::log::LogEntry;
+using goby::middleware::log::LogIFStream;
+using goby::middleware::log::LogOFStream;
+using goby::time::SystemClock;
+
+const std::string log_file_base("/tmp/goby3_test_log_compressed");
+constexpr goby::middleware::Group nav_group("groups::nav");
+constexpr goby::middleware::Group sonar_group("groups::sonar");
+
+const int nentries = 100000;
+// small blocks so that the test covers many block boundaries
+const std::size_t block_size = 64 * 1024;
+SystemClock::time_point log_start{std::chrono::seconds(1700000000)};
+
+// representative data: slowly varying navigation (text) and sonar metadata (binary)
+std::vector<unsigned char> payload(int i)
+{
+    std::vector<unsigned char> data;
+    if (i % 2)
+    {
+        std::stringstream ss;
+        ss.precision(10);
+        ss << i << ",lat:" << 42.358 + 1e-6 * i << ",lon:" << -71.087 + 2e-6 * i
+           << ",depth:" << 10 + std::sin(i * 1e-3) << ",heading:" << (i / 100) % 360;
+        std::string s = ss.str();
+        data.assign(s.begin(), s.end());
+    }
+    else
+    {
+        std::string id = std::to_string(i) + ",";
+        data.assign(id.begin(), id.end());
+        for (int beam = 0; beam < 32; ++beam)
+        {
+            auto range = static_cast<std::uint16_t>(1000 + 10 * beam + (i / 50) % 20);
+            data.push_back(range >> 8);
+            data.push_back(range & 0xFF);
+            data.push_back(static_cast<unsigned char>(beam));
+        }
+    }
+    return data;
+}
+
+int entry_number(const LogEntry& entry)
+{
+    return std::stoi(std::string(entry.data().begin(), entry.data().end()));
+}
+
+bool entry_ok(const LogEntry& entry, int i)
+{
+    return entry.data() == payload(i) &&
+           entry.timestamp() == log_start + i * std::chrono::milliseconds(1) &&
+           entry.group() == ((i % 2) ? nav_group : sonar_group);
+}
+
+std::string type_name(CompressionType type)
+{
+    switch (type)
+    {
+        case CompressionType::NONE: return "none";
+        case CompressionType::ZLIB: return "zlib";
+        case CompressionType::ZSTD: return "zstd";
+    }
+    return "unknown";
+}
+
+std::string write_log(CompressionType type, std::uint64_t* uncompressed_size)
+{
+    std::string file = log_file_base + "_" + type_name(type) + ".goby";
+    LogEntry::reset();
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        LogOFStream out(file, type, LogOFStream::default_compression_level, block_size);
+        assert(out.is_open());
+        for (int i = 0; i < nentries; ++i)
+        {
+            LogEntry entry(payload(i), goby::middleware::MarshallingScheme::CSTR,
+                           (i % 2) ? "Nav" : "Sonar", (i % 2) ? nav_group : sonar_group,
+                           log_start + i * std::chrono::milliseconds(1));
+            entry.serialize(&out);
+        }
+        out.close();
+        if (type != CompressionType::NONE)
+            *uncompressed_size = out.uncompressed_bytes();
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+
+    std::ifstream written(file.c_str(), std::ifstream::binary | std::ifstream::ate);
+    std::uint64_t file_size = written.tellg();
+    if (type == CompressionType::NONE)
+        *uncompressed_size = file_size;
+
+    std::cout << type_name(type) << ": wrote " << nentries << " entries ("
+              << *uncompressed_size / 1.0e6 << " MB) at " << *uncompressed_size / 1.0e6 / dt.count()
+              << " MB/s, file size: " << file_size / 1.0e6
+              << " MB, compression ratio: " << static_cast<double>(*uncompressed_size) / file_size
+              << std::endl;
+    return file;
+}
+
+void test_sequential(const std::string& file, bool compressed, int expected_entries)
+{
+    LogEntry::reset();
+    LogIFStream in(file);
+    assert(in.is_open());
+    assert(in.is_compressed() == compressed);
+
+    auto start = std::chrono::steady_clock::now();
+    int read = 0;
+    int last = -1;
+    for (;;)
+    {
+        try
+        {
+            LogEntry entry;
+            entry.parse(&in);
+            int i = entry_number(entry);
+            assert(i > last);
+            assert(entry_ok(entry, i));
+            last = i;
+            ++read;
+        }
+        catch (goby::middleware::log::LogException& e)
+        {
+            // expected only for the corrupted file
+            assert(expected_entries != nentries);
+        }
+        catch (std::exception& e)
+        {
+            break;
+        }
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    std::cout << "\tread " << read << " entries at " << read / dt.count() << " entries/s"
+              << std::endl;
+
+    if (expected_entries == nentries)
+        assert(read == nentries);
+    else
+        assert(read >= expected_entries && read < nentries);
+}
+
+void test_seek(const std::string& file)
+{
+    LogEntry::reset();
+    IndexedLogReader reader(file);
+    reader.build_index();
+    assert(reader.index().size() == nentries);
+
+    LogEntry entry;
+    for (int target : {nentries / 2, 3, nentries - 1, 0, 77777, 12345, 12346})
+    {
+        reader.seek(log_start + target * std::chrono::milliseconds(1));
+        assert(reader.next(&entry));
+        assert(entry_number(entry) == target);
+        assert(entry_ok(entry, target));
+    }
+
+    // seeking directly in the stream only decompresses the destination block
+    LogIFStream in(file);
+    in.seekg(0, std::ios::end);
+    std::streamoff end = in.tellg();
+    in.seekg(reader.index()[4321].offset);
+    entry.parse(&in);
+    assert(entry_number(entry) == 4321);
+    in.seekg(end);
+    assert(in.tellg() == end);
+}
+
+void test_corruption(const std::string& file)
+{
+    std::string corrupt_file = log_file_base + "_corrupt.goby";
+    {
+        std::ifstream in(file.c_str(), std::ifstream::binary);
+        std::ofstream out(corrupt_file.c_str(), std::ofstream::binary);
+        out << in.rdbuf();
+    }
+
+    // damage a byte in the middle of the file (inside one block)
+    std::fstream f(corrupt_file.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    f.seekg(0, std::ios::end);
+    std::streamoff size = f.tellg();
+    f.seekg(size / 2);
+    char c;
+    f.get(c);
+    f.seekp(size / 2);
+    f.put(c ^ 0x5A);
+    f.close();
+
+    // we should lose at most the entries in the damaged block (plus one spanning each boundary)
+    const int min_entry_size = 60;
+    int max_lost = block_size / min_entry_size + 2;
+    std::cout << "corrupted block:" << std::endl;
+    test_sequential(corrupt_file, true, nentries - max_lost);
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::DIE, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    std::uint64_t uncompressed_size = 0;
+    std::string uncompressed = write_log(CompressionType::NONE, &uncompressed_size);
+    test_sequential(uncompressed, false, nentries);
+
+    for (auto type : {CompressionType::ZLIB, CompressionType::ZSTD})
+    {
+        if (!goby::middleware::log::compression_available(type))
+        {
+            std::cout << type_name(type) << ": not available, skipping" << std::endl;
+            continue;
+        }
+
+        std::uint64_t compressed_uncompressed_size = 0;
+        std::string file = write_log(type, &compressed_uncompressed_size);
+        // the container holds exactly the uncompressed log
+        assert(compressed_uncompressed_size == uncompressed_size);
+
+        test_sequential(file, true, nentries);
+        test_seek(file);
+        test_corruption(file);
+    }
+
+    std::cout << "all tests passed" << std::endl;
+}
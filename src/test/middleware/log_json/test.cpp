@@ -0,0 +1,268 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <google/protobuf/util/json_util.h>
+
+#include "goby/middleware/log.h"
+#include "goby/middleware/log/protobuf_json.h"
+#include "goby/middleware/log/protobuf_log_plugin.h"
+#include "goby/util/debug_logger.h"
+
+#include "goby/test/middleware/log_json/test.pb.h"
+
+// tests the direct protobuf to JSON writer against libprotobuf's MessageToJsonString and compares the throughput of the JSON log conversion before (json_message() + nlohmann::json::dump()) and after (write_json())
+
+#if GOOGLE_PROTOBUF_VERSION < 3001000
+#define ByteSizeLong ByteSize
+#endif
+
+using goby::middleware::log::LogEntry;
+using goby::test::middleware::protobuf::JSONTestMessage;
+using goby::test::middleware::protobuf::JSONTestNested;
+
+constexpr goby::middleware::Group test_group("goby::test::log_json");
+const std::string log_file = "/tmp/goby_test_log_json.goby";
+const int nentries = 100000;
+
+std::string to_json(const google::protobuf::Message& msg)
+{
+    std::string out;
+    goby::middleware::log::protobuf_json::append_message(msg, out);
+    return out;
+}
+
+// compare by value as the two writers may order keys and format numbers differently
+void check_against_libprotobuf(const JSONTestMessage& msg)
+{
+    std::string expected;
+    google::protobuf::util::MessageToJsonString(msg, &expected);
+    auto j = nlohmann::json::parse(to_json(msg));
+    // libprotobuf (3.x) drops extensions
+    j.erase("[goby.test.middleware.protobuf.test_extension]");
+    auto j_expected = nlohmann::json::parse(expected);
+    if (j != j_expected)
+    {
+        std::cerr << "Mismatch:\n  expected: " << j_expected.dump() << "\n  actual:   " << j.dump()
+                  << std::endl;
+        assert(false);
+    }
+}
+
+JSONTestMessage make_message(int i)
+{
+    JSONTestMessage msg;
+    msg.set_int32_field(-i);
+    msg.set_uint32_field(i);
+    msg.set_int64_field(-(std::int64_t(1) << 60) + i);
+    msg.set_uint64_field(std::numeric_limits<std::uint64_t>::max() - i);
+    msg.set_double_field(i * 0.1);
+    msg.set_float_field(i * 0.1f);
+    msg.set_bool_field(i % 2);
+    msg.set_string_field("sample " + std::to_string(i));
+    msg.set_mode(i % 2 ? JSONTestMessage::MODE_SURVEY : JSONTestMessage::MODE_IDLE);
+    msg.mutable_nested()->set_id(i);
+    for (int k = 0; k < 4; ++k) msg.mutable_nested()->add_values(i + k * 0.25);
+    for (int k = 0; k < 3; ++k)
+    {
+        auto& nested = *msg.add_repeated_nested();
+        nested.set_id(k);
+        nested.set_label("label " + std::to_string(k));
+        nested.add_values(k * 1.5);
+    }
+    for (int k = 0; k < 8; ++k) msg.add_repeated_double(i + k / 3.0);
+    return msg;
+}
+
+void test_types()
+{
+    JSONTestMessage msg;
+    // empty message
+    assert(to_json(msg) == "{}");
+    check_against_libprotobuf(msg);
+
+    msg.set_int32_field(-42);
+    msg.set_uint32_field(std::numeric_limits<std::uint32_t>::max());
+    msg.set_int64_field(std::numeric_limits<std::int64_t>::min());
+    msg.set_uint64_field(std::numeric_limits<std::uint64_t>::max());
+    msg.set_sint32_field(-7);
+    msg.set_fixed64_field(1234567890123ull);
+    msg.set_double_field(0.1);
+    msg.set_float_field(0.1f);
+    msg.set_bool_field(false);
+    msg.set_string_field("quote \" backslash \\ newline \n tab \t control \x01 unicode \xc3\xa9\xe2\x82\xac");
+    msg.set_bytes_field(std::string("\x00\xff\x10 bytes", 9));
+    msg.set_mode(JSONTestMessage::MODE_SURVEY);
+    msg.mutable_nested()->set_id(3);
+    msg.mutable_nested()->add_values(1e20);
+    msg.mutable_nested()->add_values(-1e-20);
+    msg.mutable_nested()->add_values(100000);
+    msg.mutable_nested()->add_values(1.0 / 3);
+
+    for (int i : {1, -2, 3}) msg.add_repeated_int32(i);
+    msg.add_repeated_double(std::numeric_limits<double>::max());
+    msg.add_repeated_double(std::numeric_limits<double>::denorm_min());
+    msg.add_repeated_double(0);
+    msg.add_repeated_string("a");
+    msg.add_repeated_string("");
+    msg.add_repeated_mode(JSONTestMessage::MODE_IDLE);
+    msg.add_repeated_mode(JSONTestMessage::MODE_SURVEY);
+    msg.add_repeated_nested()->set_label("first");
+    msg.add_repeated_nested();
+    // base64 padding
+    for (const char* bytes : {"a", "ab", "abc", "abcd"}) msg.add_repeated_bytes(bytes);
+
+    (*msg.mutable_string_map())["one"] = 1;
+    (*msg.mutable_string_map())["two"] = 2;
+    (*msg.mutable_int64_map())[-5].set_id(5);
+    (*msg.mutable_bool_map())[true] = "yes";
+
+    check_against_libprotobuf(msg);
+
+    // special values are written as strings
+    msg.set_double_field(std::numeric_limits<double>::quiet_NaN());
+    msg.set_float_field(-std::numeric_limits<float>::infinity());
+    msg.add_repeated_double(std::numeric_limits<double>::infinity());
+    check_against_libprotobuf(msg);
+    auto j = nlohmann::json::parse(to_json(msg));
+    assert(j["doubleField"] == "NaN");
+    assert(j["floatField"] == "-Infinity");
+
+    // extensions
+    msg.SetExtension(goby::test::middleware::protobuf::test_extension, 99);
+    j = nlohmann::json::parse(to_json(msg));
+    assert(j["[goby.test.middleware.protobuf.test_extension]"] == 99);
+
+    // exact output for a simple message
+    JSONTestNested nested;
+    nested.set_id(1);
+    nested.add_values(0.5);
+    nested.add_values(2);
+    nested.set_label("x");
+    assert(to_json(nested) == R"({"id":1,"values":[0.5,2],"label":"x"})");
+
+    // invalid UTF-8 is replaced
+    std::string out;
+    goby::middleware::log::protobuf_json::append_string("a\xff" "b\xc3", out);
+    assert(out == R"("a\ufffdb\ufffd")");
+    nlohmann::json::parse(out);
+
+    std::cout << "types: passed" << std::endl;
+}
+
+void write_log()
+{
+    goby::middleware::log::ProtobufPlugin plugin;
+    LogEntry::reset();
+    std::ofstream out_log_file(log_file);
+    plugin.register_write_hooks(out_log_file);
+
+    auto time = goby::time::SystemClock::now();
+    for (int i = 0; i < nentries; ++i)
+    {
+        auto msg = make_message(i);
+        std::vector<unsigned char> data(msg.ByteSizeLong());
+        msg.SerializeToArray(&data[0], data.size());
+        LogEntry entry(data, goby::middleware::MarshallingScheme::PROTOBUF,
+                       JSONTestMessage::descriptor()->full_name(), test_group,
+                       time + std::chrono::milliseconds(i));
+        entry.serialize(&out_log_file);
+    }
+}
+
+// converts the whole log to JSON, returning the entries/second
+double convert_log(bool write_json, std::ostream& os)
+{
+    goby::middleware::log::ProtobufPlugin plugin;
+    LogEntry::reset();
+    std::ifstream in_log_file(log_file);
+    plugin.register_read_hooks(in_log_file);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nentries; ++i)
+    {
+        LogEntry entry;
+        entry.parse(&in_log_file);
+        if (write_json)
+        {
+            plugin.write_json(entry, os);
+        }
+        else
+        {
+            // the previous conversion in goby_log_tool
+            auto j = plugin.json_message(entry);
+            goby::middleware::log::LogPlugin::add_json_metadata(entry, *j);
+            os << j->dump() << std::endl;
+        }
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    return nentries / dt.count();
+}
+
+void test_log_conversion()
+{
+    write_log();
+
+    std::stringstream before, after;
+    double rate_before = convert_log(false, before);
+    double rate_after = convert_log(true, after);
+
+    // same content
+    std::string line_before, line_after;
+    for (int i = 0; i < nentries; ++i)
+    {
+        std::getline(before, line_before);
+        std::getline(after, line_after);
+        auto j_before = nlohmann::json::parse(line_before);
+        auto j_after = nlohmann::json::parse(line_after);
+        assert(j_before == j_after);
+        assert(j_after["_group_"] == std::string(test_group.c_str()));
+        assert(j_after["_type_"] == JSONTestMessage::descriptor()->full_name());
+        assert(j_after["nested"]["id"] == i);
+    }
+    assert(!std::getline(after, line_after));
+
+    std::cout << "log conversion (" << nentries << " entries): json_message + dump: " << rate_before
+              << " entries/s, write_json: " << rate_after << " entries/s (" << rate_after / rate_before
+              << "x)" << std::endl;
+
+    std::remove(log_file.c_str());
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_types();
+    test_log_conversion();
+
+    std::cout << "all tests passed" << std::endl;
+}
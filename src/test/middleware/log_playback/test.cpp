@@ -0,0 +1,233 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "goby/middleware/log/indexed_log_reader.h"
+#include "goby/middleware/log/playback_clock.h"
+#include "goby/middleware/log/playback_scheduler.h"
+#include "goby/middleware/marshalling/interface.h"
+#include "goby/util/debug_logger.h"
+
+using goby::middleware::log::IndexedLogReader;
+using goby::middleware::log::LogEntry;
+using goby::middleware::log::PlaybackClock;
+using goby::middleware::log::PlaybackScheduler;
+using goby::time::SystemClock;
+
+const std::string log_file("/tmp/goby3_test_log_playback.goby");
+constexpr goby::middleware::Group group_a("groups::a");
+constexpr goby::middleware::Group group_b("groups::b");
+
+// 20 seconds of log time at 1 kHz
+const int nentries = 20000;
+const auto entry_period = std::chrono::milliseconds(1);
+SystemClock::time_point log_start{std::chrono::seconds(1700000000)};
+
+int entry_number(const LogEntry& entry)
+{
+    return std::stoi(std::string(entry.data().begin(), entry.data().end()));
+}
+
+void write_log()
+{
+    LogEntry::reset();
+    std::ofstream out(log_file.c_str(), std::ofstream::binary);
+    for (int i = 0; i < nentries; ++i)
+    {
+        std::string payload = std::to_string(i);
+        LogEntry entry(std::vector<unsigned char>(payload.begin(), payload.end()),
+                       goby::middleware::MarshallingScheme::CSTR,
+                       (i % 2) ? "TypeA" : "TypeB", (i % 3) ? group_a : group_b,
+                       log_start + i * entry_period);
+        entry.serialize(&out);
+    }
+}
+
+void test_index_and_seek(IndexedLogReader& reader)
+{
+    assert(reader.index().size() == nentries);
+    assert(reader.begin_time() == log_start);
+    assert(reader.end_time() == log_start + (nentries - 1) * entry_period);
+
+    LogEntry entry;
+    for (int target : {nentries / 2, 17, nentries - 1, 0, 12345})
+    {
+        reader.seek(log_start + target * entry_period);
+        assert(reader.next(&entry));
+        assert(entry_number(entry) == target);
+        assert(entry.timestamp() == log_start + target * entry_period);
+        assert(entry.group() == ((target % 3) ? group_a : group_b));
+        assert(entry.type() == ((target % 2) ? "TypeA" : "TypeB"));
+    }
+
+    // seek between entries goes to the next one
+    reader.seek(log_start + 100 * entry_period + std::chrono::microseconds(1));
+    assert(reader.next(&entry) && entry_number(entry) == 101);
+
+    // seek past the end
+    reader.seek(log_start + nentries * entry_period);
+    assert(!reader.next(&entry));
+
+    // read everything as fast as possible
+    reader.seek_index(0);
+    auto start = std::chrono::steady_clock::now();
+    int expected = 0;
+    while (reader.next(&entry)) assert(entry_number(entry) == expected++);
+    assert(expected == nentries);
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+    std::cout << "Read " << nentries << " prefetched entries at " << nentries / dt.count()
+              << " entries/s" << std::endl;
+}
+
+// replay through goby_playback's scheduler, called at goby_playback's loop frequency, and check the order and the total replay time
+void test_replay(IndexedLogReader& reader, double rate)
+{
+    const auto loop_period = std::chrono::milliseconds(10);
+
+    auto wall_start = SystemClock::now() + std::chrono::milliseconds(10);
+    PlaybackScheduler scheduler(reader, log_start, wall_start, rate);
+
+    std::vector<double> late_ms;
+    late_ms.reserve(nentries);
+
+    int expected = 0;
+    auto next_loop = std::chrono::steady_clock::now();
+    while (!scheduler.end_of_window())
+    {
+        scheduler.play_due([&](const LogEntry& entry) {
+            assert(entry_number(entry) == expected++);
+            auto now = SystemClock::now();
+            // never early
+            assert(scheduler.clock().log_now(now) >= entry.timestamp());
+            late_ms.push_back(std::chrono::duration<double, std::milli>(
+                                  now - scheduler.clock().wall_time(entry.timestamp()))
+                                  .count());
+        });
+        next_loop += loop_period;
+        std::this_thread::sleep_until(next_loop);
+    }
+    assert(expected == nentries);
+
+    std::chrono::duration<double> replay_time = SystemClock::now() - wall_start;
+    std::chrono::duration<double> log_duration = (nentries - 1) * entry_period;
+    double ideal = log_duration.count() / rate;
+
+    std::sort(late_ms.begin(), late_ms.end());
+    std::cout << "Replay at " << rate << "x: " << replay_time.count() << " s (ideal " << ideal
+              << " s), timing error median: " << late_ms[late_ms.size() / 2]
+              << " ms, 99th percentile: " << late_ms[late_ms.size() * 99 / 100]
+              << " ms, max: " << late_ms.back() << " ms" << std::endl;
+
+    // the last entry can't be played before it's due, and generously allow for a loaded test machine
+    assert(replay_time.count() >= ideal);
+    assert(replay_time.count() <= ideal * 1.25 + 0.1);
+}
+
+// only the entries within the playback window are played
+void test_window(IndexedLogReader& reader)
+{
+    auto log_end = log_start + std::chrono::seconds(1);
+    PlaybackScheduler scheduler(reader, log_start + std::chrono::seconds(2), SystemClock::now(),
+                                1000, log_end + std::chrono::seconds(2));
+
+    int played = 0;
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!scheduler.end_of_window())
+    {
+        played += scheduler.play_due([&](const LogEntry& entry) {
+            assert(entry.timestamp() >= log_start + std::chrono::seconds(2) &&
+                   entry.timestamp() <= log_end + std::chrono::seconds(2));
+        });
+        assert(std::chrono::steady_clock::now() < timeout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // both ends inclusive
+    assert(played == std::chrono::seconds(1) / entry_period + 1);
+}
+
+void test_clock()
+{
+    auto wall_start = SystemClock::time_point(std::chrono::seconds(100));
+    PlaybackClock clock(log_start, wall_start, 10);
+
+    // start delay
+    assert(clock.log_now(wall_start - std::chrono::seconds(1)) == log_start);
+    assert(clock.log_now(wall_start + std::chrono::seconds(1)) ==
+           log_start + std::chrono::seconds(10));
+    assert(clock.wall_time(log_start + std::chrono::seconds(10)) ==
+           wall_start + std::chrono::seconds(1));
+
+    // rate change continues from the current log time
+    clock.set_rate(2, wall_start + std::chrono::seconds(1));
+    assert(clock.log_now(wall_start + std::chrono::seconds(2)) ==
+           log_start + std::chrono::seconds(12));
+
+    // pause
+    clock.set_paused(true, wall_start + std::chrono::seconds(2));
+    assert(clock.log_now(wall_start + std::chrono::seconds(5)) ==
+           log_start + std::chrono::seconds(12));
+    assert(clock.wall_time(log_start + std::chrono::seconds(13)) == SystemClock::time_point::max());
+    clock.set_paused(false, wall_start + std::chrono::seconds(5));
+    assert(clock.log_now(wall_start + std::chrono::seconds(6)) ==
+           log_start + std::chrono::seconds(14));
+
+    // seek
+    clock.seek(log_start, wall_start + std::chrono::seconds(6));
+    assert(clock.log_now(wall_start + std::chrono::seconds(7)) ==
+           log_start + std::chrono::seconds(2));
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_clock();
+
+    write_log();
+    LogEntry::reset();
+
+    int new_groups = 0, new_types = 0;
+    LogEntry::new_group_hook[goby::middleware::MarshallingScheme::CSTR] =
+        [&](const goby::middleware::Group&) { ++new_groups; };
+    LogEntry::new_type_hook[goby::middleware::MarshallingScheme::CSTR] =
+        [&](const std::string&) { ++new_types; };
+
+    IndexedLogReader reader(log_file);
+    reader.build_index();
+    // only run once, when indexing
+    assert(new_groups == 2 && new_types == 2);
+
+    test_index_and_seek(reader);
+    test_replay(reader, 10);
+    test_replay(reader, 50);
+    test_window(reader);
+    assert(new_groups == 2 && new_types == 2);
+
+    std::cout << "all tests passed" << std::endl;
+}
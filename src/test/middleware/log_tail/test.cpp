@@ -0,0 +1,214 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "goby/middleware/log/log_tail.h"
+#include "goby/middleware/marshalling/interface.h"
+#include "goby/util/debug_logger.h"
+
+using goby::middleware::log::LogEntry;
+using goby::middleware::log::LogTailReader;
+using goby::middleware::log::LogTailWriter;
+
+constexpr goby::middleware::Group test_group("groups::tail");
+const std::string tail_name("goby_test_middleware_log_tail");
+
+goby::time::SystemClock::time_point start_time{goby::time::SystemClock::now()};
+
+LogEntry make_entry(int i)
+{
+    std::string payload = "entry" + std::to_string(i);
+    return LogEntry(std::vector<unsigned char>(payload.begin(), payload.end()),
+                    goby::middleware::MarshallingScheme::CSTR, "type" + std::to_string(i % 3),
+                    test_group, start_time + std::chrono::microseconds(i));
+}
+
+void check_entry(const LogEntry& entry, int i)
+{
+    auto expected = make_entry(i);
+    assert(entry.data() == expected.data());
+    assert(entry.scheme() == expected.scheme());
+    assert(entry.type() == expected.type());
+    assert(entry.group() == expected.group());
+    assert(entry.timestamp() == expected.timestamp());
+}
+
+// multiple readers get every entry, including across wraps of the ring
+void test_in_order()
+{
+    LogTailWriter writer(tail_name, 4096);
+    LogTailReader reader1(tail_name), reader2(tail_name);
+
+    LogEntry entry;
+    assert(!reader1.read(&entry));
+
+    const int n = 1000;
+    for (int i = 0; i < n; ++i)
+    {
+        writer.write(make_entry(i));
+        assert(reader1.read(&entry));
+        check_entry(entry, i);
+        assert(!reader1.read(&entry));
+
+        // reader2 lags behind by a few entries but doesn't overrun
+        if (i % 10 == 9)
+        {
+            for (int j = i - 9; j <= i; ++j)
+            {
+                assert(reader2.read(&entry));
+                check_entry(entry, j);
+            }
+        }
+    }
+
+    assert(reader1.entries_read() == n && reader1.overruns() == 0);
+    assert(reader2.entries_read() == n && reader2.overruns() == 0);
+    std::cout << "test_in_order passed" << std::endl;
+}
+
+// a reader that falls too far behind is resynchronized to the newest data
+void test_overrun()
+{
+    LogTailWriter writer(tail_name, 1024);
+    LogTailReader reader(tail_name);
+
+    for (int i = 0; i < 200; ++i) writer.write(make_entry(i));
+
+    LogEntry entry;
+    assert(!reader.read(&entry));
+    assert(reader.overruns() == 1);
+
+    writer.write(make_entry(200));
+    assert(reader.read(&entry));
+    check_entry(entry, 200);
+    std::cout << "test_overrun passed" << std::endl;
+}
+
+// concurrent reader thread sees a strictly increasing sequence
+void test_threaded()
+{
+    LogTailWriter writer(tail_name, 1 << 16);
+    LogTailReader reader(tail_name);
+
+    const int n = 100000;
+    std::atomic<bool> writer_done{false};
+    std::thread t(
+        [&]()
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                writer.write(make_entry(i));
+                if (i % 100 == 0)
+                    std::this_thread::yield();
+            }
+            writer_done = true;
+        });
+
+    int last = -1;
+    LogEntry entry;
+    while (last < n - 1)
+    {
+        bool done = writer_done;
+        if (!reader.read(&entry))
+        {
+            // if we were overrun at the very end, there's nothing left to read
+            if (done)
+                break;
+            std::this_thread::yield();
+        }
+        else
+        {
+            auto payload = std::string(entry.data().begin(), entry.data().end());
+            int i = std::stoi(payload.substr(5));
+            assert(i > last);
+            check_entry(entry, i);
+            last = i;
+        }
+    }
+    t.join();
+    assert(reader.entries_read() > 0);
+
+    std::cout << "test_threaded passed: read " << reader.entries_read() << "/" << n
+              << " entries with " << reader.overruns() << " overruns" << std::endl;
+}
+
+bool is_mapped(const std::string& shm_name)
+{
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line))
+    {
+        if (line.find("/dev/shm" + shm_name) != std::string::npos)
+            return true;
+    }
+    return false;
+}
+
+// a segment with an invalid header is rejected, and not left mapped
+void test_invalid()
+{
+    const std::string shm_name = "/" + tail_name + "_invalid";
+    int fd = shm_open(shm_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    assert(fd >= 0);
+    int truncated = ftruncate(fd, 4096);
+    assert(truncated == 0);
+    close(fd);
+
+    bool threw = false;
+    try
+    {
+        LogTailReader reader(shm_name);
+    }
+    catch (goby::middleware::log::LogException& e)
+    {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+        threw = true;
+    }
+    assert(threw);
+    assert(!is_mapped(shm_name));
+
+    shm_unlink(shm_name.c_str());
+    std::cout << "test_invalid passed" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::DEBUG1, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_in_order();
+    test_overrun();
+    test_threaded();
+    test_invalid();
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,213 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include "goby/middleware/transport/interthread.h"
+#include "goby/middleware/transport/message_pool.h"
+#include "goby/test/middleware/message_pool/test.pb.h"
+#include "goby/util/debug_logger.h"
+
+// tests MessagePool and InterThreadTransporter::publish_pooled and reports the heap allocation rate for a 1 kHz IMU-style publication
+
+using goby::test::middleware::protobuf::IMUData;
+
+// count heap allocations made by threads that opt in
+std::atomic<long> allocations(0);
+thread_local bool count_allocations = false;
+
+void* operator new(std::size_t size)
+{
+    if (count_allocations)
+        ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+constexpr goby::middleware::Group imu_group{"goby::test::imu"};
+
+const int rate_hz = 1000;
+const int nmessages = 1000;
+// allocations while the pool fills and the containers reach their steady state capacity are not counted
+const int warmup_messages = 100;
+
+const std::string frame_id("vehicle_imu_frame_ned_reference_0");
+
+std::atomic<int> received(0);
+std::atomic<bool> subscriber_ready(false);
+std::atomic<bool> quit(false);
+
+void fill_imu(IMUData& imu, int i)
+{
+    imu.set_time(i * 1.0e-3);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        imu.add_linear_acceleration(0.01 * axis + i * 1e-6);
+        imu.add_angular_velocity(0.02 * axis - i * 1e-6);
+    }
+    for (int j = 0; j < 9; ++j) imu.add_covariance(j == 0 || j == 4 || j == 8 ? 1e-3 : 0);
+    imu.set_frame_id(frame_id);
+}
+
+void subscriber()
+{
+    goby::middleware::InterThreadTransporter interthread;
+    int last = -1;
+    interthread.subscribe<imu_group>(
+        [&](const IMUData& imu)
+        {
+            int i = static_cast<int>(imu.time() * 1.0e3 + 0.5);
+            assert(i > last || i == 0);
+            assert(imu.angular_velocity_size() == 3);
+            assert(imu.frame_id() == frame_id);
+            last = i;
+            ++received;
+        });
+    subscriber_ready = true;
+    while (!quit) interthread.poll(std::chrono::milliseconds(10));
+}
+
+// publishes at 1 kHz and returns the publisher thread's allocations/second after warmup
+double run(bool pooled)
+{
+    goby::middleware::InterThreadTransporter interthread;
+    received = 0;
+
+    IMUData reusable;
+    auto next = std::chrono::steady_clock::now();
+    long warm_allocations = 0;
+    auto warm_start = next;
+
+    count_allocations = true;
+    for (int i = 0; i < nmessages; ++i)
+    {
+        if (i == warmup_messages)
+        {
+            warm_allocations = allocations;
+            warm_start = std::chrono::steady_clock::now();
+        }
+
+        if (pooled && (i % 2))
+        {
+            auto imu = interthread.acquire_pooled<IMUData>();
+            fill_imu(*imu, i);
+            interthread.publish<imu_group>(imu);
+        }
+        else if (pooled)
+        {
+            reusable.Clear();
+            fill_imu(reusable, i);
+            interthread.publish_pooled<imu_group>(reusable);
+        }
+        else
+        {
+            // typical usage prior to the pool: fill a message and publish it (copied into a new shared_ptr)
+            reusable.Clear();
+            fill_imu(reusable, i);
+            interthread.publish<imu_group>(reusable);
+        }
+
+        next += std::chrono::microseconds(1000000 / rate_hz);
+        std::this_thread::sleep_until(next);
+    }
+    count_allocations = false;
+
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - warm_start;
+    double rate = (allocations - warm_allocations) / dt.count();
+
+    while (received < nmessages) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::cout << (pooled ? "publish (pooled): " : "publish (const Data&): ") << rate
+              << " allocations/s at " << rate_hz << " Hz ("
+              << (allocations - warm_allocations) / double(nmessages - warmup_messages)
+              << " per message)" << std::endl;
+    return rate;
+}
+
+void test_pool()
+{
+    goby::middleware::MessagePool<IMUData> pool(2);
+    IMUData* first;
+    {
+        auto imu = pool.acquire();
+        first = imu.get();
+        fill_imu(*imu, 1);
+    }
+    auto allocations_after_first = pool.allocations();
+    // message + control block
+    assert(allocations_after_first == 2);
+
+    {
+        // recycled and cleared
+        auto imu = pool.acquire();
+        assert(imu.get() == first);
+        assert(!imu->has_time() && imu->angular_velocity_size() == 0);
+        assert(pool.allocations() == allocations_after_first);
+
+        // a second message while the first is in use is a new allocation
+        auto imu2 = pool.acquire();
+        assert(imu2.get() != first);
+    }
+
+    // messages may outlive the pool
+    std::shared_ptr<const IMUData> survivor;
+    {
+        goby::middleware::MessagePool<IMUData> short_lived_pool;
+        auto imu = short_lived_pool.acquire();
+        fill_imu(*imu, 2);
+        survivor = imu;
+    }
+    assert(survivor->frame_id() == frame_id);
+    survivor.reset();
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_pool();
+
+    std::thread sub_thread(subscriber);
+    while (!subscriber_ready) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    double unpooled_rate = run(false);
+    double pooled_rate = run(true);
+
+    quit = true;
+    sub_thread.join();
+
+    assert(unpooled_rate > rate_hz);
+    // steady state pooled publication should not allocate (except to grow the pool if the subscriber falls behind)
+    assert(pooled_rate < 0.05 * unpooled_rate);
+
+    std::cout << "all tests passed" << std::endl;
+}
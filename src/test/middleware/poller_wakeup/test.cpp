@@ -0,0 +1,513 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <poll.h>
+#include <thread>
+#include <vector>
+
+#include "goby/middleware/transport/interthread.h"
+#include "goby/middleware/transport/poller.h"
+#include "goby/middleware/transport/poller_wakeup.h"
+#include "goby/util/debug_logger.h"
+
+// tests PollerWakeup and the InterThreadTransporter poll loop, and compares the wakeup latency and publisher throughput against the previous handshake (publishers lock the subscriber's poller mutex before notifying a condition variable)
+
+using goby::middleware::InterThreadTransporter;
+using goby::middleware::PollerWakeup;
+using clock_type = std::chrono::steady_clock;
+
+constexpr goby::middleware::Group ping_group{"goby::test::poller_wakeup::ping"};
+constexpr goby::middleware::Group pong_group{"goby::test::poller_wakeup::pong"};
+constexpr goby::middleware::Group data_group{"goby::test::poller_wakeup::data"};
+constexpr goby::middleware::Group done_group{"goby::test::poller_wakeup::done"};
+
+const int nround_trips = 20000;
+const int npublishers = 4;
+const int npublications = 200000;
+
+bool readable(int fd)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+void test_wakeup()
+{
+    PollerWakeup wakeup;
+
+    // notify before waiting is not lost
+    auto seq = wakeup.sequence();
+    wakeup.notify();
+    assert(wakeup.sequence() != seq);
+    auto start = clock_type::now();
+    assert(wakeup.wait_until(seq, clock_type::now() + std::chrono::seconds(10)));
+    assert(clock_type::now() - start < std::chrono::milliseconds(100));
+    wakeup.wait(seq);
+    // nobody was waiting, so no system call was made
+    assert(wakeup.wake_count() == 0);
+    assert(!readable(wakeup.fd()));
+
+    // timeout
+    seq = wakeup.sequence();
+    start = clock_type::now();
+    assert(!wakeup.wait_until(seq, start + std::chrono::milliseconds(50)));
+    auto waited = clock_type::now() - start;
+    assert(waited >= std::chrono::milliseconds(50) && waited < std::chrono::milliseconds(500));
+    // already expired
+    assert(!wakeup.wait_until(seq, start));
+    assert(!wakeup.wait_until(seq, std::chrono::system_clock::now()));
+
+    // notify from another thread while waiting
+    seq = wakeup.sequence();
+    std::thread notifier(
+        [&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            wakeup.notify();
+        });
+    wakeup.wait(seq);
+    notifier.join();
+    assert(wakeup.wake_count() == 1);
+
+    // armed descriptor
+    wakeup.arm_fd();
+    wakeup.notify();
+    assert(readable(wakeup.fd()));
+    wakeup.notify();
+    // only signaled once until cleared
+    assert(wakeup.wake_count() == 2);
+    wakeup.clear_fd();
+    assert(!readable(wakeup.fd()));
+    wakeup.notify();
+    assert(readable(wakeup.fd()));
+    wakeup.clear_fd();
+    wakeup.disarm_fd();
+    wakeup.notify();
+    assert(!readable(wakeup.fd()));
+
+    std::cout << "wakeup: passed" << std::endl;
+}
+
+// many threads notifying a waiter that waits without a timeout: a lost wakeup leaves the waiter blocked (detected by the watchdog below)
+void test_stress()
+{
+    const int nnotifiers = 8;
+    const int nnotifies = 20000;
+    const int nrounds = 20;
+    const auto watchdog_timeout = std::chrono::seconds(30);
+
+    for (int round = 0; round < nrounds; ++round)
+    {
+        PollerWakeup wakeup;
+        std::atomic<int> published{0};
+        std::atomic<bool> done{false};
+        int waits = 0;
+
+        std::thread waiter(
+            [&]()
+            {
+                int seen = 0;
+                for (;;)
+                {
+                    auto seq = wakeup.sequence();
+                    int p = published.load();
+                    if (p == nnotifiers * nnotifies)
+                        break;
+                    if (p != seen)
+                    {
+                        seen = p;
+                        continue;
+                    }
+                    wakeup.wait(seq);
+                    ++waits;
+                }
+                done = true;
+            });
+
+        std::vector<std::thread> notifiers;
+        for (int n = 0; n < nnotifiers; ++n)
+        {
+            notifiers.emplace_back(
+                [&]()
+                {
+                    for (int i = 0; i < nnotifies; ++i)
+                    {
+                        ++published;
+                        wakeup.notify();
+                        if (i % 64 == 0)
+                            std::this_thread::yield();
+                    }
+                });
+        }
+        for (auto& notifier : notifiers) notifier.join();
+
+        auto deadline = clock_type::now() + watchdog_timeout;
+        while (!done)
+        {
+            if (clock_type::now() > deadline)
+                goby::glog.is_die() && goby::glog << "stress: waiter blocked (lost wakeup) in round "
+                                                  << round << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        waiter.join();
+
+        if (round == nrounds - 1)
+            std::cout << "stress: " << nrounds << " rounds of " << nnotifiers << "x" << nnotifies
+                      << " notifications, last round: " << waits << " waits, "
+                      << wakeup.wake_count() << " system calls" << std::endl;
+    }
+
+    std::cout << "stress: passed" << std::endl;
+}
+
+double median(std::vector<double>& v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+double p99(std::vector<double>& v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() * 99 / 100];
+}
+
+// ping-pong between two threads with InterThreadTransporter (blocking poll()): checks that no wakeup is lost (which would hang) and measures the round trip time
+void test_interthread_latency()
+{
+    std::atomic<bool> ready{false};
+    std::thread ponger(
+        [&]()
+        {
+            InterThreadTransporter interthread;
+            int pings = 0;
+            interthread.subscribe<ping_group, int>(
+                [&](const int& i)
+                {
+                    ++pings;
+                    interthread.publish<pong_group>(i);
+                });
+            ready = true;
+            while (pings < nround_trips) interthread.poll();
+        });
+
+    InterThreadTransporter interthread;
+    int last_pong = -1;
+    interthread.subscribe<pong_group, int>([&](const int& i) { last_pong = i; });
+    while (!ready) std::this_thread::yield();
+
+    std::vector<double> round_trip_us;
+    round_trip_us.reserve(nround_trips);
+    for (int i = 0; i < nround_trips; ++i)
+    {
+        auto start = clock_type::now();
+        interthread.publish<ping_group>(i);
+        while (last_pong != i) interthread.poll();
+        round_trip_us.push_back(
+            std::chrono::duration<double, std::micro>(clock_type::now() - start).count());
+    }
+    ponger.join();
+
+    std::cout << "interthread ping-pong (" << nround_trips
+              << " round trips): median: " << median(round_trip_us)
+              << " us, p99: " << p99(round_trip_us) << " us" << std::endl;
+}
+
+// many publishers to one subscriber with InterThreadTransporter
+void test_interthread_throughput()
+{
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> publishers;
+    for (int p = 0; p < npublishers; ++p)
+    {
+        publishers.emplace_back(
+            [&]()
+            {
+                InterThreadTransporter interthread;
+                ++ready;
+                while (!go) std::this_thread::yield();
+                auto data = std::make_shared<const int>(1);
+                for (int i = 0; i < npublications / npublishers; ++i)
+                    interthread.publish<data_group>(data);
+                interthread.publish<done_group>(0);
+            });
+    }
+
+    InterThreadTransporter interthread;
+    int received = 0, done = 0;
+    interthread.subscribe<data_group, int>([&](std::shared_ptr<const int> i) { received += *i; });
+    interthread.subscribe<done_group, int>([&](const int&) { ++done; });
+    while (ready < npublishers) std::this_thread::yield();
+
+    auto start = clock_type::now();
+    go = true;
+    while (done < npublishers) interthread.poll();
+    std::chrono::duration<double> dt = clock_type::now() - start;
+    for (auto& t : publishers) t.join();
+    assert(received == npublications);
+    std::cout << "interthread throughput (" << npublishers
+              << " publishers): " << npublications / dt.count() << " publications/s, "
+              << interthread.wakeup()->wake_count() << " wake calls" << std::endl;
+}
+
+// the previous handshake, for comparison
+struct MutexCVWakeup
+{
+    std::timed_mutex poll_mutex;
+    std::condition_variable_any cv;
+
+    void notify()
+    {
+        {
+            std::lock_guard<std::timed_mutex> l(poll_mutex);
+        }
+        cv.notify_all();
+    }
+};
+
+// minimal poll loop around a queue, with the subscriber waiting using either mechanism
+template <typename Wakeup> struct QueueBenchmark
+{
+    Wakeup wakeup;
+    std::mutex data_mutex;
+    std::deque<int> data;
+    std::atomic<int> done{0};
+
+    void publish(int i)
+    {
+        {
+            std::lock_guard<std::mutex> l(data_mutex);
+            data.push_back(i);
+        }
+        wakeup.notify();
+    }
+
+    int take()
+    {
+        std::lock_guard<std::mutex> l(data_mutex);
+        int n = data.size();
+        data.clear();
+        return n;
+    }
+
+    // returns publications/s
+    double run(std::vector<double>* latency_us);
+    int poll();
+};
+
+template <> int QueueBenchmark<MutexCVWakeup>::poll()
+{
+    std::unique_lock<std::timed_mutex> lock(wakeup.poll_mutex);
+    int n = take();
+    while (n == 0 && done < npublishers)
+    {
+        wakeup.cv.wait(lock);
+        n = take();
+    }
+    return n;
+}
+
+template <> int QueueBenchmark<PollerWakeup>::poll()
+{
+    for (;;)
+    {
+        auto seq = wakeup.sequence();
+        int n = take();
+        if (n > 0 || done == npublishers)
+            return n;
+        wakeup.wait(seq);
+    }
+}
+
+template <typename Wakeup> double QueueBenchmark<Wakeup>::run(std::vector<double>* latency_us)
+{
+    std::atomic<bool> go{false};
+    std::vector<std::thread> publishers;
+    for (int p = 0; p < npublishers; ++p)
+    {
+        publishers.emplace_back(
+            [&]()
+            {
+                while (!go) std::this_thread::yield();
+                for (int i = 0; i < npublications / npublishers; ++i) publish(i);
+                ++done;
+                wakeup.notify();
+            });
+    }
+
+    auto start = clock_type::now();
+    go = true;
+    int received = 0;
+    while (done < npublishers || received < npublications) received += poll();
+    std::chrono::duration<double> dt = clock_type::now() - start;
+    for (auto& t : publishers) t.join();
+    assert(received == npublications);
+
+    // wakeup latency: time from publish() in another thread to the return of poll()
+    std::atomic<bool> quit{false};
+    std::atomic<long long> publish_time_ns{0};
+    std::thread publisher(
+        [&]()
+        {
+            for (int i = 0; i < nround_trips / 10; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                publish_time_ns = clock_type::now().time_since_epoch().count();
+                publish(i);
+            }
+            quit = true;
+            done = npublishers;
+            wakeup.notify();
+        });
+    done = 0;
+    while (!quit)
+    {
+        if (poll() > 0)
+            latency_us->push_back(
+                (clock_type::now().time_since_epoch().count() - publish_time_ns) / 1e3);
+    }
+    publisher.join();
+
+    return npublications / dt.count();
+}
+
+void test_compare_handshake()
+{
+    std::vector<double> latency_old, latency_new;
+    double rate_old = QueueBenchmark<MutexCVWakeup>().run(&latency_old);
+    double rate_new = QueueBenchmark<PollerWakeup>().run(&latency_new);
+
+    std::cout << "publisher throughput (" << npublishers
+              << " publishers): mutex + condition_variable: " << rate_old
+              << " publications/s, PollerWakeup: " << rate_new << " publications/s ("
+              << rate_new / rate_old << "x)" << std::endl;
+    std::cout << "wakeup latency: mutex + condition_variable: median: " << median(latency_old)
+              << " us, p99: " << p99(latency_old) << " us; PollerWakeup: median: "
+              << median(latency_new) << " us, p99: " << p99(latency_new) << " us" << std::endl;
+}
+
+// the deprecated interfaces kept for code written against the previous poller handshake
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+// a transporter that still overrides the previous _poll(lock)
+class LegacyTransporter : public goby::middleware::Poller<LegacyTransporter>
+{
+  public:
+    LegacyTransporter(InterThreadTransporter& inner)
+        : goby::middleware::Poller<LegacyTransporter>(&inner)
+    {
+    }
+
+    std::atomic<int> pending{0};
+
+  private:
+    friend goby::middleware::Poller<LegacyTransporter>;
+    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    {
+        assert(lock && lock->owns_lock());
+        int items = pending.exchange(0);
+        // as the previous transporters did before calling the subscribers
+        if (items)
+            lock.reset();
+        return items;
+    }
+};
+
+void test_legacy_interface()
+{
+    InterThreadTransporter interthread;
+    LegacyTransporter legacy(interthread);
+
+    // _poll(lock) is still called, and notifications through cv() still wake the poller
+    std::thread notifier([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        legacy.pending = 2;
+        std::lock_guard<std::timed_mutex> lock(*legacy.poll_mutex());
+        legacy.cv()->notify_all();
+    });
+    assert(legacy.poll(std::chrono::seconds(10)) == 2);
+    notifier.join();
+    assert(legacy.poll(std::chrono::milliseconds(10)) == 0);
+
+    // wait(lock, ...) on cv() from other threads returns after the next notification (as IOThread's notify thread used to)
+    std::mutex mutex;
+    bool ready = false;
+    const int nwaiters = 3;
+    std::atomic<int> woken{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < nwaiters; ++i)
+    {
+        waiters.emplace_back([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            interthread.cv()->wait(lock, [&]() { return ready; });
+            assert(lock.owns_lock());
+            ++woken;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready = true;
+    }
+    interthread.cv()->notify_all();
+    for (auto& waiter : waiters) waiter.join();
+    assert(woken == nwaiters);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto start = clock_type::now();
+    assert(interthread.cv()->wait_for(lock, std::chrono::milliseconds(20)) ==
+           std::cv_status::timeout);
+    assert(clock_type::now() - start >= std::chrono::milliseconds(20));
+    assert(!interthread.cv()->wait_for(lock, std::chrono::milliseconds(1), []() { return false; }));
+    assert(lock.owns_lock());
+
+    std::cout << "legacy _poll(lock) and cv() interfaces: passed" << std::endl;
+}
+
+#pragma GCC diagnostic pop
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    test_wakeup();
+    test_stress();
+    test_interthread_latency();
+    test_interthread_throughput();
+    test_compare_handshake();
+    test_legacy_interface();
+
+    std::cout << "all tests passed" << std::endl;
+}
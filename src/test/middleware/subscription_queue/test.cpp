@@ -0,0 +1,205 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+
+// tests the bounded subscription queues (TransporterConfig::SubscriptionQueue) of the InterThreadTransporter, and compares the publisher cost and queued data of a stalled subscriber with an unbounded vs. bounded queue
+
+using goby::middleware::InterThreadTransporter;
+using goby::middleware::Subscriber;
+using goby::middleware::protobuf::ThreadHealth;
+using goby::middleware::protobuf::TransporterConfig;
+using QueueConfig = TransporterConfig::SubscriptionQueue;
+
+constexpr goby::middleware::Group data_group{"goby::test::subscription_queue::data"};
+constexpr goby::middleware::Group other_group{"goby::test::subscription_queue::other"};
+
+const int npublications = 100;
+const int nbenchmark = 1000000;
+
+// publishes 0..n-1 to group from another thread (and waits for it to finish) while this thread isn't polling
+template <const goby::middleware::Group& group> void publish_from_other_thread(int n)
+{
+    std::thread publisher(
+        [n]()
+        {
+            InterThreadTransporter interthread;
+            for (int i = 0; i < n; ++i) interthread.publish<group>(i);
+        });
+    publisher.join();
+}
+
+Subscriber<int> subscriber(int max_depth, QueueConfig::OverflowPolicy overflow)
+{
+    TransporterConfig cfg;
+    cfg.mutable_queue()->set_max_depth(max_depth);
+    cfg.mutable_queue()->set_overflow(overflow);
+    return Subscriber<int>(cfg);
+}
+
+ThreadHealth queue_health()
+{
+    ThreadHealth health;
+    goby::middleware::detail::SubscriptionStoreBase::queue_health(std::this_thread::get_id(),
+                                                                  health);
+    return health;
+}
+
+void test_policy(int max_depth, QueueConfig::OverflowPolicy overflow,
+                 const std::vector<int>& expected)
+{
+    InterThreadTransporter interthread;
+    std::vector<int> received;
+    interthread.subscribe<data_group, int>([&](const int& i) { received.push_back(i); },
+                                           subscriber(max_depth, overflow));
+
+    publish_from_other_thread<data_group>(npublications);
+
+    auto health = queue_health();
+    assert(health.subscription_queue_size() == 1);
+    const auto& queue = health.subscription_queue(0);
+    assert(queue.group() == std::string(data_group));
+    assert(queue.type() == "int");
+    assert(queue.overflow() == overflow);
+    assert(queue.depth() == expected.size());
+    assert(queue.dropped() == npublications - expected.size());
+
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    assert(received == expected);
+
+    // emptied by poll, but the drops are still counted
+    health = queue_health();
+    assert(health.subscription_queue(0).depth() == 0);
+    assert(health.subscription_queue(0).dropped() == npublications - expected.size());
+
+    std::cout << QueueConfig::OverflowPolicy_Name(overflow) << ": passed" << std::endl;
+}
+
+void test_policies()
+{
+    std::vector<int> all, oldest, newest;
+    for (int i = 0; i < npublications; ++i) all.push_back(i);
+    for (int i = 0; i < 10; ++i)
+    {
+        oldest.push_back(i);
+        newest.push_back(npublications - 10 + i);
+    }
+
+    // unbounded: not reported in the health
+    {
+        InterThreadTransporter interthread;
+        std::vector<int> received;
+        interthread.subscribe<data_group, int>([&](const int& i) { received.push_back(i); });
+        publish_from_other_thread<data_group>(npublications);
+        assert(queue_health().subscription_queue_size() == 0);
+        while (interthread.poll(std::chrono::seconds(0))) {}
+        assert(received == all);
+        std::cout << "unbounded: passed" << std::endl;
+    }
+
+    test_policy(10, QueueConfig::DROP_OLDEST, newest);
+    test_policy(10, QueueConfig::DROP_NEWEST, oldest);
+    // max_depth is ignored for KEEP_LATEST
+    test_policy(10, QueueConfig::KEEP_LATEST, {npublications - 1});
+    test_policy(0, QueueConfig::KEEP_LATEST, {npublications - 1});
+}
+
+void test_independent_subscriptions()
+{
+    // each subscription has its own queue, even for the same group in the same thread
+    InterThreadTransporter interthread;
+    std::vector<int> all, latest, other;
+    interthread.subscribe<data_group, int>([&](const int& i) { all.push_back(i); });
+    interthread.subscribe<data_group, int>([&](const int& i) { latest.push_back(i); },
+                                           subscriber(0, QueueConfig::KEEP_LATEST));
+    interthread.subscribe<other_group, int>([&](const int& i) { other.push_back(i); },
+                                            subscriber(5, QueueConfig::DROP_NEWEST));
+
+    publish_from_other_thread<data_group>(npublications);
+    publish_from_other_thread<other_group>(npublications);
+    assert(queue_health().subscription_queue_size() == 2);
+
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    assert(all.size() == npublications);
+    assert(latest == std::vector<int>({npublications - 1}));
+    assert(other == std::vector<int>({0, 1, 2, 3, 4}));
+
+    // unsubscribe removes the queue
+    interthread.unsubscribe<other_group, int>();
+    publish_from_other_thread<other_group>(npublications);
+    assert(queue_health().subscription_queue_size() == 1);
+    assert(interthread.poll(std::chrono::seconds(0)) == 0);
+
+    std::cout << "independent subscriptions: passed" << std::endl;
+}
+
+// publishes to a subscriber that doesn't poll until the publisher is done (as for a stalled logging thread)
+void benchmark_stalled(const std::string& name, const Subscriber<int>& sub)
+{
+    InterThreadTransporter interthread;
+    int received = 0;
+    interthread.subscribe<data_group, int>([&](const int&) { ++received; }, sub);
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread publisher(
+        []()
+        {
+            InterThreadTransporter interthread;
+            auto data = std::make_shared<const int>(1);
+            for (int i = 0; i < nbenchmark; ++i) interthread.publish<data_group>(data);
+        });
+    publisher.join();
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+
+    auto poll_start = std::chrono::steady_clock::now();
+    while (interthread.poll(std::chrono::seconds(0))) {}
+    std::chrono::duration<double> poll_dt = std::chrono::steady_clock::now() - poll_start;
+
+    std::cout << name << ": " << nbenchmark / dt.count() << " publications/s, " << received
+              << " queued (~" << received * sizeof(std::shared_ptr<const int>) / 1024
+              << " kB of queue), " << poll_dt.count() * 1e3 << " ms to poll" << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    test_policies();
+    test_independent_subscriptions();
+
+    benchmark_stalled("stalled subscriber, unbounded", Subscriber<int>());
+    benchmark_stalled("stalled subscriber, DROP_OLDEST max_depth 1000",
+                      subscriber(1000, QueueConfig::DROP_OLDEST));
+    benchmark_stalled("stalled subscriber, KEEP_LATEST", subscriber(0, QueueConfig::KEEP_LATEST));
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,314 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <dirent.h>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "goby/middleware/application/multi_thread.h"
+#include "goby/middleware/application/timer_service.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+
+// tests the TimerService and compares the expiry jitter and CPU use of 100 timers run by the TimerService vs. one TimerThread each
+
+using goby::middleware::TimerService;
+using namespace boost::units::si;
+
+constexpr goby::middleware::Group periodic_group{"goby::test::timer_service::periodic"};
+constexpr goby::middleware::Group one_shot_group{"goby::test::timer_service::one_shot"};
+
+const int ntimers = 100;
+const double timer_hertz = 10;
+const std::chrono::seconds benchmark_duration(5);
+
+using clock_type = std::chrono::steady_clock;
+
+int count_threads()
+{
+    int n = 0;
+    DIR* dir = opendir("/proc/self/task");
+    assert(dir);
+    while (dirent* entry = readdir(dir))
+    {
+        if (entry->d_name[0] != '.')
+            ++n;
+    }
+    closedir(dir);
+    return n;
+}
+
+// polls the transporter for the given duration
+void poll_for(goby::middleware::InterThreadTransporter& interthread,
+              std::chrono::steady_clock::duration duration)
+{
+    auto end = clock_type::now() + duration;
+    while (clock_type::now() < end) interthread.poll(end);
+}
+
+void test_callbacks(const std::shared_ptr<TimerService>& timers)
+{
+    // periodic
+    std::atomic<int> periodic_count{0};
+    auto id = timers->add_periodic(100 * hertz, [&]() { ++periodic_count; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(505));
+    assert(timers->cancel(id));
+    int count_at_cancel = periodic_count;
+    std::cout << "periodic: " << count_at_cancel << " expirations in 0.5 s at 100 Hz" << std::endl;
+    assert(count_at_cancel >= 40 && count_at_cancel <= 51);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // an expiration already being dispatched when cancel() was called may still run
+    assert(periodic_count <= count_at_cancel + 1);
+    assert(!timers->cancel(id));
+
+    // one-shot
+    std::atomic<int> one_shot_count{0};
+    auto start = clock_type::now();
+    std::atomic<long long> one_shot_delay_us{0};
+    timers->add_one_shot(0.1 * seconds,
+                         [&]()
+                         {
+                             ++one_shot_count;
+                             one_shot_delay_us =
+                                 std::chrono::duration_cast<std::chrono::microseconds>(
+                                     clock_type::now() - start)
+                                     .count();
+                         });
+    // cancelled before it expires
+    auto cancelled_id = timers->add_one_shot(0.05 * seconds, [&]() { assert(false); });
+    assert(timers->cancel(cancelled_id));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    assert(one_shot_count == 1);
+    assert(one_shot_delay_us >= 100000 && one_shot_delay_us < 200000);
+    assert(timers->size() == 0);
+
+    // callbacks may cancel themselves, and exceptions do not stop the service
+    std::atomic<int> self_cancel_count{0};
+    std::atomic<TimerService::TimerId> self_id{0};
+    self_id = timers->add_periodic(200 * hertz,
+                                   [&]()
+                                   {
+                                       while (self_id == 0) {}
+                                       if (++self_cancel_count == 3)
+                                           timers->cancel(self_id);
+                                       throw(std::runtime_error("expected exception"));
+                                   });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(self_cancel_count == 3);
+
+    // invalid frequency
+    bool caught = false;
+    try
+    {
+        timers->add_periodic(0 * hertz, []() {});
+    }
+    catch (const goby::Exception&)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "callbacks: passed" << std::endl;
+}
+
+void test_publications(const std::shared_ptr<TimerService>& timers)
+{
+    goby::middleware::InterThreadTransporter interthread;
+    int periodic_count = 0, one_shot_count = 0;
+    interthread.subscribe_empty<periodic_group>([&]() { ++periodic_count; });
+    interthread.subscribe_empty<one_shot_group>([&]() { ++one_shot_count; });
+
+    auto id = timers->add_periodic_publication<periodic_group>(50 * hertz);
+    timers->add_one_shot_publication<one_shot_group>(0.1 * seconds);
+    poll_for(interthread, std::chrono::milliseconds(500));
+    timers->cancel(id);
+    std::cout << "publications: " << periodic_count << " periodic in 0.5 s at 50 Hz" << std::endl;
+    assert(periodic_count >= 20 && periodic_count <= 26);
+    assert(one_shot_count == 1);
+
+    // warp factor
+    goby::time::SimulatorSettings::warp_factor = 10;
+    periodic_count = 0;
+    id = timers->add_periodic_publication<periodic_group>(10 * hertz);
+    goby::time::SimulatorSettings::warp_factor = 1;
+    poll_for(interthread, std::chrono::milliseconds(500));
+    timers->cancel(id);
+    std::cout << "publications: " << periodic_count << " in 0.5 s at 10 Hz, warp 10" << std::endl;
+    assert(periodic_count >= 40 && periodic_count <= 51);
+
+    std::cout << "publications: passed" << std::endl;
+}
+
+struct JitterStats
+{
+    std::vector<int> counts = std::vector<int>(ntimers, 0);
+    std::vector<double> lateness_us;
+    clock_type::duration interval{std::chrono::nanoseconds(
+        (unsigned long long)(1000000000ull / timer_hertz))};
+
+    void record(int i)
+    {
+        ++counts[i];
+        // both mechanisms expire on multiples of the interval
+        auto since_epoch = clock_type::now().time_since_epoch();
+        lateness_us.push_back(
+            std::chrono::duration<double, std::micro>(since_epoch % interval).count());
+    }
+};
+
+template <std::size_t... I>
+void subscribe_all(goby::middleware::InterThreadTransporter& interthread, JitterStats& stats,
+                   std::index_sequence<I...>)
+{
+    int dummy[] = {(interthread.subscribe_empty<
+                        goby::middleware::TimerThread<static_cast<int>(I)>::expire_group>(
+                        [&stats]() { stats.record(I); }),
+                    0)...};
+    (void)dummy;
+}
+
+template <int i>
+void launch_timer_thread(std::vector<std::thread>& threads, std::atomic<bool>& alive)
+{
+    threads.emplace_back(
+        [&alive]()
+        {
+            // constructed in the thread, as in MultiThreadApplicationBase::launch_thread
+            goby::middleware::TimerThread<i> timer(timer_hertz * hertz);
+            timer.run(alive);
+        });
+}
+
+template <std::size_t... I>
+void launch_timer_threads(std::vector<std::thread>& threads, std::atomic<bool>& alive,
+                          std::index_sequence<I...>)
+{
+    int dummy[] = {(launch_timer_thread<static_cast<int>(I)>(threads, alive), 0)...};
+    (void)dummy;
+}
+
+template <std::size_t... I>
+void add_publications(TimerService& timers, std::vector<TimerService::TimerId>& ids,
+                      std::index_sequence<I...>)
+{
+    int dummy[] = {(ids.push_back(timers.add_periodic_publication<
+                                  goby::middleware::TimerThread<static_cast<int>(I)>::expire_group>(
+                        timer_hertz * hertz)),
+                    0)...};
+    (void)dummy;
+}
+
+void report(const std::string& name, JitterStats& stats, double cpu_seconds, int threads)
+{
+    std::sort(stats.lateness_us.begin(), stats.lateness_us.end());
+    double mean = 0;
+    for (double l : stats.lateness_us) mean += l;
+    mean /= stats.lateness_us.size();
+    double p99 = stats.lateness_us[stats.lateness_us.size() * 99 / 100];
+
+    std::cout << name << ": " << threads << " threads, " << stats.lateness_us.size()
+              << " expirations, lateness mean: " << mean << " us, p99: " << p99
+              << " us, max: " << stats.lateness_us.back() << " us, CPU: " << cpu_seconds << " s"
+              << std::endl;
+
+    double expected = timer_hertz * std::chrono::duration<double>(benchmark_duration).count();
+    for (int count : stats.counts) assert(count >= expected * 0.8 && count <= expected * 1.1);
+}
+
+void benchmark()
+{
+    goby::middleware::InterThreadTransporter interthread;
+    JitterStats stats;
+    subscribe_all(interthread, stats, std::make_index_sequence<ntimers>());
+
+    int base_threads = count_threads();
+
+    // one TimerThread per timer
+    {
+        std::atomic<bool> alive{true};
+        std::vector<std::thread> threads;
+        launch_timer_threads(threads, alive, std::make_index_sequence<ntimers>());
+        // let the threads start up
+        poll_for(interthread, std::chrono::milliseconds(500));
+        stats = JitterStats();
+        int threads_running = count_threads() - base_threads;
+
+        std::clock_t cpu_start = std::clock();
+        poll_for(interthread, benchmark_duration);
+        double cpu_seconds = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        alive = false;
+        for (auto& thread : threads) thread.join();
+        // discard remaining publications
+        poll_for(interthread, std::chrono::milliseconds(200));
+
+        report("TimerThread", stats, cpu_seconds, threads_running);
+    }
+
+    // TimerService
+    {
+        // service thread for this test (released at the end of the scope)
+        auto timers = TimerService::acquire();
+        std::vector<TimerService::TimerId> ids;
+        add_publications(*timers, ids, std::make_index_sequence<ntimers>());
+        poll_for(interthread, std::chrono::milliseconds(500));
+        stats = JitterStats();
+        int threads_running = count_threads() - base_threads;
+
+        std::clock_t cpu_start = std::clock();
+        poll_for(interthread, benchmark_duration);
+        double cpu_seconds = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        for (auto id : ids) assert(timers->cancel(id));
+        poll_for(interthread, std::chrono::milliseconds(200));
+
+        report("TimerService", stats, cpu_seconds, threads_running);
+        // reported rather than checked, as it depends on the load of the test machine
+        std::cout << "TimerService overruns: " << timers->overrun_count() << std::endl;
+    }
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    {
+        auto timers = TimerService::acquire();
+        assert(TimerService::acquire() == timers);
+        test_callbacks(timers);
+        test_publications(timers);
+    }
+
+    benchmark();
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,323 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "goby/moos/moos_translator.h"
+#include "goby/test/moos/translator_format/translator_format.pb.h"
+#include "goby/util/debug_logger.h"
+
+// tests the TECHNIQUE_FORMAT serializer and parser (compiled once per format), and compares the cost of MOOSTranslator::protobuf_to_moos() and moos_to_protobuf(), which keep the compiled formats, vs. compiling the format for every message (as the static MOOSTranslation<TECHNIQUE_FORMAT>::serialize() and parse() do)
+
+using goby::moos::MOOSTranslator;
+using goby::moos::protobuf::TranslatorEntry;
+using goby::test::moos::protobuf::FormatTest;
+using FormatTranslation = goby::moos::MOOSTranslation<TranslatorEntry::TECHNIQUE_FORMAT>;
+using clock_type = std::chrono::steady_clock;
+
+const int nbenchmark = 20000;
+
+void populate(FormatTest* msg)
+{
+    msg->set_name("auv-23");
+    msg->set_x(1234.5678912345);
+    msg->set_y(-0.333333f);
+    msg->set_depth(-12);
+    msg->set_time(1700000000123ull);
+    msg->set_ok(true);
+    msg->set_mode(goby::test::moos::protobuf::MODE_SURVEY);
+    for (int range : {100, -2, 3000}) msg->add_ranges(range);
+    for (double bearing : {0.1, 1e-7, 359.99999}) msg->add_bearings(bearing);
+    msg->mutable_embedded()->set_val(3.25);
+    msg->mutable_embedded()->add_i(7);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto* history = msg->add_history();
+        history->set_val(i * 1.5);
+        history->add_i(i);
+        history->add_i(10 * i);
+    }
+    msg->set_raw(std::string("\x01\xff\x7f", 3));
+    msg->add_tags("alpha");
+    msg->add_tags("beta");
+}
+
+void test_serialize()
+{
+    FormatTest msg;
+    populate(&msg);
+
+    // expected output is that of the previous implementation (which reparsed the format for every message)
+    const std::vector<std::pair<std::string, std::string>> formats = {
+        {"NAME=%1%,X=%2%,Y=%3%,DEPTH=%4%,TIME=%5%,OK=%6%,MODE=%7%",
+         "NAME=auv-23,X=1234.5678912345,Y=-0.333333,DEPTH=-12,TIME=1700000000123,OK=true,MODE="
+         "MODE_SURVEY"},
+        // repeated fields, with indices out of range giving the maximum value or NaN
+        {"RANGES={%8%},R0=%8.0%,R2=%8.2%,R5=%8.5%,BEARINGS=%9%,B1=%9.1%,B7=%9.7%",
+         "RANGES={100,-2,3000},R0=100,R2=3000,R5=2147483647,BEARINGS=0.1,1e-07,359.99999,B1=1e-07,"
+         "B7=nan"},
+        // embedded messages
+        {"EV=%10:1%,EI=%10:2%,H1V=%11.1:1%,H0I1=%11.0:2.1%,H2I=%11.2:2%",
+         "EV=3.25,EI=7,H1V=1.5,H0I1=0,H2I=2,20"},
+        {"RAW=%12%,TAGS=%13%,T1=%13.1%,T9=%13.9%,EMB=%10%",
+         "RAW=01ff7f,TAGS=alpha,beta,T1=beta,T9=,EMB=090000000000000a401007"},
+        // past the last field (and no algorithms)
+        {"100%%,U=%15%,NONE=%99%", "100%,U=,NONE="},
+        {"%1%%4%%%%7%", "auv-23-12%MODE_SURVEY"},
+        {"%1%:%1%:%10:1%:%10:1%:%8.1%:%8.1%", "auv-23:auv-23:3.25:3.25:-2:-2"},
+        {"no directives", "no directives"},
+        {"", ""},
+        // other boost::format directives
+        {"%1$s|%2$.2f|%4$05d|%3$s", "auv-23|1234.567891234499939|-0012|-0.333333"},
+        {"%1$s %2%", "auv-23 1234.5678912345"}};
+
+    for (const auto& format : formats)
+    {
+        std::string out;
+        FormatTranslation::serialize(&out, msg, FormatTranslation::SerializerAlgorithms(),
+                                     format.first, ",");
+        assert(out == format.second);
+
+        // compiled once, used many times
+        FormatTranslation::Serializer serializer(format.first, msg.GetDescriptor(),
+                                                 FormatTranslation::SerializerAlgorithms());
+        for (int i = 0; i < 3; ++i)
+        {
+            out.clear();
+            serializer.serialize(&out, msg, ",");
+            assert(out == format.second);
+        }
+    }
+
+    std::string out;
+    FormatTranslation::serialize(&out, msg, FormatTranslation::SerializerAlgorithms(),
+                                 "%7%;%8%", ";", true);
+    assert(out == "SURVEY;100;-2;3000");
+
+    // malformed formats
+    for (const std::string& format : {"%", "%1", "trailing %4%%", "%3.1:1%", "%11:1%"})
+    {
+        bool threw = false;
+        try
+        {
+            FormatTranslation::serialize(&out, msg, FormatTranslation::SerializerAlgorithms(),
+                                         format, ",");
+        }
+        catch (std::exception&)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "serialize: passed" << std::endl;
+}
+
+void test_parse()
+{
+    const std::vector<std::vector<std::string>> parses = {
+        {"NAME=%1%,X=%2%,Y=%3%,DEPTH=%4%,TIME=%5%,OK=%6%,MODE=%7%",
+         "name=Abc,x=1,y=2,depth=3,time=4,ok=false,mode=MODE_SURVEY",
+         "name: \"Abc\" x: 1 y: 2 depth: 3 time: 4 ok: false mode: MODE_SURVEY"},
+        {"RANGES={%8%},R5=%8.5%", "ranges={1,2,3},r5=7",
+         "ranges: 1 ranges: 2 ranges: 3 ranges: 0 ranges: 0 ranges: 7"},
+        {"EV=%10:1%,H2V=%11.2:1%,H1I=%11.1:2%", "EV=3.5,H2V=-1,H1I=4,5,6",
+         "embedded { val: 3.5 } history { } history { i: 4 i: 5 i: 6 } history { val: -1 }"},
+        // separator not found
+        {"A=%1%,B=%4%", "A=x", "name: \"x\" depth: 2147483647"},
+        {"%1%", "whole string, with commas", "name: \"whole string, with commas\""},
+        {"X%2%Y%4%", "X1.5Y2", "x: 1.5 depth: 2"}};
+
+    for (const auto& parse : parses)
+    {
+        FormatTest msg;
+        FormatTranslation::parse(parse[1], &msg, parse[0], ",");
+        assert(msg.ShortDebugString() == parse[2]);
+
+        FormatTranslation::Parser parser(parse[0], FormatTest::descriptor());
+        for (int i = 0; i < 3; ++i)
+        {
+            msg.Clear();
+            parser.parse(parse[1], &msg, ",");
+            assert(msg.ShortDebugString() == parse[2]);
+        }
+    }
+
+    FormatTest msg;
+    FormatTranslation::parse("TAGS={a,b,c};MODE=idle", &msg, "TAGS={%13%};MODE=%7%", ",",
+                             FormatTranslation::ParserAlgorithms(), true);
+    assert(msg.ShortDebugString() == "mode: MODE_IDLE tags: \"a\" tags: \"b\" tags: \"c\"");
+
+    for (const std::string& format : {"%x%", "%99%", "%3:1%", "%11:1%", "%1"})
+    {
+        bool threw = false;
+        try
+        {
+            FormatTranslation::parse("a", &msg, format, ",");
+        }
+        catch (std::exception&)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "parse: passed" << std::endl;
+}
+
+TranslatorEntry make_entry(const std::string& publish_format)
+{
+    TranslatorEntry entry;
+    entry.set_protobuf_name("goby.test.moos.protobuf.FormatTest");
+
+    auto* serializer = entry.add_publish();
+    serializer->set_technique(TranslatorEntry::TECHNIQUE_FORMAT);
+    serializer->set_moos_var("FORMAT_TEST_%7%");
+    serializer->set_format(publish_format);
+    auto* upper = serializer->add_algorithm();
+    upper->set_name("to_upper");
+    upper->set_primary_field(1);
+    upper->set_output_virtual_field(20);
+
+    auto* parser = entry.add_create();
+    parser->set_technique(TranslatorEntry::TECHNIQUE_FORMAT);
+    parser->set_moos_var("FORMAT_TEST_IN");
+    parser->set_format("NAME=%1%,DEPTH=%4%,RANGES={%8%},EV=%10:1%");
+    return entry;
+}
+
+void test_translator()
+{
+    MOOSTranslator translator(make_entry("NAME=%1%,UPPER=%20%,DEPTH=%4%,R1=%8.1%"));
+
+    FormatTest msg;
+    populate(&msg);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto moos_msgs = translator.protobuf_to_moos(msg);
+        assert(moos_msgs.size() == 1);
+        assert(moos_msgs.begin()->first == "FORMAT_TEST_MODE_SURVEY");
+        assert(moos_msgs.begin()->second.GetString() == "NAME=auv-23,UPPER=AUV-23,DEPTH=-12,R1=-2");
+    }
+
+    std::map<std::string, CMOOSMsg> moos_variables;
+    moos_variables["FORMAT_TEST_IN"] =
+        CMOOSMsg(MOOS_NOTIFY, "FORMAT_TEST_IN", "NAME=abc,DEPTH=5,RANGES={1,2},EV=0.5");
+    for (int i = 0; i < 3; ++i)
+    {
+        auto parsed = translator.moos_to_protobuf<std::shared_ptr<google::protobuf::Message>>(
+            moos_variables, "goby.test.moos.protobuf.FormatTest");
+        assert(parsed->ShortDebugString() ==
+               "name: \"abc\" depth: 5 ranges: 1 ranges: 2 embedded { val: 0.5 }");
+    }
+
+    auto inverse = translator.protobuf_to_inverse_moos(msg);
+    assert(inverse.find("FORMAT_TEST_IN")->second.GetString() ==
+           "NAME=auv-23,DEPTH=-12,RANGES={100,-2,3000},EV=3.25");
+
+    // replacing the entry discards the previously compiled formats
+    translator.clear_entry("goby.test.moos.protobuf.FormatTest");
+    translator.add_entry(make_entry("DEPTH=%4%"));
+    assert(translator.protobuf_to_moos(msg).begin()->second.GetString() == "DEPTH=-12");
+
+    std::cout << "translator: passed" << std::endl;
+}
+
+void benchmark()
+{
+    FormatTest msg;
+    populate(&msg);
+    const TranslatorEntry entry = make_entry(
+        "NAME=%1%,UPPER=%20%,X=%2%,Y=%3%,DEPTH=%4%,MODE=%7%,RANGES={%8%},R1=%8.1%,EV=%10:1%");
+    MOOSTranslator translator(entry);
+
+    std::size_t sink = 0;
+    auto start = clock_type::now();
+    for (int i = 0; i < nbenchmark; ++i)
+    {
+        const auto& publish = entry.publish(0);
+        std::string moos_var, value;
+        FormatTranslation::serialize(&moos_var, msg, publish.algorithm(), publish.moos_var(),
+                                     publish.repeated_delimiter());
+        FormatTranslation::serialize(&value, msg, publish.algorithm(), publish.format(),
+                                     publish.repeated_delimiter());
+        sink += value.size();
+    }
+    std::chrono::duration<double> static_dt = clock_type::now() - start;
+
+    start = clock_type::now();
+    for (int i = 0; i < nbenchmark; ++i)
+        sink += translator.protobuf_to_moos(msg).begin()->second.GetString().size();
+    std::chrono::duration<double> compiled_dt = clock_type::now() - start;
+
+    std::cout << "serialize: compiled per message: " << nbenchmark / static_dt.count()
+              << " msg/s, compiled once: " << nbenchmark / compiled_dt.count() << " msg/s ("
+              << static_dt.count() / compiled_dt.count() << "x)" << std::endl;
+
+    const std::string in = "NAME=abc,DEPTH=5,RANGES={1,2,3},EV=0.5";
+    std::map<std::string, CMOOSMsg> moos_variables;
+    moos_variables["FORMAT_TEST_IN"] = CMOOSMsg(MOOS_NOTIFY, "FORMAT_TEST_IN", in);
+
+    start = clock_type::now();
+    for (int i = 0; i < nbenchmark; ++i)
+    {
+        FormatTest parsed;
+        FormatTranslation::parse(in, &parsed, entry.create(0).format(),
+                                 entry.create(0).repeated_delimiter());
+        sink += parsed.depth();
+    }
+    static_dt = clock_type::now() - start;
+
+    start = clock_type::now();
+    for (int i = 0; i < nbenchmark; ++i)
+        sink += translator
+                    .moos_to_protobuf<std::shared_ptr<google::protobuf::Message>>(
+                        moos_variables, "goby.test.moos.protobuf.FormatTest")
+                    ->ByteSizeLong();
+    compiled_dt = clock_type::now() - start;
+
+    std::cout << "parse: compiled per message: " << nbenchmark / static_dt.count()
+              << " msg/s, compiled once: " << nbenchmark / compiled_dt.count() << " msg/s ("
+              << static_dt.count() / compiled_dt.count() << "x)" << std::endl;
+
+    assert(sink > 0);
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+
+    test_serialize();
+    test_parse();
+    test_translator();
+    benchmark();
+
+    std::cout << "all tests passed" << std::endl;
+}
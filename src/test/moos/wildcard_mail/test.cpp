@@ -0,0 +1,177 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "goby/moos/wildcard_mail_handlers.h"
+
+// tests goby::moos::WildcardMailHandlers (as used by GobyMOOSApp for wildcard subscriptions), and compares dispatch using the cached matches vs. the previous path (testing every pattern against every message)
+
+using goby::moos::WildcardMailHandlers;
+using PreviousHandlers =
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<WildcardMailHandlers::Signal>>;
+using clock_type = std::chrono::steady_clock;
+
+CMOOSMsg make_msg(const std::string& var, const std::string& source)
+{
+    CMOOSMsg msg(MOOS_NOTIFY, var, "value");
+    msg.m_sSrc = source;
+    return msg;
+}
+
+void test_dispatch()
+{
+    WildcardMailHandlers handlers;
+    std::vector<std::string> calls;
+
+    handlers.add("NAV_*", "*").connect([&](const CMOOSMsg& msg)
+                                       { calls.push_back("NAV_*:" + msg.GetKey()); });
+    handlers.add("*", "pNav").connect([&](const CMOOSMsg& msg)
+                                      { calls.push_back("*,pNav:" + msg.GetKey()); });
+    handlers.add("DESIRED_?", "*").connect([&](const CMOOSMsg& msg)
+                                           { calls.push_back("DESIRED_?:" + msg.GetKey()); });
+    // same pattern returns the same signal
+    handlers.add("NAV_*", "*").connect([&](const CMOOSMsg& msg)
+                                       { calls.push_back("NAV_*(2):" + msg.GetKey()); });
+    assert(handlers.size() == 3);
+
+    handlers.dispatch(make_msg("NAV_X", "pNav"));
+    assert((calls == std::vector<std::string>{"*,pNav:NAV_X", "NAV_*:NAV_X", "NAV_*(2):NAV_X"}));
+
+    calls.clear();
+    handlers.dispatch(make_msg("NAV_X", "iGPS"));
+    assert((calls == std::vector<std::string>{"NAV_*:NAV_X", "NAV_*(2):NAV_X"}));
+
+    // cached result is reused
+    calls.clear();
+    handlers.dispatch(make_msg("NAV_X", "iGPS"));
+    assert((calls == std::vector<std::string>{"NAV_*:NAV_X", "NAV_*(2):NAV_X"}));
+
+    calls.clear();
+    handlers.dispatch(make_msg("DESIRED_Z", "pHelm"));
+    handlers.dispatch(make_msg("DESIRED_ZZ", "pHelm"));
+    handlers.dispatch(make_msg("DEPTH", "iGPS"));
+    assert((calls == std::vector<std::string>{"DESIRED_?:DESIRED_Z"}));
+
+    // adding a pattern invalidates the cached matches
+    calls.clear();
+    handlers.add("DEPTH", "iGPS").connect([&](const CMOOSMsg& msg)
+                                          { calls.push_back("DEPTH:" + msg.GetKey()); });
+    handlers.dispatch(make_msg("DEPTH", "iGPS"));
+    handlers.dispatch(make_msg("NAV_X", "iGPS"));
+    assert((calls == std::vector<std::string>{"DEPTH:DEPTH", "NAV_*:NAV_X", "NAV_*(2):NAV_X"}));
+
+    // adding from within a handler takes effect on the next message
+    calls.clear();
+    bool added = false;
+    handlers.add("TRIGGER", "*").connect(
+        [&](const CMOOSMsg&)
+        {
+            if (!added)
+            {
+                added = true;
+                handlers.add("TRIG*", "*").connect(
+                    [&](const CMOOSMsg& msg) { calls.push_back("TRIG*:" + msg.GetKey()); });
+            }
+        });
+    handlers.dispatch(make_msg("TRIGGER", "pA"));
+    assert(calls.empty());
+    handlers.dispatch(make_msg("TRIGGER", "pA"));
+    assert((calls == std::vector<std::string>{"TRIG*:TRIGGER"}));
+
+    std::cout << "dispatch: passed" << std::endl;
+}
+
+// as GobyMOOSApp::OnNewMail did: test every pattern for every message
+void dispatch_previous(const PreviousHandlers& handlers, const CMOOSMsg& msg)
+{
+    for (auto& handler : handlers)
+    {
+        if (MOOSWildCmp(handler.first.first, msg.GetKey()) &&
+            MOOSWildCmp(handler.first.second, msg.GetSource()))
+            (*(handler.second))(msg);
+    }
+}
+
+void benchmark()
+{
+    const int npatterns = 50;
+    const int nvars = 200;
+    const int nsources = 5;
+    const int nmail = 10000;
+    const int niterate = 20;
+
+    WildcardMailHandlers handlers;
+    PreviousHandlers previous_handlers;
+
+    int previous_calls = 0, calls = 0;
+    for (int i = 0; i < npatterns; ++i)
+    {
+        std::string var_pattern = "VAR_" + std::to_string(i) + "_*";
+        std::string app_pattern = (i % 2) ? "*" : "pApp?";
+        handlers.add(var_pattern, app_pattern).connect([&](const CMOOSMsg&) { ++calls; });
+        auto signal = std::make_shared<WildcardMailHandlers::Signal>();
+        signal->connect([&](const CMOOSMsg&) { ++previous_calls; });
+        previous_handlers.insert(std::make_pair(std::make_pair(var_pattern, app_pattern), signal));
+    }
+
+    // the mail of one iterate
+    std::vector<CMOOSMsg> mail;
+    for (int i = 0; i < nmail; ++i)
+        mail.push_back(make_msg("VAR_" + std::to_string(i % nvars) + "_X",
+                                "pApp" + std::to_string(i % nsources)));
+
+    auto start = clock_type::now();
+    for (int n = 0; n < niterate; ++n)
+        for (const auto& msg : mail) dispatch_previous(previous_handlers, msg);
+    std::chrono::duration<double> previous_dt = clock_type::now() - start;
+
+    start = clock_type::now();
+    for (int n = 0; n < niterate; ++n)
+        for (const auto& msg : mail) handlers.dispatch(msg);
+    std::chrono::duration<double> cached_dt = clock_type::now() - start;
+
+    assert(calls == previous_calls);
+    assert(calls > 0);
+
+    double previous_rate = niterate * nmail / previous_dt.count();
+    double cached_rate = niterate * nmail / cached_dt.count();
+    std::cout << npatterns << " patterns, " << nmail << " mail/iterate: previous: " << previous_rate
+              << " mail/s, cached matches: " << cached_rate << " mail/s ("
+              << cached_rate / previous_rate << "x)" << std::endl;
+}
+
+int main()
+{
+    test_dispatch();
+    benchmark();
+    std::cout << "all tests passed" << std::endl;
+}
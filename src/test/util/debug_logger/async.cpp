@@ -0,0 +1,266 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "goby/util/debug_logger.h"
+
+// tests the asynchronous glog backend (FlexOStreamBuf::enable_async()), and compares multi-threaded logging throughput and per-call latency against the synchronous backend, for a fast and a slow (e.g. terminal or network file system) stream
+
+using goby::glog;
+using goby::util::protobuf::GLogConfig;
+using namespace goby::util::logger;
+using clock_type = std::chrono::steady_clock;
+
+// stream buffer that takes (at least) delay to write each line
+class SlowBuf : public std::stringbuf
+{
+  public:
+    explicit SlowBuf(std::chrono::microseconds delay) : delay_(delay) {}
+
+  protected:
+    int sync() override
+    {
+        auto end = clock_type::now() + delay_;
+        while (clock_type::now() < end) {}
+        return std::stringbuf::sync();
+    }
+
+  private:
+    std::chrono::microseconds delay_;
+};
+
+GLogConfig::Async async_cfg(int queue_size, GLogConfig::Async::OverflowPolicy overflow)
+{
+    GLogConfig::Async cfg;
+    cfg.set_queue_size(queue_size);
+    cfg.set_overflow(overflow);
+    return cfg;
+}
+
+std::vector<std::string> lines(const std::string& s)
+{
+    std::vector<std::string> result;
+    std::stringstream ss(s);
+    std::string line;
+    while (std::getline(ss, line)) result.push_back(line);
+    return result;
+}
+
+void log_from_threads(int nthreads, int nlines)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; ++t)
+        threads.emplace_back(
+            [=]()
+            {
+                for (int i = 0; i < nlines; ++i)
+                    glog.is_debug1() && glog << "thread " << t << " line " << i << std::endl;
+            });
+    for (auto& thread : threads) thread.join();
+}
+
+void test_ordering()
+{
+    const int nthreads = 4, nlines = 1000;
+    std::stringstream ss;
+    glog.add_stream(DEBUG1, &ss);
+    glog.enable_async(async_cfg(64, GLogConfig::Async::BLOCK));
+
+    log_from_threads(nthreads, nlines);
+    glog.flush_async();
+
+    // every line is written, in order for each thread
+    auto written = lines(ss.str());
+    assert(written.size() == nthreads * nlines);
+    std::map<int, int> next_line;
+    for (const auto& line : written)
+    {
+        auto thread_pos = line.find("thread ");
+        assert(thread_pos != std::string::npos);
+        int t = 0, i = 0;
+        std::stringstream(line.substr(thread_pos + 7)) >> t;
+        std::stringstream(line.substr(line.find(" line ") + 6)) >> i;
+        assert(i == next_line[t]);
+        ++next_line[t];
+    }
+
+    auto stats = glog.buf().async_statistics();
+    assert(stats.queued == nthreads * nlines);
+    assert(stats.written == nthreads * nlines);
+    assert(stats.dropped == 0);
+
+    // lines logged before removing the stream are written to it
+    glog.is_debug1() && glog << "before removal" << std::endl;
+    glog.remove_stream(&ss);
+    assert(lines(ss.str()).back().find("before removal") != std::string::npos);
+
+    // lines logged before disabling are written
+    glog.add_stream(DEBUG1, &ss);
+    glog.is_debug1() && glog << "before disable" << std::endl;
+    glog.disable_async();
+    assert(!glog.buf().is_async());
+    assert(lines(ss.str()).back().find("before disable") != std::string::npos);
+
+    // and synchronous again
+    glog.is_debug1() && glog << "synchronous" << std::endl;
+    assert(lines(ss.str()).back().find("synchronous") != std::string::npos);
+    glog.remove_stream(&ss);
+
+    std::cout << "ordering: passed" << std::endl;
+}
+
+void test_overflow(GLogConfig::Async::OverflowPolicy overflow)
+{
+    const int nlines = 1000;
+    SlowBuf slow_buf(std::chrono::microseconds(50));
+    std::ostream slow(&slow_buf);
+    glog.add_stream(DEBUG1, &slow);
+    glog.enable_async(async_cfg(16, overflow));
+
+    log_from_threads(1, nlines);
+    glog.flush_async();
+    auto stats = glog.buf().async_statistics();
+    glog.disable_async();
+    glog.remove_stream(&slow);
+
+    auto written = lines(slow_buf.str());
+    int dropped_warnings = std::count_if(written.begin(), written.end(),
+                                         [](const std::string& line)
+                                         { return line.find("Dropped") != std::string::npos; });
+
+    assert(stats.queued + stats.dropped == nlines);
+    assert(stats.written == stats.queued);
+    if (overflow == GLogConfig::Async::DROP_NEWEST)
+    {
+        assert(stats.dropped > 0);
+        assert(dropped_warnings > 0);
+        assert(written.size() == stats.written + dropped_warnings);
+    }
+    else
+    {
+        assert(stats.dropped == 0);
+        assert(dropped_warnings == 0);
+        assert(written.size() == nlines);
+    }
+
+    std::cout << GLogConfig::Async::OverflowPolicy_Name(overflow) << ": passed (" << stats.dropped
+              << " of " << nlines << " dropped)" << std::endl;
+}
+
+struct Result
+{
+    // lines/s logged by the logging threads
+    double logging_rate;
+    // lines/s including writing all lines to the stream
+    double total_rate;
+    // per call latency
+    double median_us;
+    double p99_us;
+};
+
+Result log_rate(int nthreads, int nlines)
+{
+    std::vector<std::thread> threads;
+    std::vector<std::vector<double>> latency(nthreads, std::vector<double>(nlines));
+    auto start = clock_type::now();
+    for (int t = 0; t < nthreads; ++t)
+        threads.emplace_back(
+            [=, &latency]()
+            {
+                for (int i = 0; i < nlines; ++i)
+                {
+                    auto line_start = clock_type::now();
+                    glog.is_debug1() && glog << "thread " << t << " line " << i << " value "
+                                             << i * 0.5 << std::endl;
+                    std::chrono::duration<double, std::micro> dt = clock_type::now() - line_start;
+                    latency[t][i] = dt.count();
+                }
+            });
+    for (auto& thread : threads) thread.join();
+    std::chrono::duration<double> logging_dt = clock_type::now() - start;
+    glog.flush_async();
+    std::chrono::duration<double> total_dt = clock_type::now() - start;
+
+    std::vector<double> all;
+    for (const auto& thread_latency : latency)
+        all.insert(all.end(), thread_latency.begin(), thread_latency.end());
+    std::sort(all.begin(), all.end());
+
+    return {nthreads * nlines / logging_dt.count(), nthreads * nlines / total_dt.count(),
+            all[all.size() / 2], all[all.size() * 99 / 100]};
+}
+
+std::ostream& operator<<(std::ostream& os, const Result& r)
+{
+    return os << r.logging_rate << " lines/s logging, " << r.total_rate
+              << " lines/s written, call median " << r.median_us << " us, p99 " << r.p99_us
+              << " us";
+}
+
+void benchmark(const std::string& name, std::ostream* os, int nthreads, int nlines)
+{
+    glog.add_stream(DEBUG1, os);
+    auto sync = log_rate(nthreads, nlines);
+
+    // large enough to queue every line, so this measures the logging threads' cost alone
+    glog.enable_async(async_cfg(nthreads * nlines, GLogConfig::Async::BLOCK));
+    auto async = log_rate(nthreads, nlines);
+    glog.disable_async();
+    glog.remove_stream(os);
+
+    std::cout << name << ", " << nthreads << " threads:\n  synchronous:  " << sync
+              << "\n  asynchronous: " << async << "\n  (" << async.logging_rate / sync.logging_rate
+              << "x logging rate, " << async.total_rate / sync.total_rate << "x written rate)"
+              << std::endl;
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    glog.set_name(argv[0]);
+    glog.set_lock_action(goby::util::logger_lock::lock);
+
+    test_ordering();
+    test_overflow(GLogConfig::Async::DROP_NEWEST);
+    test_overflow(GLogConfig::Async::BLOCK);
+
+    std::ofstream file("/tmp/goby_test_debug_logger_async.txt");
+    benchmark("file", &file, 4, 25000);
+
+    SlowBuf slow_buf(std::chrono::microseconds(20));
+    std::ostream slow(&slow_buf);
+    benchmark("slow stream (20 us/line)", &slow, 4, 5000);
+
+    std::cout << "all tests passed" << std::endl;
+}
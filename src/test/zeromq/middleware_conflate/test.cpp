@@ -0,0 +1,169 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "goby/middleware/marshalling/cstr.h"
+
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/transport/interprocess.h"
+
+// tests that the InterProcessPortal only parses and posts the newest message received before each poll() for subscriptions with the KEEP_LATEST overflow policy, and compares the time spent in poll() against a regular subscription
+
+using goby::glog;
+using namespace goby::util::logger;
+using Portal = goby::zeromq::InterProcessPortal<goby::middleware::InterThreadTransporter>;
+using QueueConfig = goby::middleware::protobuf::TransporterConfig::SubscriptionQueue;
+
+constexpr goby::middleware::Group latest_group{"Latest"};
+constexpr goby::middleware::Group all_group{"All"};
+
+const int max_publish = 200;
+const int nbatches = 50;
+const int batch_size = 100;
+const std::size_t payload_size = 10000;
+
+int latest_received = 0;
+std::string latest_value;
+int all_received = 0;
+
+void poll_until(Portal& zmq, std::function<bool()> done)
+{
+    auto timeout = std::chrono::system_clock::now() + std::chrono::seconds(10);
+    while (!done())
+    {
+        zmq.poll(std::chrono::milliseconds(10));
+        if (std::chrono::system_clock::now() > timeout)
+            glog.is(DIE) && glog << "Timed out waiting for data" << std::endl;
+    }
+}
+
+goby::middleware::Subscriber<std::string> keep_latest()
+{
+    goby::middleware::protobuf::TransporterConfig cfg;
+    cfg.mutable_queue()->set_overflow(QueueConfig::KEEP_LATEST);
+    return goby::middleware::Subscriber<std::string>(cfg);
+}
+
+// publishes batches of messages to group and polls until each batch is accounted for (that is, the sum of the messages received and conflated), returning the time spent in poll()
+template <const goby::middleware::Group& group>
+double benchmark(Portal& zmq, const std::function<std::uint64_t()>& accounted)
+{
+    std::string payload(payload_size, 'x');
+    std::uint64_t start_accounted = accounted();
+    std::chrono::steady_clock::duration poll_time(0);
+    for (int b = 0; b < nbatches; ++b)
+    {
+        for (int i = 0; i < batch_size; ++i) zmq.publish<group>(payload);
+        // let the whole batch arrive
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::uint64_t expected = start_accounted + (b + 1) * batch_size;
+        auto start = std::chrono::steady_clock::now();
+        poll_until(zmq, [&]() { return accounted() == expected; });
+        poll_time += std::chrono::steady_clock::now() - start;
+    }
+    return std::chrono::duration<double, std::milli>(poll_time).count();
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    goby::zeromq::protobuf::InterProcessPortalConfig cfg;
+    cfg.set_platform("test_conflate");
+    cfg.set_client_name("conflate");
+
+    std::unique_ptr<zmq::context_t> manager_context(new zmq::context_t(1));
+    std::unique_ptr<zmq::context_t> router_context(new zmq::context_t(1));
+    goby::zeromq::Router router(*router_context, cfg);
+    std::thread t1([&] { router.run(); });
+    goby::zeromq::protobuf::InterProcessManagerHold hold;
+    hold.add_required_client("conflate");
+    goby::zeromq::Manager manager(*manager_context, cfg, router, hold);
+    std::thread t2([&] { manager.run(); });
+
+    {
+        goby::middleware::InterThreadTransporter inproc;
+        Portal zmq(inproc, cfg);
+        zmq.subscribe<latest_group, std::string>(
+            [](const std::string& s) {
+                ++latest_received;
+                latest_value = s;
+            },
+            keep_latest());
+        zmq.subscribe<all_group, std::string>([](const std::string&) { ++all_received; });
+        zmq.ready();
+        poll_until(zmq, [&]() { return !zmq.hold_state(); });
+
+        // both groups published before polling: only the latest group is conflated
+        for (int i = 0; i < max_publish; ++i)
+        {
+            zmq.publish<latest_group>(std::to_string(i));
+            zmq.publish<all_group>(std::to_string(i));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        poll_until(zmq, [&]() {
+            return all_received == max_publish &&
+                   latest_value == std::to_string(max_publish - 1);
+        });
+        std::cout << "received " << latest_received << " of " << max_publish
+                  << " (KEEP_LATEST), " << all_received << " of " << max_publish << " (default)"
+                  << std::endl;
+        assert(latest_received < max_publish);
+        assert(latest_received + zmq.received_conflated() == max_publish);
+
+        // benchmark
+        double all_ms = benchmark<all_group>(zmq, [&]() { return all_received; });
+        int latest_before = latest_received;
+        double latest_ms = benchmark<latest_group>(
+            zmq, [&]() { return latest_received + zmq.received_conflated(); });
+        std::cout << nbatches << " batches of " << batch_size << " messages: default: "
+                  << all_ms << " ms in poll(); KEEP_LATEST: " << latest_ms << " ms in poll() ("
+                  << latest_received - latest_before << " callbacks)" << std::endl;
+
+        // after unsubscribing, a regular subscription receives everything
+        zmq.unsubscribe<latest_group, std::string>();
+        latest_received = 0;
+        zmq.subscribe<latest_group, std::string>([](const std::string&) { ++latest_received; });
+        auto conflated = zmq.received_conflated();
+        for (int i = 0; i < max_publish; ++i) zmq.publish<latest_group>(std::to_string(i));
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        poll_until(zmq, [&]() { return latest_received == max_publish; });
+        assert(zmq.received_conflated() == conflated);
+    }
+
+    router_context.reset();
+    manager_context.reset();
+    t1.join();
+    t2.join();
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,133 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "goby/middleware/marshalling/cstr.h"
+
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/transport/interprocess.h"
+
+// tests that publications without any subscribers are skipped (before serialization) by both the InterProcessPortal and the InterProcessForwarder
+
+using goby::glog;
+using namespace goby::util::logger;
+
+constexpr goby::middleware::Group subscribed{"Subscribed"};
+constexpr goby::middleware::Group unsubscribed{"Unsubscribed"};
+
+const int max_publish = 100;
+int received = 0;
+
+void poll_until(goby::zeromq::InterProcessPortal<goby::middleware::InterThreadTransporter>& zmq,
+                std::function<bool()> done)
+{
+    auto timeout = std::chrono::system_clock::now() + std::chrono::seconds(10);
+    while (!done())
+    {
+        zmq.poll(std::chrono::milliseconds(10));
+        if (std::chrono::system_clock::now() > timeout)
+            glog.is(DIE) && glog << "Timed out waiting for data" << std::endl;
+    }
+}
+
+int main(int /*argc*/, char* argv[])
+{
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    goby::zeromq::protobuf::InterProcessPortalConfig cfg;
+    cfg.set_platform("test_publication_filter");
+    cfg.set_client_name("filter");
+
+    std::unique_ptr<zmq::context_t> manager_context(new zmq::context_t(1));
+    std::unique_ptr<zmq::context_t> router_context(new zmq::context_t(1));
+    goby::zeromq::Router router(*router_context, cfg);
+    std::thread t1([&] { router.run(); });
+    goby::zeromq::protobuf::InterProcessManagerHold hold;
+    hold.add_required_client("filter");
+    goby::zeromq::Manager manager(*manager_context, cfg, router, hold);
+    std::thread t2([&] { manager.run(); });
+
+    {
+        goby::middleware::InterThreadTransporter inproc;
+        goby::zeromq::InterProcessPortal<goby::middleware::InterThreadTransporter> zmq(inproc,
+                                                                                      cfg);
+        zmq.subscribe<subscribed, std::string>([](const std::string& s) {
+            assert(s == "keep");
+            ++received;
+        });
+        zmq.ready();
+        poll_until(zmq, [&]() { return !zmq.hold_state(); });
+
+        // portal
+        for (int i = 0; i < max_publish; ++i)
+        {
+            zmq.publish<unsubscribed>(std::string("skip"));
+            zmq.publish<subscribed>(std::string("keep"));
+        }
+        assert(zmq.publications_skipped() == max_publish);
+        poll_until(zmq, [&]() { return received == max_publish; });
+
+        // forwarder in another thread
+        std::atomic<bool> forwarder_done(false);
+        std::uint64_t forwarder_skipped = 0;
+        std::thread forwarder_thread([&]() {
+            goby::middleware::InterThreadTransporter inproc2;
+            goby::middleware::InterProcessForwarder<goby::middleware::InterThreadTransporter>
+                ipc(inproc2);
+            for (int i = 0; i < max_publish; ++i)
+            {
+                ipc.publish<unsubscribed>(std::string("skip"));
+                ipc.publish<subscribed>(std::string("keep"));
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            forwarder_skipped = ipc.publications_skipped();
+            forwarder_done = true;
+        });
+        poll_until(zmq, [&]() { return forwarder_done && received == 2 * max_publish; });
+        forwarder_thread.join();
+
+        std::cout << "forwarder skipped: " << forwarder_skipped
+                  << ", portal skipped: " << zmq.publications_skipped() << std::endl;
+
+        // most are skipped by the forwarder, but any sent while the portal's subscriptions were out of date are skipped by the portal
+        assert(forwarder_skipped > 0);
+        assert(forwarder_skipped + zmq.publications_skipped() == 2 * max_publish);
+        assert(received == 2 * max_publish);
+    }
+
+    router_context.reset();
+    manager_context.reset();
+    t1.join();
+    t2.join();
+
+    std::cout << "all tests passed" << std::endl;
+}
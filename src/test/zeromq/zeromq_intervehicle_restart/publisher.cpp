@@ -0,0 +1,138 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <set>
+
+#include "goby/middleware/marshalling/dccl.h"
+#include "goby/middleware/marshalling/protobuf.h"
+#include "goby/middleware/transport/intervehicle.h"
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/transport/interprocess.h"
+
+#include "goby/test/zeromq/zeromq_intervehicle_restart/publisher.h"
+#include "goby/test/zeromq/zeromq_intervehicle_restart/test.pb.h"
+
+using goby::glog;
+using goby::test::zeromq::protobuf::RestartSample;
+using namespace goby::util::logger;
+
+constexpr goby::middleware::Group restart_group{"restart", 1};
+
+// values published with the full metadata to driver A, with the fingerprint only once driver B has replaced it, and with the full metadata again after driver B's METADATA_INCLUDE
+constexpr int first_value = 1;
+constexpr int fingerprint_only_value = 100;
+constexpr int include_value = 10000;
+
+const std::chrono::seconds timeout(30);
+
+int goby_test_zeromq_intervehicle_restart_publish(
+    const goby::zeromq::protobuf::InterProcessPortalConfig* cfg, int command_fd)
+{
+    using goby::middleware::intervehicle::protobuf::ExpireData;
+    using goby::middleware::protobuf::SerializerMetadataRequest;
+    using goby::test::zeromq::read_command;
+
+    goby::zeromq::InterProcessPortal<> zmq(*cfg);
+    goby::middleware::InterVehicleForwarder<decltype(zmq)> intervehicle(zmq);
+
+    int includes = 0;
+    zmq.subscribe<goby::middleware::intervehicle::groups::metadata_request>(
+        [&includes](const SerializerMetadataRequest& request) {
+            if (request.request() == SerializerMetadataRequest::METADATA_INCLUDE)
+                ++includes;
+        });
+
+    // no process subscribes to RestartSample, so each value the drivers buffer expires
+    std::set<int> expired;
+    goby::middleware::protobuf::TransporterConfig publisher_cfg;
+    publisher_cfg.mutable_intervehicle()->mutable_buffer()->set_ack_required(true);
+    goby::middleware::Publisher<RestartSample> publisher(
+        publisher_cfg,
+        [](RestartSample& s, const goby::middleware::Group& g) { s.set_group(g.numeric()); },
+        [](const RestartSample& s, const goby::middleware::intervehicle::protobuf::AckData&) {
+            glog.is_die() && glog << "Unexpected ack for " << s.ShortDebugString() << std::endl;
+        },
+        [&expired](const RestartSample& s, const ExpireData& expire) {
+            glog.is_debug1() && glog << "Expire for " << s.ShortDebugString()
+                                     << ", expire msg: " << expire.ShortDebugString() << std::endl;
+            assert(expire.reason() == ExpireData::EXPIRED_NO_SUBSCRIBERS);
+            expired.insert(s.a());
+        });
+
+    auto publish = [&](int a) {
+        RestartSample s;
+        s.set_a(a);
+        intervehicle.publish<restart_group>(s, publisher);
+    };
+
+    zmq.ready();
+    while (zmq.hold_state()) intervehicle.poll(std::chrono::milliseconds(10));
+
+    // full metadata: driver A loads the type and requests METADATA_EXCLUDE, which we don't handle until we poll again
+    publish(first_value);
+
+    if (read_command(command_fd, timeout) != goby::test::zeromq::driver_restarted)
+        glog.is_die() && glog << "Timed out waiting for driver B" << std::endl;
+
+    // fingerprint only: driver B hasn't seen the full metadata, so cannot load the type and must request METADATA_INCLUDE
+    int fingerprint_only_count = 0;
+    auto start = std::chrono::system_clock::now();
+    while (read_command(command_fd, std::chrono::milliseconds(100)) !=
+           goby::test::zeromq::metadata_include_sent)
+    {
+        publish(fingerprint_only_value + fingerprint_only_count++);
+        if (std::chrono::system_clock::now() > start + timeout)
+            glog.is_die() && glog << "Timed out waiting for METADATA_INCLUDE" << std::endl;
+    }
+
+    // handles driver A's METADATA_EXCLUDE, then driver B's METADATA_INCLUDE
+    start = std::chrono::system_clock::now();
+    while (includes == 0)
+    {
+        intervehicle.poll(std::chrono::milliseconds(10));
+        if (std::chrono::system_clock::now() > start + timeout)
+            glog.is_die() && glog << "Timed out handling METADATA_INCLUDE" << std::endl;
+    }
+
+    // full metadata again, so driver B loads the type and buffers the data
+    publish(include_value);
+
+    start = std::chrono::system_clock::now();
+    while (!expired.count(include_value))
+    {
+        intervehicle.poll(std::chrono::milliseconds(10));
+        if (std::chrono::system_clock::now() > start + timeout)
+            glog.is_die() && glog << "Timed out waiting for expire of " << include_value
+                                  << " from driver B" << std::endl;
+    }
+
+    assert(expired.count(first_value));
+    // omitted by driver B rather than buffered
+    for (int i = 0; i < fingerprint_only_count; ++i)
+        assert(!expired.count(fingerprint_only_value + i));
+
+    glog.is_verbose() && glog << "Published " << fingerprint_only_count
+                              << " fingerprint-only publications" << std::endl;
+    return 0;
+}
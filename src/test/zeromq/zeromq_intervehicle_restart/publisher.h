@@ -0,0 +1,69 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GOBY_TEST_ZEROMQ_ZEROMQ_INTERVEHICLE_RESTART_PUBLISHER_H
+#define GOBY_TEST_ZEROMQ_ZEROMQ_INTERVEHICLE_RESTART_PUBLISHER_H
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/protobuf/interprocess_config.pb.h"
+
+namespace goby
+{
+namespace test
+{
+namespace zeromq
+{
+// written by the test to the publisher's command pipe
+constexpr char driver_restarted = 'r';
+constexpr char metadata_include_sent = 'i';
+// written by the test to a driver's command pipe
+constexpr char driver_start = 's';
+constexpr char driver_quit = 'q';
+
+// returns the next command from fd, or 0 if none is received within timeout. Exits if the test process has exited (closing the pipe)
+inline char read_command(int fd, std::chrono::milliseconds timeout)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    char command = 0;
+    if (::poll(&pfd, 1, timeout.count()) > 0 && ::read(fd, &command, 1) != 1)
+        goby::glog.is_die() && goby::glog << "Command pipe closed" << std::endl;
+    return command;
+}
+
+} // namespace zeromq
+} // namespace test
+} // namespace goby
+
+extern "C"
+{
+    // runs the publisher process (see test.cpp), returning the exit code
+    int goby_test_zeromq_intervehicle_restart_publish(
+        const goby::zeromq::protobuf::InterProcessPortalConfig* cfg, int command_fd);
+}
+
+#endif
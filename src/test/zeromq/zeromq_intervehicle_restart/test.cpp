@@ -0,0 +1,307 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <dlfcn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cassert>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "goby/acomms/protobuf/udp_multicast_driver.pb.h"
+#include "goby/middleware/marshalling/protobuf.h"
+#include "goby/middleware/transport/intervehicle.h"
+#include "goby/time/simulation.h"
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/transport/interprocess.h"
+
+#include "goby/test/zeromq/zeromq_intervehicle_restart/publisher.h"
+
+// tests that a publisher's fingerprint-only metadata (sent once the full metadata has been published) reaching a restarted InterVehiclePortal that has never loaded the type is recovered through METADATA_INCLUDE
+//
+// The publisher (and its message type) is loaded from a shared library in the publisher process only, so the driver processes can only load the type from the publication metadata:
+// 1. publisher: first publication (full metadata); driver A loads the type and requests METADATA_EXCLUDE
+// 2. driver A is replaced by driver B (which has not seen the full metadata)
+// 3. publisher (not yet having handled METADATA_EXCLUDE): fingerprint-only publications, which driver B omits, requesting METADATA_INCLUDE
+// 4. publisher: handles METADATA_INCLUDE, so the next publication has the full metadata; driver B loads the type and requests METADATA_EXCLUDE
+
+using goby::glog;
+using namespace goby::util::logger;
+using goby::middleware::protobuf::SerializerMetadataRequest;
+using goby::middleware::protobuf::SerializerTransporterMessage;
+using goby::test::zeromq::read_command;
+
+int udp_port = 61000;
+const std::chrono::seconds timeout(30);
+
+enum class Process
+{
+    TEST,
+    DRIVER_A,
+    DRIVER_B,
+    PUBLISHER
+};
+
+enum class Metadata
+{
+    NONE,
+    FINGERPRINT_ONLY,
+    FULL
+};
+
+void driver(const goby::zeromq::protobuf::InterProcessPortalConfig& zmq_cfg,
+            const goby::middleware::intervehicle::protobuf::PortalConfig& slow_cfg,
+            int command_fd)
+{
+    goby::zeromq::InterProcessPortal<goby::middleware::InterThreadTransporter> zmq(zmq_cfg);
+    goby::middleware::InterVehiclePortal<decltype(zmq)> intervehicle(zmq, slow_cfg);
+    zmq.ready();
+
+    while (read_command(command_fd, std::chrono::milliseconds(0)) !=
+           goby::test::zeromq::driver_quit)
+        intervehicle.poll(std::chrono::milliseconds(10));
+}
+
+int publisher(const goby::zeromq::protobuf::InterProcessPortalConfig& zmq_cfg, int command_fd)
+{
+    const char* lib = GOBY_LIB_DIR "/libgoby_test_zeromq_intervehicle_restart_publisher.so";
+    void* handle = dlopen(lib, RTLD_LAZY);
+    if (!handle)
+        glog.is_die() && glog << "Failed to open " << lib << ": " << dlerror() << std::endl;
+
+    using publish_func = decltype(&goby_test_zeromq_intervehicle_restart_publish);
+    auto publish = reinterpret_cast<publish_func>(
+        dlsym(handle, "goby_test_zeromq_intervehicle_restart_publish"));
+    if (!publish)
+        glog.is_die() && glog << "Failed to load publisher: " << dlerror() << std::endl;
+
+    return publish(&zmq_cfg, command_fd);
+}
+
+void write_command(int fd, char command)
+{
+    if (::write(fd, &command, 1) != 1)
+        glog.is_die() && glog << "Failed to write command" << std::endl;
+}
+
+int wait_for_exit(pid_t pid)
+{
+    int wstatus;
+    waitpid(pid, &wstatus, 0);
+    return wstatus;
+}
+
+// observes the publications to the drivers, and the drivers' metadata requests, and commands the other processes
+void test(const goby::zeromq::protobuf::InterProcessPortalConfig& zmq_cfg,
+          const std::map<Process, pid_t>& pids, const std::map<Process, int>& command_fds)
+{
+    goby::zeromq::InterProcessPortal<> zmq(zmq_cfg);
+
+    std::vector<Metadata> published;
+    zmq.subscribe<goby::middleware::intervehicle::groups::modem_data_out>(
+        [&published](const SerializerTransporterMessage& msg) {
+            const auto& key = msg.key();
+            if (!key.has_metadata())
+                published.push_back(Metadata::NONE);
+            else if (key.metadata().file_descriptor_size() > 0)
+                published.push_back(Metadata::FULL);
+            else
+            {
+                assert(key.metadata().has_fingerprint());
+                published.push_back(Metadata::FINGERPRINT_ONLY);
+            }
+        });
+
+    int excludes = 0, includes = 0;
+    zmq.subscribe<goby::middleware::intervehicle::groups::metadata_request>(
+        [&](const SerializerMetadataRequest& request) {
+            glog.is_debug1() && glog << "Metadata request: " << request.ShortDebugString()
+                                     << std::endl;
+            switch (request.request())
+            {
+                case SerializerMetadataRequest::METADATA_EXCLUDE: ++excludes; break;
+                case SerializerMetadataRequest::METADATA_INCLUDE: ++includes; break;
+            }
+        });
+
+    // the drivers expire the buffered data as nothing subscribes to it
+    int expires = 0;
+    zmq.subscribe<goby::middleware::intervehicle::groups::modem_expire_in>(
+        [&expires](const goby::middleware::intervehicle::protobuf::ExpireMessagePair&) {
+            ++expires;
+        });
+
+    zmq.ready();
+
+    auto wait_for = [&](std::function<bool()> done, const std::string& description) {
+        auto start = std::chrono::system_clock::now();
+        while (!done())
+        {
+            zmq.poll(std::chrono::milliseconds(10));
+            if (std::chrono::system_clock::now() > start + timeout)
+                glog.is_die() && glog << udp_port << ": Timed out waiting for " << description
+                                      << std::endl;
+        }
+    };
+
+    // until driver A has sent everything for the first publication
+    wait_for([&]() { return excludes == 1 && expires == 1; },
+             "METADATA_EXCLUDE and expire from driver A");
+    assert(includes == 0);
+
+    write_command(command_fds.at(Process::DRIVER_A), goby::test::zeromq::driver_quit);
+    assert(wait_for_exit(pids.at(Process::DRIVER_A)) == 0);
+    write_command(command_fds.at(Process::DRIVER_B), goby::test::zeromq::driver_start);
+    write_command(command_fds.at(Process::PUBLISHER), goby::test::zeromq::driver_restarted);
+
+    wait_for([&]() { return includes > 0; }, "METADATA_INCLUDE from driver B");
+    write_command(command_fds.at(Process::PUBLISHER), goby::test::zeromq::metadata_include_sent);
+
+    wait_for([&]() { return excludes == 2 && expires == 2; },
+             "METADATA_EXCLUDE and expire from driver B");
+    assert(wait_for_exit(pids.at(Process::PUBLISHER)) == 0);
+
+    write_command(command_fds.at(Process::DRIVER_B), goby::test::zeromq::driver_quit);
+    assert(wait_for_exit(pids.at(Process::DRIVER_B)) == 0);
+
+    // full, fingerprint only (at least one reaching driver B), then full again after METADATA_INCLUDE
+    assert(published.size() >= 3);
+    assert(published.front() == Metadata::FULL);
+    assert(published.back() == Metadata::FULL);
+    for (auto it = published.begin() + 1, end = published.end() - 1; it != end; ++it)
+        assert(*it == Metadata::FINGERPRINT_ONLY);
+    assert(excludes == 2);
+    assert(expires == 2);
+
+    glog.is_verbose() && glog << "Fingerprint-only publications: " << published.size() - 2
+                              << ", METADATA_INCLUDE requests: " << includes << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    goby::time::SimulatorSettings::using_sim_time = false;
+
+    if (argc >= 2)
+        udp_port += std::atoi(argv[1]);
+
+    // fork before starting any threads
+    std::map<Process, pid_t> pids;
+    std::map<Process, int> command_fds;
+    Process process = Process::TEST;
+    int command_fd = -1;
+    for (auto child : {Process::DRIVER_A, Process::DRIVER_B, Process::PUBLISHER})
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+            return EXIT_FAILURE;
+
+        pid_t child_pid = fork();
+        if (child_pid == 0)
+        {
+            for (const auto& p : command_fds) close(p.second);
+            close(fds[1]);
+            process = child;
+            command_fd = fds[0];
+            break;
+        }
+        close(fds[0]);
+        pids[child] = child_pid;
+        command_fds[child] = fds[1];
+    }
+
+    const std::map<Process, std::string> names{{Process::TEST, "test"},
+                                               {Process::DRIVER_A, "driver_a"},
+                                               {Process::DRIVER_B, "driver_b"},
+                                               {Process::PUBLISHER, "publisher"}};
+
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(std::string(argv[0]) + "_" + names.at(process));
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    goby::zeromq::protobuf::InterProcessPortalConfig zmq_cfg;
+    zmq_cfg.set_platform("test-intervehicle-restart" + std::to_string(udp_port));
+    zmq_cfg.set_client_name(names.at(process));
+
+    goby::middleware::intervehicle::protobuf::PortalConfig slow_cfg;
+    auto& link_cfg = *slow_cfg.add_link();
+    link_cfg.set_modem_id(1);
+    goby::acomms::protobuf::DriverConfig& driver_cfg = *link_cfg.mutable_driver();
+    driver_cfg.set_driver_type(goby::acomms::protobuf::DRIVER_UDP_MULTICAST);
+    auto* udp_multicast_driver_cfg =
+        driver_cfg.MutableExtension(goby::acomms::udp_multicast::protobuf::config);
+    udp_multicast_driver_cfg->set_max_frame_size(64);
+    udp_multicast_driver_cfg->set_multicast_port(udp_port);
+    goby::acomms::protobuf::MACConfig& mac_cfg = *link_cfg.mutable_mac();
+    mac_cfg.set_type(goby::acomms::protobuf::MAC_FIXED_DECENTRALIZED);
+    goby::acomms::protobuf::ModemTransmission& slot = *mac_cfg.add_slot();
+    slot.set_src(1);
+    slot.set_slot_seconds(0.2);
+
+    int rc = 0;
+    switch (process)
+    {
+        case Process::TEST:
+        {
+            auto manager_context = std::make_unique<zmq::context_t>(1);
+            auto router_context = std::make_unique<zmq::context_t>(1);
+
+            goby::zeromq::protobuf::InterProcessManagerHold hold;
+            hold.add_required_client(names.at(Process::TEST));
+            hold.add_required_client(names.at(Process::DRIVER_A));
+            hold.add_required_client(names.at(Process::PUBLISHER));
+
+            goby::zeromq::Router router(*router_context, zmq_cfg);
+            std::thread router_thread([&] { router.run(); });
+            goby::zeromq::Manager manager(*manager_context, zmq_cfg, router, hold);
+            std::thread manager_thread([&] { manager.run(); });
+
+            test(zmq_cfg, pids, command_fds);
+
+            router_context.reset();
+            manager_context.reset();
+            router_thread.join();
+            manager_thread.join();
+            break;
+        }
+
+        case Process::DRIVER_A: driver(zmq_cfg, slow_cfg, command_fd); break;
+
+        case Process::DRIVER_B:
+            if (read_command(command_fd, timeout) != goby::test::zeromq::driver_start)
+                glog.is_die() && glog << "Timed out waiting to start" << std::endl;
+            driver(zmq_cfg, slow_cfg, command_fd);
+            break;
+
+        case Process::PUBLISHER: rc = publisher(zmq_cfg, command_fd); break;
+    }
+
+    if (rc == 0)
+        std::cout << names.at(process) << ": all tests passed" << std::endl;
+    return rc;
+}
@@ -0,0 +1,278 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "goby/middleware/marshalling/cstr.h"
+
+#include "goby/middleware/transport/interthread.h"
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/transport/interprocess.h"
+
+// tests a Router split into shards (publications and subscriptions are routed by a hash of the group, and regex subscriptions receive from all the shards), and benchmarks the aggregate throughput of a number of client processes (each publishing to its own group, and subscribing to the group of the next client) against the number of shards
+
+using goby::glog;
+using namespace goby::util::logger;
+using goby::middleware::DynamicGroup;
+using goby::middleware::InterThreadTransporter;
+using goby::middleware::MarshallingScheme;
+using Portal = goby::zeromq::InterProcessPortal<InterThreadTransporter>;
+using clock_type = std::chrono::steady_clock;
+
+const int default_nclients = 8;
+const int test_publications = 10;
+const int test_shards = 3;
+const std::vector<int> default_benchmark_shards = {1, 2, 4};
+const auto benchmark_duration = std::chrono::seconds(1);
+// time for the publications in flight to arrive before a client exits
+const auto drain_duration = std::chrono::seconds(1);
+const std::size_t benchmark_data_size = 100;
+
+// written by each client to the pipe
+struct ClientResult
+{
+    int index;
+    int received;
+    int regex_groups;
+    double first_receive_ms;
+    double last_receive_ms;
+};
+
+double ms_since(clock_type::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+std::string client_name(int index) { return "client" + std::to_string(index); }
+std::string data_group(int index) { return "Data" + std::to_string(index); }
+
+void poll_for(Portal& zmq, clock_type::duration duration)
+{
+    auto end = clock_type::now() + duration;
+    while (clock_type::now() < end) zmq.poll(std::chrono::milliseconds(10));
+}
+
+// child process: publishes to its own group (test_publications, or as many as possible in benchmark_duration), and subscribes to the group of the next client (and, for client 0 when testing, to all the groups using a regex)
+void client(const goby::zeromq::protobuf::InterProcessPortalConfig& cfg, int index, int nclients,
+            bool benchmark, int fd, clock_type::time_point start)
+{
+    auto client_cfg = cfg;
+    client_cfg.set_client_name(client_name(index));
+
+    InterThreadTransporter interthread;
+    Portal zmq(interthread, client_cfg);
+
+    ClientResult result{index, 0, 0, -1, -1};
+    DynamicGroup publish_group(data_group(index));
+    DynamicGroup subscribe_group(data_group((index + 1) % nclients));
+
+    zmq.subscribe_dynamic<std::string>(
+        std::function<void(const std::string&)>(
+            [&](const std::string& data)
+            {
+                if (!benchmark)
+                    assert(data == std::string(subscribe_group));
+                if (result.received++ == 0)
+                    result.first_receive_ms = ms_since(start);
+                result.last_receive_ms = ms_since(start);
+            }),
+        subscribe_group);
+
+    std::set<std::string> regex_groups;
+    if (!benchmark && index == 0)
+    {
+        zmq.subscribe_regex(
+            [&](const std::vector<unsigned char>&, int scheme, const std::string&,
+                const goby::middleware::Group& group)
+            {
+                assert(scheme == MarshallingScheme::CSTR);
+                regex_groups.insert(std::string(group));
+            },
+            {MarshallingScheme::CSTR}, ".*", "Data[0-9]+");
+    }
+
+    zmq.ready();
+    while (zmq.hold_state()) zmq.poll(std::chrono::milliseconds(10));
+
+    if (benchmark)
+    {
+        std::string data(benchmark_data_size, 'x');
+        auto end = clock_type::now() + benchmark_duration;
+        for (int i = 0; clock_type::now() < end; ++i)
+        {
+            zmq.publish_dynamic(data, publish_group);
+            if (i % 100 == 0)
+                zmq.poll(std::chrono::seconds(0));
+        }
+    }
+    else
+    {
+        for (int i = 0; i < test_publications; ++i)
+            zmq.publish_dynamic(std::string(publish_group), publish_group);
+    }
+    poll_for(zmq, drain_duration);
+
+    result.regex_groups = regex_groups.size();
+    auto written = write(fd, &result, sizeof(result));
+    assert(written == sizeof(result));
+}
+
+// runs nclients against a Router with nshards, returning the aggregate received publications per second
+double run(int nshards, int nclients, bool benchmark)
+{
+    goby::zeromq::protobuf::InterProcessPortalConfig cfg;
+    cfg.set_platform("test_zeromq_router_shards_" + std::to_string(nshards));
+    cfg.set_router_shards(nshards);
+
+    int fds[2];
+    if (pipe(fds) != 0)
+        glog.is(DIE) && glog << "Failed to create pipe" << std::endl;
+
+    // fork the clients before starting any threads
+    auto start = clock_type::now();
+    std::vector<pid_t> children;
+    for (int i = 0; i < nclients; ++i)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            client(cfg, i, nclients, benchmark, fds[1], start);
+            close(fds[1]);
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    close(fds[1]);
+
+    // as gobyd's default router_threads
+    std::unique_ptr<zmq::context_t> router_context(new zmq::context_t(10));
+    std::unique_ptr<zmq::context_t> manager_context(new zmq::context_t(1));
+    goby::zeromq::Router router(*router_context, cfg);
+    assert(router.shards() == nshards);
+    std::thread t1([&] { router.run(); });
+    goby::zeromq::protobuf::InterProcessManagerHold hold;
+    for (int i = 0; i < nclients; ++i) hold.add_required_client(client_name(i));
+    goby::zeromq::Manager manager(*manager_context, cfg, router, hold);
+    std::thread t2([&] { manager.run(); });
+
+    for (auto pid : children)
+    {
+        int wstatus;
+        waitpid(pid, &wstatus, 0);
+        assert(WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0);
+    }
+
+    router_context.reset();
+    manager_context.reset();
+    t1.join();
+    t2.join();
+
+    long total_received = 0;
+    double first_receive_ms = -1, last_receive_ms = 0;
+    for (int i = 0; i < nclients; ++i)
+    {
+        ClientResult result;
+        auto bytes_read = read(fds[0], &result, sizeof(result));
+        assert(bytes_read == sizeof(result));
+        assert(result.received > 0);
+
+        if (!benchmark)
+        {
+            assert(result.received == test_publications);
+            // all the groups (whichever shard they are on) but possibly our own
+            if (result.index == 0)
+                assert(result.regex_groups >= nclients - 1);
+        }
+
+        total_received += result.received;
+        if (first_receive_ms < 0 || result.first_receive_ms < first_receive_ms)
+            first_receive_ms = result.first_receive_ms;
+        last_receive_ms = std::max(last_receive_ms, result.last_receive_ms);
+    }
+    close(fds[0]);
+
+    return total_received / ((last_receive_ms - first_receive_ms) / 1000);
+}
+
+// usage: goby_test_zeromq_router_shards [nclients] [benchmark shard counts...]
+int main(int argc, char* argv[])
+{
+    int nclients = argc > 1 ? std::stoi(argv[1]) : default_nclients;
+    std::vector<int> benchmark_shards;
+    for (int i = 2; i < argc; ++i) benchmark_shards.push_back(std::stoi(argv[i]));
+    if (benchmark_shards.empty())
+        benchmark_shards = default_benchmark_shards;
+
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    // groups are spread over the shards
+    std::set<int> shards_used;
+    for (int i = 0; i < nclients; ++i)
+    {
+        int shard = goby::zeromq::router_shard("/" + data_group(i) + "/", test_shards);
+        assert(shard >= 0 && shard < test_shards);
+        shards_used.insert(shard);
+    }
+    assert(shards_used.size() > 1);
+    assert(goby::zeromq::router_shard("/", test_shards) == -1);
+    assert(goby::zeromq::router_shard("/" + data_group(0) + "/", 1) == 0);
+
+    run(1, nclients, false);
+    run(test_shards, nclients, false);
+    std::cout << "routing: passed" << std::endl;
+
+    // each shard is a thread in the Router process, and each client is a process, so shards can only scale the throughput with spare cores
+    unsigned cores = std::thread::hardware_concurrency();
+    std::cout << "benchmark on " << cores << " core(s)" << std::endl;
+    if (cores <= static_cast<unsigned>(
+                     *std::max_element(benchmark_shards.begin(), benchmark_shards.end())))
+        std::cout << "(fewer cores than shards + 1: no scaling is expected)" << std::endl;
+
+    double first_rate = 0;
+    for (int nshards : benchmark_shards)
+    {
+        double rate = run(nshards, nclients, true);
+        if (first_rate == 0)
+            first_rate = rate;
+        std::cout << nclients << " clients, " << nshards << " shard(s): " << rate
+                  << " publications/s received (" << rate / first_rate << "x)" << std::endl;
+    }
+
+    std::cout << "all tests passed" << std::endl;
+}
@@ -0,0 +1,225 @@
+// Copyright 2026:
+//   GobySoft, LLC (2013-)
+//   Community contributors (see AUTHORS file)
+// File authors:
+//   Toby Schneider <toby@gobysoft.org>
+//
+//
+// This file is part of the Goby Underwater Autonomy Project Binaries
+// ("The Goby Binaries").
+//
+// The Goby Binaries are free software: you can redistribute them and/or modify
+// them under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// The Goby Binaries are distributed in the hope that they will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Goby.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "goby/middleware/marshalling/cstr.h"
+
+#include "goby/middleware/transport/interprocess.h"
+#include "goby/middleware/transport/interthread.h"
+#include "goby/time/steady_clock.h"
+#include "goby/util/debug_logger.h"
+#include "goby/zeromq/transport/interprocess.h"
+
+// benchmarks bringing up a number of client processes against gobyd (Router and Manager) with all the clients required for the hold to be released, with gobyd pushing the release to all clients vs. each client polling for it, and the shutdown of a Forwarder (which waits for the Portal to acknowledge its unsubscribe all)
+
+using goby::glog;
+using namespace goby::util::logger;
+using goby::middleware::InterProcessForwarder;
+using goby::middleware::InterThreadTransporter;
+using Portal = goby::zeromq::InterProcessPortal<InterThreadTransporter>;
+using clock_type = goby::time::SteadyClock;
+
+constexpr goby::middleware::Group data_group{"Data"};
+
+const int default_nclients = 40;
+
+// written by each client to the pipe
+struct ClientTimes
+{
+    // ready() called
+    double ready_ms;
+    // Manager's release received
+    double released_ms;
+    // hold_state() false (after the Portal has waited for the subscriptions to settle)
+    double running_ms;
+    double forwarder_shutdown_ms;
+};
+
+double ms_since(clock_type::time_point start, clock_type::time_point t = clock_type::now())
+{
+    return std::chrono::duration<double, std::milli>(t - start).count();
+}
+
+void poll_until(Portal& zmq, std::function<bool()> done)
+{
+    auto timeout = clock_type::now() + std::chrono::seconds(30);
+    while (!done())
+    {
+        zmq.poll(std::chrono::milliseconds(10));
+        if (clock_type::now() > timeout)
+            glog.is(DIE) && glog << "Timed out" << std::endl;
+    }
+}
+
+std::string client_name(int index) { return "client" + std::to_string(index); }
+
+// child process
+void client(const goby::zeromq::protobuf::InterProcessPortalConfig& cfg, int index, int fd,
+            clock_type::time_point start)
+{
+    auto client_cfg = cfg;
+    client_cfg.set_client_name(client_name(index));
+
+    InterThreadTransporter interthread;
+    Portal zmq(interthread, client_cfg);
+    zmq.subscribe<data_group, std::string>([](const std::string&) {});
+
+    ClientTimes times;
+    times.ready_ms = ms_since(start);
+    zmq.ready();
+    poll_until(zmq, [&]() { return !zmq.hold_state(); });
+    times.running_ms = ms_since(start);
+    times.released_ms = ms_since(start, zmq.hold_release_time());
+
+    // destroy a Forwarder (in another thread) while this thread polls the Portal
+    std::atomic<bool> done{false};
+    std::thread thread([&]() {
+        InterThreadTransporter inner;
+        auto forwarder = std::make_unique<InterProcessForwarder<InterThreadTransporter>>(inner);
+        forwarder->subscribe<data_group, std::string>([](const std::string&) {});
+        auto shutdown_start = clock_type::now();
+        forwarder.reset();
+        times.forwarder_shutdown_ms = ms_since(shutdown_start);
+        done = true;
+    });
+    poll_until(zmq, [&]() { return done.load(); });
+    thread.join();
+
+    auto written = write(fd, &times, sizeof(times));
+    assert(written == sizeof(times));
+}
+
+// returns the latency from the Manager seeing the last required client ready to the last client receiving the release
+double run(int nclients, bool push_release)
+{
+    std::string mode = push_release ? "push" : "poll";
+
+    goby::zeromq::protobuf::InterProcessPortalConfig cfg;
+    cfg.set_platform("test_zeromq_startup_" + mode);
+
+    int fds[2];
+    if (pipe(fds) != 0)
+        glog.is(DIE) && glog << "Failed to create pipe" << std::endl;
+
+    // fork the clients before starting any threads
+    auto start = clock_type::now();
+    std::vector<pid_t> children;
+    for (int i = 0; i < nclients; ++i)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            client(cfg, i, fds[1], start);
+            close(fds[1]);
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    close(fds[1]);
+
+    std::unique_ptr<zmq::context_t> manager_context(new zmq::context_t(1));
+    std::unique_ptr<zmq::context_t> router_context(new zmq::context_t(1));
+    goby::zeromq::Router router(*router_context, cfg);
+    std::thread t1([&] { router.run(); });
+    goby::zeromq::protobuf::InterProcessManagerHold hold;
+    for (int i = 0; i < nclients; ++i) hold.add_required_client(client_name(i));
+    hold.set_push_release(push_release);
+    goby::zeromq::Manager manager(*manager_context, cfg, router, hold);
+    std::thread t2([&] { manager.run(); });
+
+    for (auto pid : children)
+    {
+        int wstatus;
+        waitpid(pid, &wstatus, 0);
+        assert(WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0);
+    }
+
+    router_context.reset();
+    manager_context.reset();
+    t1.join();
+    t2.join();
+
+    // when the Manager saw the last required client ready
+    assert(manager.hold_release_time() != clock_type::time_point());
+    double all_ready_ms = ms_since(start, manager.hold_release_time());
+
+    std::vector<double> latency_ms;
+    double last_ready_ms = 0, last_running_ms = 0, forwarder_ms = 0;
+    for (int i = 0; i < nclients; ++i)
+    {
+        ClientTimes times;
+        auto bytes_read = read(fds[0], &times, sizeof(times));
+        assert(bytes_read == sizeof(times));
+        // no client is released before the last one is ready
+        assert(times.ready_ms <= all_ready_ms);
+        assert(times.released_ms >= all_ready_ms);
+        assert(times.running_ms >= times.released_ms);
+        latency_ms.push_back(times.released_ms - all_ready_ms);
+        last_ready_ms = std::max(last_ready_ms, times.ready_ms);
+        last_running_ms = std::max(last_running_ms, times.running_ms);
+        forwarder_ms += times.forwarder_shutdown_ms;
+    }
+    close(fds[0]);
+
+    std::sort(latency_ms.begin(), latency_ms.end());
+    std::cout << mode << ": " << nclients << " clients: last ready() call at " << last_ready_ms
+              << " ms, Manager saw the last ready at " << all_ready_ms
+              << " ms, clients released after: " << latency_ms.front() << " ms (first), "
+              << latency_ms[latency_ms.size() / 2] << " ms (median), " << latency_ms.back()
+              << " ms (last), all running at " << last_running_ms << " ms" << std::endl;
+    std::cout << mode << ": Forwarder shutdown: " << forwarder_ms / nclients << " ms (mean)"
+              << std::endl;
+
+    return latency_ms.back();
+}
+
+int main(int argc, char* argv[])
+{
+    int nclients = argc > 1 ? std::stoi(argv[1]) : default_nclients;
+
+    goby::glog.add_stream(goby::util::logger::WARN, &std::cerr);
+    goby::glog.set_name(argv[0]);
+    goby::glog.set_lock_action(goby::util::logger_lock::lock);
+
+    double push_ms = run(nclients, true);
+    double poll_ms = run(nclients, false);
+    std::cout << "release of the last client: push: " << push_ms << " ms, poll only: " << poll_ms
+              << " ms" << std::endl;
+
+    std::cout << "all tests passed" << std::endl;
+}
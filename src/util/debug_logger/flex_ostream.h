@@ -106,6 +106,23 @@ class FlexOstream : public std::ostream
         sb_.remove_stream(os);
     }
 
+    /// Write lines from a separate thread (see FlexOStreamBuf::enable_async())
+    void enable_async(const goby::util::protobuf::GLogConfig::Async& cfg =
+                          goby::util::protobuf::GLogConfig::Async())
+    {
+        std::lock_guard<std::recursive_mutex> l(goby::util::logger::mutex);
+        sb_.enable_async(cfg);
+    }
+
+    void disable_async()
+    {
+        std::lock_guard<std::recursive_mutex> l(goby::util::logger::mutex);
+        sb_.disable_async();
+    }
+
+    /// Block until all lines logged so far have been written to the attached streams
+    void flush_async() { sb_.flush_async(); }
+
     const FlexOStreamBuf& buf() { return sb_; }
 
     //@}
@@ -25,21 +25,23 @@
 #include <algorithm> // for copy, max
 #include <atomic>    // for atomic
 #include <cassert>   // for assert
-#include <chrono>    // for time_point
-#include <cstdio>    // for EOF
-#include <cstdlib>   // for exit
-#include <deque>     // for deque
-#include <iomanip>   // for operator<<
-#include <iostream>  // for operator<<
-#include <iterator>  // for ostreamb...
-#include <map>       // for map, map...
-#include <memory>    // for make_shared
-#include <mutex>     // for mutex
-#include <sstream>   // for basic_st...
-#include <string>    // for string
-#include <thread>    // for thread
-#include <utility>   // for move, pair
-#include <vector>    // for vector
+#include <chrono>             // for time_point
+#include <condition_variable> // for condition_variable
+#include <cstdint>            // for uint64_t
+#include <cstdio>             // for EOF
+#include <cstdlib>            // for exit
+#include <deque>              // for deque
+#include <iomanip>            // for operator<<
+#include <iostream>           // for operator<<
+#include <iterator>           // for ostreamb...
+#include <map>                // for map, map...
+#include <memory>             // for make_shared
+#include <mutex>              // for mutex
+#include <sstream>            // for basic_st...
+#include <string>             // for string
+#include <thread>             // for thread
+#include <utility>            // for move, pair
+#include <vector>             // for vector
 
 #include <boost/date_time/gregorian/gregorian.hpp>          // for date
 #include <boost/date_time/posix_time/posix_time_config.hpp> // for time_dur...
@@ -66,6 +68,228 @@ std::mutex curses_mutex;
 
 std::recursive_mutex goby::util::logger::mutex;
 
+namespace
+{
+/// Bounded lock-free multiple producer, single consumer queue (after Dmitry Vyukov's bounded MPMC queue)
+template <typename T> class BoundedMPSCQueue
+{
+  public:
+    explicit BoundedMPSCQueue(std::size_t size) : mask_(round_up_pow2(size) - 1)
+    {
+        cells_.reset(new Cell[mask_ + 1]);
+        for (std::size_t i = 0; i <= mask_; ++i) cells_[i].sequence.store(i);
+    }
+
+    /// moves from value and returns true unless the queue is full
+    bool push(T& value)
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_release,
+                                                       std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// only to be called from the consumer thread
+    bool pop(T& value)
+    {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            return false;
+        value = std::move(cell.value);
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// true if no value has been (or is being) pushed since the last pop
+    bool empty() const { return enqueue_pos_.load() == dequeue_pos_.load(); }
+
+  private:
+    static std::size_t round_up_pow2(std::size_t size)
+    {
+        std::size_t pow2 = 2;
+        while (pow2 < size) pow2 <<= 1;
+        return pow2;
+    }
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    const std::size_t mask_;
+    std::atomic<std::size_t> enqueue_pos_{0};
+    // keep the producer and consumer positions on separate cache lines
+    char padding_[64];
+    std::atomic<std::size_t> dequeue_pos_{0};
+};
+} // namespace
+
+/// Writes the lines queued by the logging threads to the attached streams from its own thread
+class goby::util::FlexOStreamBuf::AsyncSink
+{
+  public:
+    AsyncSink(FlexOStreamBuf& buf, const protobuf::GLogConfig::Async& cfg)
+        : buf_(buf),
+          queue_(cfg.queue_size()),
+          overflow_(cfg.overflow()),
+          thread_([this]() { run(); })
+    {
+    }
+
+    /// writes any remaining lines before returning
+    ~AsyncSink()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            alive_ = false;
+            wake_cv_.notify_one();
+        }
+        thread_.join();
+    }
+
+    void push(Line& line)
+    {
+        while (!queue_.push(line))
+        {
+            // never drop the line explaining why we're exiting
+            if (overflow_ == protobuf::GLogConfig::Async::DROP_NEWEST && !line.die)
+            {
+                ++dropped_;
+                return;
+            }
+            std::this_thread::yield();
+        }
+        ++queued_;
+
+        // only lock if the writing thread has (or is about to) run out of lines. The fence orders our push before the load of sink_waiting_, pairing with run()'s (seq_cst) store of sink_waiting_ before it checks queue_.empty(): either we see sink_waiting_ or it sees our line
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sink_waiting_.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wake_cv_.notify_one();
+        }
+    }
+
+    void flush()
+    {
+        std::uint64_t target = queued_;
+        std::unique_lock<std::mutex> lock(mutex_);
+        written_cv_.wait(lock, [&]() { return written_ >= target; });
+    }
+
+    AsyncStatistics statistics() const
+    {
+        AsyncStatistics stats;
+        stats.queued = queued_;
+        stats.written = written_;
+        stats.dropped = dropped_;
+        return stats;
+    }
+
+  private:
+    void run()
+    {
+        Line line;
+        for (;;)
+        {
+            std::uint64_t batch = 0;
+            while (batch < max_batch && queue_.pop(line))
+            {
+                display(line);
+                ++batch;
+            }
+
+            std::uint64_t dropped = dropped_;
+            if (dropped != dropped_reported_)
+            {
+                std::stringstream ss;
+                ss << logger::warn << "Dropped " << dropped - dropped_reported_
+                   << " log line(s) as the queue was full";
+                Line warning{ss.str(), logger::WARN, "", false, SystemClock::now()};
+                display(warning);
+                dropped_reported_ = dropped;
+            }
+
+            // flush once per batch, rather than once per line as sync() does
+            {
+                std::lock_guard<std::mutex> lock(buf_.display_mutex_);
+                buf_.flush_streams();
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (batch > 0)
+            {
+                written_ += batch;
+                written_cv_.notify_all();
+            }
+
+            // push() checks sink_waiting_ after pushing, so either it notifies us or we see the line here
+            sink_waiting_.store(true, std::memory_order_seq_cst);
+            if (queue_.empty())
+            {
+                if (!alive_)
+                    break;
+                wake_cv_.wait(lock, [this]() { return !queue_.empty() || !alive_; });
+            }
+            sink_waiting_.store(false, std::memory_order_seq_cst);
+        }
+    }
+
+    void display(Line& line)
+    {
+        std::lock_guard<std::mutex> lock(buf_.display_mutex_);
+        buf_.display(line, false);
+    }
+
+  private:
+    // maximum number of lines written between flushes of the streams
+    static constexpr std::uint64_t max_batch{256};
+
+    FlexOStreamBuf& buf_;
+    BoundedMPSCQueue<Line> queue_;
+    const protobuf::GLogConfig::Async::OverflowPolicy overflow_;
+
+    std::atomic<std::uint64_t> queued_{0};
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    // only used by the writing thread
+    std::uint64_t dropped_reported_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable written_cv_;
+    std::atomic<bool> sink_waiting_{false};
+    bool alive_{true};
+
+    // last, so that everything above is constructed before run() starts
+    std::thread thread_;
+};
+
 goby::util::FlexOStreamBuf::FlexOStreamBuf(FlexOstream* parent)
     : buffer_(1),
       name_("no name"),
@@ -84,6 +308,8 @@ goby::util::FlexOStreamBuf::FlexOStreamBuf(FlexOstream* parent)
 
 goby::util::FlexOStreamBuf::~FlexOStreamBuf()
 {
+    disable_async();
+
 #ifdef HAS_NCURSES
     if (curses_)
         delete curses_;
@@ -92,6 +318,8 @@ goby::util::FlexOStreamBuf::~FlexOStreamBuf()
 
 void goby::util::FlexOStreamBuf::add_stream(logger::Verbosity verbosity, std::ostream* os)
 {
+    std::lock_guard<std::mutex> lock(display_mutex_);
+
     //check that this stream doesn't exist
     // if so, update its verbosity and return
     bool stream_exists = false;
@@ -117,6 +345,10 @@ void goby::util::FlexOStreamBuf::add_stream(logger::Verbosity verbosity, std::os
 
 void goby::util::FlexOStreamBuf::remove_stream(std::ostream* os)
 {
+    // write the lines logged before removal to os, and never touch it afterwards
+    flush_async();
+    std::lock_guard<std::mutex> lock(display_mutex_);
+
     streams_.erase(std::remove_if(streams_.begin(), streams_.end(),
                                   [&os](const StreamConfig& sc) { return sc.os() == os; }));
 
@@ -131,6 +363,7 @@ void goby::util::FlexOStreamBuf::remove_stream(std::ostream* os)
 void goby::util::FlexOStreamBuf::enable_gui()
 {
 #ifdef HAS_NCURSES
+    std::lock_guard<std::mutex> display_lock(display_mutex_);
 
     is_gui_ = true;
     curses_ = new FlexNCurses;
@@ -156,6 +389,8 @@ void goby::util::FlexOStreamBuf::enable_gui()
 
 void goby::util::FlexOStreamBuf::add_group(const std::string& name, logger::Group g)
 {
+    std::lock_guard<std::mutex> display_lock(display_mutex_);
+
     bool group_existed = groups_.count(name);
 
     groups_[name] = std::move(g);
@@ -202,7 +437,17 @@ int goby::util::FlexOStreamBuf::sync()
     // all but last one
     while (buffer_.size() > 1)
     {
-        display(buffer_.front());
+        Line line{std::move(buffer_.front()), current_verbosity_, group_name_, die_flag_,
+                  SystemClock::now()};
+        if (async_)
+        {
+            async_->push(line);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(display_mutex_);
+            display(line);
+        }
         buffer_.pop_front();
     }
 
@@ -216,45 +461,76 @@ int goby::util::FlexOStreamBuf::sync()
     }
 
     if (die_flag_)
+    {
+        flush_async();
         exit(EXIT_FAILURE);
+    }
 
     return 0;
 }
 
-void goby::util::FlexOStreamBuf::display(std::string& s)
+void goby::util::FlexOStreamBuf::enable_async(const protobuf::GLogConfig::Async& cfg)
+{
+    if (!async_)
+        async_.reset(new AsyncSink(*this, cfg));
+}
+
+void goby::util::FlexOStreamBuf::disable_async() { async_.reset(); }
+
+void goby::util::FlexOStreamBuf::flush_async()
+{
+    if (async_)
+        async_->flush();
+}
+
+goby::util::FlexOStreamBuf::AsyncStatistics goby::util::FlexOStreamBuf::async_statistics() const
 {
+    return async_ ? async_->statistics() : AsyncStatistics();
+}
+
+void goby::util::FlexOStreamBuf::display(Line& line, bool flush /*= true*/)
+{
+    std::string& s = line.text;
+    auto end_line = [flush](std::ostream& os)
+    {
+        if (flush)
+            os << std::endl;
+        else
+            os << '\n';
+    };
+
     bool gui_displayed = false;
     for (const StreamConfig& cfg : streams_)
     {
         if ((cfg.os() == &std::cout || cfg.os() == &std::cerr || cfg.os() == &std::clog) &&
-            current_verbosity_ <= cfg.verbosity())
+            line.verbosity <= cfg.verbosity())
         {
 #ifdef HAS_NCURSES
-            if (is_gui_ && current_verbosity_ <= cfg.verbosity() && !gui_displayed)
+            if (is_gui_ && line.verbosity <= cfg.verbosity() && !gui_displayed)
             {
-                if (!die_flag_)
+                if (!line.die)
                 {
                     std::lock_guard<std::mutex> lock(curses_mutex);
-                    std::stringstream line;
+                    std::stringstream gui_line;
                     boost::posix_time::time_duration time_of_day =
-                        SystemClock::now<boost::posix_time::ptime>().time_of_day();
-                    line << "\n"
-                         << std::setfill('0') << std::setw(2) << time_of_day.hours() << ":"
-                         << std::setw(2) << time_of_day.minutes() << ":" << std::setw(2)
-                         << time_of_day.seconds()
-                         << TermColor::esc_code_from_col(groups_[group_name_].color()) << " | "
-                         << esc_nocolor << s;
-
-                    curses_->insert(SystemClock::now<boost::posix_time::ptime>(), line.str(),
-                                    &groups_[group_name_]);
+                        time::convert<boost::posix_time::ptime>(line.time).time_of_day();
+                    gui_line << "\n"
+                             << std::setfill('0') << std::setw(2) << time_of_day.hours() << ":"
+                             << std::setw(2) << time_of_day.minutes() << ":" << std::setw(2)
+                             << time_of_day.seconds()
+                             << TermColor::esc_code_from_col(groups_[line.group_name].color())
+                             << " | " << esc_nocolor << s;
+
+                    curses_->insert(time::convert<boost::posix_time::ptime>(line.time),
+                                    gui_line.str(), &groups_[line.group_name]);
                 }
                 else
                 {
                     curses_->alive(false);
                     input_thread_->join();
                     curses_->cleanup();
-                    std::cerr << TermColor::esc_code_from_col(groups_[group_name_].color()) << name_
-                              << esc_nocolor << ": " << s << esc_nocolor << std::endl;
+                    std::cerr << TermColor::esc_code_from_col(groups_[line.group_name].color())
+                              << name_ << esc_nocolor << ": " << s << esc_nocolor << std::endl;
                 }
                 gui_displayed = true;
                 continue;
@@ -264,22 +540,33 @@ void goby::util::FlexOStreamBuf::display(std::string& s)
             (void)gui_displayed;
 #endif
 
-            *cfg.os() << TermColor::esc_code_from_col(groups_[group_name_].color()) << name_
-                      << esc_nocolor << " [" << goby::time::str() << "]";
-            if (!group_name_.empty())
+            *cfg.os() << TermColor::esc_code_from_col(groups_[line.group_name].color()) << name_
+                      << esc_nocolor << " [" << goby::time::str(line.time) << "]";
+            if (!line.group_name.empty())
                 *cfg.os() << " "
-                          << "{" << group_name_ << "}";
-            *cfg.os() << ": " << s << std::endl;
+                          << "{" << line.group_name << "}";
+            *cfg.os() << ": " << s;
+            end_line(*cfg.os());
         }
-        else if (cfg.os() && current_verbosity_ <= cfg.verbosity())
+        else if (cfg.os() && line.verbosity <= cfg.verbosity())
         {
-            goby::util::logger::basic_log_header(*cfg.os(), group_name_);
+            goby::util::logger::basic_log_header(*cfg.os(), line.group_name, line.time);
             strip_escapes(s);
-            *cfg.os() << s << std::endl;
+            *cfg.os() << s;
+            end_line(*cfg.os());
         }
     }
 }
 
+void goby::util::FlexOStreamBuf::flush_streams()
+{
+    for (const StreamConfig& cfg : streams_)
+    {
+        if (cfg.os())
+            cfg.os()->flush();
+    }
+}
+
 void goby::util::FlexOStreamBuf::refresh()
 {
 #ifdef HAS_NCURSES
@@ -26,6 +26,7 @@
 #define GOBY_UTIL_DEBUG_LOGGER_FLEX_OSTREAMBUF_H
 
 #include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <deque>
 #include <iostream>
@@ -38,6 +39,7 @@
 #include <boost/date_time.hpp>
 #include <memory>
 
+#include "goby/time/system_clock.h"
 #include "goby/util/protobuf/debug_logger.pb.h"
 
 #include "term_color.h"
@@ -97,7 +99,11 @@ class FlexOStreamBuf : public std::streambuf
     int overflow(int c = EOF);
 
     /// name of the application being served
-    void name(const std::string& s) { name_ = s; }
+    void name(const std::string& s)
+    {
+        std::lock_guard<std::mutex> lock(display_mutex_);
+        name_ = s;
+    }
 
     /// add a stream to the logger
     void add_stream(logger::Verbosity verbosity, std::ostream* os);
@@ -135,8 +141,46 @@ class FlexOStreamBuf : public std::streambuf
 
     logger_lock::LockAction lock_action() { return lock_action_; }
 
+    /// \brief Write lines from a separate thread rather than from within sync()
+    ///
+    /// Completed lines (with the time they were logged) are passed through a bounded lock-free queue to the writing thread, so the logging thread doesn't wait on the attached streams. Call before logging from multiple threads (as for enable_gui()).
+    void enable_async(const protobuf::GLogConfig::Async& cfg = protobuf::GLogConfig::Async());
+
+    /// \brief Write any queued lines, stop the writing thread and return to writing from within sync()
+    void disable_async();
+
+    bool is_async() const { return async_ != nullptr; }
+
+    /// \brief Block until all the lines queued so far have been written (returns immediately if !is_async())
+    void flush_async();
+
+    struct AsyncStatistics
+    {
+        /// lines passed to the writing thread
+        std::uint64_t queued{0};
+        /// lines written by the writing thread
+        std::uint64_t written{0};
+        /// lines discarded as the queue was full (GLogConfig::Async::DROP_NEWEST)
+        std::uint64_t dropped{0};
+    };
+    AsyncStatistics async_statistics() const;
+
   private:
-    void display(std::string& s);
+    /// a completed line, with everything needed to display it
+    struct Line
+    {
+        std::string text;
+        logger::Verbosity verbosity{logger::UNKNOWN};
+        std::string group_name;
+        bool die{false};
+        time::SystemClock::time_point time;
+    };
+
+    class AsyncSink;
+
+    // flush: end with std::endl rather than '\n'
+    void display(Line& line, bool flush = true);
+    void flush_streams();
     void strip_escapes(std::string& s);
 
   private:
@@ -180,6 +224,10 @@ class FlexOStreamBuf : public std::streambuf
 
     std::atomic<logger_lock::LockAction> lock_action_;
     //    FlexOstream* parent_;
+
+    // held while writing a line, or changing the streams, groups or name that it uses
+    std::mutex display_mutex_;
+    std::unique_ptr<AsyncSink> async_;
 };
 } // namespace util
 } // namespace goby
@@ -110,7 +110,7 @@ void goby::zeromq::setup_socket(zmq::socket_t& socket, const protobuf::Socket& c
 //
 
 goby::zeromq::InterProcessPortalMainThread::InterProcessPortalMainThread(zmq::context_t& context)
-    : control_socket_(context, ZMQ_PAIR), publish_socket_(context, ZMQ_PUB)
+    : context_(context), control_socket_(context, ZMQ_PAIR), publish_socket_(context, ZMQ_XPUB)
 {
     control_socket_.bind("inproc://control");
 }
@@ -131,9 +131,16 @@ bool goby::zeromq::InterProcessPortalMainThread::recv(protobuf::InprocControl* c
     return message_received;
 }
 
-void goby::zeromq::InterProcessPortalMainThread::set_publish_cfg(const protobuf::Socket& cfg)
+void goby::zeromq::InterProcessPortalMainThread::set_publish_cfg(
+    const protobuf::Socket& cfg,
+    const google::protobuf::RepeatedPtrField<protobuf::Socket>& shard_cfg)
 {
     setup_socket(publish_socket_, cfg);
+    for (const auto& socket_cfg : shard_cfg)
+    {
+        shard_publish_sockets_.push_back(std::make_unique<zmq::socket_t>(context_, ZMQ_XPUB));
+        setup_socket(*shard_publish_sockets_.back(), socket_cfg);
+    }
     have_pubsub_sockets_ = true;
 }
 
@@ -143,6 +150,7 @@ void goby::zeromq::InterProcessPortalMainThread::set_hold_state(bool hold)
     if (hold_ && !hold)
     {
         hold_ = hold;
+        hold_release_time_ = goby::time::SteadyClock::now();
 
         // TODO: this is necessary to allow initial ZMQ subscription forwarding
         // messages to flow through the system so that we don't lose the
@@ -169,28 +177,58 @@ void goby::zeromq::InterProcessPortalMainThread::set_hold_state(bool hold)
     send_control_msg(control);
 }
 
-void goby::zeromq::InterProcessPortalMainThread::publish(const std::string& identifier,
-                                                         const char* bytes, int size,
-                                                         bool ignore_buffer)
+void goby::zeromq::InterProcessPortalMainThread::send_publication(const std::string& identifier,
+                                                                  zmq::message_t& msg)
 {
-    if (publish_ready() || ignore_buffer)
-    {
-        zmq::message_t msg(identifier.size() + size);
-        memcpy(msg.data(), identifier.data(), identifier.size());
-        memcpy(static_cast<char*>(msg.data()) + identifier.size(), bytes, size);
+    auto size = msg.size() - identifier.size();
+    publish_socket(router_shard(identifier, shards())).send(msg, zmq_send_flags_none);
 
-        publish_socket_.send(msg, zmq_send_flags_none);
+    glog.is(DEBUG3) && glog << "Published " << size << " bytes to ["
+                            << identifier.substr(0, identifier.size() - 1) << "]" << std::endl;
+}
 
-        glog.is(DEBUG3) && glog << "Published " << size << " bytes to ["
-                                << identifier.substr(0, identifier.size() - 1) << "]" << std::endl;
-    }
-    else
-    {
-        glog.is(DEBUG3) && glog << "Buffering publication of " << size << " bytes to ["
-                                << identifier.substr(0, identifier.size() - 1) << "]" << std::endl;
+void goby::zeromq::InterProcessPortalMainThread::buffer_publication(const std::string& identifier,
+                                                                    std::vector<char> bytes)
+{
+    glog.is(DEBUG3) && glog << "Buffering publication of " << bytes.size() << " bytes to ["
+                            << identifier.substr(0, identifier.size() - 1) << "]" << std::endl;
 
-        publish_queue_.emplace_back(identifier, std::vector<char>(bytes, bytes + size));
+    publish_queue_.emplace_back(identifier, std::move(bytes));
+}
+
+void goby::zeromq::InterProcessPortalMainThread::update_subscriptions()
+{
+    if (!have_pubsub_sockets_)
+        return;
+
+#ifdef USE_OLD_ZMQ_CPP_API
+    int flags = ZMQ_NOBLOCK;
+#else
+    auto flags = zmq::recv_flags::dontwait;
+#endif
+
+    // the XPUB sockets receive the (aggregate) subscriptions of all the processes from each Router shard
+    zmq::message_t msg;
+    for (int shard = 0, n = shards(); shard < n; ++shard)
+    {
+        while (zmq_socket_recv(publish_socket(shard), msg, flags))
+        {
+            subscriptions_->handle_subscription_message(static_cast<const char*>(msg.data()),
+                                                        msg.size());
+        }
     }
+
+    if (publish_ready())
+        subscriptions_->set_updated();
+}
+
+bool goby::zeromq::InterProcessPortalMainThread::has_subscribers(const std::string& identifier)
+{
+    if (!publish_ready())
+        return true;
+
+    update_subscriptions();
+    return subscriptions_->has_subscribers(identifier);
 }
 
 void goby::zeromq::InterProcessPortalMainThread::subscribe(const std::string& identifier)
@@ -244,18 +282,86 @@ void goby::zeromq::InterProcessPortalMainThread::send_control_msg(
     control_socket_.send(zmq_control_msg, zmq_send_flags_none);
 }
 
+//
+// SubscriptionTracker
+//
+void goby::zeromq::SubscriptionTracker::handle_subscription_message(const char* data,
+                                                                  std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    std::string topic(data + 1, size - 1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (data[0])
+    {
+        case 1:
+            glog.is(DEBUG3) && glog << "Subscriber added for [" << topic << "]" << std::endl;
+            topics_.insert(topic);
+            break;
+        case 0:
+        {
+            glog.is(DEBUG3) && glog << "No more subscribers for [" << topic << "]" << std::endl;
+            auto it = topics_.find(topic);
+            if (it != topics_.end())
+                topics_.erase(it);
+            break;
+        }
+        default: return;
+    }
+    cache_.clear();
+}
+
+void goby::zeromq::SubscriptionTracker::set_updated()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    updated_ = true;
+    last_update_ = std::chrono::steady_clock::now();
+}
+
+bool goby::zeromq::SubscriptionTracker::has_subscribers(
+    const std::string& identifier, std::chrono::steady_clock::duration max_age)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!updated_ || std::chrono::steady_clock::now() - last_update_ > max_age)
+        return true;
+
+    auto it = cache_.find(identifier);
+    if (it != cache_.end())
+        return it->second;
+
+    // same prefix matching as performed by ZeroMQ on the publisher side
+    bool subscribed = false;
+    for (const auto& topic : topics_)
+    {
+        if (identifier.compare(0, topic.size(), topic) == 0)
+        {
+            subscribed = true;
+            break;
+        }
+    }
+
+    // identifiers include the publishing thread, so bound the cache in case of many short-lived threads
+    const std::size_t max_cache_size = 10000;
+    if (cache_.size() >= max_cache_size)
+        cache_.clear();
+    cache_.insert(std::make_pair(identifier, subscribed));
+    return subscribed;
+}
+
 //
 // InterProcessPortalReadThread
 //
 goby::zeromq::InterProcessPortalReadThread::InterProcessPortalReadThread(
     const protobuf::InterProcessPortalConfig& cfg, zmq::context_t& context,
-    std::atomic<bool>& alive, std::shared_ptr<std::condition_variable_any> poller_cv)
+    std::atomic<bool>& alive, std::shared_ptr<middleware::PollerWakeup> poller_wakeup)
     : cfg_(cfg),
+      context_(context),
       control_socket_(context, ZMQ_PAIR),
       subscribe_socket_(context, ZMQ_SUB),
       manager_socket_(context, ZMQ_REQ),
       alive_(alive),
-      poller_cv_(std::move(poller_cv))
+      poller_wakeup_(std::move(poller_wakeup))
 {
     poll_items_.resize(NUMBER_SOCKETS);
     poll_items_[SOCKET_CONTROL] = {(void*)control_socket_, 0, ZMQ_POLLIN, 0};
@@ -371,6 +477,11 @@ void goby::zeromq::InterProcessPortalReadThread::poll(long timeout_ms)
                     if (zmq_socket_recv(manager_socket_, zmq_msg))
                         manager_data(zmq_msg);
                     break;
+                default:
+                    // Router shards 1 and up
+                    if (zmq_socket_recv(subscribe_socket(i - NUMBER_SOCKETS + 1), zmq_msg))
+                        subscribe_data(zmq_msg);
+                    break;
             }
         }
     }
@@ -387,11 +498,7 @@ void goby::zeromq::InterProcessPortalReadThread::control_data(const zmq::message
         case protobuf::InprocControl::SUBSCRIBE:
         {
             auto& zmq_filter = control_msg.subscription_identifier();
-#ifdef USE_OLD_CPPZMQ_SETSOCKOPT
-            subscribe_socket_.setsockopt(ZMQ_SUBSCRIBE, zmq_filter.c_str(), zmq_filter.size());
-#else
-            subscribe_socket_.set(zmq::sockopt::subscribe, zmq_filter);
-#endif
+            set_subscription(zmq_filter, true);
 
             glog.is(DEBUG2) && glog << "subscribed with identifier: [" << zmq_filter << "]"
                                     << std::endl;
@@ -408,11 +515,7 @@ void goby::zeromq::InterProcessPortalReadThread::control_data(const zmq::message
             glog.is(DEBUG2) && glog << "unsubscribing with identifier: [" << zmq_filter << "]"
                                     << std::endl;
 
-#ifdef USE_OLD_CPPZMQ_SETSOCKOPT
-            subscribe_socket_.setsockopt(ZMQ_UNSUBSCRIBE, zmq_filter.c_str(), zmq_filter.size());
-#else
-            subscribe_socket_.set(zmq::sockopt::unsubscribe, zmq_filter);
-#endif
+            set_subscription(zmq_filter, false);
 
             protobuf::InprocControl control_ack;
             control_ack.set_type(protobuf::InprocControl::UNSUBSCRIBE_ACK);
@@ -437,6 +540,27 @@ void goby::zeromq::InterProcessPortalReadThread::control_data(const zmq::message
         default: break;
     }
 }
+void goby::zeromq::InterProcessPortalReadThread::set_subscription(const std::string& zmq_filter,
+                                                                  bool subscribe)
+{
+    int shard = router_shard(zmq_filter, shards());
+    for (int i = 0, n = shards(); i < n; ++i)
+    {
+        if (shard >= 0 && shard != i)
+            continue;
+
+#ifdef USE_OLD_CPPZMQ_SETSOCKOPT
+        subscribe_socket(i).setsockopt(subscribe ? ZMQ_SUBSCRIBE : ZMQ_UNSUBSCRIBE,
+                                       zmq_filter.c_str(), zmq_filter.size());
+#else
+        if (subscribe)
+            subscribe_socket(i).set(zmq::sockopt::subscribe, zmq_filter);
+        else
+            subscribe_socket(i).set(zmq::sockopt::unsubscribe, zmq_filter);
+#endif
+    }
+}
+
 void goby::zeromq::InterProcessPortalReadThread::subscribe_data(const zmq::message_t& zmq_msg)
 {
     // data from goby - forward to the main thread
@@ -455,19 +579,30 @@ void goby::zeromq::InterProcessPortalReadThread::manager_data(const zmq::message
 
     if (response.request() == protobuf::PROVIDE_PUB_SUB_SOCKETS)
     {
-        if (response.subscribe_socket().transport() == protobuf::Socket::TCP)
-            response.mutable_subscribe_socket()->set_ethernet_address(
-                cfg_.has_ip_address() ? cfg_.ip_address() : cfg_.ipv4_address());
-        if (response.publish_socket().transport() == protobuf::Socket::TCP)
-            response.mutable_publish_socket()->set_ethernet_address(
-                cfg_.has_ip_address() ? cfg_.ip_address() : cfg_.ipv4_address());
+        auto set_address = [this](protobuf::Socket* socket)
+        {
+            if (socket->transport() == protobuf::Socket::TCP)
+                socket->set_ethernet_address(cfg_.has_ip_address() ? cfg_.ip_address()
+                                                                   : cfg_.ipv4_address());
+        };
+        set_address(response.mutable_subscribe_socket());
+        set_address(response.mutable_publish_socket());
+        for (auto& socket : *response.mutable_shard_subscribe_socket()) set_address(&socket);
+        for (auto& socket : *response.mutable_shard_publish_socket()) set_address(&socket);
 
         setup_socket(subscribe_socket_, response.subscribe_socket());
+        for (const auto& socket_cfg : response.shard_subscribe_socket())
+        {
+            shard_subscribe_sockets_.push_back(std::make_unique<zmq::socket_t>(context_, ZMQ_SUB));
+            setup_socket(*shard_subscribe_sockets_.back(), socket_cfg);
+            poll_items_.push_back({(void*)*shard_subscribe_sockets_.back(), 0, ZMQ_POLLIN, 0});
+        }
 
         protobuf::InprocControl control;
         control.set_type(protobuf::InprocControl::PUB_CONFIGURATION);
         control.set_hold(response.hold());
         *control.mutable_publish_socket() = response.publish_socket();
+        *control.mutable_shard_publish_socket() = response.shard_publish_socket();
         send_control_msg(control);
 
         have_pubsub_sockets_ = true;
@@ -482,7 +617,7 @@ void goby::zeromq::InterProcessPortalReadThread::send_control_msg(
     zmq::message_t zmq_control_msg(control.ByteSizeLong());
     control.SerializeToArray((char*)zmq_control_msg.data(), zmq_control_msg.size());
     control_socket_.send(zmq_control_msg, zmq_send_flags_none);
-    poller_cv_->notify_all();
+    poller_wakeup_->notify();
 }
 
 //
@@ -503,55 +638,10 @@ unsigned goby::zeromq::Router::last_port(zmq::socket_t& socket)
     return port;
 }
 
-void goby::zeromq::Router::run()
+namespace
+{
+void run_proxy(zmq::socket_t& frontend, zmq::socket_t& backend)
 {
-    zmq::socket_t frontend(context_, ZMQ_XPUB);
-    zmq::socket_t backend(context_, ZMQ_XSUB);
-
-    int send_hwm = cfg_.send_queue_size();
-    int receive_hwm = cfg_.receive_queue_size();
-
-#ifdef USE_OLD_CPPZMQ_SETSOCKOPT
-    frontend.setsockopt(ZMQ_SNDHWM, &send_hwm, sizeof(send_hwm));
-    backend.setsockopt(ZMQ_SNDHWM, &send_hwm, sizeof(send_hwm));
-    frontend.setsockopt(ZMQ_RCVHWM, &receive_hwm, sizeof(receive_hwm));
-    backend.setsockopt(ZMQ_RCVHWM, &receive_hwm, sizeof(receive_hwm));
-    frontend.setsockopt(ZMQ_IPV6, 1);
-    backend.setsockopt(ZMQ_IPV6, 1);
-#else
-    frontend.set(zmq::sockopt::sndhwm, send_hwm);
-    backend.set(zmq::sockopt::sndhwm, send_hwm);
-    frontend.set(zmq::sockopt::rcvhwm, receive_hwm);
-    backend.set(zmq::sockopt::rcvhwm, receive_hwm);
-    frontend.set(zmq::sockopt::ipv6, 1);
-    backend.set(zmq::sockopt::ipv6, 1);
-#endif
-
-    switch (cfg_.transport())
-    {
-        case protobuf::InterProcessPortalConfig::IPC:
-        {
-            std::string xpub_sock_name =
-                "ipc://" +
-                (cfg_.has_socket_name() ? cfg_.socket_name() : "/tmp/goby_" + cfg_.platform()) +
-                ".xpub";
-            std::string xsub_sock_name =
-                "ipc://" +
-                (cfg_.has_socket_name() ? cfg_.socket_name() : "/tmp/goby_" + cfg_.platform()) +
-                ".xsub";
-            frontend.bind(xpub_sock_name.c_str());
-            backend.bind(xsub_sock_name.c_str());
-            break;
-        }
-        case protobuf::InterProcessPortalConfig::TCP:
-        {
-            frontend.bind("tcp://*:0");
-            backend.bind("tcp://*:0");
-            pub_port = last_port(frontend);
-            sub_port = last_port(backend);
-            break;
-        }
-    }
     try
     {
 #ifdef USE_OLD_ZMQ_CPP_API
@@ -570,6 +660,85 @@ void goby::zeromq::Router::run()
     }
 }
 
+// IPC socket name suffix for a Router shard (shard 0 keeps the unsharded names)
+std::string shard_suffix(int shard) { return shard == 0 ? "" : "." + std::to_string(shard); }
+} // namespace
+
+void goby::zeromq::Router::run()
+{
+    std::vector<std::unique_ptr<zmq::socket_t>> frontends, backends;
+
+    int send_hwm = cfg_.send_queue_size();
+    int receive_hwm = cfg_.receive_queue_size();
+
+    for (int shard = 0; shard < shards_; ++shard)
+    {
+        frontends.push_back(std::make_unique<zmq::socket_t>(context_, ZMQ_XPUB));
+        backends.push_back(std::make_unique<zmq::socket_t>(context_, ZMQ_XSUB));
+        zmq::socket_t& frontend = *frontends.back();
+        zmq::socket_t& backend = *backends.back();
+
+#ifdef USE_OLD_CPPZMQ_SETSOCKOPT
+        frontend.setsockopt(ZMQ_SNDHWM, &send_hwm, sizeof(send_hwm));
+        backend.setsockopt(ZMQ_SNDHWM, &send_hwm, sizeof(send_hwm));
+        frontend.setsockopt(ZMQ_RCVHWM, &receive_hwm, sizeof(receive_hwm));
+        backend.setsockopt(ZMQ_RCVHWM, &receive_hwm, sizeof(receive_hwm));
+        frontend.setsockopt(ZMQ_IPV6, 1);
+        backend.setsockopt(ZMQ_IPV6, 1);
+#else
+        frontend.set(zmq::sockopt::sndhwm, send_hwm);
+        backend.set(zmq::sockopt::sndhwm, send_hwm);
+        frontend.set(zmq::sockopt::rcvhwm, receive_hwm);
+        backend.set(zmq::sockopt::rcvhwm, receive_hwm);
+        frontend.set(zmq::sockopt::ipv6, 1);
+        backend.set(zmq::sockopt::ipv6, 1);
+#endif
+
+        switch (cfg_.transport())
+        {
+            case protobuf::InterProcessPortalConfig::IPC:
+            {
+                std::string xpub_sock_name =
+                    "ipc://" +
+                    (cfg_.has_socket_name() ? cfg_.socket_name()
+                                            : "/tmp/goby_" + cfg_.platform()) +
+                    ".xpub" + shard_suffix(shard);
+                std::string xsub_sock_name =
+                    "ipc://" +
+                    (cfg_.has_socket_name() ? cfg_.socket_name()
+                                            : "/tmp/goby_" + cfg_.platform()) +
+                    ".xsub" + shard_suffix(shard);
+                frontend.bind(xpub_sock_name.c_str());
+                backend.bind(xsub_sock_name.c_str());
+                break;
+            }
+            case protobuf::InterProcessPortalConfig::TCP:
+            {
+                frontend.bind("tcp://*:0");
+                backend.bind("tcp://*:0");
+                shard_pub_ports_[shard] = last_port(frontend);
+                shard_sub_ports_[shard] = last_port(backend);
+                break;
+            }
+        }
+    }
+
+    // the Manager waits for these, so set them once all the shard ports are known
+    if (cfg_.transport() == protobuf::InterProcessPortalConfig::TCP)
+    {
+        pub_port = shard_pub_ports_[0];
+        sub_port = shard_sub_ports_[0];
+    }
+
+    std::vector<std::thread> shard_threads;
+    for (int shard = 1; shard < shards_; ++shard)
+        shard_threads.emplace_back([&, shard]() { run_proxy(*frontends[shard], *backends[shard]); });
+
+    run_proxy(*frontends[0], *backends[0]);
+
+    for (auto& thread : shard_threads) thread.join();
+}
+
 //
 // Manager
 //
@@ -583,8 +752,11 @@ goby::zeromq::Manager::Manager(zmq::context_t& context,
       subscribe_socket_(std::make_unique<zmq::socket_t>(context_, ZMQ_SUB)),
       publish_socket_(std::make_unique<zmq::socket_t>(context_, ZMQ_PUB))
 {
-    setup_socket(*subscribe_socket_, subscribe_socket_cfg());
-    setup_socket(*publish_socket_, publish_socket_cfg());
+    // requests and responses go through the Router shard for their group
+    setup_socket(*subscribe_socket_,
+                 subscribe_socket_cfg(std::max(0, router_shard(zmq_filter_req_, router_.shards()))));
+    setup_socket(*publish_socket_,
+                 publish_socket_cfg(std::max(0, router_shard(zmq_filter_rep_, router_.shards()))));
     poll_items_.resize(NUMBER_SOCKETS);
     poll_items_[SOCKET_MANAGER] = {(void*)*manager_socket_, 0, ZMQ_POLLIN, 0};
     poll_items_[SOCKET_SUBSCRIBE] = {(void*)*subscribe_socket_, 0, ZMQ_POLLIN, 0};
@@ -648,6 +820,7 @@ void goby::zeromq::Manager::run()
                             zmq::message_t reply(pb_response.ByteSizeLong());
                             pb_response.SerializeToArray((char*)reply.data(), reply.size());
                             manager_socket_->send(reply, zmq_send_flags_none);
+                            publish_hold_released();
                             break;
                         }
                         case SOCKET_SUBSCRIBE:
@@ -672,6 +845,7 @@ void goby::zeromq::Manager::run()
                                 static_cast<char*>(reply.data()) + zmq_filter_rep_.size(), size);
 
                             publish_socket_->send(reply, zmq_send_flags_none);
+                            publish_hold_released();
                             break;
                     }
                 }
@@ -711,11 +885,22 @@ goby::zeromq::Manager::handle_request(const protobuf::ManagerRequest& pb_request
     {
         *pb_response.mutable_subscribe_socket() = subscribe_socket_cfg();
         *pb_response.mutable_publish_socket() = publish_socket_cfg();
+        for (int shard = 1, n = router_.shards(); shard < n; ++shard)
+        {
+            *pb_response.add_shard_subscribe_socket() = subscribe_socket_cfg(shard);
+            *pb_response.add_shard_publish_socket() = publish_socket_cfg(shard);
+        }
     }
     else if (pb_request.request() == protobuf::PROVIDE_HOLD_STATE)
     {
+        bool was_holding = reported_clients_ != required_clients_;
         if (pb_request.ready() && required_clients_.count(pb_request.client_name()))
             reported_clients_.insert(pb_request.client_name());
+        if (was_holding && reported_clients_ == required_clients_)
+        {
+            hold_release_time_ = goby::time::SteadyClock::now();
+            hold_released_ = push_release_;
+        }
 
         pb_response.set_hold(hold_state());
     }
@@ -723,7 +908,32 @@ goby::zeromq::Manager::handle_request(const protobuf::ManagerRequest& pb_request
     return pb_response;
 }
 
-goby::zeromq::protobuf::Socket goby::zeromq::Manager::publish_socket_cfg()
+void goby::zeromq::Manager::publish_hold_released()
+{
+    if (!hold_released_)
+        return;
+    hold_released_ = false;
+
+    // push the release to all the clients rather than waiting for each of them to request the hold state again
+    protobuf::ManagerResponse pb_response;
+    pb_response.set_request(protobuf::PROVIDE_HOLD_STATE);
+    pb_response.set_client_name("");
+    pb_response.set_client_pid(0);
+    pb_response.set_hold(false);
+    pb_response.set_all_clients(true);
+
+    glog.is_debug3() && glog << "Manager:: Hold released, sending: "
+                             << pb_response.ShortDebugString() << std::endl;
+
+    auto size = pb_response.ByteSizeLong();
+    zmq::message_t reply(zmq_filter_rep_.size() + size);
+    memcpy(reply.data(), zmq_filter_rep_.data(), zmq_filter_rep_.size());
+    pb_response.SerializeToArray(static_cast<char*>(reply.data()) + zmq_filter_rep_.size(), size);
+
+    publish_socket_->send(reply, zmq_send_flags_none);
+}
+
+goby::zeromq::protobuf::Socket goby::zeromq::Manager::publish_socket_cfg(int shard)
 {
     protobuf::Socket publish_socket;
 
@@ -742,17 +952,17 @@ goby::zeromq::protobuf::Socket goby::zeromq::Manager::publish_socket_cfg()
             publish_socket.set_transport(protobuf::Socket::IPC);
             publish_socket.set_socket_name(
                 (cfg_.has_socket_name() ? cfg_.socket_name() : "/tmp/goby_" + cfg_.platform()) +
-                ".xsub");
+                ".xsub" + shard_suffix(shard));
             break;
         case protobuf::InterProcessPortalConfig::TCP:
             publish_socket.set_transport(protobuf::Socket::TCP);
-            publish_socket.set_ethernet_port(router_.sub_port);
+            publish_socket.set_ethernet_port(router_.shard_sub_port(shard));
             break;
     }
     return publish_socket;
 }
 
-goby::zeromq::protobuf::Socket goby::zeromq::Manager::subscribe_socket_cfg()
+goby::zeromq::protobuf::Socket goby::zeromq::Manager::subscribe_socket_cfg(int shard)
 {
     while (cfg_.transport() == protobuf::InterProcessPortalConfig::TCP && (router_.pub_port == 0))
         usleep(1e4);
@@ -770,11 +980,12 @@ goby::zeromq::protobuf::Socket goby::zeromq::Manager::subscribe_socket_cfg()
             subscribe_socket.set_transport(protobuf::Socket::IPC);
             subscribe_socket.set_socket_name(
                 (cfg_.has_socket_name() ? cfg_.socket_name() : "/tmp/goby_" + cfg_.platform()) +
-                ".xpub");
+                ".xpub" + shard_suffix(shard));
             break;
         case protobuf::InterProcessPortalConfig::TCP:
             subscribe_socket.set_transport(protobuf::Socket::TCP);
-            subscribe_socket.set_ethernet_port(router_.pub_port); // our publish is their subscribe
+            subscribe_socket.set_ethernet_port(
+                router_.shard_pub_port(shard)); // our publish is their subscribe
             break;
     }
 
@@ -26,9 +26,10 @@
 
 #include "goby/middleware/marshalling/protobuf.h"
 
+#include <algorithm>          // for copy
 #include <atomic>             // for atomic
 #include <chrono>             // for mill...
-#include <condition_variable> // for cond...
+#include <cstdint>            // for uint64_t
 #include <deque>              // for deque
 #include <functional>         // for func...
 #include <iosfwd>             // for size_t
@@ -40,27 +41,31 @@
 #include <tuple>              // for make...
 #include <unistd.h>           // for getpid
 #include <unordered_map>      // for unor...
+#include <unordered_set>      // for unor...
 #include <utility>            // for make...
 #include <vector>             // for vector
 
 #include <zmq.h>   // for ZMQ_...
 #include <zmq.hpp> // for sock...
 
-#include "goby/middleware/common.h"                             // for thre...
-#include "goby/middleware/group.h"                              // for Group
-#include "goby/middleware/marshalling/interface.h"              // for Seri...
-#include "goby/middleware/protobuf/serializer_transporter.pb.h" // for Seri...
-#include "goby/middleware/protobuf/transporter_config.pb.h"     // for Tran...
-#include "goby/middleware/transport/interface.h"                // for Poll...
-#include "goby/middleware/transport/interprocess.h"             // for Inte...
-#include "goby/middleware/transport/null.h"                     // for Null...
-#include "goby/middleware/transport/serialization_handlers.h"   // for Seri...
-#include "goby/middleware/transport/subscriber.h"               // for Subs...
-#include "goby/time/system_clock.h"                             // for Syst...
-#include "goby/util/debug_logger/flex_ostream.h"                // for Flex...
-#include "goby/util/debug_logger/flex_ostreambuf.h"             // for lock
-#include "goby/zeromq/protobuf/interprocess_config.pb.h"        // for Inte...
-#include "goby/zeromq/protobuf/interprocess_zeromq.pb.h"        // for Inpr...
+#include "goby/middleware/common.h"                              // for thre...
+#include "goby/middleware/group.h"                               // for Group
+#include "goby/middleware/marshalling/interface.h"               // for Seri...
+#include "goby/middleware/protobuf/serializer_transporter.pb.h"  // for Seri...
+#include "goby/middleware/protobuf/transporter_config.pb.h"      // for Tran...
+#include "goby/middleware/transport/detail/publication_filter.h" // for Publ...
+#include "goby/middleware/transport/interface.h"                 // for Poll...
+#include "goby/middleware/transport/interprocess.h"              // for Inte...
+#include "goby/middleware/transport/null.h"                      // for Null...
+#include "goby/middleware/transport/poller_wakeup.h"             // for Poll...
+#include "goby/middleware/transport/serialization_handlers.h"    // for Seri...
+#include "goby/middleware/transport/subscriber.h"                // for Subs...
+#include "goby/time/steady_clock.h"                              // for Stea...
+#include "goby/time/system_clock.h"                              // for Syst...
+#include "goby/util/debug_logger/flex_ostream.h"                 // for Flex...
+#include "goby/util/debug_logger/flex_ostreambuf.h"              // for lock
+#include "goby/zeromq/protobuf/interprocess_config.pb.h"         // for Inte...
+#include "goby/zeromq/protobuf/interprocess_zeromq.pb.h"         // for Inpr...
 
 #if ZMQ_VERSION <= ZMQ_MAKE_VERSION(4, 3, 1)
 #define USE_OLD_ZMQ_CPP_API
@@ -157,6 +162,26 @@ make_identifier(const std::string& type_name, int scheme, const std::string& gro
     }
 }
 
+/// \brief Router shard (0 to shards - 1) that carries the publications and subscriptions for an identifier ("/group/..."), or -1 if the identifier doesn't contain the whole group (e.g. the "/" prefix used by regex subscriptions), as is subscribed to on all the shards
+inline int router_shard(const std::string& identifier, int shards)
+{
+    if (shards <= 1)
+        return 0;
+
+    auto group_end = identifier.find('/', 1);
+    if (identifier.empty() || identifier[0] != '/' || group_end == std::string::npos)
+        return -1;
+
+    // FNV-1a, as all the processes (whatever their standard library's std::hash) must agree
+    std::uint32_t hash = 2166136261u;
+    for (std::string::size_type i = 1; i < group_end; ++i)
+    {
+        hash ^= static_cast<unsigned char>(identifier[i]);
+        hash *= 16777619u;
+    }
+    return hash % shards;
+}
+
 #ifdef USE_OLD_ZMQ_CPP_API
 using zmq_recv_flags_type = int;
 using zmq_send_flags_type = int;
@@ -165,6 +190,35 @@ using zmq_recv_flags_type = zmq::recv_flags;
 using zmq_send_flags_type = zmq::send_flags;
 #endif
 
+/// \brief Set of topics (identifier prefixes) that any process is subscribed to, as reported by the subscription messages received on the publish (XPUB) sockets (one per Router shard).
+///
+/// Updated by the portal's main thread; has_subscribers() may be called from any thread (e.g. by the forwarders via middleware::detail::PublicationFilter).
+class SubscriptionTracker
+{
+  public:
+    /// \brief Apply a subscription message from an XPUB socket: 1 (subscribe) or 0 (unsubscribe) followed by the topic
+    void handle_subscription_message(const char* data, std::size_t size);
+
+    /// \brief Record that all pending subscription messages have been handled
+    void set_updated();
+
+    /// \brief Returns true if any topic is a prefix of \c identifier
+    ///
+    /// \param max_age If the subscriptions were last updated longer ago than this, true is returned (used by threads that cannot update the subscriptions themselves)
+    bool has_subscribers(const std::string& identifier,
+                         std::chrono::steady_clock::duration max_age =
+                             std::chrono::steady_clock::duration::max());
+
+  private:
+    std::mutex mutex_;
+    // a topic subscribed to on several Router shards (e.g. "/") is reported by each of them
+    std::multiset<std::string> topics_;
+    // identifier -> has_subscribers, cleared when topics_ changes
+    std::unordered_map<std::string, bool> cache_;
+    bool updated_{false};
+    std::chrono::steady_clock::time_point last_update_;
+};
+
 // run in the same thread as InterProcessPortal
 class InterProcessPortalMainThread
 {
@@ -175,9 +229,11 @@ class InterProcessPortalMainThread
 #ifdef USE_OLD_CPPZMQ_SETSOCKOPT
         control_socket_.setsockopt(ZMQ_LINGER, 0);
         publish_socket_.setsockopt(ZMQ_LINGER, 0);
+        for (auto& socket : shard_publish_sockets_) socket->setsockopt(ZMQ_LINGER, 0);
 #else
         control_socket_.set(zmq::sockopt::linger, 0);
         publish_socket_.set(zmq::sockopt::linger, 0);
+        for (auto& socket : shard_publish_sockets_) socket->set(zmq::sockopt::linger, 0);
 #endif
     }
 
@@ -186,13 +242,49 @@ class InterProcessPortalMainThread
 
     bool recv(protobuf::InprocControl* control_msg,
               zmq_recv_flags_type flags = zmq_recv_flags_type());
-    void set_publish_cfg(const protobuf::Socket& cfg);
+    /// \brief Connect the publish socket for each Router shard (shard_cfg are shards 1 and up)
+    void set_publish_cfg(const protobuf::Socket& cfg,
+                         const google::protobuf::RepeatedPtrField<protobuf::Socket>& shard_cfg);
 
     void set_hold_state(bool hold);
     bool hold_state() { return hold_; }
+    goby::time::SteadyClock::time_point hold_release_time() const { return hold_release_time_; }
 
     void publish(const std::string& identifier, const char* bytes, int size,
-                 bool ignore_buffer = false);
+                 bool ignore_buffer = false)
+    {
+        publish(
+            identifier, size, [&](char* buffer) { std::copy(bytes, bytes + size, buffer); },
+            ignore_buffer);
+    }
+
+    /// \brief Publish size bytes of data after the (null terminated) identifier, with the data written by write_data(char* buffer) directly into the outgoing message (or the hold buffer)
+    template <typename DataWriter>
+    void publish(const std::string& identifier, std::size_t size, const DataWriter& write_data,
+                 bool ignore_buffer = false)
+    {
+        if (publish_ready() || ignore_buffer)
+        {
+            zmq::message_t msg(identifier.size() + size);
+            auto* msg_data = static_cast<char*>(msg.data());
+            std::copy(identifier.begin(), identifier.end(), msg_data);
+            write_data(msg_data + identifier.size());
+            send_publication(identifier, msg);
+        }
+        else
+        {
+            std::vector<char> bytes(size);
+            write_data(bytes.data());
+            buffer_publication(identifier, std::move(bytes));
+        }
+    }
+
+    /// \brief Handle any pending subscription messages on the publish socket
+    void update_subscriptions();
+    /// \brief Returns false if no process is subscribed to the given (null terminated) identifier. Always true while holding as publications are queued until the hold is released.
+    bool has_subscribers(const std::string& identifier);
+    std::shared_ptr<SubscriptionTracker> subscriptions() { return subscriptions_; }
+
     void subscribe(const std::string& identifier);
     void unsubscribe(const std::string& identifier);
     void reader_shutdown();
@@ -201,11 +293,25 @@ class InterProcessPortalMainThread
     void send_control_msg(const protobuf::InprocControl& control);
 
   private:
+    void send_publication(const std::string& identifier, zmq::message_t& msg);
+    void buffer_publication(const std::string& identifier, std::vector<char> bytes);
+
+    int shards() const { return 1 + shard_publish_sockets_.size(); }
+    zmq::socket_t& publish_socket(int shard)
+    {
+        return shard <= 0 ? publish_socket_ : *shard_publish_sockets_[shard - 1];
+    }
+
   private:
+    zmq::context_t& context_;
     zmq::socket_t control_socket_;
     zmq::socket_t publish_socket_;
+    // Router shards 1 and up
+    std::vector<std::unique_ptr<zmq::socket_t>> shard_publish_sockets_;
     bool hold_{true};
+    goby::time::SteadyClock::time_point hold_release_time_;
     bool have_pubsub_sockets_{false};
+    std::shared_ptr<SubscriptionTracker> subscriptions_{std::make_shared<SubscriptionTracker>()};
 
     std::deque<std::pair<std::string, std::vector<char>>>
         publish_queue_; //used before hold == false
@@ -220,17 +326,19 @@ class InterProcessPortalReadThread
   public:
     InterProcessPortalReadThread(const protobuf::InterProcessPortalConfig& cfg,
                                  zmq::context_t& context, std::atomic<bool>& alive,
-                                 std::shared_ptr<std::condition_variable_any> poller_cv);
+                                 std::shared_ptr<middleware::PollerWakeup> poller_wakeup);
     void run();
     ~InterProcessPortalReadThread()
     {
 #ifdef USE_OLD_CPPZMQ_SETSOCKOPT
         control_socket_.setsockopt(ZMQ_LINGER, 0);
         subscribe_socket_.setsockopt(ZMQ_LINGER, 0);
+        for (auto& socket : shard_subscribe_sockets_) socket->setsockopt(ZMQ_LINGER, 0);
         manager_socket_.setsockopt(ZMQ_LINGER, 0);
 #else
         control_socket_.set(zmq::sockopt::linger, 0);
         subscribe_socket_.set(zmq::sockopt::linger, 0);
+        for (auto& socket : shard_subscribe_sockets_) socket->set(zmq::sockopt::linger, 0);
         manager_socket_.set(zmq::sockopt::linger, 0);
 #endif
     }
@@ -242,14 +350,25 @@ class InterProcessPortalReadThread
     void manager_data(const zmq::message_t& zmq_msg);
     void send_control_msg(const protobuf::InprocControl& control);
     void send_manager_request(const protobuf::ManagerRequest& req);
+    // (un)subscribe on the Router shard for the identifier (or all of them)
+    void set_subscription(const std::string& zmq_filter, bool subscribe);
+
+    int shards() const { return 1 + shard_subscribe_sockets_.size(); }
+    zmq::socket_t& subscribe_socket(int shard)
+    {
+        return shard <= 0 ? subscribe_socket_ : *shard_subscribe_sockets_[shard - 1];
+    }
 
   private:
     const protobuf::InterProcessPortalConfig& cfg_;
+    zmq::context_t& context_;
     zmq::socket_t control_socket_;
     zmq::socket_t subscribe_socket_;
+    // Router shards 1 and up, polled after the NUMBER_SOCKETS sockets
+    std::vector<std::unique_ptr<zmq::socket_t>> shard_subscribe_sockets_;
     zmq::socket_t manager_socket_;
     std::atomic<bool>& alive_;
-    std::shared_ptr<std::condition_variable_any> poller_cv_;
+    std::shared_ptr<middleware::PollerWakeup> poller_wakeup_;
     std::vector<zmq::pollitem_t> poll_items_;
     enum
     {
@@ -285,7 +404,7 @@ class InterProcessPortalImplementation
         : cfg_(cfg),
           zmq_context_(cfg.zeromq_number_io_threads()),
           zmq_main_(zmq_context_),
-          zmq_read_thread_(cfg_, zmq_context_, zmq_alive_, middleware::PollerInterface::cv())
+          zmq_read_thread_(cfg_, zmq_context_, zmq_alive_, middleware::PollerInterface::wakeup())
     {
         _init();
     }
@@ -296,13 +415,15 @@ class InterProcessPortalImplementation
           cfg_(cfg),
           zmq_context_(cfg.zeromq_number_io_threads()),
           zmq_main_(zmq_context_),
-          zmq_read_thread_(cfg_, zmq_context_, zmq_alive_, middleware::PollerInterface::cv())
+          zmq_read_thread_(cfg_, zmq_context_, zmq_alive_, middleware::PollerInterface::wakeup())
     {
         _init();
     }
 
     ~InterProcessPortalImplementation()
     {
+        middleware::detail::PublicationFilter::remove(this);
+
         if (zmq_thread_)
         {
             zmq_main_.reader_shutdown();
@@ -311,11 +432,29 @@ class InterProcessPortalImplementation
     }
 
     /// \brief When using hold functionality, call when the process is ready to receive publications (typically done after most or all subscribe calls)
-    void ready() { ready_ = true; }
+    void ready()
+    {
+        ready_ = true;
+        // report now rather than at the next periodic hold state request, so that the hold is released as soon as the last required client is ready
+        if (zmq_main_.hold_state())
+            _request_hold_state();
+    }
 
     /// \brief When using hold functionality, returns whether the system is holding (true) and thus waiting for all processes to connect and be ready, or running (false).
     bool hold_state() { return zmq_main_.hold_state(); }
 
+    /// \brief When using hold functionality, the time at which the Manager's release of the hold was received (before the publications queued during the hold are sent), or time_point() while holding
+    goby::time::SteadyClock::time_point hold_release_time() const
+    {
+        return zmq_main_.hold_release_time();
+    }
+
+    /// \brief Number of publications (from this portal and its forwarders) that were not serialized or sent as no process was subscribed to them
+    std::uint64_t publications_skipped() const { return publications_skipped_; }
+
+    /// \brief Number of received messages that were not parsed or posted to this portal's subscriptions as they all use the KEEP_LATEST SubscriptionQueue overflow policy and a newer message from the same publisher (identifier) was received before the same poll()
+    std::uint64_t received_conflated() const { return received_conflated_; }
+
     friend Base;
     friend typename Base::Base;
 
@@ -335,7 +474,8 @@ class InterProcessPortalImplementation
                 switch (control_msg.type())
                 {
                     case protobuf::InprocControl::PUB_CONFIGURATION:
-                        zmq_main_.set_publish_cfg(control_msg.publish_socket());
+                        zmq_main_.set_publish_cfg(control_msg.publish_socket(),
+                                                  control_msg.shard_publish_socket());
                         break;
                     default: break;
                 }
@@ -350,9 +490,10 @@ class InterProcessPortalImplementation
             [this](std::shared_ptr<const protobuf::ManagerResponse> response) {
                 goby::glog.is_debug3() && goby::glog << "Received ManagerResponse: "
                                                      << response->ShortDebugString() << std::endl;
+                // gobyd publishes a response for all clients when it releases the hold
                 if (response->request() == protobuf::PROVIDE_HOLD_STATE &&
-                    response->client_pid() == getpid() &&
-                    response->client_name() == cfg_.client_name())
+                    (response->all_clients() || (response->client_pid() == getpid() &&
+                                                 response->client_name() == cfg_.client_name())))
                 {
                     zmq_main_.set_hold_state(response->hold());
                 }
@@ -367,28 +508,64 @@ class InterProcessPortalImplementation
                 }
             },
             groups::manager_response, middleware::Subscriber<protobuf::ManagerResponse>());
+
+        if (cfg_.skip_unsubscribed_publications())
+        {
+            // forwarded publications are published from this (main) thread
+            auto subscriptions = zmq_main_.subscriptions();
+            std::string process = process_;
+            std::string thread = id_component(std::this_thread::get_id(), threads_);
+            middleware::detail::PublicationFilter::add(
+                Base::layer(), this,
+                [subscriptions, process, thread](const std::string& type_name, int scheme,
+                                                 const std::string& group) {
+                    return subscriptions->has_subscribers(
+                        make_identifier(type_name, scheme, group,
+                                        IdentifierWildcard::THREAD_WILDCARD, process) +
+                            thread + '\0',
+                        forwarder_subscriptions_max_age_);
+                });
+        }
     }
 
     template <typename Data, int scheme>
     void _publish(const Data& d, const goby::middleware::Group& group,
                   const middleware::Publisher<Data>& /*publisher*/, bool ignore_buffer = false)
     {
-        std::vector<char> bytes(middleware::SerializerParserHelper<Data, scheme>::serialize(d));
         std::string type_name = middleware::SerializerParserHelper<Data, scheme>::type_name(d);
-        _publish_serialized(type_name, scheme, bytes, group, ignore_buffer);
+        std::string identifier = _make_fully_qualified_identifier(type_name, scheme, group) + '\0';
+        // check before serializing, as this is the expensive part of an unwanted publication
+        if (!ignore_buffer && !_has_subscribers(identifier))
+            return;
+
+        middleware::BufferSerializer<Data, scheme> serializer(d);
+        zmq_main_.publish(
+            identifier, serializer.size(), [&](char* buffer) { serializer.write(buffer); },
+            ignore_buffer);
     }
 
     void _publish_serialized(std::string type_name, int scheme, const std::vector<char>& bytes,
                              const goby::middleware::Group& group, bool ignore_buffer = false)
     {
         std::string identifier = _make_fully_qualified_identifier(type_name, scheme, group) + '\0';
-        zmq_main_.publish(identifier, &bytes[0], bytes.size(), ignore_buffer);
+        if (!ignore_buffer && !_has_subscribers(identifier))
+            return;
+        zmq_main_.publish(identifier, bytes.data(), bytes.size(), ignore_buffer);
+    }
+
+    bool _has_subscribers(const std::string& identifier)
+    {
+        if (!cfg_.skip_unsubscribed_publications() || zmq_main_.has_subscribers(identifier))
+            return true;
+
+        ++publications_skipped_;
+        return false;
     }
 
     template <typename Data, int scheme>
     void _subscribe(std::function<void(std::shared_ptr<const Data> d)> f,
                     const goby::middleware::Group& group,
-                    const middleware::Subscriber<Data>& /*subscriber*/)
+                    const middleware::Subscriber<Data>& subscriber)
     {
         std::string identifier =
             _make_identifier<Data, scheme>(group, IdentifierWildcard::PROCESS_THREAD_WILDCARD);
@@ -402,6 +579,11 @@ class InterProcessPortalImplementation
             portal_subscriptions_.count(identifier) == 0)
             zmq_main_.subscribe(identifier);
         portal_subscriptions_.insert(std::make_pair(identifier, subscription));
+
+        if (subscriber.cfg().queue().overflow() ==
+            middleware::protobuf::TransporterConfig::SubscriptionQueue::KEEP_LATEST)
+            ++latest_only_subscriptions_[identifier];
+        _update_conflated(identifier);
     }
 
     std::shared_ptr<middleware::SerializationSubscriptionRegex> _subscribe_regex(
@@ -425,6 +607,8 @@ class InterProcessPortalImplementation
             _make_identifier<Data, scheme>(group, IdentifierWildcard::PROCESS_THREAD_WILDCARD);
 
         portal_subscriptions_.erase(identifier);
+        latest_only_subscriptions_.erase(identifier);
+        _update_conflated(identifier);
 
         // If no forwarded subscriptions, do the actual unsubscribe
         if (forwarder_subscriptions_.count(identifier) == 0)
@@ -444,6 +628,8 @@ class InterProcessPortalImplementation
                     zmq_main_.unsubscribe(identifier);
             }
             portal_subscriptions_.clear();
+            latest_only_subscriptions_.clear();
+            conflated_identifiers_.clear();
         }
         else // forwarder unsubscribe
         {
@@ -462,7 +648,7 @@ class InterProcessPortalImplementation
         }
     }
 
-    int _poll(std::unique_ptr<std::unique_lock<std::timed_mutex>>& lock)
+    int _poll()
     {
         int items = 0;
         protobuf::InprocControl new_control_msg;
@@ -476,16 +662,30 @@ class InterProcessPortalImplementation
         while (zmq_main_.recv(&new_control_msg, flags))
             zmq_main_.control_buffer().push_back(new_control_msg);
 
-        while (!zmq_main_.control_buffer().empty())
+        // keep the subscriptions seen by the forwarders up to date (and drain the publish socket's subscription messages in any case)
+        zmq_main_.update_subscriptions();
+
+        _find_conflated();
+
+        for (std::size_t index = 0; !zmq_main_.control_buffer().empty(); ++index)
         {
             const auto& control_msg = zmq_main_.control_buffer().front();
             switch (control_msg.type())
             {
                 case protobuf::InprocControl::RECEIVE:
                 {
-                    ++items;
-                    if (lock)
-                        lock.reset();
+                    // superseded by a newer message in this poll (regex subscriptions still receive it)
+                    bool conflated = index < conflated_.size() && conflated_[index];
+                    if (conflated)
+                    {
+                        ++received_conflated_;
+                        if (regex_subscriptions_.empty())
+                            break;
+                    }
+                    else
+                    {
+                        ++items;
+                    }
 
                     const auto& data = control_msg.received_data();
 
@@ -498,12 +698,15 @@ class InterProcessPortalImplementation
                     // build a set so if any of the handlers unsubscribes, we still have a pointer to the middleware::SerializationHandlerBase<>
                     std::vector<std::weak_ptr<const middleware::SerializationHandlerBase<>>>
                         subs_to_post;
-                    auto portal_range = portal_subscriptions_.equal_range(identifier);
-                    for (auto it = portal_range.first; it != portal_range.second; ++it)
-                        subs_to_post.push_back(it->second);
-                    auto forwarder_it = forwarder_subscriptions_.find(identifier);
-                    if (forwarder_it != forwarder_subscriptions_.end())
-                        subs_to_post.push_back(forwarder_it->second);
+                    if (!conflated)
+                    {
+                        auto portal_range = portal_subscriptions_.equal_range(identifier);
+                        for (auto it = portal_range.first; it != portal_range.second; ++it)
+                            subs_to_post.push_back(it->second);
+                        auto forwarder_it = forwarder_subscriptions_.find(identifier);
+                        if (forwarder_it != forwarder_subscriptions_.end())
+                            subs_to_post.push_back(forwarder_it->second);
+                    }
 
                     // actually post the data
                     {
@@ -538,23 +741,7 @@ class InterProcessPortalImplementation
                 }
                 break;
 
-                case protobuf::InprocControl::REQUEST_HOLD_STATE:
-                {
-                    protobuf::ManagerRequest req;
-
-                    req.set_ready(ready_);
-                    req.set_request(protobuf::PROVIDE_HOLD_STATE);
-                    req.set_client_name(cfg_.client_name());
-                    req.set_client_pid(getpid());
-
-                    goby::glog.is_debug3() && goby::glog << "Published ManagerRequest: "
-                                                         << req.ShortDebugString() << std::endl;
-
-                    _publish<protobuf::ManagerRequest, middleware::MarshallingScheme::PROTOBUF>(
-                        req, groups::manager_request,
-                        middleware::Publisher<protobuf::ManagerRequest>(), true);
-                }
-                break;
+                case protobuf::InprocControl::REQUEST_HOLD_STATE: _request_hold_state(); break;
 
                 default: break;
             }
@@ -563,6 +750,75 @@ class InterProcessPortalImplementation
         return items;
     }
 
+    void _request_hold_state()
+    {
+        protobuf::ManagerRequest req;
+
+        req.set_ready(ready_);
+        req.set_request(protobuf::PROVIDE_HOLD_STATE);
+        req.set_client_name(cfg_.client_name());
+        req.set_client_pid(getpid());
+
+        goby::glog.is_debug3() && goby::glog << "Published ManagerRequest: "
+                                             << req.ShortDebugString() << std::endl;
+
+        _publish<protobuf::ManagerRequest, middleware::MarshallingScheme::PROTOBUF>(
+            req, groups::manager_request, middleware::Publisher<protobuf::ManagerRequest>(), true);
+    }
+
+    // marks (in conflated_) the received messages in the control buffer that needn't be posted as a newer message with the same identifier follows them and all the subscriptions to it are KEEP_LATEST
+    void _find_conflated()
+    {
+        conflated_.clear();
+        if (conflated_identifiers_.empty())
+            return;
+
+        const auto& buffer = zmq_main_.control_buffer();
+        conflated_.resize(buffer.size(), false);
+        newer_received_.clear();
+        // newest first
+        for (std::size_t index = buffer.size(); index-- > 0;)
+        {
+            const auto& control_msg = buffer[index];
+            if (control_msg.type() != protobuf::InprocControl::RECEIVE)
+                continue;
+
+            // "/group/scheme/type/process/thread/\0data": compare the "/group/scheme/type/" prefix (subscription identifier) without parsing the whole identifier
+            const auto& data = control_msg.received_data();
+            auto null_delim = data.find('\0');
+            std::string::size_type type_end = 0;
+            int slashes = 0;
+            for (; slashes < 4; ++slashes)
+            {
+                type_end = data.find('/', type_end);
+                if (type_end == std::string::npos || type_end > null_delim)
+                    break;
+                ++type_end;
+            }
+            if (slashes < 4)
+                continue;
+
+            subscription_identifier_.assign(data, 0, type_end);
+            if (!conflated_identifiers_.count(subscription_identifier_))
+                continue;
+
+            if (!newer_received_.insert(data.substr(0, null_delim)).second)
+                conflated_[index] = true;
+        }
+    }
+
+    // conflate received messages for this subscription identifier if all the subscriptions to it are KEEP_LATEST (i.e. only from the portal thread)
+    void _update_conflated(const std::string& identifier)
+    {
+        auto latest_only_it = latest_only_subscriptions_.find(identifier);
+        if (latest_only_it != latest_only_subscriptions_.end() &&
+            latest_only_it->second == portal_subscriptions_.count(identifier) &&
+            forwarder_subscriptions_.count(identifier) == 0)
+            conflated_identifiers_.insert(identifier);
+        else
+            conflated_identifiers_.erase(identifier);
+    }
+
     void _receive_publication_forwarded(
         const goby::middleware::protobuf::SerializerTransporterMessage& msg)
     {
@@ -570,8 +826,23 @@ class InterProcessPortalImplementation
             _make_identifier(msg.key().type(), msg.key().marshalling_scheme(), msg.key().group(),
                              IdentifierWildcard::NO_WILDCARDS) +
             '\0';
+        // the forwarder may not have had up-to-date subscriptions
+        if (!_has_subscribers(identifier))
+            return;
         auto& bytes = msg.data();
-        zmq_main_.publish(identifier, &bytes[0], bytes.size());
+        zmq_main_.publish(identifier, bytes.data(), bytes.size());
+    }
+
+    void _receive_publication_forwarded(const middleware::SerializedPublication& publication)
+    {
+        std::string identifier =
+            _make_identifier(publication.type, publication.scheme, publication.group,
+                             IdentifierWildcard::NO_WILDCARDS) +
+            '\0';
+        // the forwarder may not have had up-to-date subscriptions
+        if (!_has_subscribers(identifier))
+            return;
+        zmq_main_.publish(identifier, publication.bytes.data(), publication.bytes.size());
     }
 
     void _receive_subscription_forwarded(
@@ -617,6 +888,7 @@ class InterProcessPortalImplementation
 
             default: break;
         }
+        _update_conflated(identifier);
     }
 
     void _forwarder_unsubscribe(const std::string& subscriber_id, const std::string& identifier)
@@ -733,34 +1005,71 @@ class InterProcessPortalImplementation
     std::unordered_multimap<std::string,
                             std::shared_ptr<const middleware::SerializationSubscriptionRegex>>
         regex_subscriptions_;
+
+    // number of portal subscriptions for each identifier that use the KEEP_LATEST overflow policy
+    std::unordered_map<std::string, std::size_t> latest_only_subscriptions_;
+    // identifiers whose received messages are conflated in _poll()
+    std::unordered_set<std::string> conflated_identifiers_;
+    // reused by _find_conflated()
+    std::vector<bool> conflated_;
+    std::unordered_set<std::string> newer_received_;
+    std::string subscription_identifier_;
     std::string process_{std::to_string(getpid())};
     std::unordered_map<int, std::string> schemes_;
     std::unordered_map<std::thread::id, std::string> threads_;
 
     bool ready_{false};
+
+    std::atomic<std::uint64_t> publications_skipped_{0};
+    std::uint64_t received_conflated_{0};
+    // forwarders only skip publications if the main thread has updated the subscriptions this recently, so that a main thread blocked in poll() (which would not see new subscriptions) results in a forwarded publication (which wakes it up)
+    static constexpr std::chrono::steady_clock::duration forwarder_subscriptions_max_age_{
+        std::chrono::milliseconds(100)};
 };
 
+template <typename InnerTransporter,
+          template <typename Derived, typename InnerTransporterType> class PortalBase>
+constexpr std::chrono::steady_clock::duration
+    InterProcessPortalImplementation<InnerTransporter,
+                                     PortalBase>::forwarder_subscriptions_max_age_;
+
+/// \brief XPUB/XSUB proxy for all the interprocess publications, split into cfg.router_shards() proxies (each run in its own thread) partitioned by router_shard()
 class Router
 {
   public:
     Router(zmq::context_t& context, const protobuf::InterProcessPortalConfig& cfg)
-        : context_(context), cfg_(cfg)
+        : context_(context),
+          cfg_(cfg),
+          shards_(std::max(1u, cfg.router_shards())),
+          shard_pub_ports_(shards_, 0),
+          shard_sub_ports_(shards_, 0)
     {
     }
 
+    /// \brief Runs shard 0 in the calling thread, and the others in threads of their own, until the context is terminated
     void run();
     unsigned last_port(zmq::socket_t& socket);
 
+    int shards() const { return shards_; }
+    /// \brief TCP port of a shard's XPUB socket, valid once pub_port is set
+    unsigned shard_pub_port(int shard) const { return shard_pub_ports_[shard]; }
+    /// \brief TCP port of a shard's XSUB socket, valid once sub_port is set
+    unsigned shard_sub_port(int shard) const { return shard_sub_ports_[shard]; }
+
     Router(Router&) = delete;
     Router& operator=(Router&) = delete;
 
   public:
+    // shard 0, set after all the shards are bound
     std::atomic<unsigned> pub_port{0};
     std::atomic<unsigned> sub_port{0};
 
   private:
     zmq::context_t& context_;
     const protobuf::InterProcessPortalConfig& cfg_;
+    const int shards_;
+    std::vector<unsigned> shard_pub_ports_;
+    std::vector<unsigned> shard_sub_ports_;
 };
 
 class Manager
@@ -774,19 +1083,30 @@ class Manager
         : Manager(context, cfg, router)
     {
         for (const auto& req_c : hold.required_client()) required_clients_.insert(req_c);
+        push_release_ = hold.push_release();
     }
 
     void run();
 
     protobuf::ManagerResponse handle_request(const protobuf::ManagerRequest& pb_request);
-    protobuf::Socket publish_socket_cfg();
-    protobuf::Socket subscribe_socket_cfg();
+    protobuf::Socket publish_socket_cfg(int shard = 0);
+    protobuf::Socket subscribe_socket_cfg(int shard = 0);
 
     bool hold_state();
 
+    /// \brief Time at which the last required client reported ready (releasing the hold), or time_point() if the hold hasn't been released
+    goby::time::SteadyClock::time_point hold_release_time() const { return hold_release_time_; }
+
+  private:
+    // publishes a hold: false response for all clients (if the hold was released by the last request handled)
+    void publish_hold_released();
+
   private:
     std::set<std::string> reported_clients_;
     std::set<std::string> required_clients_;
+    bool hold_released_{false};
+    bool push_release_{true};
+    goby::time::SteadyClock::time_point hold_release_time_;
 
     zmq::context_t& context_;
     const protobuf::InterProcessPortalConfig& cfg_;